@@ -415,6 +415,7 @@ set(BASE_CMN_SRC
     src/common/fileback.cpp
     src/common/fileconf.cpp
     src/common/filefn.cpp
+    src/common/filemapping.cpp
     src/common/filename.cpp
     src/common/filesys.cpp
     src/common/filtall.cpp
@@ -474,6 +475,7 @@ set(BASE_CMN_SRC
     src/common/xti.cpp
     src/common/xtistrm.cpp
     src/common/zipstrm.cpp
+    src/common/zstdstream.cpp
     src/common/zstream.cpp
     src/common/fswatchercmn.cpp
     src/generic/fswatcherg.cpp
@@ -537,6 +539,7 @@ set(BASE_CMN_HDR
     wx/file.h
     wx/fileconf.h
     wx/filefn.h
+    wx/filemapping.h
     wx/filename.h
     wx/filesys.h
     wx/fontenc.h
@@ -643,6 +646,7 @@ set(BASE_CMN_HDR
     wx/xtiprop.h
     wx/xtitypes.h
     wx/zipstrm.h
+    wx/zstdstream.h
     wx/zstream.h
     wx/meta/convertible.h
     wx/meta/if.h
@@ -776,6 +780,7 @@ set(GUI_CMN_SRC
     src/common/imagall.cpp
     src/common/imagbmp.cpp
     src/common/image.cpp
+    src/common/imageloader.cpp
     src/common/imagfill.cpp
     src/common/imaggif.cpp
     src/common/imagiff.cpp
@@ -801,6 +806,7 @@ set(GUI_CMN_SRC
     src/common/panelcmn.cpp
     src/common/persist.cpp
     src/common/pickerbase.cpp
+    src/common/pixelconv.cpp
     src/common/popupcmn.cpp
     src/common/preferencescmn.cpp
     src/common/prntbase.cpp
@@ -1085,6 +1091,7 @@ set(GUI_CMN_HDR
     wx/iconbndl.h
     wx/imagbmp.h
     wx/image.h
+    wx/imageloader.h
     wx/imaggif.h
     wx/imagiff.h
     wx/imagjpeg.h
@@ -303,6 +303,22 @@ if(wxUSE_LIBLZMA)
     endif()
 endif()
 
+if(wxUSE_LIBZSTD)
+    find_package(Zstd)
+    if(NOT ZSTD_FOUND)
+        message(WARNING "libzstd not found, Zstandard compression won't be available")
+        wx_option_force_value(wxUSE_LIBZSTD OFF)
+    endif()
+endif()
+
+if(wxUSE_LIBPCRE2)
+    find_package(PCRE2)
+    if(NOT PCRE2_FOUND)
+        message(WARNING "PCRE2 not found, wxRE_PCRE won't use it")
+        wx_option_force_value(wxUSE_LIBPCRE2 OFF)
+    endif()
+endif()
+
 if(UNIX)
     if(wxUSE_SECRETSTORE AND NOT APPLE)
         # The required APIs are always available under MSW and OS X but we must
@@ -0,0 +1,38 @@
+## FindPCRE2.cmake
+##
+## Find the PCRE2 library.
+##
+## This module defines PCRE2_FOUND, PCRE2_INCLUDE_DIRS and PCRE2_LIBRARIES.
+
+## The library with the code unit size of wxChar is needed as wxRegEx uses it
+## for matching.
+if(NOT wxUSE_UNICODE)
+  set(PCRE2_LIBRARY_NAME pcre2-8)
+elseif(WIN32)
+  set(PCRE2_LIBRARY_NAME pcre2-16)
+else()
+  set(PCRE2_LIBRARY_NAME pcre2-32)
+endif()
+
+find_path(PCRE2_INCLUDE_DIR
+  NAMES
+    pcre2.h
+)
+
+find_library(PCRE2_LIBRARY
+  NAMES
+    ${PCRE2_LIBRARY_NAME}
+)
+
+include(FindPackageHandleStandardArgs)
+find_package_handle_standard_args(PCRE2 DEFAULT_MSG PCRE2_LIBRARY PCRE2_INCLUDE_DIR)
+
+if(PCRE2_FOUND)
+  set(PCRE2_INCLUDE_DIRS ${PCRE2_INCLUDE_DIR})
+  set(PCRE2_LIBRARIES ${PCRE2_LIBRARY})
+else()
+  set(PCRE2_INCLUDE_DIRS)
+  set(PCRE2_LIBRARIES)
+endif()
+
+mark_as_advanced(PCRE2_LIBRARY PCRE2_INCLUDE_DIR)
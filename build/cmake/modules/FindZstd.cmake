@@ -0,0 +1,29 @@
+## FindZstd.cmake
+##
+## Find the Zstandard compression library.
+##
+## This module defines ZSTD_FOUND, ZSTD_INCLUDE_DIRS and ZSTD_LIBRARIES.
+
+find_path(ZSTD_INCLUDE_DIR
+  NAMES
+    zstd.h
+)
+
+find_library(ZSTD_LIBRARY
+  NAMES
+    zstd
+    zstd_static
+)
+
+include(FindPackageHandleStandardArgs)
+find_package_handle_standard_args(Zstd DEFAULT_MSG ZSTD_LIBRARY ZSTD_INCLUDE_DIR)
+
+if(ZSTD_FOUND)
+  set(ZSTD_INCLUDE_DIRS ${ZSTD_INCLUDE_DIR})
+  set(ZSTD_LIBRARIES ${ZSTD_LIBRARY})
+else()
+  set(ZSTD_INCLUDE_DIRS)
+  set(ZSTD_LIBRARIES)
+endif()
+
+mark_as_advanced(ZSTD_LIBRARY ZSTD_INCLUDE_DIR)
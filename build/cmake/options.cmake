@@ -92,6 +92,12 @@ wx_add_thirdparty_library(wxUSE_LIBTIFF TIFF "use libtiff (TIFF file format)")
 wx_option(wxUSE_LIBLZMA "use LZMA compression" OFF)
 set(wxTHIRD_PARTY_LIBRARIES ${wxTHIRD_PARTY_LIBRARIES} wxUSE_LIBLZMA "use liblzma for LZMA compression")
 
+wx_option(wxUSE_LIBZSTD "use Zstandard compression" OFF)
+set(wxTHIRD_PARTY_LIBRARIES ${wxTHIRD_PARTY_LIBRARIES} wxUSE_LIBZSTD "use libzstd for Zstandard compression")
+
+wx_option(wxUSE_LIBPCRE2 "use PCRE2 for wxRegEx" OFF)
+set(wxTHIRD_PARTY_LIBRARIES ${wxTHIRD_PARTY_LIBRARIES} wxUSE_LIBPCRE2 "use PCRE2 for Perl-compatible regular expressions")
+
 wx_option(wxUSE_OPENGL "use OpenGL (or Mesa)")
 
 if(UNIX)
@@ -258,6 +258,8 @@ switches and options:
 @li -h (\--help): Show a help message.
 @li -v (\--verbose): Show verbose logging information.
 @li -c (\--cpp-code): Write C++ source rather than a XRS file.
+@li -b (\--binary): Write a compiled XRC file rather than a XRS file, see
+    below.
 @li -e (\--extra-cpp-code): If used together with -c, generates C++ header file
     containing class definitions for the windows defined by the XRC file (see
     special subsection).
@@ -265,8 +267,8 @@ switches and options:
 @li -g (\--gettext): Output underscore-wrapped strings that poEdit or gettext
     can scan. Outputs to stdout, or a file if -o is used.
 @li -n (\--function) @<name@>: Specify C++ function name (use with -c).
-@li -o (\--output) @<filename@>: Specify the output file, such as resource.xrs
-    or resource.cpp.
+@li -o (\--output) @<filename@>: Specify the output file, such as resource.xrs,
+    resource.xrb or resource.cpp.
 @li -l (\--list-of-handlers) @<filename@>: Output a list of necessary handlers
     to this file.
 
@@ -276,8 +278,21 @@ For example:
 $ wxrc resource.xrc
 $ wxrc resource.xrc -o resource.xrs
 $ wxrc resource.xrc -v -c -o resource.cpp
+$ wxrc dialogs.xrc frames.xrc -b -o resource.xrb
 @endcode
 
+@note Compiled XRC files, conventionally using .xrb extension, contain all the
+resources from all the input files in a pre-parsed binary form (see
+wxXmlBinaryDocument) and can be loaded by wxXmlResource::Load() just as the
+XRC files. Unlike them, they don't need to be parsed when loading them and
+each of the resources is only created when it is used for the first time,
+which makes using them much faster for the applications with many resources.
+Bitmaps and other files referenced by the resources are not included in the
+compiled file, the references to them are adjusted to be relative to the
+output file location instead. Notice that the compiled files are specific to
+the wxWidgets version used to create them and need to be regenerated when
+upgrading it.
+
 @note XRS file is essentially a renamed ZIP archive which means that you can
 manipulate it with standard ZIP tools. Note that if you are using XRS files,
 you have to initialize the wxFileSystem archive handler first! It is a simple
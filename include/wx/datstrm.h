@@ -56,6 +56,13 @@ protected:
     wxDataStreamBase(const wxMBConv& conv);
     ~wxDataStreamBase();
 
+    // Return true if the byte order used by the stream is different from the
+    // native one and so the bytes of all values need to be swapped.
+    bool NeedsSwap() const
+    {
+        return m_be_order != (wxBYTE_ORDER == wxBIG_ENDIAN);
+    }
+
 
     bool m_be_order;
 
@@ -92,6 +92,7 @@
 class WXDLLIMPEXP_FWD_BASE wxFileConfigGroup;
 class WXDLLIMPEXP_FWD_BASE wxFileConfigEntry;
 class WXDLLIMPEXP_FWD_BASE wxFileConfigLineList;
+class wxFileConfigPathCache;
 
 #if wxUSE_STREAMS
 class WXDLLIMPEXP_FWD_BASE wxInputStream;
@@ -229,10 +230,18 @@ private:
   bool DoSetPath(const wxString& strPath, bool createMissingComponents);
 
   // set/test the dirty flag
-  void SetDirty() { m_isDirty = true; }
-  void ResetDirty() { m_isDirty = false; }
+  void SetDirty() { m_isDirty = true; m_canUseJournal = false; }
+  void ResetDirty() { m_isDirty = false; m_canUseJournal = true; m_journal.clear(); }
   bool IsDirty() const { return m_isDirty; }
 
+  // functions used with wxCONFIG_USE_JOURNAL style
+  wxString GetJournalFileName() const;
+  wxString GetJournalHeader() const;
+  void AddToJournal(const wxString& record);
+  bool FlushJournal();
+  void ReplayJournal();
+  void UpdateLocalFileInfo();
+
 
   // member variables
   // ----------------
@@ -246,6 +255,8 @@ private:
   wxFileConfigGroup *m_pRootGroup,      // the top (unnamed) group
                     *m_pCurrentGroup;   // the current group
 
+  wxFileConfigPathCache *m_pathCache;   // groups of the recently used paths
+
   wxMBConv    *m_conv;
 
 #ifdef __UNIX__
@@ -255,6 +266,15 @@ private:
   bool m_isDirty;                       // if true, we have unsaved changes
   bool m_autosave;                      // if true, save changes on destruction
 
+  // if true, all unsaved changes are in m_journal and can be saved by just
+  // appending it to the journal file, see wxCONFIG_USE_JOURNAL
+  bool m_canUseJournal;
+  wxString m_journal;
+
+  wxFileOffset m_localFileSize,         // size of the local file on disk
+               m_journalSize;           // and of its journal
+  wxUint32 m_localFileChecksum;         // checksum of the local file contents
+
   wxDECLARE_NO_COPY_CLASS(wxFileConfig);
   wxDECLARE_ABSTRACT_CLASS(wxFileConfig);
 };
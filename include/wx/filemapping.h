@@ -0,0 +1,90 @@
+///////////////////////////////////////////////////////////////////////////////
+// Name:        wx/filemapping.h
+// Purpose:     wxFileMapping: map file contents into memory
+// Author:      wxWidgets development team
+// Created:     2026-10-19
+// Copyright:   (c) 2026 wxWidgets development team
+// Licence:     wxWindows licence
+///////////////////////////////////////////////////////////////////////////////
+
+#ifndef _WX_FILEMAPPING_H_
+#define _WX_FILEMAPPING_H_
+
+#include "wx/defs.h"
+
+#if wxUSE_FILE
+
+#include "wx/string.h"
+
+// ----------------------------------------------------------------------------
+// wxFileMapping: read-only or read-write memory mapping of an entire file
+// ----------------------------------------------------------------------------
+
+class WXDLLIMPEXP_BASE wxFileMapping
+{
+public:
+    enum Mode
+    {
+        Read,
+        ReadWrite
+    };
+
+    // Default ctor doesn't map anything, call Open() later.
+    wxFileMapping() { Init(); }
+
+    // Map the given file, use IsOk() to check if this succeeded.
+    explicit wxFileMapping(const wxString& filename, Mode mode = Read)
+    {
+        Init();
+
+        Open(filename, mode);
+    }
+
+    // Unmaps the file, if necessary.
+    ~wxFileMapping() { Close(); }
+
+    // Map the entire contents of the given file into memory, closing the
+    // currently mapped file, if any. Logs an error and returns false if the
+    // file couldn't be mapped.
+    bool Open(const wxString& filename, Mode mode = Read);
+
+    // Unmap the file: the pointers returned by GetData() become invalid.
+    void Close();
+
+    // Note that the mapping of an empty file is valid but has NULL data.
+    bool IsOk() const { return m_ok; }
+
+    // Return the size of the mapped data, which is the size of the file.
+    size_t GetSize() const { return m_size; }
+
+    // Return the pointer to the mapped data.
+    const void* GetData() const { return m_data; }
+
+    // Return the pointer to the data which can be modified, the changes are
+    // written back to the file. Can only be used in ReadWrite mode.
+    void* GetWritableData() const;
+
+    // Write any changes done to the mapped data to the file immediately.
+    bool Flush();
+
+private:
+    void Init()
+    {
+        m_data = NULL;
+        m_size = 0;
+        m_ok = false;
+        m_writable = false;
+    }
+
+
+    void* m_data;
+    size_t m_size;
+    bool m_ok;
+    bool m_writable;
+
+    wxDECLARE_NO_COPY_CLASS(wxFileMapping);
+};
+
+#endif // wxUSE_FILE
+
+#endif // _WX_FILEMAPPING_H_
@@ -18,6 +18,33 @@
 
 WX_DECLARE_STRING_HASH_MAP(int, wxArchiveFilenameHashMap);
 
+//---------------------------------------------------------------------------
+// wxArchiveFSCacheStats: statistics about wxArchiveFSHandler caches use
+//---------------------------------------------------------------------------
+
+struct wxArchiveFSCacheStats
+{
+    wxArchiveFSCacheStats()
+    {
+        archiveHits = archiveMisses = dataHits = dataMisses = 0;
+        dataCount = dataSize = 0;
+    }
+
+    // number of times the catalog of an already opened archive was reused
+    // and number of archives which had to be opened
+    size_t archiveHits,
+           archiveMisses;
+
+    // number of files returned from the cache of entries contents and number
+    // of files which had to be read from the archive
+    size_t dataHits,
+           dataMisses;
+
+    // number of entries and total size of the data currently in the cache
+    size_t dataCount,
+           dataSize;
+};
+
 //---------------------------------------------------------------------------
 // wxArchiveFSHandler
 //---------------------------------------------------------------------------
@@ -33,8 +60,18 @@ public:
     void Cleanup();
     virtual ~wxArchiveFSHandler();
 
+    // Set the maximal size of the entries whose contents is kept in memory
+    // after being read and the maximal total size of all such entries, use
+    // 0 for either of them to disable caching the contents.
+    void SetCacheLimits(size_t maxEntrySize, size_t maxTotalSize);
+
+    wxArchiveFSCacheStats GetCacheStats() const;
+    void ResetCacheStats();
+
 private:
     class wxArchiveFSCache *m_cache;
+    class wxArchiveFSDataCache *m_dataCache;
+    wxArchiveFSCacheStats m_stats;
     wxFileSystem m_fs;
 
     // these vars are used by FindFirst/Next:
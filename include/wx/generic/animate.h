@@ -151,6 +151,9 @@ protected:      // internal utilities
 
     void IncrementalUpdateBackingStore();
     bool RebuildBackingStoreUpToFrame(unsigned int);
+
+    // Return true if the given frame hides all the previous ones.
+    bool IsKeyFrame(unsigned int frame) const;
     void DrawFrame(wxDC &dc, unsigned int);
 
     virtual void DisplayStaticImage() wxOVERRIDE;
@@ -18,6 +18,7 @@
 #include "wx/image.h"
 #include "wx/animdecod.h"
 #include "wx/dynarray.h"
+#include "wx/vector.h"
 
 // internal utility used to store a frame in 8bit-per-pixel format
 class GIFImage;
@@ -52,7 +53,18 @@ public:
     wxGIFDecoder();
     ~wxGIFDecoder();
 
-    // get data of current frame
+    // get data of current frame: notice that the frames are decoded on
+    // demand and the pointer returned by GetData() is only valid until the
+    // next call to it for a different frame, as the frame may be discarded
+    // from the cache of the decoded frames then
+    //
+    // as only the first frame is decoded by LoadGIF(), errors in the other
+    // ones are not detected by it and such frames are decoded as far as
+    // possible, as truncated ones, i.e. GetData() and ConvertToImage() still
+    // succeed for them and only fail if there is not enough memory
+    //
+    // also notice that, because these const functions update the cache, the
+    // same decoder can't be used from several threads at once
     unsigned char* GetData(unsigned int frame) const;
     unsigned char* GetPalette(unsigned int frame) const;
     unsigned int GetNcolours(unsigned int frame) const;
@@ -68,12 +80,17 @@ public:
     bool IsAnimation() const
         { return m_nFrames > 1; }
 
-    // load function which returns more info than just Load():
+    // load function which returns more info than just Load(): notice that
+    // only the first frame data is validated by it, see GetData()
     wxGIFErrorCode LoadGIF( wxInputStream& stream );
 
     // free all internal frames
     void Destroy();
 
+    // set the maximal amount of memory used for the decoded frames, the least
+    // recently used frames are discarded when it is exceeded (16MB by default)
+    void SetMaxCacheSize(size_t bytes);
+
     // implementation of wxAnimationDecoder's pure virtuals
     virtual bool Load( wxInputStream& stream ) wxOVERRIDE
         { return LoadGIF(stream) == wxGIF_OK; }
@@ -94,10 +111,23 @@ private:
     wxGIFErrorCode dgif(wxInputStream& stream,
                         GIFImage *img, int interl, int bits);
 
+    // decode the given frame if it's not decoded yet
+    wxGIFErrorCode DecodeFrame(unsigned int frame) const;
+
+    // discard the decoded frames to make room for sizeNeeded more bytes
+    void ShrinkCache(size_t sizeNeeded) const;
+
 
     // array of all frames
     wxArrayPtrVoid m_frames;
 
+    // indices of the decoded frames, from least to most recently used
+    mutable wxVector<unsigned int> m_cachedFrames;
+
+    // memory used by the decoded frames and its upper limit
+    mutable size_t m_cacheSize;
+    size_t m_maxCacheSize;
+
     // decoder state vars
     int           m_restbits;       // remaining valid bits
     unsigned int  m_restbyte;       // remaining bytes in this block
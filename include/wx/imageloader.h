@@ -0,0 +1,211 @@
+///////////////////////////////////////////////////////////////////////////////
+// Name:        wx/imageloader.h
+// Purpose:     wxImageLoader: loading images in background threads
+// Author:      wxWidgets development team
+// Created:     2026-10-19
+// Copyright:   (c) 2026 wxWidgets development team
+// Licence:     wxWindows licence
+///////////////////////////////////////////////////////////////////////////////
+
+#ifndef _WX_IMAGELOADER_H_
+#define _WX_IMAGELOADER_H_
+
+#include "wx/defs.h"
+
+#if wxUSE_IMAGE && wxUSE_THREADS && wxUSE_STREAMS
+
+#include "wx/event.h"
+#include "wx/image.h"
+#include "wx/thread.h"
+#include "wx/vector.h"
+
+class WXDLLIMPEXP_FWD_BASE wxInputStream;
+
+class wxImageLoaderRequest;
+class wxImageLoaderThread;
+
+// ----------------------------------------------------------------------------
+// wxImageLoaderEvent: sent when an image has been loaded by wxImageLoader
+// ----------------------------------------------------------------------------
+
+class WXDLLIMPEXP_CORE wxImageLoaderEvent : public wxEvent
+{
+public:
+    wxImageLoaderEvent(wxEventType type = wxEVT_NULL, int winid = wxID_ANY)
+        : wxEvent(winid, type),
+          m_requestId(0)
+    {
+    }
+
+    wxImageLoaderEvent(wxEventType type,
+                       int winid,
+                       int requestId,
+                       const wxString& filename,
+                       const wxImage& image)
+        : wxEvent(winid, type),
+          m_requestId(requestId),
+          m_filename(filename),
+          m_image(image)
+    {
+    }
+
+    // The value returned by wxImageLoader::Load() for this image.
+    int GetRequestId() const { return m_requestId; }
+
+    // The name of the file the image was loaded from, empty if it was loaded
+    // from a stream.
+    const wxString& GetFileName() const { return m_filename; }
+
+    // The loaded image, invalid if loading it failed.
+    const wxImage& GetImage() const { return m_image; }
+
+    bool IsOk() const { return m_image.IsOk(); }
+
+    virtual wxEvent *Clone() const wxOVERRIDE { return new wxImageLoaderEvent(*this); }
+
+private:
+    int m_requestId;
+    wxString m_filename;
+    wxImage m_image;
+
+    wxDECLARE_DYNAMIC_CLASS_NO_ASSIGN(wxImageLoaderEvent);
+};
+
+wxDECLARE_EXPORTED_EVENT(WXDLLIMPEXP_CORE, wxEVT_IMAGE_LOADED, wxImageLoaderEvent);
+
+typedef void (wxEvtHandler::*wxImageLoaderEventFunction)(wxImageLoaderEvent&);
+
+#define wxImageLoaderEventHandler(func) \
+    wxEVENT_HANDLER_CAST(wxImageLoaderEventFunction, func)
+
+#define EVT_IMAGE_LOADED(id, func) \
+    wx__DECLARE_EVT1(wxEVT_IMAGE_LOADED, id, wxImageLoaderEventHandler(func))
+
+// ----------------------------------------------------------------------------
+// wxImageLoader: decodes images using a pool of worker threads
+// ----------------------------------------------------------------------------
+
+class WXDLLIMPEXP_CORE wxImageLoader : public wxEvtHandler
+{
+public:
+    // The events are sent to the given handler, which must outlive this
+    // object, and use the specified id.
+    explicit wxImageLoader(wxEvtHandler *handler, int id = wxID_ANY);
+
+    // Cancels all the pending requests and waits until the worker threads
+    // terminate.
+    virtual ~wxImageLoader();
+
+    // Set the maximal number of worker threads, by default the number of
+    // CPUs is used. Can only be called before the first call to Load().
+    void SetMaxThreads(unsigned count);
+
+    // Limit the total size of the images being decoded or decoded but not
+    // delivered yet to the handler to the given number of bytes: when it
+    // would be exceeded, the worker threads don't start loading new images
+    // until some of them are processed by the main thread. 0 means no limit,
+    // which is the default.
+    void SetMemoryLimit(size_t bytes);
+
+    // Set wxIMAGE_OPTION_MAX_WIDTH and wxIMAGE_OPTION_MAX_HEIGHT for all
+    // images loaded after this call, which is useful for loading thumbnails.
+    void SetMaxSize(int width, int height);
+
+    // Queue the image for loading and return the request id, which is always
+    // strictly positive. Requests with higher priority are processed first,
+    // requests with the same priority are processed in the order of Load()
+    // calls.
+    int Load(const wxString& filename,
+             int priority = 0,
+             wxBitmapType type = wxBITMAP_TYPE_ANY);
+
+    // Overload loading the image from the given stream, which must be
+    // allocated on the heap and is deleted by the loader.
+    int Load(wxInputStream *stream,
+             int priority = 0,
+             wxBitmapType type = wxBITMAP_TYPE_ANY);
+
+    // Change the priority of a request which hasn't started yet, returns
+    // false if there is no such request.
+    bool SetPriority(int requestId, int priority);
+
+    // Cancel the given request: no event will be generated for it. Returns
+    // false if the request had been already completed or doesn't exist.
+    bool Cancel(int requestId);
+
+    // Cancel all the requests which haven't been delivered yet.
+    void CancelAll();
+
+    // Return the number of requests not delivered yet, including the ones
+    // being currently loaded.
+    size_t GetPendingCount() const;
+
+private:
+    friend class wxImageLoaderThread;
+
+    int DoLoad(wxImageLoaderRequest *request);
+
+    // Called by the worker threads: returns the next request to process or
+    // NULL if the thread should exit.
+    wxImageLoaderRequest *GetNextRequest();
+
+    // Called by the worker threads when a request is done.
+    void OnRequestDone(wxImageLoaderRequest *request);
+
+    // Called in the main thread when OnRequestDone() wakes it up.
+    void OnThreadEvent(wxThreadEvent& event);
+
+    // Return the estimated memory needed for loading the next image, 0 if
+    // unknown. Must be called with m_mutex locked.
+    size_t EstimateMemory() const;
+
+    // Return true if an image needing the given amount of memory can be
+    // loaded now. Must be called with m_mutex locked.
+    bool HasMemoryFor(size_t size) const;
+
+    void StartThreadsIfNeeded();
+    void StopThreads();
+
+
+    wxEvtHandler * const m_handler;
+    const int m_id;
+
+    unsigned m_maxThreads;
+    int m_maxWidth,
+        m_maxHeight;
+
+    // All the fields below are protected by this mutex.
+    mutable wxMutex m_mutex;
+    wxCondition m_condition;
+
+    int m_lastRequestId;
+    unsigned long m_lastSequence;
+
+    // Requests not started yet, not sorted.
+    wxVector<wxImageLoaderRequest *> m_pending;
+
+    // Requests being processed by the worker threads.
+    wxVector<wxImageLoaderRequest *> m_running;
+
+    // Requests processed but not delivered to the handler yet.
+    wxVector<wxImageLoaderRequest *> m_done;
+
+    // The memory used by the images in m_done, reserved for the images in
+    // m_running and its upper limit.
+    size_t m_memoryUsed,
+           m_memoryReserved,
+           m_memoryLimit;
+
+    // The size of the biggest image loaded so far.
+    size_t m_memoryBiggest;
+
+    bool m_stopping;
+
+    wxVector<wxImageLoaderThread *> m_threads;
+
+    wxDECLARE_NO_COPY_CLASS(wxImageLoader);
+};
+
+#endif // wxUSE_IMAGE && wxUSE_THREADS && wxUSE_STREAMS
+
+#endif // _WX_IMAGELOADER_H_
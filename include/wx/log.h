@@ -595,6 +595,19 @@ protected:
     // this one as the default implementation of it simply asserts
     virtual void DoLogText(const wxString& msg);
 
+    // override this method to queue the records instead of logging them
+    // immediately; it is called for the records logged from the main thread
+    // or from a thread using this object as its thread-specific target and for
+    // the records logged from the other threads when they're flushed by the
+    // main thread; if it returns true, the record is considered to be handled
+    // and the derived class must log it later using CallDoLogNow()
+    virtual bool DoQueueRecord(wxLogLevel WXUNUSED(level),
+                               const wxString& WXUNUSED(msg),
+                               const wxLogRecordInfo& WXUNUSED(info))
+    {
+        return false;
+    }
+
 
     // the rest of the functions are for backwards compatibility only, don't
     // use them in new code; if you're updating your existing code you need to
@@ -629,6 +642,14 @@ protected:
     // nothing otherwise; return the old value of repetition counter
     unsigned LogLastRepeatIfNeeded();
 
+    // called from OnLog() if it's called from the main thread or if we have a
+    // (presumably MT-safe) thread-specific logger, by FlushThreadMessages()
+    // when it plays back the buffered messages logged from the other threads
+    // and by the derived classes for the records queued by DoQueueRecord()
+    void CallDoLogNow(wxLogLevel level,
+                      const wxString& msg,
+                      const wxLogRecordInfo& info);
+
 private:
 #if wxUSE_THREADS
     // called from FlushActive() to really log any buffered messages logged
@@ -648,13 +669,6 @@ private:
     // from the main thread
     static wxLog *GetMainThreadActiveTarget();
 
-    // called from OnLog() if it's called from the main thread or if we have a
-    // (presumably MT-safe) thread-specific logger and by FlushThreadMessages()
-    // when it plays back the buffered messages logged from the other threads
-    void CallDoLogNow(wxLogLevel level,
-                      const wxString& msg,
-                      const wxLogRecordInfo& info);
-
 
     // variables
     // ----------------
@@ -756,6 +770,74 @@ protected:
 
 #endif // wxUSE_STD_IOSTREAM
 
+#if wxUSE_THREADS
+
+class wxLogAsyncQueue;
+class wxLogAsyncThread;
+
+// log everything to a "FILE *", stderr by default, from a background thread:
+// the threads logging the messages only queue them and they are formatted and
+// written in batches by the background thread
+class WXDLLIMPEXP_BASE wxLogAsync : public wxLog,
+                                    protected wxMessageOutputStderr
+{
+public:
+    // maxPending is the maximal number of messages queued by each thread, the
+    // messages logged by it while this number is reached are dropped
+    wxLogAsync(FILE *fp = NULL,
+               const wxMBConv& conv = wxConvWhateverWorks,
+               size_t maxPending = 4096);
+    virtual ~wxLogAsync();
+
+    // write all the queued messages immediately
+    virtual void Flush() wxOVERRIDE;
+
+    // return the total number of dropped messages
+    size_t GetDroppedCount() const;
+
+protected:
+    virtual bool DoQueueRecord(wxLogLevel level,
+                               const wxString& msg,
+                               const wxLogRecordInfo& info) wxOVERRIDE;
+    virtual void DoLogRecord(wxLogLevel level,
+                             const wxString& msg,
+                             const wxLogRecordInfo& info) wxOVERRIDE;
+    virtual void DoLogTextAtLevel(wxLogLevel level, const wxString& msg) wxOVERRIDE;
+    virtual void DoLogText(const wxString& msg) wxOVERRIDE;
+
+private:
+    // format and write all the queued records, also writing the repeated
+    // message count if flush is true
+    void WriteQueued(bool flush);
+
+    // write the formatted messages to the file
+    void WriteBatch();
+
+    // the buffers of all threads which logged anything, this object is
+    // shared with them and may outlive this one
+    wxLogAsyncQueue *m_queue;
+
+    // the thread writing the messages, NULL if it couldn't be started, in
+    // which case they are written immediately
+    wxLogAsyncThread *m_thread;
+
+    // protects all the fields below, which are only used by the thread
+    // currently writing the messages
+    wxCriticalSection m_csWrite;
+
+    // true while WriteQueued() is executing
+    bool m_writing;
+
+    // the formatted messages not written yet
+    wxMemoryBuffer m_batch;
+
+    friend class wxLogAsyncThread;
+
+    wxDECLARE_NO_COPY_CLASS(wxLogAsync);
+};
+
+#endif // wxUSE_THREADS
+
 // ----------------------------------------------------------------------------
 // /dev/null log target: suppress logging until this object goes out of scope
 // ----------------------------------------------------------------------------
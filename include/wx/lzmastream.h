@@ -79,16 +79,26 @@ class WXDLLIMPEXP_BASE wxLZMAOutputStream : public wxFilterOutputStream,
                                             private wxPrivate::wxLZMAData
 {
 public:
-    explicit wxLZMAOutputStream(wxOutputStream& stream, int level = -1)
+    // The threads parameter can be 0 to use as many threads as there are
+    // CPUs or a positive number of threads to use for compression. If more
+    // than one thread is used, the input is split in independently compressed
+    // blocks of the given size (0 means to use the default block size).
+    explicit wxLZMAOutputStream(wxOutputStream& stream,
+                                int level = -1,
+                                int threads = 1,
+                                size_t blockSize = 0)
         : wxFilterOutputStream(stream)
     {
-        Init(level);
+        Init(level, threads, blockSize);
     }
 
-    explicit wxLZMAOutputStream(wxOutputStream* stream, int level = -1)
+    explicit wxLZMAOutputStream(wxOutputStream* stream,
+                                int level = -1,
+                                int threads = 1,
+                                size_t blockSize = 0)
         : wxFilterOutputStream(stream)
     {
-        Init(level);
+        Init(level, threads, blockSize);
     }
 
     virtual ~wxLZMAOutputStream() { Close(); }
@@ -102,7 +112,7 @@ protected:
     wxFileOffset OnSysTell() const wxOVERRIDE { return m_pos; }
 
 private:
-    void Init(int level);
+    void Init(int level, int threads, size_t blockSize);
 
     // Write the contents of the internal buffer to the output stream.
     bool UpdateOutput();
@@ -126,19 +136,29 @@ class WXDLLIMPEXP_BASE wxLZMAClassFactory: public wxFilterClassFactory
 public:
     wxLZMAClassFactory();
 
+    // Set the parameters used for the output streams created by this factory,
+    // see wxLZMAOutputStream ctor for their meaning.
+    void SetThreads(int threads, size_t blockSize = 0)
+        { m_threads = threads; m_blockSize = blockSize; }
+    int GetThreads() const { return m_threads; }
+    size_t GetBlockSize() const { return m_blockSize; }
+
     wxFilterInputStream *NewStream(wxInputStream& stream) const wxOVERRIDE
         { return new wxLZMAInputStream(stream); }
     wxFilterOutputStream *NewStream(wxOutputStream& stream) const wxOVERRIDE
-        { return new wxLZMAOutputStream(stream, -1); }
+        { return new wxLZMAOutputStream(stream, -1, m_threads, m_blockSize); }
     wxFilterInputStream *NewStream(wxInputStream *stream) const wxOVERRIDE
         { return new wxLZMAInputStream(stream); }
     wxFilterOutputStream *NewStream(wxOutputStream *stream) const wxOVERRIDE
-        { return new wxLZMAOutputStream(stream, -1); }
+        { return new wxLZMAOutputStream(stream, -1, m_threads, m_blockSize); }
 
     const wxChar * const *GetProtocols(wxStreamProtocolType type
                                        = wxSTREAM_PROTOCOL) const wxOVERRIDE;
 
 private:
+    int m_threads;
+    size_t m_blockSize;
+
     wxDECLARE_DYNAMIC_CLASS(wxLZMAClassFactory);
 };
 
@@ -51,6 +51,9 @@ protected:
     wxFileOffset OnSysSeek(wxFileOffset pos, wxSeekMode mode) wxOVERRIDE;
     wxFileOffset OnSysTell() const wxOVERRIDE;
 
+    const void *DoPeekBuffer(size_t *size) wxOVERRIDE;
+    void DoConsumeBuffer(size_t size) wxOVERRIDE;
+
 private:
     // common part of ctors taking wxInputStream
     void InitFromStream(wxInputStream& stream, wxFileOffset lenFile);
@@ -0,0 +1,88 @@
+///////////////////////////////////////////////////////////////////////////////
+// Name:        wx/private/pixelconv.h
+// Purpose:     Bulk conversion functions between different pixel formats
+// Author:      wxWidgets development team
+// Created:     2026-10-19
+// Copyright:   (c) 2026 wxWidgets development team
+// Licence:     wxWindows licence
+///////////////////////////////////////////////////////////////////////////////
+
+#ifndef _WX_PRIVATE_PIXELCONV_H_
+#define _WX_PRIVATE_PIXELCONV_H_
+
+#include "wx/defs.h"
+
+// All the functions below convert the given number of pixels, typically one
+// row of an image, and are optimized for processing many pixels at once,
+// using SSE2 instructions when available.
+//
+// "RGB" format is the one used by wxImage: 3 bytes per pixel with the
+// optional alpha channel stored separately. "RGBA" format uses 4 bytes per
+// pixel, in this order, as GdkPixbuf does. Finally, "ARGB32" is the format
+// of Cairo image surfaces and of Windows DIBs: 32 bit words in native byte
+// order with the alpha channel in the most significant byte.
+
+// Convert from RGB to RGBA format, alpha may be NULL to make all pixels
+// opaque.
+WXDLLIMPEXP_CORE void wxConvertRGBToRGBA(unsigned char* dst,
+                                         const unsigned char* rgb,
+                                         const unsigned char* alpha,
+                                         size_t count);
+
+// Convert from RGBA to RGB format, alpha may be NULL to discard it.
+WXDLLIMPEXP_CORE void wxConvertRGBAToRGB(unsigned char* rgb,
+                                         unsigned char* alpha,
+                                         const unsigned char* src,
+                                         size_t count);
+
+// Convert from RGB to ARGB32 format. If alpha is NULL, the alpha byte of the
+// result is set to 0xff, otherwise the colour components are premultiplied
+// by it.
+WXDLLIMPEXP_CORE void wxConvertRGBToARGB32(wxUint32* dst,
+                                           const unsigned char* rgb,
+                                           const unsigned char* alpha,
+                                           size_t count);
+
+// Convert from ARGB32 to RGB format. If alpha is non-NULL, the alpha channel
+// is copied into it and the colour components are unpremultiplied, otherwise
+// they're copied as is.
+WXDLLIMPEXP_CORE void wxConvertARGB32ToRGB(unsigned char* rgb,
+                                           unsigned char* alpha,
+                                           const wxUint32* src,
+                                           size_t count);
+
+// Premultiply the colour components of ARGB32 pixels by their alpha, in
+// place. Notice that, for compatibility, the colour of fully transparent
+// pixels is left unchanged.
+WXDLLIMPEXP_CORE void wxPremultiplyARGB32(wxUint32* data, size_t count);
+
+// Compose the premultiplied ARGB32 source pixels over the destination ones
+// using the "over" operator, i.e. compute dst = src + dst*(1 - src_alpha) for
+// all components, including alpha. Fully transparent source pixels leave the
+// destination unchanged, even if their colour is not 0, as it may be for the
+// pixels premultiplied by wxPremultiplyARGB32().
+WXDLLIMPEXP_CORE void wxComposeARGB32Over(wxUint32* dst,
+                                          const wxUint32* src,
+                                          size_t count);
+
+// Convert RGB pixels to grey using the given weights for the components, as
+// wxColour::MakeGrey() does. If mask is non-NULL, it points to the 3
+// components of the mask colour and the pixels of this colour are left
+// unchanged.
+WXDLLIMPEXP_CORE void wxConvertRGBToGrey(unsigned char* dst,
+                                         const unsigned char* src,
+                                         size_t count,
+                                         double weight_r,
+                                         double weight_g,
+                                         double weight_b,
+                                         const unsigned char* mask = NULL);
+
+// Convert RGB pixels to their disabled appearance, as
+// wxColour::MakeDisabled() does. Mask has the same meaning as above.
+WXDLLIMPEXP_CORE void wxConvertRGBToDisabled(unsigned char* dst,
+                                             const unsigned char* src,
+                                             size_t count,
+                                             unsigned char brightness,
+                                             const unsigned char* mask = NULL);
+
+#endif // _WX_PRIVATE_PIXELCONV_H_
@@ -14,10 +14,44 @@
 
 class WXDLLIMPEXP_FWD_BASE wxLog;
 
+#if wxUSE_LOG && wxUSE_THREADS
+class wxLogAsyncBuffer;
+class wxLogAsyncQueue;
+
+// Release the buffer used by this thread for logging with wxLogAsync, does
+// nothing if the buffer is NULL.
+void wxReleaseLogAsyncBuffer(wxLogAsyncBuffer *buffer);
+
+// Release the reference to the wxLogAsync queue, does nothing if it is NULL.
+void wxReleaseLogAsyncQueue(wxLogAsyncQueue *queue);
+#endif
+
 #if wxUSE_INTL
 #include "wx/hashset.h"
 WX_DECLARE_HASH_SET(wxString, wxStringHash, wxStringEqual,
                     wxLocaleUntranslatedStrings);
+
+#include "wx/hashmap.h"
+typedef const wxString *wxTranslatedStringPtr;
+WX_DECLARE_HASH_MAP(wxString, wxTranslatedStringPtr, wxStringHash, wxStringEqual,
+                    wxTranslationsCacheMap);
+
+class WXDLLIMPEXP_FWD_BASE wxTranslations;
+
+// Results of the recent wxTranslations::GetTranslatedString() calls, with NULL
+// values for the strings without translations.
+struct wxTranslationsCache
+{
+    wxTranslationsCache() : translations(NULL), generation(0) { }
+
+    // the object whose translations are cached and the value of the global
+    // translations generation counter when the cache was filled: the cache is
+    // not used and cleared if either of them changes
+    const wxTranslations *translations;
+    int generation;
+
+    wxTranslationsCacheMap map;
+};
 #endif
 
 
@@ -50,9 +84,25 @@ public:
 #if wxUSE_INTL
     // Storage for wxTranslations::GetUntranslatedString()
     wxLocaleUntranslatedStrings untranslatedStrings;
+
+    // Storage for wxTranslations::GetTranslatedString()
+    wxTranslationsCache translationsCache;
+#endif
+
+#if wxUSE_LOG && wxUSE_THREADS
+    // the buffer used for queuing the messages logged by this thread when
+    // using wxLogAsync or NULL if it wasn't used by this thread yet
+    wxLogAsyncBuffer *logAsyncBuffer;
+
+    // the queue of the active wxLogAsync target, if any, as of the time when
+    // the active target was changed for the logTargetSerial-th time
+    wxLogAsyncQueue *logAsyncQueue;
+    int logTargetSerial;
 #endif
 
 #if wxUSE_THREADS
+    ~wxThreadSpecificInfo();
+
     // Cleans up storage for the current thread. Should be called when a thread
     // is being destroyed. If it's not called, the only bad thing that happens
     // is that the memory is deallocated later, on process termination.
@@ -60,7 +110,14 @@ public:
 #endif
 
 private:
-    wxThreadSpecificInfo() : logger(NULL), loggingDisabled(false) {}
+    wxThreadSpecificInfo() : logger(NULL), loggingDisabled(false)
+    {
+#if wxUSE_LOG && wxUSE_THREADS
+        logAsyncBuffer = NULL;
+        logAsyncQueue = NULL;
+        logTargetSerial = 0;
+#endif
+    }
 };
 
 #define wxThreadInfo wxThreadSpecificInfo::Get()
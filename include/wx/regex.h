@@ -16,6 +16,9 @@
 #if wxUSE_REGEX
 
 #include "wx/string.h"
+#include "wx/vector.h"
+
+class WXDLLIMPEXP_FWD_BASE wxArrayString;
 
 // ----------------------------------------------------------------------------
 // constants
@@ -46,6 +49,10 @@ enum
     // after/before it regardless of the setting of wxRE_NOT[BE]OL
     wxRE_NEWLINE  = 16,
 
+    // use PCRE2 library and Perl-compatible syntax, if available, otherwise
+    // this is the same as wxRE_ADVANCED
+    wxRE_PCRE     = 128,
+
     // default flags
     wxRE_DEFAULT  = wxRE_EXTENDED
 };
@@ -63,6 +70,23 @@ enum
     wxRE_NOTEOL = 64
 };
 
+// ----------------------------------------------------------------------------
+// wxRegExLineMatch: a line matched by wxRegEx::MatchLines()
+// ----------------------------------------------------------------------------
+
+struct wxRegExLineMatch
+{
+    // the index of the matching line
+    size_t line;
+
+    // the start of the match in the line and its length, both are 0 if the
+    // expression was compiled with wxRE_NOSUB
+    size_t start,
+           len;
+};
+
+typedef wxVector<wxRegExLineMatch> wxRegExLineMatches;
+
 // ----------------------------------------------------------------------------
 // wxRegEx: a regular expression
 // ----------------------------------------------------------------------------
@@ -97,8 +121,41 @@ public:
     //
     // may only be called after successful call to Compile()
     bool Matches(const wxString& text, int flags = 0) const;
-    bool Matches(const wxChar *text, int flags, size_t len) const
-        { return Matches(wxString(text, len), flags); }
+    bool Matches(const wxChar *text, int flags, size_t len) const;
+
+    // matches the expression against all the given lines and returns the
+    // number of matching lines, filling matches, if non-NULL, with their
+    // indices and the matching parts in the order of lines
+    //
+    // numThreads is the maximal number of threads used for matching, 0 means
+    // to use as many of them as there are CPUs
+    //
+    // this doesn't change the results returned by GetMatch()
+    size_t MatchLines(const wxArrayString& lines,
+                      wxRegExLineMatches *matches,
+                      int flags = 0,
+                      unsigned numThreads = 1) const;
+
+    // the same for the lines in a single buffer: offsets has count + 1
+    // elements and line n is the text from offsets[n] to offsets[n + 1],
+    // excluding the trailing line end, if any
+    size_t MatchLines(const wxChar *text,
+                      const size_t *offsets,
+                      size_t count,
+                      wxRegExLineMatches *matches,
+                      int flags = 0,
+                      unsigned numThreads = 1) const;
+
+#if wxUSE_UNICODE
+    // the same for the lines in a buffer in UTF-8, the offsets and the
+    // matching parts of the lines are in bytes
+    size_t MatchLinesUTF8(const char *text,
+                          const size_t *offsets,
+                          size_t count,
+                          wxRegExLineMatches *matches,
+                          int flags = 0,
+                          unsigned numThreads = 1) const;
+#endif // wxUSE_UNICODE
 
     // get the start index and the length of the match of the expression
     // (index 0) or a bracketed subexpression (index != 0)
@@ -173,6 +173,29 @@ public:
     bool Ungetch(char c);
 
 
+    // zero-copy read functions
+    // ------------------------
+
+    // return the pointer to the data which can be read from the stream right
+    // now without copying it and fill size with the size of this data
+    //
+    // the data remains in the stream until ConsumeBuffer() is called and the
+    // pointer is only valid until then or until any other method of the
+    // stream is called
+    //
+    // this works for all streams but only avoids copying the data for the
+    // streams keeping it in memory, the others read it into an internal
+    // buffer first
+    //
+    // blocks until some data appears in the stream, if necessary, and returns
+    // NULL (and sets size to 0) on EOF or error
+    const void *PeekBuffer(size_t *size);
+
+    // remove the given number of bytes, which must be less or equal to the
+    // size returned by the last call to PeekBuffer(), from the stream
+    void ConsumeBuffer(size_t size);
+
+
     // position functions
     // ------------------
 
@@ -200,6 +223,20 @@ protected:
     // read
     virtual size_t OnSysRead(void *buffer, size_t size) = 0;
 
+    // zero-copy read support
+    // ----------------------
+
+    // return the pointer to the stream data, this is only called by
+    // PeekBuffer() when the write-back buffer is empty
+    //
+    // the default implementation reads the data into the write-back buffer
+    // and returns it, streams keeping their data in memory should override
+    // this to return a pointer to it and must override DoConsumeBuffer() too
+    virtual const void *DoPeekBuffer(size_t *size);
+
+    // advance the current position by the given number of bytes
+    virtual void DoConsumeBuffer(size_t size);
+
     // write-back buffer support
     // -------------------------
 
@@ -567,19 +604,34 @@ public:
     // Position functions
     virtual wxFileOffset SeekI(wxFileOffset pos, wxSeekMode mode = wxFromStart) wxOVERRIDE;
     virtual wxFileOffset TellI() const wxOVERRIDE;
-    virtual bool IsSeekable() const wxOVERRIDE { return m_parent_i_stream->IsSeekable(); }
+    virtual bool IsSeekable() const wxOVERRIDE;
+
+    virtual wxFileOffset GetLength() const wxOVERRIDE;
 
     // the buffer given to the stream will be deleted by it
     void SetInputStreamBuffer(wxStreamBuffer *buffer);
     wxStreamBuffer *GetInputStreamBuffer() const { return m_i_streambuf; }
 
+    // read the next buffer from the parent stream in a background thread
+    // while the current one is being consumed, returns false if this couldn't
+    // be enabled (or disabled)
+    bool EnableReadAhead(bool enable = true);
+    bool IsReadAheadEnabled() const { return m_readAhead != NULL; }
+
 protected:
     virtual size_t OnSysRead(void *buffer, size_t bufsize) wxOVERRIDE;
     virtual wxFileOffset OnSysSeek(wxFileOffset seek, wxSeekMode mode) wxOVERRIDE;
     virtual wxFileOffset OnSysTell() const wxOVERRIDE;
 
+    virtual const void *DoPeekBuffer(size_t *size) wxOVERRIDE;
+    virtual void DoConsumeBuffer(size_t size) wxOVERRIDE;
+
     wxStreamBuffer *m_i_streambuf;
 
+private:
+    // the object reading the data in background, NULL if not used
+    class wxBufferedReadAhead *m_readAhead;
+
     wxDECLARE_NO_COPY_CLASS(wxBufferedInputStream);
 };
 
@@ -63,6 +63,18 @@ class WXDLLIMPEXP_FWD_BASE wxLocale;
 class wxPluralFormsCalculator;
 wxDECLARE_SCOPED_PTR(wxPluralFormsCalculator, wxPluralFormsCalculatorPtr)
 
+class wxMsgCatalogFile;
+wxDECLARE_SCOPED_PTR(wxMsgCatalogFile, wxMsgCatalogFilePtr)
+
+// flags for wxMsgCatalog::CreateFromFile() and CreateFromData()
+enum
+{
+    // don't convert all the messages when loading the catalog but look them
+    // up in the catalog data, memory-mapping the file if possible, when they
+    // are needed
+    wxMSGCATALOG_LAZY = 1
+};
+
 // ----------------------------------------------------------------------------
 // wxMsgCatalog corresponds to one loaded message catalog.
 // ----------------------------------------------------------------------------
@@ -72,17 +84,17 @@ class WXDLLIMPEXP_BASE wxMsgCatalog
 public:
     // Ctor is protected, because CreateFromXXX functions must be used,
     // but destruction should be unrestricted
-#if !wxUSE_UNICODE
     ~wxMsgCatalog();
-#endif
 
     // load the catalog from disk or from data; caller is responsible for
     // deleting them if not NULL
     static wxMsgCatalog *CreateFromFile(const wxString& filename,
-                                        const wxString& domain);
+                                        const wxString& domain,
+                                        int flags = 0);
 
     static wxMsgCatalog *CreateFromData(const wxScopedCharBuffer& data,
-                                        const wxString& domain);
+                                        const wxString& domain,
+                                        int flags = 0);
 
     // get name of the catalog
     wxString GetDomain() const { return m_domain; }
@@ -99,6 +111,9 @@ protected:
     {}
 
 private:
+    // common part of CreateFromXXX() called after loading m_file
+    bool FinishLoading(int flags);
+
     // variable pointing to the next element in a linked list (or NULL)
     wxMsgCatalog *m_pNext;
     friend class wxTranslations;
@@ -113,6 +128,9 @@ private:
 #endif
 
     wxPluralFormsCalculatorPtr m_pluralFormsCalculator;
+
+    // the catalog data if wxMSGCATALOG_LAZY is used, NULL otherwise
+    wxMsgCatalogFilePtr m_file;
 };
 
 // ----------------------------------------------------------------------------
@@ -222,12 +240,18 @@ class WXDLLIMPEXP_BASE wxFileTranslationsLoader
     : public wxTranslationsLoader
 {
 public:
+    // flags are passed to wxMsgCatalog::CreateFromFile()
+    explicit wxFileTranslationsLoader(int flags = 0) : m_flags(flags) { }
+
     static void AddCatalogLookupPathPrefix(const wxString& prefix);
 
     virtual wxMsgCatalog *LoadCatalog(const wxString& domain,
                                       const wxString& lang) wxOVERRIDE;
 
     virtual wxArrayString GetAvailableTranslations(const wxString& domain) const wxOVERRIDE;
+
+private:
+    int m_flags;
 };
 
 
@@ -112,12 +112,25 @@ protected:
 #if SIZEOF_WCHAR_T == 2
     wchar_t m_lastWChar;
 #endif // SIZEOF_WCHAR_T == 2
+
+    // True once GetChar() decoded at least one character: we can't query the
+    // conversion properties before this happens as wxConvAuto only creates
+    // the real conversion object when it sees the input.
+    bool m_hasDecoded;
 #endif // wxUSE_UNICODE
 
     bool   EatEOL(const wxChar &c);
     void   UngetLast(); // should be used instead of wxInputStream::Ungetch() because of Unicode issues
     wxChar NextNonSeparators();
 
+    // Helpers of ReadLine() implementing reading the entire lines at once
+    // directly from the stream buffer instead of decoding them one character
+    // at a time. ReadLineFromBuffer() returns false if the line must be read
+    // using GetChar(), e.g. because it couldn't be decoded.
+    bool   CanReadLineFromBuffer() const;
+    bool   ReadLineFromBuffer(wxString& line);
+    bool   DecodeLine(wxString& line, const char* data, size_t len) const;
+
     wxDECLARE_NO_COPY_CLASS(wxTextInputStream);
 };
 
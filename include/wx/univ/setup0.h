@@ -611,6 +611,28 @@
 // Recommended setting: 1 if you need LZMA compression.
 #define wxUSE_LIBLZMA       0
 
+// Set to 1 if libzstd is available to enable wxZstd{Input,Output}Stream
+// classes.
+//
+// As with liblzma above, libzstd headers and libraries must be available if
+// this option is enabled when not using configure or CMake.
+//
+// Default is 0 under MSW, auto-detected by configure.
+//
+// Recommended setting: 1 if you need fast compression and decompression.
+#define wxUSE_LIBZSTD       0
+
+// Set to 1 if PCRE2 library is available to use it for wxRegEx compiled with
+// wxRE_PCRE flag.
+//
+// As with liblzma above, PCRE2 headers and libraries must be available if
+// this option is enabled when not using configure or CMake.
+//
+// Default is 0 under MSW, auto-detected by configure.
+//
+// Recommended setting: 1 if you need fast regular expressions matching.
+#define wxUSE_LIBPCRE2      0
+
 // If enabled, the code written by Apple will be used to write, in a portable
 // way, float on the disk. See extended.c for the license which is different
 // from wxWidgets one.
@@ -20,6 +20,7 @@
 #include "wx/stream.h"
 #include "wx/file.h"
 #include "wx/ffile.h"
+#include "wx/filemapping.h"
 
 #if wxUSE_FILE
 
@@ -150,6 +151,42 @@ private:
     wxDECLARE_NO_COPY_CLASS(wxFileStream);
 };
 
+// ----------------------------------------------------------------------------
+// wxMappedFileInputStream reading from a file mapped into memory
+// ----------------------------------------------------------------------------
+
+class WXDLLIMPEXP_BASE wxMappedFileInputStream : public wxInputStream
+{
+public:
+    explicit wxMappedFileInputStream(const wxString& fileName);
+
+    virtual wxFileOffset GetLength() const wxOVERRIDE
+        { return static_cast<wxFileOffset>(m_mapping.GetSize()); }
+
+    virtual bool IsOk() const wxOVERRIDE
+        { return wxInputStream::IsOk() && m_mapping.IsOk(); }
+    virtual bool IsSeekable() const wxOVERRIDE { return true; }
+
+    // Direct access to the entire file contents, without copying them.
+    const void* GetData() const { return m_mapping.GetData(); }
+    size_t GetSize() const { return m_mapping.GetSize(); }
+
+protected:
+    virtual size_t OnSysRead(void *buffer, size_t size) wxOVERRIDE;
+    virtual wxFileOffset OnSysSeek(wxFileOffset pos, wxSeekMode mode) wxOVERRIDE;
+    virtual wxFileOffset OnSysTell() const wxOVERRIDE
+        { return static_cast<wxFileOffset>(m_pos); }
+
+    virtual const void *DoPeekBuffer(size_t *size) wxOVERRIDE;
+    virtual void DoConsumeBuffer(size_t size) wxOVERRIDE;
+
+private:
+    wxFileMapping m_mapping;
+    size_t m_pos;
+
+    wxDECLARE_NO_COPY_CLASS(wxMappedFileInputStream);
+};
+
 #endif //wxUSE_FILE
 
 #if wxUSE_FFILE
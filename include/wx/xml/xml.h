@@ -33,6 +33,7 @@ class WXDLLIMPEXP_FWD_XML wxXmlNode;
 class WXDLLIMPEXP_FWD_XML wxXmlAttribute;
 class WXDLLIMPEXP_FWD_XML wxXmlDocument;
 class WXDLLIMPEXP_FWD_XML wxXmlIOHandler;
+class WXDLLIMPEXP_FWD_XML wxXmlArena;
 class WXDLLIMPEXP_FWD_BASE wxInputStream;
 class WXDLLIMPEXP_FWD_BASE wxOutputStream;
 
@@ -81,6 +82,8 @@ private:
     wxString m_name;
     wxString m_value;
     wxXmlAttribute *m_next;
+
+    friend class wxXmlArena;
 };
 
 #if WXWIN_COMPATIBILITY_2_8
@@ -104,7 +107,7 @@ class WXDLLIMPEXP_XML wxXmlNode
 public:
     wxXmlNode()
         : m_attrs(NULL), m_parent(NULL), m_children(NULL), m_next(NULL),
-          m_lineNo(-1), m_noConversion(false)
+          m_lineNo(-1), m_noConversion(false), m_hasSharedName(false)
     {
     }
 
@@ -135,7 +138,8 @@ public:
 
     // access methods:
     wxXmlNodeType GetType() const { return m_type; }
-    const wxString& GetName() const { return m_name; }
+    const wxString& GetName() const
+        { return m_hasSharedName ? GetSharedName() : m_name; }
     const wxString& GetContent() const { return m_content; }
 
     bool IsWhitespaceOnly() const;
@@ -161,7 +165,7 @@ public:
     int GetLineNumber() const { return m_lineNo; }
 
     void SetType(wxXmlNodeType type) { m_type = type; }
-    void SetName(const wxString& name) { m_name = name; }
+    void SetName(const wxString& name) { m_name = name; m_hasSharedName = false; }
     void SetContent(const wxString& con) { m_content = con; }
 
     void SetParent(wxXmlNode *parent) { m_parent = parent; }
@@ -216,8 +220,17 @@ private:
     int m_lineNo; // line number in original file, or -1
     bool m_noConversion; // don't do encoding conversion - node is plain text
 
+    // Nodes created by wxXmlDocument::Load() with wxXMLDOC_USE_ARENA flag are
+    // allocated from a wxXmlArena and may use the name interned by it instead
+    // of m_name, this is only possible if this flag is set.
+    bool m_hasSharedName;
+
+    const wxString& GetSharedName() const;
+
     void DoFree();
     void DoCopy(const wxXmlNode& node);
+
+    friend class wxXmlArena;
 };
 
 #if WXWIN_COMPATIBILITY_2_8
@@ -273,7 +286,8 @@ private:
 enum wxXmlDocumentLoadFlag
 {
     wxXMLDOC_NONE = 0,
-    wxXMLDOC_KEEP_WHITESPACE_NODES = 1
+    wxXMLDOC_KEEP_WHITESPACE_NODES = 1,
+    wxXMLDOC_USE_ARENA = 2
 };
 
 
@@ -359,6 +373,152 @@ private:
     wxDECLARE_CLASS(wxXmlDocument);
 };
 
+
+// Kinds of the nodes returned by wxXmlReader.
+enum wxXmlReaderNodeType
+{
+    wxXML_READER_NONE,
+    wxXML_READER_START_ELEMENT,
+    wxXML_READER_END_ELEMENT,
+    wxXML_READER_TEXT,
+    wxXML_READER_CDATA,
+    wxXML_READER_COMMENT,
+    wxXML_READER_PI
+};
+
+class WXDLLIMPEXP_FWD_XML wxXmlReader;
+
+// Base class for the objects receiving the nodes from wxXmlReader::Parse().
+// All handlers may return false to stop parsing.
+
+class WXDLLIMPEXP_XML wxXmlReaderHandler
+{
+public:
+    wxXmlReaderHandler() {}
+    virtual ~wxXmlReaderHandler() {}
+
+    virtual bool OnStartElement(wxXmlReader& WXUNUSED(reader)) { return true; }
+    virtual bool OnEndElement(wxXmlReader& WXUNUSED(reader)) { return true; }
+    virtual bool OnText(wxXmlReader& WXUNUSED(reader)) { return true; }
+    virtual bool OnComment(wxXmlReader& WXUNUSED(reader)) { return true; }
+    virtual bool OnProcessingInstruction(wxXmlReader& WXUNUSED(reader)) { return true; }
+
+private:
+    wxDECLARE_NO_COPY_CLASS(wxXmlReaderHandler);
+};
+
+// This class reads XML documents sequentially, node by node, without building
+// the entire tree of wxXmlNode in memory as wxXmlDocument does.
+
+class WXDLLIMPEXP_XML wxXmlReader
+{
+public:
+    wxXmlReader();
+    explicit wxXmlReader(wxInputStream& stream, int flags = wxXMLDOC_NONE);
+    ~wxXmlReader();
+
+    // Start reading the given stream, which must remain valid while this
+    // object is used, using wxXmlDocumentLoadFlag values.
+    bool Open(wxInputStream& stream, int flags = wxXMLDOC_NONE);
+    void Close();
+
+    bool IsOpened() const { return m_impl != NULL; }
+
+    // Advance to the next node, returns false at the end of the document or
+    // on error.
+    bool Read();
+
+    // Read all the nodes and pass them to the handler. Returns false if an
+    // error occurred.
+    bool Parse(wxXmlReaderHandler& handler);
+
+    bool HasError() const;
+
+    // Accessors for the current node.
+    wxXmlReaderNodeType GetNodeType() const;
+    const wxString& GetName() const;
+    const wxString& GetContent() const;
+    int GetDepth() const;
+    int GetLineNumber() const;
+
+    // Attributes of the current start element node.
+    size_t GetAttributeCount() const;
+    const wxString& GetAttributeName(size_t n) const;
+    const wxString& GetAttributeValue(size_t n) const;
+    bool GetAttribute(const wxString& attrName, wxString *value) const;
+    wxString GetAttribute(const wxString& attrName,
+                          const wxString& defaultVal = wxEmptyString) const;
+    bool HasAttribute(const wxString& attrName) const;
+
+    // Read the entire subtree of the current start element node and return
+    // it as a new wxXmlNode which must be deleted by the caller, or NULL on
+    // error. After this call the reader is positioned on the end element
+    // node corresponding to the start one.
+    wxXmlNode *ReadNode();
+
+    // Skip the subtree of the current start element node, leaving the reader
+    // positioned on the corresponding end element node.
+    bool Skip();
+
+private:
+    class wxXmlReaderImpl *m_impl;
+
+    wxDECLARE_NO_COPY_CLASS(wxXmlReader);
+};
+
+
+// Compact binary representation of an XML document allowing to create the
+// nodes corresponding to the top-level elements of the document individually,
+// without parsing the entire document.
+
+class WXDLLIMPEXP_XML wxXmlBinaryDocument
+{
+public:
+    wxXmlBinaryDocument();
+    ~wxXmlBinaryDocument();
+
+    // Save the root element of the given document and all its descendants in
+    // binary format, indexing the children of the root element by the value
+    // of the given attribute.
+    static bool Save(const wxXmlDocument& doc,
+                     wxOutputStream& stream,
+                     const wxString& indexAttr = wxS("name"));
+
+    // Check if the stream contains data in binary format without consuming
+    // any of it.
+    static bool CanRead(wxInputStream& stream);
+
+    // Read all the data from the stream and load the index from it.
+    bool Load(wxInputStream& stream);
+    bool IsOk() const;
+
+    // Create a new node corresponding to the root element, without any
+    // children. The returned node must be deleted by the caller.
+    wxXmlNode *CreateRoot() const;
+
+    // Return the number of children of the root element.
+    size_t GetCount() const;
+
+    // Return the name of the n-th child of the root element and the value of
+    // its attribute used for indexing, empty if it doesn't have it.
+    wxString GetNodeName(size_t n) const;
+    wxString GetKey(size_t n) const;
+
+    // Return the index of the first child with the given key or of the next
+    // child with the same key as the given one, or wxNOT_FOUND.
+    int Find(const wxString& key) const;
+    int FindNext(size_t n) const;
+
+    // Create the n-th child of the root element with all its descendants. The
+    // returned node must be deleted by the caller.
+    wxXmlNode *CreateNode(size_t n) const;
+
+private:
+    class wxXmlBinaryDocumentImpl *m_impl;
+
+    wxDECLARE_NO_COPY_CLASS(wxXmlBinaryDocument);
+};
+
 #endif // wxUSE_XML
 
 #endif // _WX_XML_H_
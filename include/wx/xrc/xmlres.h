@@ -43,9 +43,11 @@ class WXDLLIMPEXP_FWD_CORE wxToolBar;
 
 class WXDLLIMPEXP_FWD_XML wxXmlDocument;
 class WXDLLIMPEXP_FWD_XML wxXmlNode;
+class WXDLLIMPEXP_FWD_XML wxXmlBinaryDocument;
 class WXDLLIMPEXP_FWD_XRC wxXmlSubclassFactory;
 class wxXmlSubclassFactories;
 class wxXmlResourceModule;
+class wxXmlResourceDataRecord;
 class wxXmlResourceDataRecords;
 
 // These macros indicate current version of XML resources (this information is
@@ -77,7 +79,8 @@ enum wxXmlResourceFlags
     wxXRC_USE_LOCALE     = 1,
     wxXRC_NO_SUBCLASSING = 2,
     wxXRC_NO_RELOADING   = 4,
-    wxXRC_USE_ENVVARS    = 8
+    wxXRC_USE_ENVVARS    = 8,
+    wxXRC_LOAD_ASYNC     = 16
 };
 
 // This class holds XML resources from one or more .xml files
@@ -396,6 +399,20 @@ private:
                       const wxString& classname,
                       bool recursive);
 
+    // implementation of DoLoadFile(): if binary is non-NULL and the file is a
+    // compiled XRC one, only its index is loaded and the binary document
+    // which can be used to load the resources later is returned in it
+    wxXmlDocument *DoLoadFile(const wxString& file,
+                              wxXmlBinaryDocument **binary);
+
+    // checks the document contents and prepares it for use, returns false if
+    // it's not a valid XRC document
+    bool DoPreprocessDocument(wxXmlDocument& doc);
+
+    // waits until the file loaded in the background, if any, is parsed and
+    // makes its contents available in the record
+    void DoFinishLoadFile(wxXmlResourceDataRecord& rec);
+
 private:
     long m_version;
 
@@ -15,6 +15,7 @@
 
 #include "wx/archive.h"
 #include "wx/filename.h"
+#include "wx/vector.h"
 
 // some methods from wxZipInputStream and wxZipOutputStream stream do not get
 // exported/imported when compiled with Mingw versions before 3.4.2. So they
@@ -277,6 +278,12 @@ private:
     wxZipNotifier *m_zipnotifier;
     class wxZipWeakLinks *m_backlink;
 
+    // copy all the fields except for the extra ones
+    void AssignFields(const wxZipEntry& e);
+
+    // copy the entry without sharing the extra fields memory with it
+    void AssignUnshared(const wxZipEntry& e);
+
     friend class wxZipInputStream;
     friend class wxZipOutputStream;
 
@@ -321,6 +328,9 @@ public:
     int  GetLevel() const                       { return m_level; }
     void WXZIPFIX SetLevel(int level);
 
+    bool IsParallelDeflateEnabled() const       { return m_parallel; }
+    void WXZIPFIX EnableParallelDeflate(bool enable = true);
+
     void SetFormat(wxZipArchiveFormat format)   { m_format = format; }
     wxZipArchiveFormat GetFormat() const        { return m_format; }
 
@@ -365,6 +375,7 @@ private:
     wxUint32 m_crcAccumulator;
     wxOutputStream *m_comp;
     int m_level;
+    bool m_parallel;
     wxFileOffset m_offsetAdjustment;
     wxString m_Comment;
     bool m_endrecWritten;
@@ -429,6 +440,9 @@ private:
     bool DoOpen(wxZipEntry *entry = NULL, bool raw = false);
     bool OpenDecompressor(bool raw = false);
 
+    // used by wxZipIndex to open an entry of an already indexed archive
+    bool OpenIndexedEntry(const wxZipEntry& entry);
+
     class wxStoredInputStream *m_store;
     class wxZlibInputStream2 *m_inflate;
     class wxRawInputStream *m_rawin;
@@ -450,11 +464,69 @@ private:
                     wxZipEntry *entry, wxZipInputStream& inputStream);
     friend bool wxZipOutputStream::CopyArchiveMetaData(
                     wxZipInputStream& inputStream);
+    friend class wxZipIndex;
 
     wxDECLARE_NO_COPY_CLASS(wxZipInputStream);
 };
 
 
+/////////////////////////////////////////////////////////////////////////////
+// wxZipIndex
+//
+// Reads the central directory of a zip archive once and allows finding its
+// entries by name and opening independent streams for reading them. The
+// index is not modified after its creation, so it can be used from several
+// threads at once, and each stream returned by OpenEntry() can be used by a
+// different thread.
+
+class WXDLLIMPEXP_BASE wxZipIndex
+{
+public:
+    // Index the zip file with the given name, which is mapped into memory
+    // if possible and is reopened for every entry otherwise.
+    explicit wxZipIndex(const wxString& filename, wxMBConv& conv = wxConvLocal);
+
+    // Index the zip archive contained in the given memory buffer, which must
+    // remain valid for the lifetime of this object.
+    wxZipIndex(const void *data, size_t size, wxMBConv& conv = wxConvLocal);
+
+    ~wxZipIndex();
+
+    bool IsOk() const                       { return m_ok; }
+
+    size_t GetCount() const                 { return m_entries.size(); }
+    const wxZipEntry& GetEntry(size_t n) const { return *m_entries[n]; }
+    const wxString& GetComment() const      { return m_comment; }
+
+    // Return the index of the entry with the given name or wxNOT_FOUND.
+    int Find(const wxString& name, wxPathFormat format = wxPATH_NATIVE) const;
+
+    // Return a new stream for reading the given entry or NULL on error. The
+    // caller must delete the stream, which can only be used for reading
+    // this entry.
+    wxZipInputStream *OpenEntry(size_t n) const;
+    wxZipInputStream *OpenEntry(const wxString& name,
+                                wxPathFormat format = wxPATH_NATIVE) const;
+
+private:
+    void Init(wxMBConv& conv);
+    void Load();
+    wxInputStream *OpenSource() const;
+
+    wxMBConv *m_conv;
+    wxString m_filename;
+    class wxFileMapping *m_mapping;
+    const void *m_data;
+    size_t m_size;
+    wxVector<wxZipEntry*> m_entries;
+    class wxZipIndexNames_ *m_names;
+    wxString m_comment;
+    bool m_ok;
+
+    wxDECLARE_NO_COPY_CLASS(wxZipIndex);
+};
+
+
 /////////////////////////////////////////////////////////////////////////////
 // Iterators
 
@@ -0,0 +1,183 @@
+///////////////////////////////////////////////////////////////////////////////
+// Name:        wx/zstdstream.h
+// Purpose:     Filters streams using Zstandard compression
+// Author:      wxWidgets development team
+// Created:     2026-10-19
+// Copyright:   (c) 2026 wxWidgets development team
+// Licence:     wxWindows licence
+///////////////////////////////////////////////////////////////////////////////
+
+#ifndef _WX_ZSTDSTREAM_H_
+#define _WX_ZSTDSTREAM_H_
+
+#include "wx/defs.h"
+
+#if wxUSE_LIBZSTD && wxUSE_STREAMS
+
+#include "wx/stream.h"
+#include "wx/versioninfo.h"
+
+// These are the real names of ZSTD_CCtx and ZSTD_DCtx types declared in zstd.h
+// which we don't want to include from here.
+struct ZSTD_CCtx_s;
+struct ZSTD_DCtx_s;
+
+// ----------------------------------------------------------------------------
+// Filter for decompressing data compressed using Zstandard
+// ----------------------------------------------------------------------------
+
+class WXDLLIMPEXP_BASE wxZstdInputStream : public wxFilterInputStream
+{
+public:
+    explicit wxZstdInputStream(wxInputStream& stream)
+        : wxFilterInputStream(stream)
+    {
+        Init();
+    }
+
+    explicit wxZstdInputStream(wxInputStream* stream)
+        : wxFilterInputStream(stream)
+    {
+        Init();
+    }
+
+    virtual ~wxZstdInputStream();
+
+    char Peek() wxOVERRIDE { return wxInputStream::Peek(); }
+    wxFileOffset GetLength() const wxOVERRIDE { return wxInputStream::GetLength(); }
+
+protected:
+    size_t OnSysRead(void *buffer, size_t size) wxOVERRIDE;
+    wxFileOffset OnSysTell() const wxOVERRIDE { return m_pos; }
+
+private:
+    void Init();
+
+    ZSTD_DCtx_s* m_dctx;
+
+    // Buffer for the compressed data read from the underlying stream.
+    wxUint8* m_inBuf;
+    size_t m_inBufSize;
+
+    // The part of m_inBuf which contains the data not decompressed yet.
+    size_t m_inPos,
+           m_inSize;
+
+    // True if the last frame hasn't been entirely decompressed yet.
+    bool m_inFrame;
+
+    // True if the decompressor may still have some output buffered.
+    bool m_hasOutput;
+
+    wxFileOffset m_pos;
+
+    wxDECLARE_NO_COPY_CLASS(wxZstdInputStream);
+};
+
+// ----------------------------------------------------------------------------
+// Filter for compressing data using Zstandard algorithm
+// ----------------------------------------------------------------------------
+
+class WXDLLIMPEXP_BASE wxZstdOutputStream : public wxFilterOutputStream
+{
+public:
+    // The level can be -1 to use the default compression level or a value
+    // between 1 and wxZstdOutputStream::GetMaxLevel(). The threads parameter
+    // can be 0 to use as many threads as there are CPUs or a positive number
+    // of threads to use for compression.
+    explicit wxZstdOutputStream(wxOutputStream& stream,
+                                int level = -1,
+                                int threads = 1)
+        : wxFilterOutputStream(stream)
+    {
+        Init(level, threads);
+    }
+
+    explicit wxZstdOutputStream(wxOutputStream* stream,
+                                int level = -1,
+                                int threads = 1)
+        : wxFilterOutputStream(stream)
+    {
+        Init(level, threads);
+    }
+
+    virtual ~wxZstdOutputStream();
+
+    void Sync() wxOVERRIDE { DoFlush(false); }
+    bool Close() wxOVERRIDE;
+    wxFileOffset GetLength() const wxOVERRIDE { return m_pos; }
+
+    // Return the maximal supported compression level.
+    static int GetMaxLevel();
+
+protected:
+    size_t OnSysWrite(const void *buffer, size_t size) wxOVERRIDE;
+    wxFileOffset OnSysTell() const wxOVERRIDE { return m_pos; }
+
+private:
+    void Init(int level, int threads);
+
+    // Compress the given data, using the given ZSTD_EndDirective value, and
+    // write all the output to the underlying stream. Returns false on error,
+    // in which case m_lasterror is updated.
+    bool Compress(const void *buffer, size_t size, int directive);
+
+    // End the current frame (if finish is true) or just flush the data
+    // compressed so far, return true on success or false on error.
+    bool DoFlush(bool finish);
+
+    ZSTD_CCtx_s* m_cctx;
+
+    // Buffer for the compressed data written to the underlying stream.
+    wxUint8* m_outBuf;
+    size_t m_outBufSize;
+
+    // True if the current frame was already ended.
+    bool m_finished;
+
+    wxFileOffset m_pos;
+
+    wxDECLARE_NO_COPY_CLASS(wxZstdOutputStream);
+};
+
+// ----------------------------------------------------------------------------
+// Support for creating Zstandard streams from extension/MIME type
+// ----------------------------------------------------------------------------
+
+class WXDLLIMPEXP_BASE wxZstdClassFactory: public wxFilterClassFactory
+{
+public:
+    wxZstdClassFactory();
+
+    // Set the parameters used for the output streams created by this factory,
+    // see wxZstdOutputStream ctor for their meaning.
+    void SetLevel(int level) { m_level = level; }
+    int GetLevel() const { return m_level; }
+
+    void SetThreads(int threads) { m_threads = threads; }
+    int GetThreads() const { return m_threads; }
+
+    wxFilterInputStream *NewStream(wxInputStream& stream) const wxOVERRIDE
+        { return new wxZstdInputStream(stream); }
+    wxFilterOutputStream *NewStream(wxOutputStream& stream) const wxOVERRIDE
+        { return new wxZstdOutputStream(stream, m_level, m_threads); }
+    wxFilterInputStream *NewStream(wxInputStream *stream) const wxOVERRIDE
+        { return new wxZstdInputStream(stream); }
+    wxFilterOutputStream *NewStream(wxOutputStream *stream) const wxOVERRIDE
+        { return new wxZstdOutputStream(stream, m_level, m_threads); }
+
+    const wxChar * const *GetProtocols(wxStreamProtocolType type
+                                       = wxSTREAM_PROTOCOL) const wxOVERRIDE;
+
+private:
+    int m_level;
+    int m_threads;
+
+    wxDECLARE_DYNAMIC_CLASS(wxZstdClassFactory);
+};
+
+WXDLLIMPEXP_BASE wxVersionInfo wxGetLibZstdVersionInfo();
+
+#endif // wxUSE_LIBZSTD && wxUSE_STREAMS
+
+#endif // _WX_ZSTDSTREAM_H_
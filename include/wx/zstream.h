@@ -30,7 +30,8 @@ enum wxZLibFlags {
     wxZLIB_NO_HEADER = 0,    // raw deflate stream, no header or checksum
     wxZLIB_ZLIB = 1,         // zlib header and checksum
     wxZLIB_GZIP = 2,         // gzip header and checksum, requires zlib 1.2.1+
-    wxZLIB_AUTO = 3          // autodetect header zlib or gzip
+    wxZLIB_AUTO = 3,         // autodetect header zlib or gzip
+    wxZLIB_PARALLEL = 0x100  // compress using multiple threads (output only)
 };
 
 class WXDLLIMPEXP_BASE wxZlibInputStream: public wxFilterInputStream {
@@ -84,6 +85,9 @@ class WXDLLIMPEXP_BASE wxZlibOutputStream: public wxFilterOutputStream {
 
   virtual void DoFlush(bool final);
 
+  // Prepare for compressing another stream.
+  bool ResetDeflate();
+
  private:
   void Init(int level, int flags);
 
@@ -92,6 +96,7 @@ class WXDLLIMPEXP_BASE wxZlibOutputStream: public wxFilterOutputStream {
   unsigned char *m_z_buffer;
   struct z_stream_s *m_deflate;
   wxFileOffset m_pos;
+  class wxZlibParallelDeflate *m_parallel;
 
   wxDECLARE_NO_COPY_CLASS(wxZlibOutputStream);
 };
@@ -13,7 +13,8 @@ enum
     wxCONFIG_USE_GLOBAL_FILE = 2,
     wxCONFIG_USE_RELATIVE_PATH = 4,
     wxCONFIG_USE_NO_ESCAPE_CHARACTERS = 8,
-    wxCONFIG_USE_SUBDIR = 16
+    wxCONFIG_USE_SUBDIR = 16,
+    wxCONFIG_USE_JOURNAL = 32
 };
 
 
@@ -316,6 +317,10 @@ public:
             now your application's responsibility to ensure that there is no
             newline or other illegal characters in a value, before writing that
             value to the file.
+            @n Also for wxFileConfig only, @c wxCONFIG_USE_JOURNAL style can be
+            used to avoid rewriting the entire local configuration file every
+            time it's saved, see wxFileConfig::wxFileConfig(). This style is
+            new since wxWidgets 3.1.4.
         @param conv
             This parameter is only used by wxFileConfig when compiled in
             Unicode mode. It specifies the encoding in which the configuration
@@ -40,6 +40,19 @@ public:
         globalFilename is empty) then the system-wide file is not used at all.
         Otherwise its name and path are also constructed in the way appropriate
         for the current platform from the application and vendor names.
+
+        If @a style includes ::wxCONFIG_USE_JOURNAL, the changes to the
+        entries values are saved by Flush() by appending them to a journal
+        file, with the same name as the local file and additional
+        @c .journal extension, instead of rewriting the entire local file,
+        which can be much faster if the file is big and only a few entries
+        are modified. The journal is applied to the local file contents when
+        it is read and is merged into it, i.e. the local file is rewritten and
+        the journal is removed, when it becomes too big or when the changes
+        that can't be journaled, such as renaming or deleting the groups, are
+        saved. Notice that a journal is ignored and removed if the local file
+        was modified after it had been written. This style is only available
+        in wxWidgets 3.1.4 and later.
      */
     wxFileConfig(const wxString& appName = wxEmptyString,
                const wxString& vendorName = wxEmptyString,
@@ -0,0 +1,135 @@
+/////////////////////////////////////////////////////////////////////////////
+// Name:        filemapping.h
+// Purpose:     interface of wxFileMapping
+// Author:      wxWidgets team
+// Licence:     wxWindows licence
+/////////////////////////////////////////////////////////////////////////////
+
+/**
+    @class wxFileMapping
+
+    wxFileMapping maps the entire contents of a file into memory.
+
+    This allows accessing the file data directly as if it were in a memory
+    buffer, with the operating system loading the data from the file only
+    when it is actually accessed. Mapping big files is usually much faster
+    than reading them using wxFile, notably when only parts of the file data
+    are really used.
+
+    Notice that the file is closed as soon as it is mapped, but the mapping
+    remains valid until Close() is called or the object is destroyed.
+
+    Under Unix systems, accessing the mapped memory after the file was
+    truncated by another process results in a @c SIGBUS signal, so this class
+    should only be used for the files which are not going to be modified
+    while they're mapped.
+
+    Example of use:
+    @code
+        wxFileMapping mapping("data.bin");
+        if ( mapping.IsOk() )
+        {
+            const char* p = static_cast<const char*>(mapping.GetData());
+            for ( size_t n = 0; n < mapping.GetSize(); n++ )
+                ... use p[n] ...
+        }
+    @endcode
+
+    @library{wxbase}
+    @category{file}
+
+    @see wxMappedFileInputStream
+
+    @since 3.1.4
+*/
+class wxFileMapping
+{
+public:
+    /**
+        The access mode for the mapped memory.
+     */
+    enum Mode
+    {
+        /// The mapped data can only be read.
+        Read,
+
+        /// The mapped data can be modified using GetWritableData() and the
+        /// changes are written to the file.
+        ReadWrite
+    };
+
+    /**
+        Default constructor doesn't map any file.
+
+        Call Open() to map a file later.
+    */
+    wxFileMapping();
+
+    /**
+        Constructor mapping the given file.
+
+        Use IsOk() to check whether the file was mapped successfully.
+    */
+    explicit wxFileMapping(const wxString& filename, Mode mode = Read);
+
+    /**
+        Destructor calls Close().
+    */
+    ~wxFileMapping();
+
+    /**
+        Map the given file into memory.
+
+        If another file is currently mapped, it is unmapped first.
+
+        Notice that mapping an empty file succeeds but GetData() returns
+        @NULL for it.
+
+        @return @true if the file was mapped successfully or @false after
+            logging an error otherwise.
+    */
+    bool Open(const wxString& filename, Mode mode = Read);
+
+    /**
+        Unmap the currently mapped file, if any.
+
+        The pointers previously returned by GetData() and GetWritableData()
+        can't be used after calling this function.
+    */
+    void Close();
+
+    /**
+        Return @true if the file is currently mapped.
+    */
+    bool IsOk() const;
+
+    /**
+        Return the size of the mapped data, i.e.\ the size of the file.
+    */
+    size_t GetSize() const;
+
+    /**
+        Return the pointer to the mapped data.
+
+        The returned pointer may be @NULL if the mapped file is empty.
+    */
+    const void* GetData() const;
+
+    /**
+        Return the pointer to the mapped data allowing to modify it.
+
+        This function can only be called if the file was mapped in
+        ReadWrite mode. The changes to the data are written back to the file
+        by the operating system at some later time or when Flush() is called.
+    */
+    void* GetWritableData() const;
+
+    /**
+        Write all changes to the mapped data to the file immediately.
+
+        Does nothing if the file was mapped in read-only mode.
+
+        @return @true on success or @false after logging an error otherwise.
+    */
+    bool Flush();
+};
@@ -6,17 +6,106 @@
 // Licence:     wxWindows licence
 /////////////////////////////////////////////////////////////////////////////
 
+/**
+    Statistics about the use of wxArchiveFSHandler caches.
+
+    @see wxArchiveFSHandler::GetCacheStats()
+
+    @since 3.1.4
+*/
+struct wxArchiveFSCacheStats
+{
+    /**
+        Number of times the catalog of an already opened archive was reused.
+    */
+    size_t archiveHits;
+
+    /**
+        Number of times an archive had to be opened and its catalog read.
+    */
+    size_t archiveMisses;
+
+    /**
+        Number of files whose contents was found in the cache.
+    */
+    size_t dataHits;
+
+    /**
+        Number of files which had to be read from the archive.
+    */
+    size_t dataMisses;
+
+    /**
+        Number of entries whose contents is currently cached.
+    */
+    size_t dataCount;
+
+    /**
+        Total size of the currently cached contents, in bytes.
+    */
+    size_t dataSize;
+};
+
 /**
     @class wxArchiveFSHandler
 
     A file system handler for accessing files inside of archives.
+
+    The handler keeps the catalog of every archive it has opened, so that
+    the entries of the same archive can be found without reading it again.
+    Additionally, the contents of the small entries is kept in memory after
+    being read for the first time, and opening them again doesn't require
+    reopening the archive nor decompressing them. By default, the entries of
+    up to 64KiB are cached and the total size of the cached data is limited
+    to 4MiB, with the least recently used entries being discarded when this
+    limit is exceeded. Use SetCacheLimits() to change this.
 */
 class wxArchiveFSHandler : public wxFileSystemHandler
 {
 public:
     wxArchiveFSHandler();
     virtual ~wxArchiveFSHandler();
+
+    /**
+        Frees the memory used by the handler caches.
+
+        Notice that, since wxWidgets 3.1.4, this also discards the cached
+        contents of the archive entries.
+    */
     void Cleanup();
+
+    /**
+        Set the limits for caching the contents of the archive entries.
+
+        @param maxEntrySize
+            The maximal size of an entry whose contents is cached.
+        @param maxTotalSize
+            The maximal total size of the cached contents.
+
+        If either of the parameters is 0, the contents is not cached at all.
+        Reducing the limits discards the cached data exceeding them
+        immediately.
+
+        @since 3.1.4
+    */
+    void SetCacheLimits(size_t maxEntrySize, size_t maxTotalSize);
+
+    /**
+        Returns the statistics about the use of the caches.
+
+        This can be used to check the efficiency of the caching and to find
+        the appropriate values for SetCacheLimits().
+
+        @since 3.1.4
+    */
+    wxArchiveFSCacheStats GetCacheStats() const;
+
+    /**
+        Resets the hit and miss counters returned by GetCacheStats().
+
+        @since 3.1.4
+    */
+    void ResetCacheStats();
 };
 
 
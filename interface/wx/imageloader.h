@@ -0,0 +1,259 @@
+///////////////////////////////////////////////////////////////////////////////
+// Name:        wx/imageloader.h
+// Purpose:     wxImageLoader documentation
+// Author:      wxWidgets development team
+// Created:     2026-10-19
+// Copyright:   (c) 2026 wxWidgets development team
+// Licence:     wxWindows licence
+///////////////////////////////////////////////////////////////////////////////
+
+/**
+    @class wxImageLoaderEvent
+
+    Event sent by wxImageLoader when an image has been loaded.
+
+    @beginEventTable{wxImageLoaderEvent}
+    @event{EVT_IMAGE_LOADED(id, func)}
+        Process a @c wxEVT_IMAGE_LOADED event.
+    @endEventTable
+
+    @since 3.1.4
+
+    @library{wxcore}
+    @category{events}
+*/
+class wxImageLoaderEvent : public wxEvent
+{
+public:
+    /**
+        Constructor, normally only used by wxImageLoader itself.
+    */
+    wxImageLoaderEvent(wxEventType type,
+                       int winid,
+                       int requestId,
+                       const wxString& filename,
+                       const wxImage& image);
+
+    /**
+        Returns the identifier of the request returned by wxImageLoader::Load().
+    */
+    int GetRequestId() const;
+
+    /**
+        Returns the name of the file the image was loaded from.
+
+        The returned string is empty if the image was loaded from a stream.
+    */
+    const wxString& GetFileName() const;
+
+    /**
+        Returns the loaded image.
+
+        The image is invalid if loading it failed.
+    */
+    const wxImage& GetImage() const;
+
+    /**
+        Returns @true if the image was loaded successfully.
+    */
+    bool IsOk() const;
+};
+
+wxEventType wxEVT_IMAGE_LOADED;
+
+/**
+    @class wxImageLoader
+
+    Loads images in the background using a pool of worker threads.
+
+    This class is useful for applications which need to load many images,
+    e.g. to show thumbnails of all the files in a directory, without blocking
+    the UI while doing it. The images are loaded using the image handlers
+    registered with wxImage and are delivered to the main thread by sending
+    wxImageLoaderEvent to the handler specified when creating the loader, in
+    the order in which they are loaded. No event is sent for the cancelled
+    requests.
+
+    Example of using it:
+    @code
+    MyFrame::MyFrame()
+        : m_loader(this)
+    {
+        m_loader.SetMaxSize(128, 128);
+        m_loader.SetMemoryLimit(64*1024*1024);
+
+        Bind(wxEVT_IMAGE_LOADED, &MyFrame::OnImageLoaded, this);
+    }
+
+    void MyFrame::ShowThumbnails(const wxArrayString& files)
+    {
+        m_loader.CancelAll();
+
+        for ( size_t n = 0; n < files.size(); n++ )
+        {
+            // Load the thumbnails of the visible items first.
+            m_loader.Load(files[n], IsItemVisible(n) ? 1 : 0);
+        }
+    }
+
+    void MyFrame::OnImageLoaded(wxImageLoaderEvent& event)
+    {
+        if ( event.IsOk() )
+            SetThumbnail(event.GetFileName(), event.GetImage());
+    }
+    @endcode
+
+    The memory limit set by SetMemoryLimit() applies to the images which are
+    being loaded or have been already loaded but not yet delivered to the main
+    thread: if the main thread doesn't process the events quickly enough, the
+    worker threads pause until it does. As the size of an image is not known
+    before loading it, the memory needed for loading it is estimated as the
+    size corresponding to the maximal size set by SetMaxSize(), if both of its
+    components are specified, or as the size of the biggest image loaded so
+    far otherwise. Notice that a single image is always loaded, even if it is
+    bigger than the limit.
+
+    Notice that the images are loaded without logging any errors, failing to
+    load an image results in an event with an invalid image being sent
+    instead. Also notice that the image handlers must not be added or removed
+    while any images are being loaded.
+
+    As several images are loaded concurrently, the image handlers used must
+    be safe to use from several threads at once. This is the case for all the
+    standard handlers, i.e. BMP, ICO, CUR, ANI, PNG, JPEG, GIF, PCX, PNM,
+    TIFF, TGA, IFF and XPM ones, which keep all the state needed for loading
+    an image in local objects. Custom handlers must not modify their members
+    in their LoadFile() and DoCanRead() implementations to be usable with
+    this class.
+
+    @since 3.1.4
+
+    @library{wxcore}
+    @category{gdi,threading}
+
+    @see wxImage::LoadFile()
+*/
+class wxImageLoader : public wxEvtHandler
+{
+public:
+    /**
+        Constructor.
+
+        @param handler
+            The handler to which wxImageLoaderEvent are sent, it must not be
+            @NULL and must remain alive as long as this object exists.
+        @param id
+            The id used for the events generated by this object.
+    */
+    explicit wxImageLoader(wxEvtHandler *handler, int id = wxID_ANY);
+
+    /**
+        Destructor cancels all the requests and waits until the images
+        being currently loaded by the worker threads are done.
+    */
+    virtual ~wxImageLoader();
+
+    /**
+        Sets the maximal number of worker threads.
+
+        By default, as many threads as there are CPUs in the system are used.
+
+        This function must be called before the first call to Load().
+    */
+    void SetMaxThreads(unsigned count);
+
+    /**
+        Limits the total size of the images loaded but not yet delivered.
+
+        The size of an image is computed as the size of its RGB data plus the
+        size of its alpha channel, if any. The images being loaded by the
+        worker threads are counted too, using the estimate of their size
+        described in the class documentation.
+
+        @param bytes
+            The limit in bytes or 0, which is the default, for no limit.
+    */
+    void SetMemoryLimit(size_t bytes);
+
+    /**
+        Sets the maximal size of the images loaded after this call.
+
+        This is the same as setting @c wxIMAGE_OPTION_MAX_WIDTH and
+        @c wxIMAGE_OPTION_MAX_HEIGHT options for each loaded image, see
+        wxImage::GetOptionInt(). Either of the values may be 0 to not limit the
+        corresponding dimension.
+    */
+    void SetMaxSize(int width, int height);
+
+    /**
+        Queues the image file for loading.
+
+        The requests with higher priority are processed before the requests
+        with lower priority, the requests with the same priority are processed
+        in the order of their submission.
+
+        @param filename
+            The name of the file to load the image from.
+        @param priority
+            The priority of this request, see SetPriority().
+        @param type
+            The type of the image, may be @c wxBITMAP_TYPE_ANY to detect it
+            automatically.
+        @return
+            The id of this request, which is always strictly positive.
+    */
+    int Load(const wxString& filename,
+             int priority = 0,
+             wxBitmapType type = wxBITMAP_TYPE_ANY);
+
+    /**
+        Queues the image for loading from the given stream.
+
+        @param stream
+            The stream to load the image from. It must be allocated on the heap
+            and will be deleted by wxImageLoader.
+        @param priority
+            The priority of this request, see SetPriority().
+        @param type
+            The type of the image, may be @c wxBITMAP_TYPE_ANY to detect it
+            automatically.
+        @return
+            The id of this request, which is always strictly positive.
+    */
+    int Load(wxInputStream *stream,
+             int priority = 0,
+             wxBitmapType type = wxBITMAP_TYPE_ANY);
+
+    /**
+        Changes the priority of a request.
+
+        This is typically used to load the images which become visible before
+        the other ones.
+
+        @return
+            @true if the priority was changed, @false if there is no such
+            request or if it's already being processed.
+    */
+    bool SetPriority(int requestId, int priority);
+
+    /**
+        Cancels the given request.
+
+        No wxImageLoaderEvent is generated for the cancelled request.
+
+        @return
+            @true if the request was cancelled, @false if it had been already
+            delivered or doesn't exist.
+    */
+    bool Cancel(int requestId);
+
+    /**
+        Cancels all the requests not delivered yet.
+    */
+    void CancelAll();
+
+    /**
+        Returns the number of requests which haven't been delivered yet.
+    */
+    size_t GetPendingCount() const;
+};
@@ -12,6 +12,13 @@
 
     This is the image handler for the GIF format.
 
+    Notice that only the first frame of an animated GIF is checked for errors
+    when it is loaded, the other ones are only decoded when they are used.
+    Loading a later frame with the corrupted data doesn't fail but results in
+    an image with the pixels which couldn't be decoded left transparent (or
+    using the first palette colour if the frame has no transparency), in the
+    same way as for a truncated file.
+
     @library{wxcore}
     @category{gdi}
 
@@ -601,6 +601,47 @@ protected:
     */
     virtual void DoLogText(const wxString& msg);
 
+    /**
+        Called to handle a new record before logging it.
+
+        This method is called for all the messages logged using this log
+        target before they are passed to DoLogRecord(): for the messages
+        logged from the main thread or from a thread using this object as its
+        thread-specific target (see SetThreadActiveTarget()) as soon as they
+        are logged and for the messages logged from the other threads when
+        they are flushed by the main thread.
+
+        If this method returns @true, the record is considered to be handled
+        and is not logged in any other way, so the derived class must log it
+        later itself by calling CallDoLogNow(), typically from another thread.
+        Notice that this method must be thread-safe if this object is used as
+        thread-specific target.
+
+        The base class version simply returns @false.
+
+        @see wxLogAsync
+
+        @since 3.1.4
+     */
+    virtual bool DoQueueRecord(wxLogLevel level,
+                               const wxString& msg,
+                               const wxLogRecordInfo& info);
+
+    /**
+        Log the given record immediately.
+
+        This function counts the repeated messages, if necessary, appends the
+        extra information, such as the system error message, to @a msg and
+        calls DoLogRecord(). It can be used by the classes overriding
+        DoQueueRecord() to log the queued messages. Notice that it must not be
+        called concurrently from different threads.
+
+        @since 3.1.4
+     */
+    void CallDoLogNow(wxLogLevel level,
+                      const wxString& msg,
+                      const wxLogRecordInfo& info);
+
     //@}
 };
 
@@ -820,6 +861,97 @@ public:
 
 
 
+/**
+    @class wxLogAsync
+
+    This class writes the log messages to a C file stream, like wxLogStderr,
+    but does it from a separate background thread.
+
+    The threads logging the messages, including the main one, only store them
+    in a buffer specific to each thread, without formatting them, which is
+    much faster than writing them immediately, and never wait for the
+    messages logged by the other threads to be written. The background thread
+    wakes up periodically, or when a buffer becomes half full, and formats and
+    writes all the messages queued so far at once. Notice that this means that
+    the messages logged by different threads are not necessarily written in
+    the order in which they were logged, only the order of the messages logged
+    by the same thread is preserved.
+
+    The number of messages queued by each thread is limited and the messages
+    logged while the limit is reached are dropped. The number of the dropped
+    messages is logged as a warning when the next batch of messages is written
+    and can also be retrieved using GetDroppedCount().
+
+    Unlike wxLogStderr, this class writes the debug and trace messages to the
+    same file as all the other ones.
+
+    The threads logging the messages don't lock anything shared with the other
+    threads unless the active log target changes. It is safe to replace this
+    log target with another one using wxLog::SetActiveTarget() and delete it
+    while the other threads are still logging.
+
+    If the background thread can't be started, the messages are written
+    immediately and, for the messages logged from the threads other than the
+    main one, only when they are flushed by the main thread, as for all the
+    other log targets.
+
+    This class is only available if @c wxUSE_THREADS is 1.
+
+    @library{wxbase}
+    @category{logging}
+
+    @see wxLogStderr
+
+    @since 3.1.4
+*/
+class wxLogAsync : public wxLog
+{
+public:
+    /**
+        Constructs a log target which sends all the log messages to the given
+        @c FILE from the background thread.
+
+        The @a fp and @a conv arguments have the same meaning as in wxLogStderr
+        constructor.
+
+        @param fp
+            The file to write the messages to, @c stderr if it is @NULL.
+        @param conv
+            The conversion to use for writing the messages.
+        @param maxPending
+            The maximal number of messages queued by each thread, the messages
+            logged by a thread while it already has this many messages waiting
+            to be written are dropped.
+    */
+    wxLogAsync(FILE *fp = NULL,
+               const wxMBConv& conv = wxConvWhateverWorks,
+               size_t maxPending = 4096);
+
+    /**
+        Destructor stops the background thread and writes all the messages
+        queued so far.
+    */
+    virtual ~wxLogAsync();
+
+    /**
+        Writes all the messages queued so far immediately from the calling
+        thread.
+    */
+    virtual void Flush();
+
+    /**
+        Returns the total number of messages which were dropped because too
+        many messages were queued.
+
+        Notice that the messages are only counted as dropped when the next
+        batch of messages is written, so it may be necessary to call Flush()
+        before calling this function to get the up to date value.
+    */
+    size_t GetDroppedCount() const;
+};
+
+
+
 /**
     @class wxLogBuffer
 
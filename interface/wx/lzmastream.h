@@ -89,8 +89,29 @@ class wxLZMAOutputStream : public wxFilterOutputStream
         stream.
 
         This overload does not take ownership of the @a stream.
+
+        @param stream
+            The stream to write the compressed data to.
+        @param level
+            Compression level from 0 to 9 or -1 to use the default one.
+        @param threads
+            The number of threads to use for compression, 1 by default. Use
+            0 to use as many threads as there are CPUs. Multi-threaded
+            compression requires liblzma 5.2 or later, built with threads
+            support, and the single-threaded one is used if it is not
+            available. This parameter is available since wxWidgets 3.1.4.
+        @param blockSize
+            When using more than one thread, the input is split into blocks
+            of this size which are compressed independently. Bigger blocks
+            result in better compression but less parallelism. The default
+            value of 0 uses the block size chosen by liblzma, which is three
+            times the dictionary size for the given compression level. This
+            parameter is available since wxWidgets 3.1.4.
     */
-    wxLZMAOutputStream(wxOutputStream& stream);
+    wxLZMAOutputStream(wxOutputStream& stream,
+                       int level = -1,
+                       int threads = 1,
+                       size_t blockSize = 0);
 
     /**
         Create compressing stream associated with the given underlying
@@ -99,8 +120,65 @@ class wxLZMAOutputStream : public wxFilterOutputStream
         As with the base wxFilterOutputStream class, passing @a stream by
         pointer indicates that this object takes ownership of it and will
         delete it when it is itself destroyed.
+
+        See the other overload for the description of the other parameters.
      */
-    wxLZMAOutputStream(wxOutputStream* stream);
+    wxLZMAOutputStream(wxOutputStream* stream,
+                       int level = -1,
+                       int threads = 1,
+                       size_t blockSize = 0);
+};
+
+/**
+    @class wxLZMAClassFactory
+
+    Filter class factory for the XZ format.
+
+    The factory found by wxFilterClassFactory::Find() creates the streams
+    using a single thread. To create, for example, a .tar.xz archive using
+    several threads, create a separate factory object and configure it:
+    @code
+    wxLZMAClassFactory factory;
+    factory.SetThreads(0);
+
+    wxTarOutputStream tar(factory.NewStream(new wxFFileOutputStream("backup.tar.xz")));
+    @endcode
+
+    @library{wxbase}
+    @category{archive,streams}
+
+    @see wxLZMAOutputStream
+
+    @since 3.1.2
+*/
+class wxLZMAClassFactory : public wxFilterClassFactory
+{
+public:
+    wxLZMAClassFactory();
+
+    /**
+        Set the number of threads and the block size used by the output
+        streams created by this factory.
+
+        See wxLZMAOutputStream constructor for the meaning of the parameters.
+
+        @since 3.1.4
+    */
+    void SetThreads(int threads, size_t blockSize = 0);
+
+    /**
+        Returns the number of threads set by SetThreads(), 1 by default.
+
+        @since 3.1.4
+    */
+    int GetThreads() const;
+
+    /**
+        Returns the block size set by SetThreads(), 0 by default.
+
+        @since 3.1.4
+    */
+    size_t GetBlockSize() const;
 };
 
 /**
@@ -5,6 +5,46 @@
 // Licence:     wxWindows licence
 /////////////////////////////////////////////////////////////////////////////
 
+/**
+    Flags used by wxQuantize functions.
+
+    The flags can be combined using bitwise OR.
+*/
+enum
+{
+    /// Include the standard Windows colours in the palette.
+    wxQUANTIZE_INCLUDE_WINDOWS_COLOURS  = 0x01,
+
+    /// Return the 8 bit image data, see wxQuantize::Quantize().
+    wxQUANTIZE_RETURN_8BIT_DATA         = 0x02,
+
+    /// Fill the destination image with the quantized data.
+    wxQUANTIZE_FILL_DESTINATION_IMAGE   = 0x04,
+
+    /**
+        Use octree algorithm instead of the default median cut one.
+
+        This algorithm is usually slightly faster and, for big images, can
+        use several threads for building the colour histogram and mapping the
+        pixels to the palette when dithering is not used. If the image doesn't
+        have more colours than requested, its colours are preserved exactly.
+
+        @since 3.1.4
+     */
+    wxQUANTIZE_OCTREE                   = 0x08,
+
+    /**
+        Don't use Floyd-Steinberg dithering when mapping the image colours to
+        the palette.
+
+        Without dithering, quantization is much faster but the result may
+        contain visible colour bands.
+
+        @since 3.1.4
+     */
+    wxQUANTIZE_NO_DITHERING             = 0x10
+};
+
 /**
     @class wxQuantize
 
@@ -31,10 +71,15 @@ public:
         (@a in_rows contains @a w * 3 bytes per row, @a out_rows @a w bytes per row).
         Fills @a out_rows with indexes into palette (which is also stored into @a palette
         variable).
+
+        The @a flags parameter, added in wxWidgets 3.1.4, can contain
+        ::wxQUANTIZE_OCTREE and ::wxQUANTIZE_NO_DITHERING to change the
+        algorithm used, the other flags are ignored by this function.
     */
     static void DoQuantize(unsigned int w, unsigned int h,
                            unsigned char** in_rows, unsigned char** out_rows,
-                           unsigned char* palette, int desiredNoColours);
+                           unsigned char* palette, int desiredNoColours,
+                           int flags = 0);
 
     /**
         Reduce the colours in the source image and put the result into the destination image.
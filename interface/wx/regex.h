@@ -34,6 +34,24 @@ enum
     */
     wxRE_NEWLINE  = 16,
 
+    /**
+        Use PCRE2 library and Perl-compatible RE syntax.
+
+        The expression is compiled to native code using PCRE2 just-in-time
+        compiler when it is supported on the current platform, which is
+        usually significantly faster than the builtin library. This flag can
+        be combined with wxRE_ICASE, wxRE_NOSUB and wxRE_NEWLINE, but not with
+        the other syntax flags. Note that, unlike with the POSIX syntax, the
+        leftmost alternative and not the longest match is preferred by PCRE2.
+
+        PCRE2 is only used if wxWidgets was built with @c wxUSE_LIBPCRE2 set
+        to 1, otherwise this flag is the same as wxRE_ADVANCED, which
+        supports most of the commonly used Perl extensions too.
+
+        @since 3.1.4
+    */
+    wxRE_PCRE     = 128,
+
     /** Default flags.*/
     wxRE_DEFAULT  = wxRE_EXTENDED
 };
@@ -54,6 +72,32 @@ enum
     wxRE_NOTEOL = 64
 };
 
+/**
+    Information about a line matched by wxRegEx::MatchLines().
+
+    @since 3.1.4
+*/
+struct wxRegExLineMatch
+{
+    /// The index of the matching line.
+    size_t line;
+
+    /**
+        The start of the match in the line and its length.
+
+        Both of them are 0 if the expression was compiled with ::wxRE_NOSUB.
+     */
+    size_t start,
+           len;
+};
+
+/**
+    The type of the vector filled by wxRegEx::MatchLines().
+
+    @since 3.1.4
+*/
+typedef wxVector<wxRegExLineMatch> wxRegExLineMatches;
+
 /**
     @class wxRegEx
 
@@ -81,6 +125,19 @@ enum
     It is possible to use the other if preferred by selecting it when building
     the wxWidgets.
 
+    Additionally, PCRE2 library can be used for the expressions compiled with
+    ::wxRE_PCRE flag if wxWidgets was built with PCRE2 support.
+
+    When using the builtin library, the automata built while matching are kept
+    and reused by the subsequent calls to Matches(), so matching the same
+    expression against many strings, e.g. filtering the lines of a big text,
+    is much faster than compiling it anew every time. The strings which can't
+    match because they don't contain a literal part required by the
+    expression, e.g. @c "error" in @c "error: .* failed", are also rejected
+    without running the regex engine at all. Notice that this implies that
+    the same wxRegEx object can't be used concurrently by several threads,
+    however MatchLines() can use several threads for matching many lines.
+
     @library{wxbase}
     @category{data}
 
@@ -202,7 +259,9 @@ public:
         a wxStrlen() will be done internally if the regex library requires the
         length. When using Matches() in a loop the <b>Matches(text, flags, len)</b>
         form can be used instead, making it possible to avoid a wxStrlen() inside
-        the loop.
+        the loop. Since wxWidgets 3.1.4 this form also avoids copying @a text
+        when using the builtin library, making it the fastest way to match
+        the parts of a bigger buffer.
 
         May only be called after successful call to Compile().
     */
@@ -221,6 +280,59 @@ public:
     */
     bool Matches(const wxString& text, int flags = 0) const;
 
+    //@{
+    /**
+        Matches the precompiled regular expression against all the given
+        lines and returns the number of matching lines.
+
+        If @a matches is non-@NULL, it is filled with the indices of the
+        matching lines, in increasing order, and the positions of the matches
+        in them. Notice that GetMatch() can't be used to get the matches found
+        by this function, and its results are not affected by it.
+
+        The lines may be either given as an array of strings or stored in a
+        single buffer, e.g. the contents of a file, in which case @a offsets
+        must contain @a count + 1 elements and the line with the index @c n
+        is the text between @c offsets[n] and @c offsets[n + 1], excluding the
+        trailing @c "\\n" or @c "\\r\\n", if any. MatchLinesUTF8() can be used
+        to match the lines in UTF-8 without converting all of them to wxString
+        first, the offsets and the positions of the matches are in bytes for
+        it.
+
+        If @a numThreads is greater than 1, up to this number of threads,
+        including the current one, is used for matching, which can be much
+        faster for big inputs when using the builtin library or PCRE2. If it
+        is 0, as many threads as there are CPUs are used. The results don't
+        depend on the number of threads used and only a single thread is used
+        for matching a few hundred lines or less, when wxUSE_THREADS is 0 or
+        when using the system library which doesn't allow matching the same
+        expression concurrently.
+
+        @e Flags may be combination of @c wxRE_NOTBOL and @c wxRE_NOTEOL, see
+        @ref wxRE_NOT_FLAGS, and are used for all lines.
+
+        May only be called after successful call to Compile().
+
+        @since 3.1.4
+    */
+    size_t MatchLines(const wxArrayString& lines,
+                      wxRegExLineMatches* matches,
+                      int flags = 0,
+                      unsigned numThreads = 1) const;
+    size_t MatchLines(const wxChar* text,
+                      const size_t* offsets,
+                      size_t count,
+                      wxRegExLineMatches* matches,
+                      int flags = 0,
+                      unsigned numThreads = 1) const;
+    size_t MatchLinesUTF8(const char* text,
+                          const size_t* offsets,
+                          size_t count,
+                          wxRegExLineMatches* matches,
+                          int flags = 0,
+                          unsigned numThreads = 1) const;
+    //@}
+
     /**
         Replaces the current regular expression in the string pointed to by
         @a text, with the text in @a replacement and return number of matches
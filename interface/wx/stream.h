@@ -619,6 +619,62 @@ public:
     */
     virtual char Peek();
 
+    /**
+        Returns the pointer to the data available in the stream without
+        copying it.
+
+        This function returns the pointer to the data which would be returned
+        by the next call to Read() and fills @a size with the size of this
+        data, which is always at least 1 byte unless @NULL is returned. The
+        data is not removed from the stream: ConsumeBuffer() must be called
+        to do it after processing all or a part of the data. The returned
+        pointer is only valid until ConsumeBuffer() or any other function
+        reading from or seeking in the stream is called.
+
+        This allows parsing the stream contents in place, which is much more
+        efficient than reading them into an intermediate buffer for the
+        streams keeping their data in memory, such as wxMemoryInputStream,
+        wxBufferedInputStream and wxMappedFileInputStream. For the other
+        streams, the data is read into an internal buffer, so using this
+        function is not worse than calling Read().
+
+        Notice that, just as after calling Read(), Eof() may already return
+        @true while the last chunk of data returned by this function hasn't
+        been consumed yet, so the return value of this function, and not
+        Eof(), should be used to determine when to stop reading.
+
+        Example of use:
+        @code
+        size_t size;
+        while ( const void* data = stream.PeekBuffer(&size) )
+        {
+            // Process at most size bytes starting at data, e.g.:
+            const size_t processed = Parse(data, size);
+
+            stream.ConsumeBuffer(processed);
+        }
+        @endcode
+
+        @param size
+            Non-@NULL pointer filled with the size of the available data.
+        @return Pointer to the data or @NULL on EOF or error, in which case
+            @a size is set to 0.
+
+        @since 3.1.4
+    */
+    const void* PeekBuffer(size_t* size);
+
+    /**
+        Removes the data returned by PeekBuffer() from the stream.
+
+        @a size must be less than or equal to the size returned by the last
+        call to PeekBuffer(). After calling this function, LastRead() returns
+        @a size.
+
+        @since 3.1.4
+    */
+    void ConsumeBuffer(size_t size);
+
     /**
         Reads the specified amount of bytes and stores the data in buffer.
         To check if the call was successful you must use LastRead() to check
@@ -718,6 +774,30 @@ protected:
         variable should be set accordingly as well).
     */
     size_t OnSysRead(void* buffer, size_t bufsize) = 0;
+
+    /**
+        Internal function called by PeekBuffer() when the write-back buffer is
+        empty.
+
+        The default implementation reads the data into the write-back buffer,
+        the streams keeping their data in memory should override it to
+        return the pointer to this data directly and must override
+        DoConsumeBuffer() too. On EOF or error, @NULL should be returned and
+        the internal @c m_lasterror variable set accordingly.
+
+        @since 3.1.4
+    */
+    virtual const void* DoPeekBuffer(size_t* size);
+
+    /**
+        Internal function called by ConsumeBuffer() to advance the stream
+        position by the given number of bytes.
+
+        Must be overridden if DoPeekBuffer() is.
+
+        @since 3.1.4
+    */
+    virtual void DoConsumeBuffer(size_t size);
 };
 
 
@@ -810,6 +890,58 @@ public:
         Destructor.
     */
     virtual ~wxBufferedInputStream();
+
+    /**
+        Enable or disable reading ahead in background.
+
+        In read-ahead mode, as soon as the data read from the associated
+        stream is taken into the buffer, a background thread starts reading
+        the next chunk of data, of the same size as the buffer, from it. This
+        allows the slow operations, such as disk I/O or decompression, to
+        overlap with the processing of the data in the current thread, which
+        can significantly speed up pipelines such as reading a file through
+        wxZlibInputStream and parsing its contents, especially when using a
+        buffered stream with read-ahead enabled at each stage, e.g.:
+        @code
+        wxFileInputStream file("data.gz");
+        wxBufferedInputStream bufferedFile(file, 65536);
+        wxZlibInputStream zin(bufferedFile);
+        wxBufferedInputStream bufferedData(zin, 65536);
+
+        bufferedFile.EnableReadAhead();
+        bufferedData.EnableReadAhead();
+
+        ... read from bufferedData ...
+        @endcode
+
+        Notice that the associated stream must not be used directly while
+        read-ahead is enabled, as it may be accessed from the background
+        thread at any moment. Seeking and TellI() still work as usual, but
+        wait for the background read in progress to complete.
+
+        Disabling read-ahead mode may fail if some data was already read from
+        the associated stream in background and it is not seekable, so that
+        this data can't be given back to it.
+
+        @param enable
+            Enable read-ahead if @true, disable it otherwise.
+        @return @true if read-ahead was enabled or disabled, @false if this
+            is not possible because the stream doesn't use a buffer, threads
+            support is not available or, when disabling it, as explained
+            above.
+
+        @since 3.1.4
+    */
+    bool EnableReadAhead(bool enable = true);
+
+    /**
+        Returns @true if read-ahead mode is enabled.
+
+        @see EnableReadAhead()
+
+        @since 3.1.4
+    */
+    bool IsReadAheadEnabled() const;
 };
 
 
@@ -223,7 +223,10 @@ public:
 
         Returns @NULL if translation is not available.
 
-        This function is thread-safe.
+        This function is thread-safe. Since wxWidgets 3.1.4, the results of
+        its calls are cached in a per-thread cache, so calling it repeatedly
+        for the same string is cheap. The cache is invalidated when a catalog
+        is added or the language is changed.
 
         @remarks Domains are searched in the last to first order, i.e. catalogs
                  added later override those added before.
@@ -256,7 +259,10 @@ public:
         See GNU gettext manual for additional information on plural forms handling.
         This method is called by the wxGetTranslation() function and _() macro.
 
-        This function is thread-safe.
+        This function is thread-safe. Since wxWidgets 3.1.4, the results of
+        its calls are cached in a per-thread cache, so calling it repeatedly
+        for the same string is cheap. The cache is invalidated when a catalog
+        is added or the language is changed.
 
         @remarks Domains are searched in the last to first order, i.e. catalogs
                  added later override those added before.
@@ -342,6 +348,21 @@ public:
 class wxFileTranslationsLoader : public wxTranslationsLoader
 {
 public:
+    /**
+        Constructor.
+
+        @param flags
+            Flags passed to wxMsgCatalog::CreateFromFile() when loading the
+            catalogs. Use ::wxMSGCATALOG_LAZY to make loading big catalogs
+            faster, e.g.
+            @code
+            wxTranslations::Get()->SetLoader(
+                new wxFileTranslationsLoader(wxMSGCATALOG_LAZY));
+            @endcode
+            This parameter is new since wxWidgets 3.1.4.
+     */
+    explicit wxFileTranslationsLoader(int flags = 0);
+
     /**
         Add a prefix to the catalog lookup path: the message catalog files will
         be looked up under prefix/lang/LC_MESSAGES and prefix/lang directories
@@ -400,6 +421,29 @@ protected:
 };
 
 
+/**
+    Flags for wxMsgCatalog::CreateFromFile() and wxMsgCatalog::CreateFromData().
+
+    @since 3.1.4
+ */
+enum
+{
+    /**
+        Don't convert all the messages when creating the catalog.
+
+        By default, all messages are converted to wxString and stored in a
+        hash map when the catalog is loaded, which takes time and memory
+        proportional to the catalog size. With this flag, the catalog file is
+        mapped into memory, if possible, and the messages are looked up using
+        the hash table contained in the MO file itself when they're needed.
+        Each translation is converted to wxString only once, when it is found
+        for the first time.
+
+        This flag is ignored in non-Unicode build.
+     */
+    wxMSGCATALOG_LAZY = 1
+};
+
 /**
     Represents a loaded translations message catalog.
 
@@ -417,23 +461,32 @@ public:
         @param filename  Path to the MO file to load.
         @param domain    Catalog's domain. This typically matches
                          the @a filename.
+        @param flags     May contain ::wxMSGCATALOG_LAZY, this parameter is
+                         new since wxWidgets 3.1.4.
 
         @return Successfully loaded catalog or NULL on failure.
      */
     static wxMsgCatalog *CreateFromFile(const wxString& filename,
-                                        const wxString& domain);
+                                        const wxString& domain,
+                                        int flags = 0);
 
     /**
         Creates catalog from MO file data in memory buffer.
 
-        @param data      Data in MO file format.
+        @param data      Data in MO file format. If @a flags contains
+                         ::wxMSGCATALOG_LAZY, the data must remain valid
+                         during the catalog lifetime, i.e. either be owned by
+                         @a data or not be freed before the catalog is.
         @param domain    Catalog's domain. This typically matches
                          the @a filename.
+        @param flags     May contain ::wxMSGCATALOG_LAZY, this parameter is
+                         new since wxWidgets 3.1.4.
 
         @return Successfully loaded catalog or NULL on failure.
      */
     static wxMsgCatalog *CreateFromData(const wxScopedCharBuffer& data,
-                                        const wxString& domain);
+                                        const wxString& domain,
+                                        int flags = 0);
 };
 
 
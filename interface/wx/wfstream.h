@@ -217,6 +217,68 @@ public:
 
 
 
+/**
+    @class wxMappedFileInputStream
+
+    This class reads data from a file mapped into memory using wxFileMapping.
+
+    Reading the file in this way avoids the overhead of system calls and of
+    copying the data into intermediate buffers and can be significantly
+    faster than using wxFileInputStream for big files. Moreover, the entire
+    file contents can be accessed directly using GetData(), which allows the
+    code knowing about this class to avoid copying the data at all.
+
+    The stream can be used anywhere a wxInputStream is accepted, e.g. with
+    wxZipInputStream, wxImage::LoadFile() or wxXmlDocument::Load().
+
+    Notice that the file must not be truncated by another process while it
+    is being read, as accessing the mapped memory beyond the new end of the
+    file results in a fatal signal under Unix systems.
+
+    Unlike wxFileInputStream, wxInputStream::SeekI() can't seek beyond the
+    end of the file and returns ::wxInvalidOffset if this is attempted.
+
+    @library{wxbase}
+    @category{streams}
+
+    @see wxFileInputStream, wxMemoryInputStream
+
+    @since 3.1.4
+*/
+class wxMappedFileInputStream : public wxInputStream
+{
+public:
+    /**
+        Maps the specified file into memory.
+
+        @warning
+        You should use wxStreamBase::IsOk() to verify if the constructor succeeded.
+    */
+    explicit wxMappedFileInputStream(const wxString& fileName);
+
+    /**
+        Returns @true if the file was mapped successfully and no error
+        occurred while reading from the stream.
+    */
+    bool IsOk() const;
+
+    /**
+        Returns the pointer to the entire contents of the file.
+
+        The returned pointer is valid for the lifetime of the stream and is
+        @NULL if the file is empty.
+    */
+    const void* GetData() const;
+
+    /**
+        Returns the size of the file, i.e.\ the size of the data returned by
+        GetData().
+    */
+    size_t GetSize() const;
+};
+
+
+
 /**
     @class wxFFileInputStream
 
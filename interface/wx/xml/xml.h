@@ -556,7 +556,15 @@ public:
 enum wxXmlDocumentLoadFlag
 {
     wxXMLDOC_NONE,
-    wxXMLDOC_KEEP_WHITESPACE_NODES
+    wxXMLDOC_KEEP_WHITESPACE_NODES,
+
+    /**
+        Allocate the nodes and attributes from a memory arena shared by the
+        whole document and store only a single copy of each element name.
+
+        @since 3.1.4
+    */
+    wxXMLDOC_USE_ARENA
 };
 
 
@@ -840,6 +848,23 @@ public:
         less memory however makes impossible to recreate exactly the loaded text with a
         Save() call later. Read the initial description of this class for more info.
 
+        If @a flags contains wxXMLDOC_USE_ARENA, the nodes and attributes of
+        the document are allocated from big memory blocks instead of being
+        allocated individually and all the nodes with the same name share a
+        single string object for it. This makes loading and destroying big
+        documents, especially those with many elements having the same name,
+        such as XRC files, significantly faster and reduces their memory
+        usage. The nodes loaded in this way can be used and modified exactly
+        as the usual ones and can be deleted individually, but the memory used
+        by them is only freed when the last of the document nodes is deleted,
+        so this flag shouldn't be used when only a few nodes of the document
+        will be detached from it and kept after destroying the document.
+        On 64-bit platforms, each node allocated from the arena uses 24 more
+        bytes and each attribute 16 more bytes than the usual ones, but the
+        nodes and attributes created without this flag don't have any extra
+        overhead.
+        This flag is available since wxWidgets 3.1.4.
+
         Returns true on success, false otherwise.
     */
     virtual bool Load(const wxString& filename,
@@ -934,3 +959,410 @@ public:
     */
     static wxVersionInfo GetLibraryVersionInfo();
 };
+
+
+/**
+    Kinds of the nodes returned by wxXmlReader::GetNodeType().
+
+    @since 3.1.4
+*/
+enum wxXmlReaderNodeType
+{
+    /// There is no current node, e.g. Read() hasn't been called yet.
+    wxXML_READER_NONE,
+
+    /// Start of an element, its name and attributes are available.
+    wxXML_READER_START_ELEMENT,
+
+    /// End of an element, only its name is available.
+    wxXML_READER_END_ELEMENT,
+
+    /// Text node, the text is returned by wxXmlReader::GetContent().
+    wxXML_READER_TEXT,
+
+    /// CDATA section, its text is returned by wxXmlReader::GetContent().
+    wxXML_READER_CDATA,
+
+    /// Comment, its text is returned by wxXmlReader::GetContent().
+    wxXML_READER_COMMENT,
+
+    /**
+        Processing instruction, wxXmlReader::GetName() returns its target and
+        wxXmlReader::GetContent() its data.
+     */
+    wxXML_READER_PI
+};
+
+/**
+    @class wxXmlReaderHandler
+
+    Base class for the objects receiving the nodes from wxXmlReader::Parse().
+
+    Override the functions corresponding to the nodes of interest and use the
+    wxXmlReader object passed to them to retrieve the information about the
+    current node. All functions may return @false to stop parsing.
+
+    @library{wxxml}
+    @category{xml}
+
+    @since 3.1.4
+*/
+class wxXmlReaderHandler
+{
+public:
+    wxXmlReaderHandler();
+    virtual ~wxXmlReaderHandler();
+
+    /**
+        Called for the start of each element.
+
+        The handler may call wxXmlReader::ReadNode() or wxXmlReader::Skip()
+        to process the entire element at once, OnEndElement() is not called
+        for this element then.
+    */
+    virtual bool OnStartElement(wxXmlReader& reader);
+
+    /// Called for the end of each element.
+    virtual bool OnEndElement(wxXmlReader& reader);
+
+    /// Called for text nodes and CDATA sections.
+    virtual bool OnText(wxXmlReader& reader);
+
+    /// Called for comments.
+    virtual bool OnComment(wxXmlReader& reader);
+
+    /// Called for processing instructions.
+    virtual bool OnProcessingInstruction(wxXmlReader& reader);
+};
+
+/**
+    @class wxXmlReader
+
+    Sequential reader of XML documents.
+
+    Unlike wxXmlDocument, which creates the tree of wxXmlNode objects for the
+    entire document, this class returns the document nodes one by one and
+    uses a fixed amount of memory, independent of the document size. This
+    makes it suitable for processing very large files.
+
+    The nodes can be either retrieved using Read() in a loop or passed to a
+    wxXmlReaderHandler by Parse(). In both cases, ReadNode() can be used to
+    create the tree of wxXmlNode objects only for some of the elements:
+    @code
+    wxFileInputStream file("huge.xml");
+    wxBufferedInputStream buffered(file, 65536);
+    wxXmlReader reader(buffered);
+    while ( reader.Read() )
+    {
+        if ( reader.GetNodeType() == wxXML_READER_START_ELEMENT &&
+                reader.GetName() == "record" )
+        {
+            wxScopedPtr<wxXmlNode> record(reader.ReadNode());
+            if ( !record )
+                break;
+
+            ... process a single record ...
+        }
+    }
+
+    if ( reader.HasError() )
+        ... handle error, which was already logged ...
+    @endcode
+
+    Consecutive text fragments are always combined into a single text node
+    and, as with wxXmlDocument::Load(), text nodes containing only white space
+    are not returned unless ::wxXMLDOC_KEEP_WHITESPACE_NODES flag is used.
+
+    The information returned by the accessors of this class is only valid
+    until the next call to Read() or any other function changing the current
+    node.
+
+    @library{wxxml}
+    @category{xml}
+
+    @see wxXmlDocument
+
+    @since 3.1.4
+*/
+class wxXmlReader
+{
+public:
+    /**
+        Default constructor.
+
+        Open() must be called before using the reader.
+    */
+    wxXmlReader();
+
+    /**
+        Constructor opening the given stream.
+
+        @see Open()
+    */
+    explicit wxXmlReader(wxInputStream& stream, int flags = wxXMLDOC_NONE);
+
+    /**
+        Start reading the given stream.
+
+        The stream is not copied and must remain valid for as long as this
+        object is used. Any previously opened stream is closed.
+
+        @param stream
+            The stream to read the XML document from.
+        @param flags
+            Combination of wxXmlDocumentLoadFlag values.
+    */
+    bool Open(wxInputStream& stream, int flags = wxXMLDOC_NONE);
+
+    /**
+        Stop reading the stream.
+
+        This is done automatically when this object is destroyed.
+    */
+    void Close();
+
+    /// Returns @true if Open() had been called.
+    bool IsOpened() const;
+
+    /**
+        Advance to the next node.
+
+        @return @true if there is a next node or @false at the end of the
+            document or on error, use HasError() to distinguish between these
+            cases.
+    */
+    bool Read();
+
+    /**
+        Read all the remaining nodes and pass them to the given handler.
+
+        Parsing stops at the end of the document, on error or when a handler
+        function returns @false.
+
+        @return @false if an error occurred.
+    */
+    bool Parse(wxXmlReaderHandler& handler);
+
+    /**
+        Returns @true if a parsing error occurred.
+
+        Notice that the error is also logged using wxLogError().
+    */
+    bool HasError() const;
+
+    /// Returns the type of the current node.
+    wxXmlReaderNodeType GetNodeType() const;
+
+    /**
+        Returns the name of the current element or processing instruction
+        target.
+    */
+    const wxString& GetName() const;
+
+    /**
+        Returns the text of the current text node, CDATA section or comment or
+        the data of the processing instruction.
+    */
+    const wxString& GetContent() const;
+
+    /**
+        Returns the depth of the current node.
+
+        The root element has depth 0, its children 1 and so on. Both start
+        and end nodes of an element have the same depth.
+    */
+    int GetDepth() const;
+
+    /// Returns the line number of the current node in the document.
+    int GetLineNumber() const;
+
+    /// Returns the number of attributes of the current element.
+    size_t GetAttributeCount() const;
+
+    /// Returns the name of the attribute with the given index.
+    const wxString& GetAttributeName(size_t n) const;
+
+    /// Returns the value of the attribute with the given index.
+    const wxString& GetAttributeValue(size_t n) const;
+
+    /**
+        Returns @true if the current element has an attribute with the given
+        name and fills @a value with its value if it's not @NULL.
+    */
+    bool GetAttribute(const wxString& attrName, wxString *value) const;
+
+    /**
+        Returns the value of the attribute with the given name or @a
+        defaultVal if the current element doesn't have it.
+    */
+    wxString GetAttribute(const wxString& attrName,
+                          const wxString& defaultVal = wxEmptyString) const;
+
+    /// Returns @true if the current element has the attribute with this name.
+    bool HasAttribute(const wxString& attrName) const;
+
+    /**
+        Read the entire current element as a tree of nodes.
+
+        This function may only be called when the reader is positioned on a
+        wxXML_READER_START_ELEMENT node. After it returns, the reader is
+        positioned on the corresponding wxXML_READER_END_ELEMENT node.
+
+        @return The new node, which must be deleted by the caller, or @NULL on
+            error.
+    */
+    wxXmlNode *ReadNode();
+
+    /**
+        Skip the entire current element.
+
+        As with ReadNode(), this function may only be called when positioned
+        on a start element node and positions the reader on the corresponding
+        end node.
+
+        @return @false on error.
+    */
+    bool Skip();
+};
+
+
+/**
+    @class wxXmlBinaryDocument
+
+    Compact binary representation of an XML document.
+
+    The binary format stores the already parsed tree of the document, with
+    white space only text nodes removed and all element and attribute names
+    stored only once, so creating wxXmlNode objects from it is much faster
+    than parsing the XML text. Moreover, it contains an index of the children
+    of the root element, allowing to create only the nodes corresponding to
+    some of them, which is used by wxXmlResource for loading the compiled XRC
+    files created by @c wxrc lazily.
+
+    Files in this format are created using Save():
+    @code
+    wxXmlDocument doc;
+    if ( doc.Load("resource.xrc") )
+    {
+        wxFileOutputStream out("resource.xrb");
+        wxXmlBinaryDocument::Save(doc, out);
+    }
+    @endcode
+    and can be read back later:
+    @code
+    wxFileInputStream in("resource.xrb");
+    wxXmlBinaryDocument bin;
+    if ( bin.Load(in) )
+    {
+        int n = bin.Find("main_frame");
+        if ( n != wxNOT_FOUND )
+        {
+            wxScopedPtr<wxXmlNode> frame(bin.CreateNode(n));
+            ...
+        }
+    }
+    @endcode
+
+    Notice that the format is meant to be only read by the same version of
+    wxWidgets which created it and is not suitable for long term storage.
+
+    @library{wxxml}
+    @category{xml}
+
+    @see wxXmlDocument
+
+    @since 3.1.4
+*/
+class wxXmlBinaryDocument
+{
+public:
+    /**
+        Default constructor.
+
+        Load() must be called before using any other functions.
+    */
+    wxXmlBinaryDocument();
+
+    /**
+        Saves the root element of the given document in binary format.
+
+        The children of the root element are indexed using the value of their
+        @a indexAttr attribute, which can be retrieved using GetKey() and
+        searched for using Find() after loading the document.
+
+        @return @true on success, @false if the document doesn't have a root
+            element, if its elements are nested more than 1024 levels deep
+            or if writing to the stream failed.
+    */
+    static bool Save(const wxXmlDocument& doc,
+                     wxOutputStream& stream,
+                     const wxString& indexAttr = "name");
+
+    /**
+        Returns @true if the stream contains the data in binary format.
+
+        This function doesn't consume any data from the stream, so it can be
+        used to check whether Load() or wxXmlDocument::Load() should be used.
+    */
+    static bool CanRead(wxInputStream& stream);
+
+    /**
+        Loads the binary data from the stream.
+
+        All the data is read into memory but no nodes are created by this
+        function.
+
+        @return @true on success or @false if the stream doesn't contain valid
+            data, in which case an error is logged.
+    */
+    bool Load(wxInputStream& stream);
+
+    /// Returns @true if the document was successfully loaded.
+    bool IsOk() const;
+
+    /**
+        Creates the root element, without any children.
+
+        The returned node must be deleted by the caller.
+    */
+    wxXmlNode *CreateRoot() const;
+
+    /// Returns the number of children of the root element.
+    size_t GetCount() const;
+
+    /// Returns the name of the child of the root element with the given index.
+    wxString GetNodeName(size_t n) const;
+
+    /**
+        Returns the value of the index attribute of the child of the root
+        element with the given index.
+
+        Returns an empty string if the node doesn't have this attribute.
+    */
+    wxString GetKey(size_t n) const;
+
+    /**
+        Returns the index of the first child of the root element with the
+        given key or @c wxNOT_FOUND.
+    */
+    int Find(const wxString& key) const;
+
+    /**
+        Returns the index of the next child of the root element with the same
+        key as the child with the given index or @c wxNOT_FOUND.
+    */
+    int FindNext(size_t n) const;
+
+    /**
+        Creates the child of the root element with the given index and all of
+        its descendants.
+
+        The returned node must be deleted by the caller and doesn't have any
+        parent.
+
+        @return The new node or @NULL on error, e.g. if the data is corrupted
+            or its elements are nested too deeply, in which case an error is
+            also logged.
+    */
+    wxXmlNode *CreateNode(size_t n) const;
+};
@@ -25,7 +25,27 @@ enum wxXmlResourceFlags
 
         @since 3.1.3
     */
-    wxXRC_USE_ENVVARS    = 8
+    wxXRC_USE_ENVVARS    = 8,
+
+    /**
+        Load the XRC files in the background.
+
+        When this flag is used, wxXmlResource::Load() only opens the files and
+        returns immediately, while parsing them is done by worker threads. The
+        main thread only waits for a file to be loaded when a resource is
+        looked up in it for the first time, so this can significantly reduce
+        the startup time of the applications with many or big XRC files.
+
+        Notice that the files inside archives are always loaded synchronously
+        and that the errors in the files loaded in the background are only
+        reported when they are needed and not by Load() itself. Similarly, the
+        ID ranges defined in such files can only be used after loading any
+        resource from them. This flag is ignored if wxWidgets was built
+        without threads support.
+
+        @since 3.1.4
+    */
+    wxXRC_LOAD_ASYNC     = 16
 };
 
 
@@ -229,6 +249,13 @@ public:
         If you are sure that the argument is name of single XRC file (rather
         than an URL or a wildcard), use LoadFile() instead.
 
+        @note
+        Since wxWidgets 3.1.4 this method can also load the compiled XRC files
+        created by @c wxrc @c \--binary. Only the index of such files is read
+        by this function, while the individual resources are created when
+        they are used for the first time, which makes loading the files
+        containing many resources significantly faster.
+
         @see LoadFile(), LoadAllFiles()
     */
     bool Load(const wxString& filemask);
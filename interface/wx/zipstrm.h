@@ -440,6 +440,117 @@ public:
 
 
 
+/**
+    @class wxZipIndex
+
+    Index of the entries of a zip file allowing random access to them.
+
+    wxZipIndex reads the central directory of a zip archive once, when it is
+    created, and keeps all its entries in memory, so that they can be looked
+    up by name in constant time using Find(). OpenEntry() then returns a new
+    independent wxZipInputStream positioned at the start of the given entry.
+
+    The zip file is mapped into memory if possible, and the streams returned
+    by OpenEntry() read from this shared mapping. If the file can't be
+    mapped, it is opened again for each entry instead.
+
+    As the index is not modified after its creation, it can be used by
+    several threads at once and, notably, the streams returned by
+    OpenEntry() can be read concurrently by different threads. This makes
+    it possible to decompress several entries of a big archive in parallel.
+
+    Example:
+    @code
+    wxZipIndex index("assets.zip");
+    if ( index.IsOk() )
+    {
+        wxScopedPtr<wxZipInputStream> in(index.OpenEntry("images/logo.png"));
+        if ( in )
+        {
+            wxImage image(*in, wxBITMAP_TYPE_PNG);
+            ...
+        }
+    }
+    @endcode
+
+    @since 3.1.4
+
+    @library{wxbase}
+    @category{archive,streams}
+
+    @see wxZipInputStream, wxFileMapping
+*/
+class wxZipIndex
+{
+public:
+    /**
+        Creates the index of the zip file with the given name.
+
+        Use IsOk() to check if the file could be read successfully.
+
+        The @a conv parameter is used as in wxZipInputStream constructor and
+        must remain valid for the lifetime of this object.
+    */
+    explicit wxZipIndex(const wxString& filename,
+                        wxMBConv& conv = wxConvLocal);
+
+    /**
+        Creates the index of the zip archive stored in memory.
+
+        The @a data is not copied and must remain valid for the lifetime of
+        this object.
+    */
+    wxZipIndex(const void *data, size_t size, wxMBConv& conv = wxConvLocal);
+
+    /**
+        Returns @true if the central directory of the archive was read
+        successfully.
+    */
+    bool IsOk() const;
+
+    /**
+        Returns the number of entries in the archive.
+    */
+    size_t GetCount() const;
+
+    /**
+        Returns the entry with the given index.
+
+        @a n must be less than GetCount().
+    */
+    const wxZipEntry& GetEntry(size_t n) const;
+
+    /**
+        Returns the zip comment.
+    */
+    const wxString& GetComment() const;
+
+    /**
+        Returns the index of the entry with the given name or @c wxNOT_FOUND.
+
+        The name is converted to the internal form using
+        wxZipEntry::GetInternalName() before looking it up. If the archive
+        contains several entries with the same name, the first of them is
+        returned.
+    */
+    int Find(const wxString& name, wxPathFormat format = wxPATH_NATIVE) const;
+
+    //@{
+    /**
+        Returns a new stream for reading the given entry.
+
+        The returned stream must be deleted by the caller and can only be used
+        for reading the data of this entry: its GetNextEntry() always returns
+        @NULL. Returns @NULL if the entry couldn't be opened.
+    */
+    wxZipInputStream* OpenEntry(size_t n) const;
+    wxZipInputStream* OpenEntry(const wxString& name,
+                                wxPathFormat format = wxPATH_NATIVE) const;
+    //@}
+};
+
+
+
 /**
     @class wxZipClassFactory
 
@@ -558,6 +669,22 @@ public:
     void SetLevel(int level);
     //@}
 
+    //@{
+    /**
+        Enable or disable compressing the entries using several threads.
+
+        When enabled, the entries created after this call are compressed by
+        wxZlibOutputStream using wxZLIB_PARALLEL flag. This can considerably
+        speed up creating archives containing big files on multi-core
+        machines, while the resulting archive remains readable by any zip
+        implementation. Parallel compression is disabled by default.
+
+        @since 3.1.4
+    */
+    bool IsParallelDeflateEnabled() const;
+    void EnableParallelDeflate(bool enable = true);
+    //@}
+
     /**
         Create a new directory entry (see wxArchiveEntry::IsDir) with the given
         name and timestamp.
@@ -0,0 +1,197 @@
+///////////////////////////////////////////////////////////////////////////////
+// Name:        wx/zstdstream.h
+// Purpose:     Zstandard [de]compression classes documentation
+// Author:      wxWidgets development team
+// Created:     2026-10-19
+// Copyright:   (c) 2026 wxWidgets development team
+// Licence:     wxWindows licence
+///////////////////////////////////////////////////////////////////////////////
+
+/**
+    @class wxZstdInputStream
+
+    This filter stream decompresses data in Zstandard format.
+
+    Zstandard is a fast compression algorithm providing compression ratios
+    comparable to or better than Gzip format used by wxZlibInputStream, while
+    decompressing significantly faster. This class can read the .zst files
+    created by zstd command line utility and also supports the input
+    consisting of several concatenated Zstandard frames.
+
+    To decompress contents of standard input to standard output, the following
+    (not optimally efficient) code could be used:
+    @code
+    wxFFileInputStream fin(stdin);
+    wxZstdInputStream zin(fin);
+    wxFFileOutputStream fout(stdout);
+    zin.Read(fout);
+
+    if ( zin.GetLastError() != wxSTREAM_EOF ) {
+        ... handle error ...
+    }
+    @endcode
+
+    This class is only available if wxWidgets was built with libzstd support,
+    i.e. @c wxUSE_LIBZSTD is set to 1, which is not the case by default.
+
+    @library{wxbase}
+    @category{archive,streams}
+
+    @see wxInputStream, wxZlibInputStream, wxZstdOutputStream.
+
+    @since 3.1.4
+*/
+class wxZstdInputStream : public wxFilterInputStream
+{
+public:
+    /**
+        Create decompressing stream associated with the given underlying
+        stream.
+
+        This overload does not take ownership of the @a stream.
+    */
+    wxZstdInputStream(wxInputStream& stream);
+
+    /**
+        Create decompressing stream associated with the given underlying
+        stream and takes ownership of it.
+
+        As with the base wxFilterInputStream class, passing @a stream by
+        pointer indicates that this object takes ownership of it and will
+        delete it when it is itself destroyed.
+     */
+    wxZstdInputStream(wxInputStream* stream);
+};
+
+/**
+    @class wxZstdOutputStream
+
+    This filter stream compresses data using Zstandard format.
+
+    The data is written as a single Zstandard frame which is ended when the
+    stream is closed. Calling Sync() flushes all the data compressed so far to
+    the underlying stream without ending the frame, while writing more data
+    after calling Close() starts a new frame.
+
+    This class is only available if wxWidgets was built with libzstd support,
+    i.e. @c wxUSE_LIBZSTD is set to 1, which is not the case by default.
+
+    @library{wxbase}
+    @category{archive,streams}
+
+    @see wxOutputStream, wxZlibOutputStream, wxZstdInputStream
+
+    @since 3.1.4
+*/
+class wxZstdOutputStream : public wxFilterOutputStream
+{
+public:
+    /**
+        Create compressing stream associated with the given underlying
+        stream.
+
+        This overload does not take ownership of the @a stream.
+
+        @param stream
+            The stream to write the compressed data to.
+        @param level
+            Compression level from 1 to GetMaxLevel() or -1 to use the default
+            one, which provides a good compromise between speed and
+            compression ratio.
+        @param threads
+            The number of threads to use for compression, 1 by default. Use
+            0 to use as many threads as there are CPUs. Multi-threaded
+            compression requires libzstd built with threads support, and the
+            single-threaded one is used if it is not available.
+    */
+    wxZstdOutputStream(wxOutputStream& stream, int level = -1, int threads = 1);
+
+    /**
+        Create compressing stream associated with the given underlying
+        stream and takes ownership of it.
+
+        As with the base wxFilterOutputStream class, passing @a stream by
+        pointer indicates that this object takes ownership of it and will
+        delete it when it is itself destroyed.
+
+        See the other overload for the description of the other parameters.
+     */
+    wxZstdOutputStream(wxOutputStream* stream, int level = -1, int threads = 1);
+
+    /**
+        Returns the maximal compression level supported by libzstd.
+
+        Notice that the highest compression levels are very slow and use a lot
+        of memory, both for compression and decompression.
+    */
+    static int GetMaxLevel();
+};
+
+/**
+    @class wxZstdClassFactory
+
+    Filter class factory for the Zstandard format.
+
+    This factory is registered for "zstd" protocol and encoding, .zst file
+    extension and "application/zstd" MIME type. The factory found by
+    wxFilterClassFactory::Find() creates the streams using the default
+    compression level and a single thread, create a separate factory object to
+    use different parameters:
+    @code
+    wxZstdClassFactory factory;
+    factory.SetLevel(19);
+    factory.SetThreads(0);
+
+    wxTarOutputStream tar(factory.NewStream(new wxFFileOutputStream("backup.tar.zst")));
+    @endcode
+
+    @library{wxbase}
+    @category{archive,streams}
+
+    @see wxZstdOutputStream
+
+    @since 3.1.4
+*/
+class wxZstdClassFactory : public wxFilterClassFactory
+{
+public:
+    wxZstdClassFactory();
+
+    /**
+        Set the compression level used by the output streams created by this
+        factory.
+
+        See wxZstdOutputStream constructor for the meaning of the parameter.
+    */
+    void SetLevel(int level);
+
+    /**
+        Returns the compression level set by SetLevel(), -1 by default.
+    */
+    int GetLevel() const;
+
+    /**
+        Set the number of threads used by the output streams created by this
+        factory.
+
+        See wxZstdOutputStream constructor for the meaning of the parameter.
+    */
+    void SetThreads(int threads);
+
+    /**
+        Returns the number of threads set by SetThreads(), 1 by default.
+    */
+    int GetThreads() const;
+};
+
+/**
+    Return the version of libzstd library used by Zstandard stream classes.
+
+    @see wxVersionInfo
+
+    @header{wx/zstdstream.h}
+    @library{wxbase}
+
+    @since 3.1.4
+*/
+wxVersionInfo wxGetLibZstdVersionInfo();
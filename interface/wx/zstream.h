@@ -19,7 +19,17 @@ enum wxZLibFlags {
     wxZLIB_NO_HEADER = 0,    //!< raw deflate stream, no header or checksum
     wxZLIB_ZLIB = 1,         //!< zlib header and checksum
     wxZLIB_GZIP = 2,         //!< gzip header and checksum, requires zlib 1.2.1+
-    wxZLIB_AUTO = 3          //!< autodetect header zlib or gzip
+    wxZLIB_AUTO = 3,         //!< autodetect header zlib or gzip
+
+    /**
+        Compress the data using several threads, see wxZlibOutputStream.
+
+        This flag can only be combined with the other flags when creating
+        wxZlibOutputStream and is ignored if wxUSE_THREADS is 0.
+
+        @since 3.1.4
+     */
+    wxZLIB_PARALLEL = 0x100
 };
 
 
@@ -62,6 +72,16 @@ public:
         is not usually used directly. It can be used to embed a raw deflate
         stream in a higher level protocol.
 
+        If wxZLIB_PARALLEL is combined with any of the other flags, the data
+        is split into blocks of 128KiB which are compressed by several worker
+        threads at once, using the last 32KiB of the previous block as the
+        dictionary to keep the compression ratio close to that of the normal
+        mode. The output is still a single standard stream which can be read
+        by any zlib-compatible decoder, but it is not byte-for-byte identical
+        to the output produced without this flag. This mode only makes sense
+        for big amounts of data and uses more memory, as several blocks can
+        be buffered at once. This flag is available since wxWidgets 3.1.4.
+
         The values of the ::wxZlibCompressionLevels and ::wxZLibFlags
         enumerations can be used.
     */
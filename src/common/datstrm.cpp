@@ -21,6 +21,7 @@
 
 #ifndef WX_PRECOMP
     #include "wx/math.h"
+    #include "wx/utils.h"
 #endif //WX_PRECOMP
 
 namespace
@@ -39,6 +40,94 @@ union Float64Data
     wxUint32 i[2];
 };
 
+// Size of the temporary buffers used for the array functions below: this
+// should be big enough to make the overhead of calling the stream functions
+// negligible.
+const size_t CHUNK_SIZE = 8192;
+
+// Swap the bytes of all count elements of the given size in place.
+//
+// Notice that 64 bit values are treated as pairs of 32 bit ones, which works
+// for both integers and doubles and avoids depending on wxHAS_INT64.
+void SwapArray(void *buffer, size_t count, size_t size)
+{
+    switch ( size )
+    {
+        case 2:
+            {
+                wxUint16 *p = static_cast<wxUint16 *>(buffer);
+                for ( size_t n = 0; n < count; n++ )
+                    p[n] = wxUINT16_SWAP_ALWAYS(p[n]);
+            }
+            break;
+
+        case 4:
+            {
+                wxUint32 *p = static_cast<wxUint32 *>(buffer);
+                for ( size_t n = 0; n < count; n++ )
+                    p[n] = wxUINT32_SWAP_ALWAYS(p[n]);
+            }
+            break;
+
+        case 8:
+            {
+                wxUint32 *p = static_cast<wxUint32 *>(buffer);
+                for ( size_t n = 0; n < count; n++, p += 2 )
+                {
+                    const wxUint32 lo = p[0];
+                    p[0] = wxUINT32_SWAP_ALWAYS(p[1]);
+                    p[1] = wxUINT32_SWAP_ALWAYS(lo);
+                }
+            }
+            break;
+
+        default:
+            wxFAIL_MSG( "unsupported element size" );
+    }
+}
+
+// Read count elements of the given size with a single call to Read() and
+// swap their bytes afterwards if necessary.
+void ReadArray(wxInputStream *input,
+               void *buffer, size_t count, size_t size,
+               bool swap)
+{
+    input->Read(buffer, count * size);
+
+    if ( swap )
+        SwapArray(buffer, count, size);
+}
+
+// Write count elements of the given size, either directly if their bytes
+// don't need to be swapped or via a temporary buffer otherwise.
+void WriteArray(wxOutputStream *output,
+                const void *buffer, size_t count, size_t size,
+                bool swap)
+{
+    if ( !swap )
+    {
+        output->Write(buffer, count * size);
+        return;
+    }
+
+    wxUint32 chunk[CHUNK_SIZE / sizeof(wxUint32)];
+    const size_t countMax = CHUNK_SIZE / size;
+
+    const char *p = static_cast<const char *>(buffer);
+    while ( count )
+    {
+        const size_t n = wxMin(count, countMax);
+        memcpy(chunk, p, n * size);
+        SwapArray(chunk, n, size);
+
+        if ( !output->Write(chunk, n * size).IsOk() )
+            break;
+
+        p += n * size;
+        count -= n;
+    }
+}
+
 } // anonymous namespace
 
 // ----------------------------------------------------------------------------
@@ -288,51 +377,14 @@ template <class T>
 static
 void DoReadI64(T *buffer, size_t size, wxInputStream *input, bool be_order)
 {
-    typedef T DataType;
-    unsigned char *pchBuffer = (unsigned char*) buffer;
-    // TODO: Check for overflow when size is of type uint and is > than 512m
-    input->Read(pchBuffer, size * 8);
-    if ( be_order )
-    {
-        for ( wxUint32 i = 0; i < size; i++ )
-        {
-            DataType v = wxUINT64_SWAP_ON_LE(*buffer);
-            *(buffer++) = v;
-        }
-    }
-    else // little endian
-    {
-        for ( wxUint32 i=0; i<size; i++ )
-        {
-            DataType v = wxUINT64_SWAP_ON_BE(*buffer);
-            *(buffer++) = v;
-        }
-    }
+    ReadArray(input, buffer, size, 8, be_order != (wxBYTE_ORDER == wxBIG_ENDIAN));
 }
 
 template <class T>
 static
 void DoWriteI64(const T *buffer, size_t size, wxOutputStream *output, bool be_order)
 {
-  typedef T DataType;
-  if ( be_order )
-  {
-    for ( size_t i = 0; i < size; i++ )
-    {
-      DataType i64 = wxUINT64_SWAP_ON_LE(*buffer);
-      buffer++;
-      output->Write(&i64, 8);
-    }
-  }
-  else // little endian
-  {
-    for ( size_t i=0; i < size; i++ )
-    {
-      DataType i64 = wxUINT64_SWAP_ON_BE(*buffer);
-      buffer++;
-      output->Write(&i64, 8);
-    }
-  }
+    WriteArray(output, buffer, size, 8, be_order != (wxBYTE_ORDER == wxBIG_ENDIAN));
 }
 
 #endif // wxLongLong_t
@@ -391,46 +443,12 @@ wxLongLong wxDataInputStream::ReadLL(void)
 
 void wxDataInputStream::Read32(wxUint32 *buffer, size_t size)
 {
-    m_input->Read(buffer, size * 4);
-
-    if (m_be_order)
-    {
-        for (wxUint32 i=0; i<size; i++)
-        {
-            wxUint32 v = wxUINT32_SWAP_ON_LE(*buffer);
-            *(buffer++) = v;
-        }
-    }
-    else
-    {
-        for (wxUint32 i=0; i<size; i++)
-        {
-            wxUint32 v = wxUINT32_SWAP_ON_BE(*buffer);
-            *(buffer++) = v;
-        }
-    }
+    ReadArray(m_input, buffer, size, 4, NeedsSwap());
 }
 
 void wxDataInputStream::Read16(wxUint16 *buffer, size_t size)
 {
-  m_input->Read(buffer, size * 2);
-
-  if (m_be_order)
-  {
-    for (wxUint32 i=0; i<size; i++)
-    {
-      wxUint16 v = wxUINT16_SWAP_ON_LE(*buffer);
-      *(buffer++) = v;
-    }
-  }
-  else
-  {
-    for (wxUint32 i=0; i<size; i++)
-    {
-      wxUint16 v = wxUINT16_SWAP_ON_BE(*buffer);
-      *(buffer++) = v;
-    }
-  }
+    ReadArray(m_input, buffer, size, 2, NeedsSwap());
 }
 
 void wxDataInputStream::Read8(wxUint8 *buffer, size_t size)
@@ -440,18 +458,63 @@ void wxDataInputStream::Read8(wxUint8 *buffer, size_t size)
 
 void wxDataInputStream::ReadDouble(double *buffer, size_t size)
 {
-  for (wxUint32 i=0; i<size; i++)
-  {
-    *(buffer++) = ReadDouble();
-  }
+#if wxUSE_APPLE_IEEE
+    if ( m_useExtendedPrecision )
+    {
+        // Read the data in chunks to avoid calling Read() for every value.
+        char buf[CHUNK_SIZE];
+        const size_t countMax = CHUNK_SIZE / 10;
+
+        while ( size )
+        {
+            const size_t count = wxMin(size, countMax);
+            if ( m_input->Read(buf, count * 10).LastRead() != count * 10 )
+                break;
+
+            for ( size_t n = 0; n < count; n++ )
+                *buffer++ = wxConvertFromIeeeExtended((const wxInt8 *)buf + n * 10);
+
+            size -= count;
+        }
+    }
+    else
+#endif // wxUSE_APPLE_IEEE
+    {
+        wxCOMPILE_TIME_ASSERT( sizeof(double) == 8, DoubleMustBe64Bit );
+
+        ReadArray(m_input, buffer, size, 8, NeedsSwap());
+    }
 }
 
 void wxDataInputStream::ReadFloat(float *buffer, size_t size)
 {
-  for (wxUint32 i=0; i<size; i++)
-  {
-    *(buffer++) = ReadFloat();
-  }
+#if wxUSE_APPLE_IEEE
+    if ( m_useExtendedPrecision )
+    {
+        // Use the same chunk size as ReadDouble() to read each chunk at once.
+        double buf[CHUNK_SIZE / 10];
+        const size_t countMax = WXSIZEOF(buf);
+
+        while ( size )
+        {
+            const size_t count = wxMin(size, countMax);
+            ReadDouble(buf, count);
+            if ( m_input->LastRead() != count * 10 )
+                break;
+
+            for ( size_t n = 0; n < count; n++ )
+                *buffer++ = (float)buf[n];
+
+            size -= count;
+        }
+    }
+    else
+#endif // wxUSE_APPLE_IEEE
+    {
+        wxCOMPILE_TIME_ASSERT( sizeof(float) == 4, FloatMustBe32Bit );
+
+        ReadArray(m_input, buffer, size, 4, NeedsSwap());
+    }
 }
 
 wxDataInputStream& wxDataInputStream::operator>>(wxString& s)
@@ -703,46 +766,12 @@ void wxDataOutputStream::WriteLL(const wxULongLong &ll)
 
 void wxDataOutputStream::Write32(const wxUint32 *buffer, size_t size)
 {
-  if (m_be_order)
-  {
-    for (wxUint32 i=0; i<size ;i++)
-    {
-      wxUint32 i32 = wxUINT32_SWAP_ON_LE(*buffer);
-      buffer++;
-      m_output->Write(&i32, 4);
-    }
-  }
-  else
-  {
-    for (wxUint32 i=0; i<size ;i++)
-    {
-      wxUint32 i32 = wxUINT32_SWAP_ON_BE(*buffer);
-      buffer++;
-      m_output->Write(&i32, 4);
-    }
-  }
+    WriteArray(m_output, buffer, size, 4, NeedsSwap());
 }
 
 void wxDataOutputStream::Write16(const wxUint16 *buffer, size_t size)
 {
-  if (m_be_order)
-  {
-    for (wxUint32 i=0; i<size ;i++)
-    {
-      wxUint16 i16 = wxUINT16_SWAP_ON_LE(*buffer);
-      buffer++;
-      m_output->Write(&i16, 2);
-    }
-  }
-  else
-  {
-    for (wxUint32 i=0; i<size ;i++)
-    {
-      wxUint16 i16 = wxUINT16_SWAP_ON_BE(*buffer);
-      buffer++;
-      m_output->Write(&i16, 2);
-    }
-  }
+    WriteArray(m_output, buffer, size, 2, NeedsSwap());
 }
 
 void wxDataOutputStream::Write8(const wxUint8 *buffer, size_t size)
@@ -752,18 +781,62 @@ void wxDataOutputStream::Write8(const wxUint8 *buffer, size_t size)
 
 void wxDataOutputStream::WriteDouble(const double *buffer, size_t size)
 {
-  for (wxUint32 i=0; i<size; i++)
-  {
-    WriteDouble(*(buffer++));
-  }
+#if wxUSE_APPLE_IEEE
+    if ( m_useExtendedPrecision )
+    {
+        // Convert the data in chunks to avoid calling Write() for every value.
+        char buf[CHUNK_SIZE];
+        const size_t countMax = CHUNK_SIZE / 10;
+
+        while ( size )
+        {
+            const size_t count = wxMin(size, countMax);
+            for ( size_t n = 0; n < count; n++ )
+                wxConvertToIeeeExtended(*buffer++, (wxInt8 *)buf + n * 10);
+
+            if ( !m_output->Write(buf, count * 10).IsOk() )
+                break;
+
+            size -= count;
+        }
+    }
+    else
+#endif // wxUSE_APPLE_IEEE
+    {
+        wxCOMPILE_TIME_ASSERT( sizeof(double) == 8, DoubleMustBe64Bit );
+
+        WriteArray(m_output, buffer, size, 8, NeedsSwap());
+    }
 }
 
 void wxDataOutputStream::WriteFloat(const float *buffer, size_t size)
 {
-  for (wxUint32 i=0; i<size; i++)
-  {
-    WriteFloat(*(buffer++));
-  }
+#if wxUSE_APPLE_IEEE
+    if ( m_useExtendedPrecision )
+    {
+        double buf[CHUNK_SIZE / 10];
+        const size_t countMax = WXSIZEOF(buf);
+
+        while ( size )
+        {
+            const size_t count = wxMin(size, countMax);
+            for ( size_t n = 0; n < count; n++ )
+                buf[n] = *buffer++;
+
+            WriteDouble(buf, count);
+            if ( !m_output->IsOk() )
+                break;
+
+            size -= count;
+        }
+    }
+    else
+#endif // wxUSE_APPLE_IEEE
+    {
+        wxCOMPILE_TIME_ASSERT( sizeof(float) == 4, FloatMustBe32Bit );
+
+        WriteArray(m_output, buffer, size, 4, NeedsSwap());
+    }
 }
 
 wxDataOutputStream& wxDataOutputStream::operator<<(const wxString& string)
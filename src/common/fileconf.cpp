@@ -40,6 +40,7 @@
 #include  "wx/config.h"
 #include  "wx/fileconf.h"
 #include  "wx/filefn.h"
+#include  "wx/hashmap.h"
 
 #include "wx/base64.h"
 
@@ -63,8 +64,8 @@
 // ----------------------------------------------------------------------------
 
 // compare functions for sorting the arrays
-static int LINKAGEMODE CompareEntries(wxFileConfigEntry *p1, wxFileConfigEntry *p2);
-static int LINKAGEMODE CompareGroups(wxFileConfigGroup *p1, wxFileConfigGroup *p2);
+static int LINKAGEMODE CompareEntries(wxFileConfigEntry **pp1, wxFileConfigEntry **pp2);
+static int LINKAGEMODE CompareGroups(wxFileConfigGroup **pp1, wxFileConfigGroup **pp2);
 
 // filter strings
 static wxString FilterInValue(const wxString& str);
@@ -84,16 +85,77 @@ static wxString GetAppName(const wxString& appname);
 // "template" array types
 // ----------------------------------------------------------------------------
 
+// these arrays are sorted on demand only, see wxFileConfigGroup::Entries()
 #ifdef WXMAKINGDLL_BASE
-    WX_DEFINE_SORTED_USER_EXPORTED_ARRAY(wxFileConfigEntry *, ArrayEntries,
-                                         WXDLLIMPEXP_BASE);
-    WX_DEFINE_SORTED_USER_EXPORTED_ARRAY(wxFileConfigGroup *, ArrayGroups,
-                                         WXDLLIMPEXP_BASE);
+    WX_DEFINE_USER_EXPORTED_ARRAY_PTR(wxFileConfigEntry *, ArrayEntries,
+                                      WXDLLIMPEXP_BASE);
+    WX_DEFINE_USER_EXPORTED_ARRAY_PTR(wxFileConfigGroup *, ArrayGroups,
+                                      WXDLLIMPEXP_BASE);
 #else
-    WX_DEFINE_SORTED_ARRAY(wxFileConfigEntry *, ArrayEntries);
-    WX_DEFINE_SORTED_ARRAY(wxFileConfigGroup *, ArrayGroups);
+    WX_DEFINE_ARRAY_PTR(wxFileConfigEntry *, ArrayEntries);
+    WX_DEFINE_ARRAY_PTR(wxFileConfigGroup *, ArrayGroups);
 #endif
 
+// ----------------------------------------------------------------------------
+// hash maps used for finding entries and groups by name
+// ----------------------------------------------------------------------------
+
+// the keys of these maps are pointers to the names of the elements themselves,
+// which don't change while they're in the map, to avoid copying them
+class wxFileConfigNameHash
+{
+public:
+    wxFileConfigNameHash() { }
+
+    size_t operator()(const wxString *name) const
+    {
+        size_t hash = 0;
+        for ( wxString::const_iterator i = name->begin(); i != name->end(); ++i )
+        {
+#if wxCONFIG_CASE_SENSITIVE
+            hash = 31*hash + (*i).GetValue();
+#else
+            hash = 31*hash + wxUniChar(wxTolower(*i)).GetValue();
+#endif
+        }
+
+        return hash;
+    }
+};
+
+class wxFileConfigNameEqual
+{
+public:
+    wxFileConfigNameEqual() { }
+
+    bool operator()(const wxString *name1, const wxString *name2) const
+    {
+#if wxCONFIG_CASE_SENSITIVE
+        return *name1 == *name2;
+#else
+        return name1->CmpNoCase(*name2) == 0;
+#endif
+    }
+};
+
+typedef const wxString *wxFileConfigNamePtr;
+
+WX_DECLARE_HASH_MAP(wxFileConfigNamePtr, wxFileConfigEntry *,
+                    wxFileConfigNameHash, wxFileConfigNameEqual,
+                    wxFileConfigEntriesIndex);
+WX_DECLARE_HASH_MAP(wxFileConfigNamePtr, wxFileConfigGroup *,
+                    wxFileConfigNameHash, wxFileConfigNameEqual,
+                    wxFileConfigGroupsIndex);
+
+// cache of the groups corresponding to the (normalized) absolute paths used
+// recently: this avoids parsing the path each time it's changed, which
+// happens twice for every access to an entry using its full path
+WX_DECLARE_STRING_HASH_MAP(wxFileConfigGroup *, wxFileConfigPathCache);
+
+// don't let the cache grow indefinitely, just start from scratch when it gets
+// too big
+static const size_t wxFILECONF_PATH_CACHE_MAX_SIZE = 1024;
+
 // ----------------------------------------------------------------------------
 // wxFileConfigLineList
 // ----------------------------------------------------------------------------
@@ -176,8 +238,12 @@ class wxFileConfigGroup
 private:
   wxFileConfig *m_pConfig;          // config object we belong to
   wxFileConfigGroup  *m_pParent;    // parent group (NULL for root group)
-  ArrayEntries  m_aEntries;         // entries in this group
-  ArrayGroups   m_aSubgroups;       // subgroups
+  mutable ArrayEntries m_aEntries;  // entries in this group
+  mutable ArrayGroups m_aSubgroups; // subgroups
+  mutable bool  m_bEntriesSorted,   // true if m_aEntries is sorted
+                m_bSubgroupsSorted; // true if m_aSubgroups is sorted
+  wxFileConfigEntriesIndex m_entriesIndex;  // the same entries and subgroups
+  wxFileConfigGroupsIndex m_subgroupsIndex; // indexed by their names
   wxString      m_strName;          // group's name
   wxFileConfigLineList *m_pLine;    // pointer to our line in the linked list
   wxFileConfigEntry *m_pLastEntry;  // last entry/subgroup of this group in the
@@ -201,9 +267,10 @@ public:
   wxFileConfigGroup    *Parent()  const { return m_pParent; }
   wxFileConfig   *Config()  const { return m_pConfig; }
 
-  const ArrayEntries& Entries() const { return m_aEntries;   }
-  const ArrayGroups&  Groups()  const { return m_aSubgroups; }
-  bool  IsEmpty() const { return Entries().IsEmpty() && Groups().IsEmpty(); }
+  // entries and subgroups sorted by name
+  const ArrayEntries& Entries() const;
+  const ArrayGroups&  Groups()  const;
+  bool  IsEmpty() const { return m_aEntries.IsEmpty() && m_aSubgroups.IsEmpty(); }
 
   // find entry/subgroup (NULL if not found)
   wxFileConfigGroup *FindSubgroup(const wxString& name) const;
@@ -299,10 +366,17 @@ void wxFileConfig::Init()
 {
     m_pCurrentGroup =
     m_pRootGroup    = new wxFileConfigGroup(NULL, wxEmptyString, this);
+    m_pathCache     = new wxFileConfigPathCache;
 
     m_linesHead =
     m_linesTail = NULL;
 
+    m_localFileSize =
+    m_journalSize = wxInvalidOffset;
+    m_localFileChecksum = 0;
+
+    ResetDirty();
+
     // It's not an error if (one of the) file(s) doesn't exist.
 
     // parse the global file
@@ -329,6 +403,13 @@ void wxFileConfig::Init()
         {
             Parse(fileLocal, true /* local */);
             SetRootPath();
+
+            UpdateLocalFileInfo();
+            if ( GetStyle() & wxCONFIG_USE_JOURNAL )
+            {
+                ReplayJournal();
+                SetRootPath();
+            }
         }
         else
         {
@@ -345,7 +426,7 @@ void wxFileConfig::Init()
         }
     }
 
-    m_isDirty = false;
+    ResetDirty();
     m_autosave = true;
 }
 
@@ -397,14 +478,19 @@ wxFileConfig::wxFileConfig(const wxString& appName, const wxString& vendorName,
 wxFileConfig::wxFileConfig(wxInputStream &inStream, const wxMBConv& conv)
             : m_conv(conv.Clone())
 {
-    m_isDirty = false;
+    ResetDirty();
     m_autosave = true;
 
+    m_localFileSize =
+    m_journalSize = wxInvalidOffset;
+    m_localFileChecksum = 0;
+
     // always local_file when this constructor is called (?)
     SetStyle(GetStyle() | wxCONFIG_USE_LOCAL_FILE);
 
     m_pCurrentGroup =
     m_pRootGroup    = new wxFileConfigGroup(NULL, wxEmptyString, this);
+    m_pathCache     = new wxFileConfigPathCache;
 
     m_linesHead =
     m_linesTail = NULL;
@@ -480,6 +566,7 @@ wxFileConfig::wxFileConfig(wxInputStream &inStream, const wxMBConv& conv)
 void wxFileConfig::CleanUp()
 {
     delete m_pRootGroup;
+    delete m_pathCache;
 
     wxFileConfigLineList *pCur = m_linesHead;
     while ( pCur != NULL ) {
@@ -676,17 +763,24 @@ wxFileConfig::DoSetPath(const wxString& strPath, bool createMissingComponents)
         return true;
     }
 
-    if ( strPath[0] == wxCONFIG_PATH_SEPARATOR ) {
-        // absolute path
-        wxSplitPath(aParts, strPath);
-    }
-    else {
+    wxString strFullPath;
+    if ( strPath[0] != wxCONFIG_PATH_SEPARATOR ) {
         // relative path, combine with current one
-        wxString strFullPath = m_strPath;
-        strFullPath << wxCONFIG_PATH_SEPARATOR << strPath;
-        wxSplitPath(aParts, strFullPath);
+        strFullPath << m_strPath << wxCONFIG_PATH_SEPARATOR << strPath;
     }
 
+    const wxString& strAbsPath = strFullPath.empty() ? strPath : strFullPath;
+
+    // check if we already know the group corresponding to this path
+    wxFileConfigPathCache::const_iterator it = m_pathCache->find(strAbsPath);
+    if ( it != m_pathCache->end() ) {
+        m_pCurrentGroup = it->second;
+        m_strPath = strAbsPath;
+        return true;
+    }
+
+    wxSplitPath(aParts, strAbsPath);
+
     // change current group
     size_t n;
     m_pCurrentGroup = m_pRootGroup;
@@ -709,6 +803,14 @@ wxFileConfig::DoSetPath(const wxString& strPath, bool createMissingComponents)
         m_strPath << wxCONFIG_PATH_SEPARATOR << aParts[n];
     }
 
+    // we can only cache the paths which don't need to be normalized
+    if ( m_strPath == strAbsPath ) {
+        if ( m_pathCache->size() >= wxFILECONF_PATH_CACHE_MAX_SIZE )
+            m_pathCache->clear();
+
+        (*m_pathCache)[m_strPath] = m_pCurrentGroup;
+    }
+
     return true;
 }
 
@@ -956,7 +1058,23 @@ bool wxFileConfig::DoWriteString(const wxString& key, const wxString& szValue)
                     szValue.c_str() );
         pEntry->SetValue(szValue);
 
-        SetDirty();
+        if ( pEntry->IsImmutable() )
+        {
+            // nothing was changed, but keep the old behaviour of marking the
+            // config as dirty
+            SetDirty();
+        }
+        else
+        {
+            wxString record;
+            record << FilterOutEntryName(m_strPath + wxCONFIG_PATH_SEPARATOR + strName)
+                   << wxT('=')
+                   << (GetStyle() & wxCONFIG_USE_NO_ESCAPE_CHARACTERS
+                        ? szValue
+                        : FilterOutValue(szValue));
+
+            AddToJournal(record);
+        }
     }
 
     return true;
@@ -981,6 +1099,14 @@ bool wxFileConfig::Flush(bool /* bCurrentOnly */)
   if ( !IsDirty() || !m_fnLocalFile.GetFullPath() )
     return true;
 
+  // try to avoid rewriting the entire file if possible
+  if ( FlushJournal() )
+  {
+    ResetDirty();
+
+    return true;
+  }
+
   // set the umask if needed
   wxCHANGE_UMASK(m_umask);
 
@@ -1013,11 +1139,215 @@ bool wxFileConfig::Flush(bool /* bCurrentOnly */)
       return false;
   }
 
+  // the journal, if any, is not needed any more as all the changes recorded
+  // in it are now in the file itself
+  const wxString journal = GetJournalFileName();
+  if ( wxFile::Exists(journal) && !wxRemoveFile(journal) )
+  {
+      wxLogWarning(_("Failed to remove configuration journal file '%s'."),
+                   journal);
+  }
+
+  m_journalSize = wxInvalidOffset;
+  UpdateLocalFileInfo();
+
   ResetDirty();
 
   return true;
 }
 
+// ----------------------------------------------------------------------------
+// journal
+// ----------------------------------------------------------------------------
+
+/*
+  When wxCONFIG_USE_JOURNAL style is used, the changes to the values of the
+  entries are not saved by rewriting the entire local file but by appending
+  them to a separate journal file, which is much faster for big files. The
+  journal is read and applied to the contents of the local file when it's
+  loaded, and is merged into it (i.e. the file is rewritten and the journal is
+  deleted) when it becomes too big or when any other changes (such as deleting
+  or renaming groups) need to be saved.
+
+  The journal starts with a header containing the size and the checksum of
+  the local file it applies to, so that it is ignored if it doesn't
+  correspond to it, e.g. if the program crashed after saving the file but
+  before deleting the journal or if the file was modified by another program.
+  Each of the following lines contains either the full path of the entry, as
+  escaped by FilterOutEntryName(), followed by "=" and its value, in the same
+  format as in the file itself, or "-" followed by the full path of a deleted
+  entry. The journal is always in UTF-8 encoding.
+*/
+
+wxString wxFileConfig::GetJournalFileName() const
+{
+    return m_fnLocalFile.GetFullPath() + wxT(".journal");
+}
+
+wxString wxFileConfig::GetJournalHeader() const
+{
+    return wxString::Format(wxT("; wxFileConfig journal for %") wxLongLongFmtSpec
+                            wxT("d bytes with checksum %08x"),
+                            (wxLongLong_t)m_localFileSize,
+                            m_localFileChecksum);
+}
+
+void wxFileConfig::UpdateLocalFileInfo()
+{
+    m_localFileSize = wxInvalidOffset;
+    m_localFileChecksum = 0;
+
+    wxFile file;
+    if ( !m_fnLocalFile.IsOk() || !file.Open(m_fnLocalFile.GetFullPath()) )
+        return;
+
+    // use FNV-1a hash of the file contents as checksum: it's not meant to
+    // detect malicious changes, just to avoid applying the journal to a
+    // different version of the file
+    wxUint32 hash = 2166136261u;
+    wxFileOffset size = 0;
+    char buf[4096];
+    for ( ;; )
+    {
+        const ssize_t len = file.Read(buf, sizeof(buf));
+        if ( len == wxInvalidOffset )
+            return;
+
+        if ( !len )
+            break;
+
+        for ( ssize_t n = 0; n < len; n++ )
+        {
+            hash ^= static_cast<unsigned char>(buf[n]);
+            hash *= 16777619u;
+        }
+
+        size += len;
+    }
+
+    m_localFileSize = size;
+    m_localFileChecksum = hash;
+}
+
+void wxFileConfig::AddToJournal(const wxString& record)
+{
+    if ( !(GetStyle() & wxCONFIG_USE_JOURNAL) || !m_canUseJournal )
+    {
+        SetDirty();
+        return;
+    }
+
+    m_journal << record << wxTextFile::GetEOL();
+    m_isDirty = true;
+}
+
+bool wxFileConfig::FlushJournal()
+{
+    if ( !(GetStyle() & wxCONFIG_USE_JOURNAL) || !m_canUseJournal )
+        return false;
+
+    // we can only use the journal if the file it applies to exists
+    if ( m_localFileSize == wxInvalidOffset )
+        return false;
+
+    // merge the journal into the file when it becomes too big, i.e. when
+    // reading it would take longer than reading the file itself (but don't
+    // bother doing it too often for small files)
+    const wxCharBuffer buf(m_journal.utf8_str());
+    const wxFileOffset journalSize = m_journalSize == wxInvalidOffset
+                                        ? 0
+                                        : m_journalSize;
+    if ( journalSize + (wxFileOffset)buf.length() >
+            wxMax(m_localFileSize / 2, 65536) )
+        return false;
+
+    wxCHANGE_UMASK(m_umask);
+
+    wxFile file;
+    if ( !file.Open(GetJournalFileName(), wxFile::write_append) )
+        return false;
+
+    // if the journal is new, start it with the header identifying the file
+    if ( file.Length() == 0 )
+    {
+        wxString header = GetJournalHeader();
+        header += wxTextFile::GetEOL();
+        if ( !file.Write(header, wxConvUTF8) )
+            return false;
+    }
+
+    // if this fails, we'll rewrite the entire file which will remove the
+    // journal with incomplete data too
+    if ( file.Write(buf.data(), buf.length()) != buf.length() )
+        return false;
+
+    m_journalSize = file.Length();
+
+    return true;
+}
+
+void wxFileConfig::ReplayJournal()
+{
+    const wxString name = GetJournalFileName();
+    if ( !wxFile::Exists(name) )
+        return;
+
+    wxTextFile file(name);
+    if ( !file.Open(wxConvUTF8) )
+    {
+        wxLogWarning(_("can't open configuration journal file '%s'."), name);
+        return;
+    }
+
+    if ( !file.GetLineCount() || file[0] != GetJournalHeader() )
+    {
+        // this journal is for a different version of the file, ignore it and
+        // delete it to avoid appending to it
+        wxLogTrace(FILECONF_TRACE_MASK,
+                   wxT("Ignoring out of date journal '%s'"), name);
+
+        file.Close();
+        wxRemoveFile(name);
+        return;
+    }
+
+    const size_t nLineCount = file.GetLineCount();
+    for ( size_t n = 1; n < nLineCount; n++ )
+    {
+        const wxString& line = file[n];
+        if ( line.empty() )
+            continue;
+
+        if ( line[0] == wxT('-') )
+        {
+            DeleteEntry(FilterInEntryName(line.substr(1)), false);
+            continue;
+        }
+
+        // find the first unescaped '=', as in Parse()
+        wxString::const_iterator i;
+        for ( i = line.begin(); i != line.end() && *i != wxT('='); ++i )
+        {
+            if ( *i == wxT('\\') && ++i == line.end() )
+                break;
+        }
+
+        if ( i == line.end() )
+        {
+            wxLogWarning(_("file '%s', line %zu: '=' expected."), name, n + 1);
+            continue;
+        }
+
+        wxString value(i + 1, line.end());
+        if ( !(GetStyle() & wxCONFIG_USE_NO_ESCAPE_CHARACTERS) )
+            value = FilterInValue(value);
+
+        DoWriteString(FilterInEntryName(wxString(line.begin(), i)), value);
+    }
+
+    m_journalSize = wxFileName::GetSize(name).GetValue();
+}
+
 #if wxUSE_STREAMS
 
 bool wxFileConfig::Save(wxOutputStream& os, const wxMBConv& conv)
@@ -1090,6 +1420,9 @@ bool wxFileConfig::RenameGroup(const wxString& oldName,
 
     group->Rename(newName);
 
+    // the cached paths of this group and its subgroups are not valid any more
+    m_pathCache->clear();
+
     SetDirty();
 
     return true;
@@ -1106,13 +1439,18 @@ bool wxFileConfig::DeleteEntry(const wxString& key, bool bGroupIfEmptyAlso)
   if ( !m_pCurrentGroup->DeleteEntry(path.Name()) )
     return false;
 
-  SetDirty();
+  AddToJournal(wxT('-') +
+               FilterOutEntryName(m_strPath + wxCONFIG_PATH_SEPARATOR + path.Name()));
 
   if ( bGroupIfEmptyAlso && m_pCurrentGroup->IsEmpty() ) {
     if ( m_pCurrentGroup != m_pRootGroup ) {
       wxFileConfigGroup *pGroup = m_pCurrentGroup;
       SetPath(wxT(".."));  // changes m_pCurrentGroup!
       m_pCurrentGroup->DeleteSubgroupByName(pGroup->Name());
+      m_pathCache->clear();
+
+      // deleting groups is not supported by the journal
+      SetDirty();
     }
     //else: never delete the root group
   }
@@ -1127,6 +1465,8 @@ bool wxFileConfig::DeleteGroup(const wxString& key)
   if ( !m_pCurrentGroup->DeleteSubgroupByName(path.Name()) )
       return false;
 
+  m_pathCache->clear();
+
   path.UpdateIfDeleted();
 
   SetDirty();
@@ -1147,6 +1487,14 @@ bool wxFileConfig::DeleteAll()
                         m_fnLocalFile.GetFullPath().c_str());
           return false;
       }
+
+      const wxString journal = GetJournalFileName();
+      if ( wxFile::Exists(journal) && !wxRemoveFile(journal) )
+      {
+          wxLogSysError(_("can't delete user configuration file '%s'"),
+                        journal);
+          return false;
+      }
   }
 
   Init();
@@ -1313,10 +1661,11 @@ bool wxFileConfig::LineListIsEmpty()
 wxFileConfigGroup::wxFileConfigGroup(wxFileConfigGroup *pParent,
                                        const wxString& strName,
                                        wxFileConfig *pConfig)
-                         : m_aEntries(CompareEntries),
-                           m_aSubgroups(CompareGroups),
-                           m_strName(strName)
+                         : m_strName(strName)
 {
+  m_bEntriesSorted =
+  m_bSubgroupsSorted = true;
+
   m_pConfig = pConfig;
   m_pParent = pParent;
   m_pLine   = NULL;
@@ -1511,13 +1860,14 @@ void wxFileConfigGroup::Rename(const wxString& newName)
     if ( newName == m_strName )
         return;
 
-    // we need to remove the group from the parent and it back under the new
-    // name to keep the parents array of subgroups alphabetically sorted
-    m_pParent->m_aSubgroups.Remove(this);
+    // we need to remove the group from the parent index and add it back under
+    // the new name, the parents array of subgroups needs to be sorted again
+    m_pParent->m_subgroupsIndex.erase(&m_strName);
 
     m_strName = newName;
 
-    m_pParent->m_aSubgroups.Add(this);
+    m_pParent->m_subgroupsIndex[&m_strName] = this;
+    m_pParent->m_bSubgroupsSorted = false;
 
     // update the group lines recursively
     UpdateGroupAndSubgroupsLines();
@@ -1536,67 +1886,40 @@ wxString wxFileConfigGroup::GetFullName() const
 // find an item
 // ----------------------------------------------------------------------------
 
-// use binary search because the array is sorted
+const ArrayEntries& wxFileConfigGroup::Entries() const
+{
+  if ( !m_bEntriesSorted ) {
+    m_aEntries.Sort(CompareEntries);
+    m_bEntriesSorted = true;
+  }
+
+  return m_aEntries;
+}
+
+const ArrayGroups& wxFileConfigGroup::Groups() const
+{
+  if ( !m_bSubgroupsSorted ) {
+    m_aSubgroups.Sort(CompareGroups);
+    m_bSubgroupsSorted = true;
+  }
+
+  return m_aSubgroups;
+}
+
 wxFileConfigEntry *
 wxFileConfigGroup::FindEntry(const wxString& name) const
 {
-  size_t
-       lo = 0,
-       hi = m_aEntries.GetCount();
-  wxFileConfigEntry *pEntry;
-
-  while ( lo < hi ) {
-    size_t i;
-    i = (lo + hi)/2;
-    pEntry = m_aEntries[i];
-
-    int res;
-    #if wxCONFIG_CASE_SENSITIVE
-      res = pEntry->Name().compare(name);
-    #else
-      res = pEntry->Name().CmpNoCase(name);
-    #endif
-
-    if ( res > 0 )
-      hi = i;
-    else if ( res < 0 )
-      lo = i + 1;
-    else
-      return pEntry;
-  }
+  const wxFileConfigEntriesIndex::const_iterator it = m_entriesIndex.find(&name);
 
-  return NULL;
+  return it == m_entriesIndex.end() ? NULL : it->second;
 }
 
 wxFileConfigGroup *
 wxFileConfigGroup::FindSubgroup(const wxString& name) const
 {
-  size_t
-       lo = 0,
-       hi = m_aSubgroups.GetCount();
-  wxFileConfigGroup *pGroup;
-
-  while ( lo < hi ) {
-    size_t i;
-    i = (lo + hi)/2;
-    pGroup = m_aSubgroups[i];
-
-    int res;
-    #if wxCONFIG_CASE_SENSITIVE
-      res = pGroup->Name().compare(name);
-    #else
-      res = pGroup->Name().CmpNoCase(name);
-    #endif
-
-    if ( res > 0 )
-      hi = i;
-    else if ( res < 0 )
-      lo = i + 1;
-    else
-      return pGroup;
-  }
+  const wxFileConfigGroupsIndex::const_iterator it = m_subgroupsIndex.find(&name);
 
-  return NULL;
+  return it == m_subgroupsIndex.end() ? NULL : it->second;
 }
 
 // ----------------------------------------------------------------------------
@@ -1610,7 +1933,14 @@ wxFileConfigEntry *wxFileConfigGroup::AddEntry(const wxString& strName, int nLin
 
     wxFileConfigEntry   *pEntry = new wxFileConfigEntry(this, strName, nLine);
 
+    // don't sort the entries now, this would make adding many of them slow,
+    // but keep them sorted if they're added in order, as is often the case
+    if ( m_bEntriesSorted && !m_aEntries.IsEmpty() &&
+            CompareEntries(&m_aEntries.Last(), &pEntry) > 0 )
+        m_bEntriesSorted = false;
+
     m_aEntries.Add(pEntry);
+    m_entriesIndex[&pEntry->Name()] = pEntry;
     return pEntry;
 }
 
@@ -1621,7 +1951,12 @@ wxFileConfigGroup *wxFileConfigGroup::AddSubgroup(const wxString& strName)
 
     wxFileConfigGroup   *pGroup = new wxFileConfigGroup(this, strName, m_pConfig);
 
+    if ( m_bSubgroupsSorted && !m_aSubgroups.IsEmpty() &&
+            CompareGroups(&m_aSubgroups.Last(), &pGroup) > 0 )
+        m_bSubgroupsSorted = false;
+
     m_aSubgroups.Add(pGroup);
+    m_subgroupsIndex[&pGroup->Name()] = pGroup;
     return pGroup;
 }
 
@@ -1751,6 +2086,7 @@ bool wxFileConfigGroup::DeleteSubgroup(wxFileConfigGroup *pGroup)
                     pGroup->Name().c_str() );
     }
 
+    m_subgroupsIndex.erase(&pGroup->Name());
     m_aSubgroups.Remove(pGroup);
     delete pGroup;
 
@@ -1799,6 +2135,7 @@ bool wxFileConfigGroup::DeleteEntry(const wxString& name)
     m_pConfig->LineListRemove(pLine);
   }
 
+  m_entriesIndex.erase(&pEntry->Name());
   m_aEntries.Remove(pEntry);
   delete pEntry;
 
@@ -1906,21 +2243,21 @@ void wxFileConfigEntry::SetValue(const wxString& strValue, bool bUser)
 // compare functions for array sorting
 // ----------------------------------------------------------------------------
 
-int CompareEntries(wxFileConfigEntry *p1, wxFileConfigEntry *p2)
+int CompareEntries(wxFileConfigEntry **pp1, wxFileConfigEntry **pp2)
 {
 #if wxCONFIG_CASE_SENSITIVE
-    return p1->Name().compare(p2->Name());
+    return (*pp1)->Name().compare((*pp2)->Name());
 #else
-    return p1->Name().CmpNoCase(p2->Name());
+    return (*pp1)->Name().CmpNoCase((*pp2)->Name());
 #endif
 }
 
-int CompareGroups(wxFileConfigGroup *p1, wxFileConfigGroup *p2)
+int CompareGroups(wxFileConfigGroup **pp1, wxFileConfigGroup **pp2)
 {
 #if wxCONFIG_CASE_SENSITIVE
-    return p1->Name().compare(p2->Name());
+    return (*pp1)->Name().compare((*pp2)->Name());
 #else
-    return p1->Name().CmpNoCase(p2->Name());
+    return (*pp1)->Name().CmpNoCase((*pp2)->Name());
 #endif
 }
 
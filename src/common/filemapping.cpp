@@ -0,0 +1,176 @@
+///////////////////////////////////////////////////////////////////////////////
+// Name:        src/common/filemapping.cpp
+// Purpose:     wxFileMapping implementation
+// Author:      wxWidgets development team
+// Created:     2026-10-19
+// Copyright:   (c) 2026 wxWidgets development team
+// Licence:     wxWindows licence
+///////////////////////////////////////////////////////////////////////////////
+
+// ============================================================================
+// declarations
+// ============================================================================
+
+// ----------------------------------------------------------------------------
+// headers
+// ----------------------------------------------------------------------------
+
+// for compilers that support precompilation, includes "wx.h".
+#include "wx/wxprec.h"
+
+#ifdef __BORLANDC__
+    #pragma hdrstop
+#endif
+
+#if wxUSE_FILE
+
+#include "wx/filemapping.h"
+
+#ifndef WX_PRECOMP
+    #include "wx/intl.h"
+    #include "wx/log.h"
+#endif // WX_PRECOMP
+
+#include "wx/file.h"
+
+// Cygwin provides mmap() and doesn't support _get_osfhandle(), so use POSIX
+// API for it, even when building wxMSW.
+#if defined(__WINDOWS__) && !defined(__CYGWIN__)
+    #define wxFILEMAPPING_USE_WIN32
+#endif
+
+#ifdef wxFILEMAPPING_USE_WIN32
+    #include "wx/msw/wrapwin.h"
+    #include <io.h>
+#else
+    #include <sys/types.h>
+    #include <sys/mman.h>
+#endif
+
+// ============================================================================
+// wxFileMapping implementation
+// ============================================================================
+
+bool wxFileMapping::Open(const wxString& filename, Mode mode)
+{
+    Close();
+
+    wxFile file;
+    if ( !file.Open(filename, mode == ReadWrite ? wxFile::read_write
+                                                : wxFile::read) )
+        return false;
+
+    const wxFileOffset length = file.Length();
+    if ( length == wxInvalidOffset )
+        return false;
+
+    // Check that the file can be mapped into our address space as a whole:
+    // this can fail for big files in 32 bit programs.
+    if ( static_cast<wxULongLong_t>(length) > static_cast<size_t>(-1) )
+    {
+        wxLogError(_("File \"%s\" is too big to be mapped into memory."),
+                   filename);
+        return false;
+    }
+
+    m_size = static_cast<size_t>(length);
+    m_writable = mode == ReadWrite;
+
+    // Mapping an empty file is not allowed by the OS, but there is no reason
+    // to consider it an error.
+    if ( !m_size )
+    {
+        m_ok = true;
+        return true;
+    }
+
+#ifdef wxFILEMAPPING_USE_WIN32
+    HANDLE hMapping = ::CreateFileMapping
+                        (
+                            (HANDLE)_get_osfhandle(file.fd()),
+                            NULL,                   // default security
+                            m_writable ? PAGE_READWRITE : PAGE_READONLY,
+                            0, 0,                   // entire file
+                            NULL                    // no name
+                        );
+    if ( hMapping )
+    {
+        m_data = ::MapViewOfFile
+                   (
+                        hMapping,
+                        m_writable ? FILE_MAP_WRITE : FILE_MAP_READ,
+                        0, 0,                       // from the beginning
+                        0                           // until the end
+                   );
+
+        // The view keeps the mapping object alive, we don't need its handle.
+        ::CloseHandle(hMapping);
+    }
+#else // !wxFILEMAPPING_USE_WIN32
+    m_data = mmap(NULL, m_size,
+                  m_writable ? PROT_READ | PROT_WRITE : PROT_READ,
+                  MAP_SHARED, file.fd(), 0);
+    if ( m_data == MAP_FAILED )
+        m_data = NULL;
+#endif // wxFILEMAPPING_USE_WIN32/!wxFILEMAPPING_USE_WIN32
+
+    if ( !m_data )
+    {
+        wxLogSysError(_("Failed to map file \"%s\" into memory"), filename);
+
+        Init();
+        return false;
+    }
+
+    // Notice that the file itself is closed when we return, but this doesn't
+    // affect the mapping which remains valid until Close().
+    m_ok = true;
+
+    return true;
+}
+
+void wxFileMapping::Close()
+{
+    if ( m_data )
+    {
+#ifdef wxFILEMAPPING_USE_WIN32
+        if ( !::UnmapViewOfFile(m_data) )
+#else
+        if ( munmap(m_data, m_size) != 0 )
+#endif
+        {
+            wxLogSysError(_("Failed to unmap file from memory"));
+        }
+    }
+
+    Init();
+}
+
+void* wxFileMapping::GetWritableData() const
+{
+    wxCHECK_MSG( m_writable, NULL, "file is mapped as read-only" );
+
+    return m_data;
+}
+
+bool wxFileMapping::Flush()
+{
+    wxCHECK_MSG( m_ok, false, "file is not mapped" );
+
+    if ( !m_writable || !m_data )
+        return true;
+
+#ifdef wxFILEMAPPING_USE_WIN32
+    if ( !::FlushViewOfFile(m_data, 0) )
+#else
+    if ( msync(m_data, m_size, MS_SYNC) != 0 )
+#endif
+    {
+        wxLogSysError(_("Failed to write mapped memory to file"));
+        return false;
+    }
+
+    return true;
+}
+
+#endif // wxUSE_FILE
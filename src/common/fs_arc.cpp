@@ -22,6 +22,7 @@
 #endif
 
 #include "wx/archive.h"
+#include "wx/mstream.h"
 #include "wx/private/fileback.h"
 
 //---------------------------------------------------------------------------
@@ -301,6 +302,211 @@ wxArchiveFSCacheData *wxArchiveFSCache::Get(const wxString& name)
     return NULL;
 }
 
+//---------------------------------------------------------------------------
+// wxArchiveFSDataCache
+//
+// Keeps the contents of the recently read small entries in memory, so that
+// reopening them doesn't require reopening the archive and decompressing
+// them again. The least recently used entries are discarded when the total
+// size of the cached data exceeds the limit.
+//---------------------------------------------------------------------------
+
+// default limits for the cached entries
+static const size_t wxARCHIVEFS_MAX_ENTRY_SIZE = 64*1024;
+static const size_t wxARCHIVEFS_MAX_TOTAL_SIZE = 4*1024*1024;
+
+struct wxArchiveFSDataNode
+{
+    wxString name;
+    wxMemoryBuffer data;
+    wxArchiveFSDataNode *prev;
+    wxArchiveFSDataNode *next;
+};
+
+WX_DECLARE_STRING_HASH_MAP(wxArchiveFSDataNode*, wxArchiveFSDataHash);
+
+class wxArchiveFSDataCache
+{
+public:
+    wxArchiveFSDataCache();
+    ~wxArchiveFSDataCache() { Clear(); }
+
+    void SetLimits(size_t maxEntrySize, size_t maxTotalSize);
+
+    // Check if an entry of the given size should be cached.
+    bool CanCache(wxFileOffset size) const;
+
+    // Return the cached data and make it the most recently used one.
+    bool Get(const wxString& name, wxMemoryBuffer& data);
+
+    void Add(const wxString& name, const wxMemoryBuffer& data);
+
+    void Clear();
+
+    size_t GetCount() const { return m_hash.size(); }
+    size_t GetSize() const { return m_size; }
+
+private:
+    void Link(wxArchiveFSDataNode *node);
+    void Unlink(wxArchiveFSDataNode *node);
+    void Shrink(size_t maxSize);
+
+    wxArchiveFSDataHash m_hash;
+
+    // the list of nodes from the most to the least recently used one
+    wxArchiveFSDataNode *m_first;
+    wxArchiveFSDataNode *m_last;
+
+    size_t m_size;
+    size_t m_maxEntrySize;
+    size_t m_maxTotalSize;
+};
+
+wxArchiveFSDataCache::wxArchiveFSDataCache()
+ :  m_first(NULL),
+    m_last(NULL),
+    m_size(0),
+    m_maxEntrySize(wxARCHIVEFS_MAX_ENTRY_SIZE),
+    m_maxTotalSize(wxARCHIVEFS_MAX_TOTAL_SIZE)
+{
+}
+
+void wxArchiveFSDataCache::SetLimits(size_t maxEntrySize, size_t maxTotalSize)
+{
+    m_maxEntrySize = maxEntrySize;
+    m_maxTotalSize = maxTotalSize;
+
+    Shrink(m_maxEntrySize ? m_maxTotalSize : 0);
+}
+
+bool wxArchiveFSDataCache::CanCache(wxFileOffset size) const
+{
+    if (!m_maxEntrySize || !m_maxTotalSize || size == wxInvalidOffset)
+        return false;
+
+    return static_cast<wxUint64>(size) <= m_maxEntrySize &&
+            static_cast<wxUint64>(size) <= m_maxTotalSize;
+}
+
+bool wxArchiveFSDataCache::Get(const wxString& name, wxMemoryBuffer& data)
+{
+    wxArchiveFSDataHash::iterator it = m_hash.find(name);
+    if (it == m_hash.end())
+        return false;
+
+    wxArchiveFSDataNode *node = it->second;
+    if (node != m_first)
+    {
+        Unlink(node);
+        Link(node);
+    }
+
+    data = node->data;
+    return true;
+}
+
+void wxArchiveFSDataCache::Add(const wxString& name, const wxMemoryBuffer& data)
+{
+    if (!CanCache(data.GetDataLen()) || m_hash.find(name) != m_hash.end())
+        return;
+
+    Shrink(m_maxTotalSize - data.GetDataLen());
+
+    wxArchiveFSDataNode *node = new wxArchiveFSDataNode;
+    node->name = name;
+    node->data = data;
+    Link(node);
+
+    m_hash[name] = node;
+    m_size += data.GetDataLen();
+}
+
+void wxArchiveFSDataCache::Clear()
+{
+    Shrink(0);
+}
+
+void wxArchiveFSDataCache::Link(wxArchiveFSDataNode *node)
+{
+    node->prev = NULL;
+    node->next = m_first;
+
+    if (m_first)
+        m_first->prev = node;
+    else
+        m_last = node;
+
+    m_first = node;
+}
+
+void wxArchiveFSDataCache::Unlink(wxArchiveFSDataNode *node)
+{
+    if (node->prev)
+        node->prev->next = node->next;
+    else
+        m_first = node->next;
+
+    if (node->next)
+        node->next->prev = node->prev;
+    else
+        m_last = node->prev;
+}
+
+void wxArchiveFSDataCache::Shrink(size_t maxSize)
+{
+    // the empty entries don't take any space but still need to be deleted
+    // when clearing the cache
+    while (m_last && (m_size > maxSize || !maxSize))
+    {
+        wxArchiveFSDataNode *node = m_last;
+        Unlink(node);
+
+        m_hash.erase(node->name);
+        m_size -= node->data.GetDataLen();
+        delete node;
+    }
+}
+
+//---------------------------------------------------------------------------
+// wxArchiveFSCachedStream
+//
+// A memory stream reading the data from the cache, it keeps a reference to
+// the data so that it remains valid even if it's discarded from the cache.
+//---------------------------------------------------------------------------
+
+class wxArchiveFSCachedStream : public wxMemoryInputStream
+{
+public:
+    wxArchiveFSCachedStream(const wxMemoryBuffer& data)
+        : wxMemoryInputStream(data.GetData(), data.GetDataLen()),
+          m_data(data)
+    {
+    }
+
+private:
+    const wxMemoryBuffer m_data;
+
+    wxDECLARE_NO_COPY_CLASS(wxArchiveFSCachedStream);
+};
+
+// Read all the data of the current entry of the given archive stream.
+static bool wxReadArchiveEntry(wxInputStream& stream,
+                               size_t size,
+                               wxMemoryBuffer& data)
+{
+    void * const buf = data.GetWriteBuf(size);
+    const size_t read = size ? stream.Read(buf, size).LastRead() : 0;
+    data.UngetWriteBuf(read);
+
+    if (read != size)
+        return false;
+
+    // try to read past the end to make the stream verify the data, e.g. its
+    // checksum, and to make sure the entry isn't bigger than expected
+    char ch;
+    return stream.Read(&ch, 1).LastRead() == 0 && stream.Eof();
+}
+
 //----------------------------------------------------------------------------
 // wxArchiveFSHandler
 //----------------------------------------------------------------------------
@@ -315,17 +521,39 @@ wxArchiveFSHandler::wxArchiveFSHandler()
     m_AllowDirs = m_AllowFiles = true;
     m_DirsFound = NULL;
     m_cache = NULL;
+    m_dataCache = new wxArchiveFSDataCache;
 }
 
 wxArchiveFSHandler::~wxArchiveFSHandler()
 {
     Cleanup();
     delete m_cache;
+    delete m_dataCache;
+}
+
+void wxArchiveFSHandler::SetCacheLimits(size_t maxEntrySize,
+                                        size_t maxTotalSize)
+{
+    m_dataCache->SetLimits(maxEntrySize, maxTotalSize);
+}
+
+wxArchiveFSCacheStats wxArchiveFSHandler::GetCacheStats() const
+{
+    wxArchiveFSCacheStats stats(m_stats);
+    stats.dataCount = m_dataCache->GetCount();
+    stats.dataSize = m_dataCache->GetSize();
+    return stats;
+}
+
+void wxArchiveFSHandler::ResetCacheStats()
+{
+    m_stats = wxArchiveFSCacheStats();
 }
 
 void wxArchiveFSHandler::Cleanup()
 {
     wxDELETE(m_DirsFound);
+    m_dataCache->Clear();
 }
 
 bool wxArchiveFSHandler::CanOpen(const wxString& location)
@@ -362,8 +590,14 @@ wxFSFile* wxArchiveFSHandler::OpenFile(
         return NULL;
 
     wxArchiveFSCacheData *cached = m_cache->Get(key);
-    if (!cached)
+    if (cached)
+    {
+        m_stats.archiveHits++;
+    }
+    else
     {
+        m_stats.archiveMisses++;
+
         wxFSFile *leftFile = m_fs.OpenFile(left);
         if (!leftFile)
             return NULL;
@@ -375,26 +609,57 @@ wxFSFile* wxArchiveFSHandler::OpenFile(
     if (!entry)
         return NULL;
 
-    wxInputStream *leftStream = cached->NewStream();
-    if (!leftStream)
+    wxInputStream *s;
+
+    wxMemoryBuffer data;
+    if (m_dataCache->Get(key + right, data))
     {
-        wxFSFile *leftFile = m_fs.OpenFile(left);
-        if (!leftFile)
-            return NULL;
-        leftStream = leftFile->DetachStream();
-        delete leftFile;
+        m_stats.dataHits++;
+
+        s = new wxArchiveFSCachedStream(data);
     }
+    else
+    {
+        m_stats.dataMisses++;
 
-    wxArchiveInputStream *s = factory->NewStream(leftStream);
-    if ( !s )
-        return NULL;
+        wxInputStream *leftStream = cached->NewStream();
+        if (!leftStream)
+        {
+            wxFSFile *leftFile = m_fs.OpenFile(left);
+            if (!leftFile)
+                return NULL;
+            leftStream = leftFile->DetachStream();
+            delete leftFile;
+        }
 
-    s->OpenEntry(*entry);
+        wxArchiveInputStream *arc = factory->NewStream(leftStream);
+        if ( !arc )
+            return NULL;
 
-    if (!s->IsOk())
-    {
-        delete s;
-        return NULL;
+        arc->OpenEntry(*entry);
+
+        if (!arc->IsOk())
+        {
+            delete arc;
+            return NULL;
+        }
+
+        s = arc;
+
+        // read the small entries entirely to be able to reuse their data
+        const wxFileOffset size = entry->GetSize();
+        if (m_dataCache->CanCache(size))
+        {
+            const bool
+                ok = wxReadArchiveEntry(*arc, static_cast<size_t>(size), data);
+            delete arc;
+
+            if (!ok)
+                return NULL;
+
+            m_dataCache->Add(key + right, data);
+            s = new wxArchiveFSCachedStream(data);
+        }
     }
 
     return new wxFSFile(s,
@@ -425,8 +690,14 @@ wxString wxArchiveFSHandler::FindFirst(const wxString& spec, int flags)
         return wxEmptyString;
 
     m_Archive = m_cache->Get(key);
-    if (!m_Archive)
+    if (m_Archive)
     {
+        m_stats.archiveHits++;
+    }
+    else
+    {
+        m_stats.archiveMisses++;
+
         wxFSFile *leftFile = m_fs.OpenFile(left);
         if (!leftFile)
             return wxEmptyString;
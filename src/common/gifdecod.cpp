@@ -25,6 +25,7 @@
 #include <stdlib.h>
 #include <string.h>
 #include "wx/gifdecod.h"
+#include "wx/mstream.h"
 #include "wx/scopedarray.h"
 #include "wx/scopedptr.h"
 #include "wx/scopeguard.h"
@@ -60,11 +61,15 @@ public:
     int transparent;                // transparent color index (-1 = none)
     wxAnimationDisposal disposal;   // disposal method
     long delay;                     // delay in ms (-1 = unused)
-    unsigned char *p;               // bitmap
+    unsigned char *p;               // bitmap (NULL if not decoded yet)
     unsigned char *pal;             // palette
     unsigned int ncolours;          // number of colours
     wxString comment;
 
+    int bits;                       // initial LZW code size
+    int interl;                     // interlaced image (1) or not (0)
+    wxMemoryBuffer data;            // LZW-compressed data sub-blocks
+
     wxDECLARE_NO_COPY_CLASS(GIFImage);
 };
 
@@ -87,6 +92,8 @@ GIFImage::GIFImage()
     p = (unsigned char *) NULL;
     pal = (unsigned char *) NULL;
     ncolours = 0;
+    bits = 0;
+    interl = 0;
 }
 
 //---------------------------------------------------------------------------
@@ -95,6 +102,8 @@ GIFImage::GIFImage()
 
 wxGIFDecoder::wxGIFDecoder()
 {
+    m_maxCacheSize = 16*1024*1024;
+    m_cacheSize = 0;
 }
 
 wxGIFDecoder::~wxGIFDecoder()
@@ -115,6 +124,73 @@ void wxGIFDecoder::Destroy()
 
     m_frames.Clear();
     m_nFrames = 0;
+
+    m_cachedFrames.clear();
+    m_cacheSize = 0;
+}
+
+void wxGIFDecoder::SetMaxCacheSize(size_t bytes)
+{
+    m_maxCacheSize = bytes;
+
+    ShrinkCache(0);
+}
+
+void wxGIFDecoder::ShrinkCache(size_t sizeNeeded) const
+{
+    // Discard the least recently used frames until the new one fits, but
+    // always keep the most recently used one as its data may be in use.
+    while ( m_cachedFrames.size() > 1 &&
+                m_cacheSize + sizeNeeded > m_maxCacheSize )
+    {
+        GIFImage * const f = GetFrame(m_cachedFrames[0]);
+        m_cacheSize -= f->w * f->h;
+        free(f->p);
+        f->p = NULL;
+
+        m_cachedFrames.erase(m_cachedFrames.begin());
+    }
+}
+
+wxGIFErrorCode wxGIFDecoder::DecodeFrame(unsigned int frame) const
+{
+    GIFImage * const f = GetFrame(frame);
+
+    if ( f->p )
+    {
+        // Just mark it as the most recently used one.
+        for ( size_t n = 0; n < m_cachedFrames.size(); n++ )
+        {
+            if ( m_cachedFrames[n] == frame )
+            {
+                m_cachedFrames.erase(m_cachedFrames.begin() + n);
+                break;
+            }
+        }
+
+        m_cachedFrames.push_back(frame);
+
+        return wxGIF_OK;
+    }
+
+    const size_t size = f->w * f->h;
+
+    ShrinkCache(size);
+
+    f->p = (unsigned char *) malloc(size);
+    if ( !f->p )
+        return wxGIF_MEMERR;
+
+    // The pixels not present in the compressed data, e.g. because it was
+    // truncated, are shown as transparent if possible.
+    memset(f->p, f->transparent == -1 ? 0 : f->transparent, size);
+
+    m_cachedFrames.push_back(frame);
+    m_cacheSize += size;
+
+    wxMemoryInputStream stream(f->data.GetData(), f->data.GetDataLen());
+
+    return wxConstCast(this, wxGIFDecoder)->dgif(stream, f, f->interl, f->bits);
 }
 
 
@@ -145,6 +221,8 @@ bool wxGIFDecoder::ConvertToImage(unsigned int frame, wxImage *image) const
 
     pal = GetPalette(frame);
     src = GetData(frame);
+    if (!src)
+        return false;
     dst = image->GetData();
     transparent = GetTransparentColourIndex(frame);
 
@@ -276,7 +354,16 @@ wxColour wxGIFDecoder::GetTransparentColour(unsigned int frame) const
                     pal[n*3 + 2]);
 }
 
-unsigned char* wxGIFDecoder::GetData(unsigned int frame) const    { return (GetFrame(frame)->p); }
+unsigned char* wxGIFDecoder::GetData(unsigned int frame) const
+{
+    // Errors in the frames other than the first one, which is checked when
+    // loading, are ignored and the partially decoded frame is returned.
+    if ( DecodeFrame(frame) == wxGIF_MEMERR )
+        return NULL;
+
+    return GetFrame(frame)->p;
+}
+
 unsigned char* wxGIFDecoder::GetPalette(unsigned int frame) const { return (GetFrame(frame)->pal); }
 unsigned int wxGIFDecoder::GetNcolours(unsigned int frame) const  { return (GetFrame(frame)->ncolours); }
 int wxGIFDecoder::GetTransparentColourIndex(unsigned int frame) const  { return (GetFrame(frame)->transparent); }
@@ -623,9 +710,8 @@ bool wxGIFDecoder::DoCanRead(wxInputStream &stream) const
 wxGIFErrorCode wxGIFDecoder::LoadGIF(wxInputStream& stream)
 {
     unsigned int  global_ncolors = 0;
-    int           bits, interl, i;
+    int           i;
     wxAnimationDisposal disposal;
-    long          size;
     long          delay;
     unsigned char type = 0;
     unsigned char pal[768];
@@ -834,18 +920,17 @@ wxGIFErrorCode wxGIFDecoder::LoadGIF(wxInputStream& stream)
                     }
                 }
 
-                interl = ((buf[8] & 0x40)? 1 : 0);
-                size = pimg->w * pimg->h;
+                pimg->interl = ((buf[8] & 0x40)? 1 : 0);
 
                 pimg->transparent = transparent;
                 pimg->disposal = disposal;
                 pimg->delay = delay;
 
-                // allocate memory for image and palette
-                pimg->p   = (unsigned char *) malloc((unsigned int)size);
+                // allocate memory for the palette, the image itself is only
+                // allocated when it's decoded
                 pimg->pal = (unsigned char *) malloc(768);
 
-                if ((!pimg->p) || (!pimg->pal))
+                if (!pimg->pal)
                     return wxGIF_MEMERR;
 
                 // load local color map if available, else use global map
@@ -865,21 +950,51 @@ wxGIFErrorCode wxGIFDecoder::LoadGIF(wxInputStream& stream)
                 }
 
                 // get initial code size from first byte in raster data
-                bits = stream.GetC();
-                if (bits == 0)
+                pimg->bits = stream.GetC();
+                if (pimg->bits == 0)
                     return wxGIF_INVFORMAT;
 
-                // decode image
-                wxGIFErrorCode result = dgif(stream, pimg.get(), interl, bits);
-                if (result != wxGIF_OK)
-                    return result;
+                // Don't decode the image yet, this is done on demand by
+                // DecodeFrame(), just store the compressed data sub-blocks,
+                // which are usually much smaller than the decoded frame.
+                wxMemoryBuffer& data = pimg->data;
+                for ( ;; )
+                {
+                    i = stream.GetC();
+                    if (stream.Eof() || (stream.LastRead() == 0))
+                    {
+                        // truncated image, decode as much as we can
+                        data.AppendByte(0);
+                        break;
+                    }
 
-                guardDestroy.Dismiss();
+                    data.AppendByte((char)i);
+                    if (i == 0)
+                        break;
+
+                    stream.Read(data.GetAppendBuf(i), i);
+                    data.UngetAppendBuf(stream.LastRead());
+                    if ((int)stream.LastRead() != i)
+                    {
+                        data.AppendByte(0);
+                        break;
+                    }
+                }
 
                 // add the image to our frame array
                 m_frames.Add(pimg.release());
                 m_nFrames++;
 
+                // decode the first frame immediately to detect invalid files
+                if (m_nFrames == 1)
+                {
+                    wxGIFErrorCode result = DecodeFrame(0);
+                    if (result != wxGIF_OK)
+                        return result;
+                }
+
+                guardDestroy.Dismiss();
+
                 // if this is not an animated GIF, exit after first image
                 if (!anim)
                     done = true;
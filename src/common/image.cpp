@@ -30,6 +30,7 @@
 
 #include "wx/wfstream.h"
 #include "wx/xpmdecod.h"
+#include "wx/private/pixelconv.h"
 
 // For memcpy
 #include <string.h>
@@ -1763,19 +1764,10 @@ wxImage wxImage::ConvertToGreyscale(double weight_r, double weight_g, double wei
     if (hasMask)
         image.SetMaskColour(mask_r, mask_g, mask_b);
 
-    const unsigned char* src = M_IMGDATA->m_data;
-    unsigned char* dst = image.GetData();
-    while (size--)
-    {
-        unsigned char r = *src++;
-        unsigned char g = *src++;
-        unsigned char b = *src++;
-        if (!hasMask || r != mask_r || g != mask_g || b != mask_b)
-            wxColour::MakeGrey(&r, &g, &b, weight_r, weight_g, weight_b);
-        *dst++ = r;
-        *dst++ = g;
-        *dst++ = b;
-    }
+    const unsigned char mask[] = { mask_r, mask_g, mask_b };
+    wxConvertRGBToGrey(image.GetData(), M_IMGDATA->m_data, size,
+                       weight_r, weight_g, weight_b,
+                       hasMask ? mask : NULL);
     return image;
 }
 
@@ -1836,19 +1828,10 @@ wxImage wxImage::ConvertToDisabled(unsigned char brightness) const
     if (hasMask)
         image.SetMaskColour(mask_r, mask_g, mask_b);
 
-    const unsigned char* src = M_IMGDATA->m_data;
-    unsigned char* dst = image.GetData();
-    while (size--)
-    {
-        unsigned char r = *src++;
-        unsigned char g = *src++;
-        unsigned char b = *src++;
-        if (!hasMask || r != mask_r || g != mask_g || b != mask_b)
-            wxColour::MakeDisabled(&r, &g, &b, brightness);
-        *dst++ = r;
-        *dst++ = g;
-        *dst++ = b;
-    }
+    const unsigned char mask[] = { mask_r, mask_g, mask_b };
+    wxConvertRGBToDisabled(image.GetData(), M_IMGDATA->m_data, size,
+                           brightness,
+                           hasMask ? mask : NULL);
     return image;
 }
 
@@ -2787,7 +2770,9 @@ bool wxImage::DoLoad(wxImageHandler& handler, wxInputStream& stream, int index)
         const unsigned widthOrig = GetWidth(),
                        heightOrig = GetHeight();
 
-        // this uses the same (trivial) algorithm as the JPEG handler
+        // halve the size until the image fits: notice that the handler may
+        // have already reduced it while loading, as the JPEG one does using
+        // libjpeg scaling by up to 1/8, so this only does the remaining part
         unsigned width = widthOrig,
                  height = heightOrig;
         while ( (maxWidth && width > maxWidth) ||
@@ -0,0 +1,563 @@
+///////////////////////////////////////////////////////////////////////////////
+// Name:        src/common/imageloader.cpp
+// Purpose:     wxImageLoader implementation
+// Author:      wxWidgets development team
+// Created:     2026-10-19
+// Copyright:   (c) 2026 wxWidgets development team
+// Licence:     wxWindows licence
+///////////////////////////////////////////////////////////////////////////////
+
+// ============================================================================
+// declarations
+// ============================================================================
+
+// ----------------------------------------------------------------------------
+// headers
+// ----------------------------------------------------------------------------
+
+// for compilers that support precompilation, includes "wx.h".
+#include "wx/wxprec.h"
+
+#ifdef __BORLANDC__
+    #pragma hdrstop
+#endif
+
+#if wxUSE_IMAGE && wxUSE_THREADS && wxUSE_STREAMS
+
+#include "wx/imageloader.h"
+
+#ifndef WX_PRECOMP
+    #include "wx/intl.h"
+    #include "wx/log.h"
+#endif // WX_PRECOMP
+
+#include "wx/stream.h"
+
+// ----------------------------------------------------------------------------
+// wxImageLoaderRequest: a single image to load
+// ----------------------------------------------------------------------------
+
+class wxImageLoaderRequest
+{
+public:
+    wxImageLoaderRequest(const wxString& filename,
+                         wxInputStream *stream,
+                         int priority,
+                         wxBitmapType type)
+        : m_filename(filename.Clone()),
+          m_stream(stream),
+          m_type(type),
+          m_priority(priority)
+    {
+        m_id = 0;
+        m_sequence = 0;
+        m_maxWidth =
+        m_maxHeight = 0;
+        m_memoryReserved = 0;
+        m_cancelled = false;
+    }
+
+    ~wxImageLoaderRequest()
+    {
+        delete m_stream;
+    }
+
+    // Load the image: this is called from a worker thread.
+    void Process()
+    {
+        // Don't log errors from the worker threads, the failure is reported
+        // by sending an event with an invalid image instead. Notice that
+        // disabling Load_Verbose is not enough as wxImage::LoadFile() and
+        // wxFile still log their errors, but wxLogNull only affects this
+        // thread when used in a worker thread.
+        wxLogNull noLog;
+
+        m_image.SetLoadFlags(m_image.GetLoadFlags() & ~wxImage::Load_Verbose);
+
+        if ( m_maxWidth )
+            m_image.SetOption(wxIMAGE_OPTION_MAX_WIDTH, m_maxWidth);
+        if ( m_maxHeight )
+            m_image.SetOption(wxIMAGE_OPTION_MAX_HEIGHT, m_maxHeight);
+
+        if ( m_stream )
+        {
+            if ( !m_image.LoadFile(*m_stream, m_type) )
+                m_image = wxImage();
+
+            // We don't need the stream any more, so free it as soon as
+            // possible, this may e.g. close the underlying file.
+            wxDELETE(m_stream);
+        }
+        else
+        {
+            if ( !m_image.LoadFile(m_filename, m_type) )
+                m_image = wxImage();
+        }
+    }
+
+    // Return the memory used by the image data.
+    size_t GetMemoryUsed() const
+    {
+        if ( !m_image.IsOk() )
+            return 0;
+
+        const size_t pixels = static_cast<size_t>(m_image.GetWidth())*
+                                m_image.GetHeight();
+
+        return m_image.HasAlpha() ? 4*pixels : 3*pixels;
+    }
+
+    // Return true if this request should be processed before the other one.
+    bool IsBefore(const wxImageLoaderRequest& other) const
+    {
+        if ( m_priority != other.m_priority )
+            return m_priority > other.m_priority;
+
+        return m_sequence < other.m_sequence;
+    }
+
+
+    const wxString m_filename;
+    wxInputStream *m_stream;
+    const wxBitmapType m_type;
+
+    int m_id;
+    int m_priority;
+    unsigned long m_sequence;
+    int m_maxWidth,
+        m_maxHeight;
+
+    // The memory reserved for this request when it started loading.
+    size_t m_memoryReserved;
+
+    // Set if the request is cancelled while it's being processed.
+    bool m_cancelled;
+
+    wxImage m_image;
+
+    wxDECLARE_NO_COPY_CLASS(wxImageLoaderRequest);
+};
+
+namespace
+{
+
+// Return the index of the request with the given id in the vector or -1.
+int
+FindRequest(const wxVector<wxImageLoaderRequest *>& requests, int requestId)
+{
+    for ( size_t n = 0; n < requests.size(); n++ )
+    {
+        if ( requests[n]->m_id == requestId )
+            return static_cast<int>(n);
+    }
+
+    return -1;
+}
+
+void DeleteRequests(wxVector<wxImageLoaderRequest *>& requests)
+{
+    for ( size_t n = 0; n < requests.size(); n++ )
+        delete requests[n];
+
+    requests.clear();
+}
+
+} // anonymous namespace
+
+// ----------------------------------------------------------------------------
+// wxImageLoaderThread: worker thread loading the images
+// ----------------------------------------------------------------------------
+
+class wxImageLoaderThread : public wxThread
+{
+public:
+    explicit wxImageLoaderThread(wxImageLoader& loader)
+        : wxThread(wxTHREAD_JOINABLE),
+          m_loader(loader)
+    {
+    }
+
+protected:
+    virtual ExitCode Entry() wxOVERRIDE
+    {
+        for ( ;; )
+        {
+            wxImageLoaderRequest * const request = m_loader.GetNextRequest();
+            if ( !request )
+                break;
+
+            request->Process();
+
+            m_loader.OnRequestDone(request);
+        }
+
+        return NULL;
+    }
+
+private:
+    wxImageLoader& m_loader;
+
+    wxDECLARE_NO_COPY_CLASS(wxImageLoaderThread);
+};
+
+// ============================================================================
+// wxImageLoaderEvent implementation
+// ============================================================================
+
+wxDEFINE_EVENT(wxEVT_IMAGE_LOADED, wxImageLoaderEvent);
+
+wxIMPLEMENT_DYNAMIC_CLASS(wxImageLoaderEvent, wxEvent);
+
+// ============================================================================
+// wxImageLoader implementation
+// ============================================================================
+
+wxImageLoader::wxImageLoader(wxEvtHandler *handler, int id)
+    : m_handler(handler),
+      m_id(id),
+      m_condition(m_mutex)
+{
+    m_maxThreads = 0;
+    m_maxWidth =
+    m_maxHeight = 0;
+
+    m_lastRequestId = 0;
+    m_lastSequence = 0;
+
+    m_memoryUsed =
+    m_memoryReserved =
+    m_memoryLimit =
+    m_memoryBiggest = 0;
+
+    m_stopping = false;
+
+    Bind(wxEVT_THREAD, &wxImageLoader::OnThreadEvent, this);
+}
+
+wxImageLoader::~wxImageLoader()
+{
+    StopThreads();
+
+    DeleteRequests(m_pending);
+    DeleteRequests(m_done);
+}
+
+void wxImageLoader::SetMaxThreads(unsigned count)
+{
+    wxCHECK_RET( m_threads.empty(),
+                 "must be called before starting loading images" );
+
+    m_maxThreads = count;
+}
+
+void wxImageLoader::SetMemoryLimit(size_t bytes)
+{
+    wxMutexLocker lock(m_mutex);
+
+    m_memoryLimit = bytes;
+
+    // The threads waiting for the memory to become available may be able to
+    // continue now.
+    m_condition.Broadcast();
+}
+
+void wxImageLoader::SetMaxSize(int width, int height)
+{
+    wxMutexLocker lock(m_mutex);
+
+    m_maxWidth = width;
+    m_maxHeight = height;
+}
+
+int wxImageLoader::Load(const wxString& filename,
+                        int priority,
+                        wxBitmapType type)
+{
+    return DoLoad(new wxImageLoaderRequest(filename, NULL, priority, type));
+}
+
+int wxImageLoader::Load(wxInputStream *stream,
+                        int priority,
+                        wxBitmapType type)
+{
+    wxCHECK_MSG( stream, 0, "NULL stream" );
+
+    return DoLoad(new wxImageLoaderRequest(wxString(), stream, priority, type));
+}
+
+int wxImageLoader::DoLoad(wxImageLoaderRequest *request)
+{
+    int requestId;
+    {
+        wxMutexLocker lock(m_mutex);
+
+        request->m_maxWidth = m_maxWidth;
+        request->m_maxHeight = m_maxHeight;
+
+        requestId = ++m_lastRequestId;
+
+        request->m_id = requestId;
+        request->m_sequence = ++m_lastSequence;
+
+        m_pending.push_back(request);
+
+        m_condition.Signal();
+    }
+
+    StartThreadsIfNeeded();
+
+    return requestId;
+}
+
+bool wxImageLoader::SetPriority(int requestId, int priority)
+{
+    wxMutexLocker lock(m_mutex);
+
+    const int n = FindRequest(m_pending, requestId);
+    if ( n == -1 )
+        return false;
+
+    m_pending[n]->m_priority = priority;
+
+    return true;
+}
+
+bool wxImageLoader::Cancel(int requestId)
+{
+    wxMutexLocker lock(m_mutex);
+
+    int n = FindRequest(m_pending, requestId);
+    if ( n != -1 )
+    {
+        delete m_pending[n];
+        m_pending.erase(m_pending.begin() + n);
+        return true;
+    }
+
+    n = FindRequest(m_running, requestId);
+    if ( n != -1 )
+    {
+        // It will be deleted by the worker thread when it's done with it.
+        m_running[n]->m_cancelled = true;
+        return true;
+    }
+
+    n = FindRequest(m_done, requestId);
+    if ( n != -1 )
+    {
+        m_memoryUsed -= m_done[n]->GetMemoryUsed();
+        m_condition.Broadcast();
+
+        delete m_done[n];
+        m_done.erase(m_done.begin() + n);
+        return true;
+    }
+
+    return false;
+}
+
+void wxImageLoader::CancelAll()
+{
+    wxMutexLocker lock(m_mutex);
+
+    DeleteRequests(m_pending);
+
+    for ( size_t n = 0; n < m_running.size(); n++ )
+        m_running[n]->m_cancelled = true;
+
+    DeleteRequests(m_done);
+
+    m_memoryUsed = 0;
+    m_condition.Broadcast();
+}
+
+size_t wxImageLoader::GetPendingCount() const
+{
+    wxMutexLocker lock(m_mutex);
+
+    size_t count = m_pending.size() + m_done.size();
+    for ( size_t n = 0; n < m_running.size(); n++ )
+    {
+        if ( !m_running[n]->m_cancelled )
+            count++;
+    }
+
+    return count;
+}
+
+wxImageLoaderRequest *wxImageLoader::GetNextRequest()
+{
+    wxMutexLocker lock(m_mutex);
+
+    for ( ;; )
+    {
+        if ( m_stopping )
+            return NULL;
+
+        if ( !m_pending.empty() && HasMemoryFor(EstimateMemory()) )
+            break;
+
+        m_condition.Wait();
+    }
+
+    size_t best = 0;
+    for ( size_t n = 1; n < m_pending.size(); n++ )
+    {
+        if ( m_pending[n]->IsBefore(*m_pending[best]) )
+            best = n;
+    }
+
+    wxImageLoaderRequest * const request = m_pending[best];
+    m_pending.erase(m_pending.begin() + best);
+    m_running.push_back(request);
+
+    // Account for the image being loaded right now, as we don't want to
+    // exceed the limit by the size of all the images loaded concurrently.
+    request->m_memoryReserved = EstimateMemory();
+    m_memoryReserved += request->m_memoryReserved;
+
+    return request;
+}
+
+void wxImageLoader::OnRequestDone(wxImageLoaderRequest *request)
+{
+    {
+        wxMutexLocker lock(m_mutex);
+
+        m_running.erase(m_running.begin() + FindRequest(m_running, request->m_id));
+
+        m_memoryReserved -= request->m_memoryReserved;
+
+        const size_t memory = request->GetMemoryUsed();
+        if ( memory > m_memoryBiggest )
+            m_memoryBiggest = memory;
+
+        // The actual size may be smaller than the reserved one, so the
+        // threads waiting for memory may be able to continue.
+        m_condition.Broadcast();
+
+        if ( request->m_cancelled || m_stopping )
+        {
+            delete request;
+            return;
+        }
+
+        m_done.push_back(request);
+        m_memoryUsed += memory;
+    }
+
+    // Wake up the main thread to deliver the image to the handler.
+    wxQueueEvent(this, new wxThreadEvent());
+}
+
+void wxImageLoader::OnThreadEvent(wxThreadEvent& WXUNUSED(event))
+{
+    wxVector<wxImageLoaderRequest *> done;
+    {
+        wxMutexLocker lock(m_mutex);
+
+        if ( m_done.empty() )
+            return;
+
+        done.swap(m_done);
+
+        m_memoryUsed = 0;
+        m_condition.Broadcast();
+    }
+
+    for ( size_t n = 0; n < done.size(); n++ )
+    {
+        wxImageLoaderRequest * const request = done[n];
+
+        wxImageLoaderEvent event(wxEVT_IMAGE_LOADED,
+                                 m_id,
+                                 request->m_id,
+                                 request->m_filename,
+                                 request->m_image);
+        event.SetEventObject(this);
+
+        delete request;
+
+        m_handler->SafelyProcessEvent(event);
+    }
+}
+
+size_t wxImageLoader::EstimateMemory() const
+{
+    // We can't know the size of the image before loading it, so use the
+    // biggest possible size if we have it or the size of the biggest image
+    // loaded so far otherwise.
+    if ( m_maxWidth > 0 && m_maxHeight > 0 )
+        return 4*static_cast<size_t>(m_maxWidth)*m_maxHeight;
+
+    return m_memoryBiggest;
+}
+
+bool wxImageLoader::HasMemoryFor(size_t size) const
+{
+    if ( !m_memoryLimit )
+        return true;
+
+    const size_t used = m_memoryUsed + m_memoryReserved;
+
+    // Always allow loading a single image, even if it's bigger than the limit,
+    // as we would never be able to load it otherwise.
+    if ( !used )
+        return true;
+
+    // If we don't know how much memory the image needs, wait until the images
+    // being loaded are done to find it out.
+    if ( !size )
+        return false;
+
+    return used + size <= m_memoryLimit;
+}
+
+void wxImageLoader::StartThreadsIfNeeded()
+{
+    if ( !m_threads.empty() )
+        return;
+
+    int count = m_maxThreads;
+    if ( !count )
+    {
+        count = wxThread::GetCPUCount();
+        if ( count < 1 )
+            count = 1;
+    }
+
+    for ( int n = 0; n < count; n++ )
+    {
+        wxImageLoaderThread * const thread = new wxImageLoaderThread(*this);
+        if ( thread->Run() != wxTHREAD_NO_ERROR )
+        {
+            delete thread;
+            break;
+        }
+
+        m_threads.push_back(thread);
+    }
+
+    if ( m_threads.empty() )
+        wxLogError(_("Failed to start image loading threads."));
+}
+
+void wxImageLoader::StopThreads()
+{
+    {
+        wxMutexLocker lock(m_mutex);
+
+        m_stopping = true;
+        m_condition.Broadcast();
+    }
+
+    for ( size_t n = 0; n < m_threads.size(); n++ )
+    {
+        m_threads[n]->Wait();
+        delete m_threads[n];
+    }
+
+    m_threads.clear();
+}
+
+#endif // wxUSE_IMAGE && wxUSE_THREADS && wxUSE_STREAMS
@@ -284,10 +284,26 @@ bool wxJPEGHandler::LoadFile( wxImage *image, wxInputStream& stream, bool verbos
     // scale the picture to fit in the specified max size if necessary
     if ( maxWidth > 0 || maxHeight > 0 )
     {
+        // libjpeg can scale the image down by 1/2, 1/4 or 1/8 directly in the
+        // DCT domain, which is much faster and uses much less memory than
+        // decoding the full image. Use the smallest such scale factor which
+        // makes the image fit, or 1/8 if none does: in the latter case the
+        // rest of the work will be done by Rescale() in wxImage::DoLoad().
+        //
+        // Notice that we must use jpeg_calc_output_dimensions() instead of
+        // just dividing the size by the scale as libjpeg rounds it up.
         unsigned& scale = cinfo.scale_denom;
-        while ( (maxWidth && (cinfo.image_width / scale > maxWidth)) ||
-                    (maxHeight && (cinfo.image_height / scale > maxHeight)) )
+        for ( ;; )
         {
+            jpeg_calc_output_dimensions( &cinfo );
+
+            if ( (!maxWidth || cinfo.output_width <= maxWidth) &&
+                    (!maxHeight || cinfo.output_height <= maxHeight) )
+                break;
+
+            if ( scale == 8 )
+                break;
+
             scale *= 2;
         }
     }
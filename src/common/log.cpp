@@ -36,6 +36,7 @@
 #endif //WX_PRECOMP
 
 #include "wx/apptrait.h"
+#include "wx/atomic.h"
 #include "wx/datetime.h"
 #include "wx/file.h"
 #include "wx/msgout.h"
@@ -103,8 +104,38 @@ WX_DEFINE_LOG_CS(TraceMask);
 // and this one is used for GetComponentLevels()
 WX_DEFINE_LOG_CS(Levels);
 
+// this one protects gs_prevLog as the messages can be logged by the thread
+// writing them for wxLogAsync
+WX_DEFINE_LOG_CS(PreviousLog);
+
+// this one protects the changes of the active log target and the variables
+// below, it is only used by the other threads when the active target changes
+WX_DEFINE_LOG_CS(ActiveTarget);
+
+// the queues of all existing wxLogAsync objects
+wxVector<wxLogAsyncQueue*> gs_logAsyncQueues;
+
+// the queue of the active log target if it is a wxLogAsync or NULL
+wxLogAsyncQueue *gs_activeLogAsyncQueue = NULL;
+
+// incremented whenever gs_activeLogAsyncQueue changes, this is the only
+// variable used by the other threads without locking to check if they need
+// to update their cached copy of it: reading a stale value is harmless as it
+// just means that the thread keeps using the old queue a bit longer
+wxAtomicInt gs_logTargetSerial = 0;
+
 } // anonymous namespace
 
+// update gs_activeLogAsyncQueue after the active log target change, must be
+// called with GetActiveTargetCS() locked
+static void wxSetActiveLogAsyncQueue(const wxLog *logger);
+
+// queue the record logged from a thread other than the main one if the active
+// log target is a wxLogAsync
+static bool wxQueueLogAsyncRecordFromThread(wxLogLevel level,
+                                            const wxString& msg,
+                                            const wxLogRecordInfo& info);
+
 #endif // wxUSE_THREADS
 
 // ----------------------------------------------------------------------------
@@ -148,6 +179,9 @@ struct PreviousLogInfo
     unsigned numRepeated;
 };
 
+// NB: all accesses to it must be protected by GetPreviousLogCS(), but this
+//     critical section must not be held while calling DoLogRecord() as it
+//     could result in a deadlock with the locks used by the log target
 PreviousLogInfo gs_prevLog;
 
 
@@ -257,37 +291,47 @@ wxLogFormatter::FormatTime(time_t t) const
 
 unsigned wxLog::LogLastRepeatIfNeeded()
 {
-    const unsigned count = gs_prevLog.numRepeated;
-
-    if ( gs_prevLog.numRepeated )
+    unsigned count;
+    wxLogLevel level;
+    wxLogRecordInfo info;
     {
-        wxString msg;
-#if wxUSE_INTL
-        if ( gs_prevLog.numRepeated == 1 )
-        {
-            // We use a separate message for this case as "repeated 1 time"
-            // looks somewhat strange.
-            msg = _("The previous message repeated once.");
-        }
-        else
-        {
-            // Notice that we still use wxPLURAL() to ensure that multiple
-            // numbers of times are correctly formatted, even though we never
-            // actually use the singular string.
-            msg.Printf(wxPLURAL("The previous message repeated %u time.",
-                                "The previous message repeated %u times.",
-                                gs_prevLog.numRepeated),
-                       gs_prevLog.numRepeated);
-        }
-#else
-        msg.Printf(wxS("The previous message was repeated %u time(s)."),
-                   gs_prevLog.numRepeated);
-#endif
+        wxCRIT_SECT_LOCKER(lock, GetPreviousLogCS());
+
+        count = gs_prevLog.numRepeated;
+        if ( !count )
+            return 0;
+
+        level = gs_prevLog.level;
+        info = gs_prevLog.info;
+
         gs_prevLog.numRepeated = 0;
         gs_prevLog.msg.clear();
-        DoLogRecord(gs_prevLog.level, msg, gs_prevLog.info);
     }
 
+    wxString msg;
+#if wxUSE_INTL
+    if ( count == 1 )
+    {
+        // We use a separate message for this case as "repeated 1 time"
+        // looks somewhat strange.
+        msg = _("The previous message repeated once.");
+    }
+    else
+    {
+        // Notice that we still use wxPLURAL() to ensure that multiple
+        // numbers of times are correctly formatted, even though we never
+        // actually use the singular string.
+        msg.Printf(wxPLURAL("The previous message repeated %u time.",
+                            "The previous message repeated %u times.",
+                            count),
+                   count);
+    }
+#else
+    msg.Printf(wxS("The previous message was repeated %u time(s)."),
+               count);
+#endif
+    DoLogRecord(level, msg, info);
+
     return count;
 }
 
@@ -295,6 +339,7 @@ wxLog::~wxLog()
 {
     // Flush() must be called before destroying the object as otherwise some
     // messages could be lost
+    wxCRIT_SECT_LOCKER(lock, GetPreviousLogCS());
     if ( gs_prevLog.numRepeated )
     {
         wxMessageOutputDebug().Printf
@@ -357,10 +402,14 @@ wxLog::OnLog(wxLogLevel level,
         logger = wxThreadInfo.logger;
         if ( !logger )
         {
+            // wxLogAsync handles the messages from any thread itself
+            if ( wxQueueLogAsyncRecordFromThread(level, msg, info) )
+                return;
+
             if ( ms_pLogger )
             {
-                // buffer the messages until they can be shown from the main
-                // thread
+                // otherwise buffer the messages until they can be shown from
+                // the main thread
                 wxCriticalSectionLocker lock(GetBackgroundLogCS());
 
                 gs_bufferedLogRecords.push_back(wxLogRecord(level, msg, info));
@@ -384,6 +433,9 @@ wxLog::OnLog(wxLogLevel level,
             return;
     }
 
+    if ( logger->DoQueueRecord(level, msg, info) )
+        return;
+
     logger->CallDoLogNow(level, msg, info);
 }
 
@@ -394,18 +446,23 @@ wxLog::CallDoLogNow(wxLogLevel level,
 {
     if ( GetRepetitionCounting() )
     {
-        if ( msg == gs_prevLog.msg )
         {
-            gs_prevLog.numRepeated++;
+            wxCRIT_SECT_LOCKER(lock, GetPreviousLogCS());
 
-            // nothing else to do, in particular, don't log the
-            // repeated message
-            return;
+            if ( msg == gs_prevLog.msg )
+            {
+                gs_prevLog.numRepeated++;
+
+                // nothing else to do, in particular, don't log the
+                // repeated message
+                return;
+            }
         }
 
         LogLastRepeatIfNeeded();
 
         // reset repetition counter for a new message
+        wxCRIT_SECT_LOCKER(lock, GetPreviousLogCS());
         gs_prevLog.msg = msg;
         gs_prevLog.level = level;
         gs_prevLog.info = info;
@@ -524,10 +581,15 @@ wxLog *wxLog::GetMainThreadActiveTarget()
             s_bInGetActiveTarget = true;
 
             // ask the application to create a log target for us
-            if ( wxTheApp != NULL )
-                ms_pLogger = wxTheApp->GetTraits()->CreateLogTarget();
-            else
-                ms_pLogger = new wxLogOutputBest;
+            wxLog * const logger = wxTheApp != NULL
+                                    ? wxTheApp->GetTraits()->CreateLogTarget()
+                                    : new wxLogOutputBest;
+
+#if wxUSE_THREADS
+            wxCriticalSectionLocker lock(GetActiveTargetCS());
+            wxSetActiveLogAsyncQueue(logger);
+#endif // wxUSE_THREADS
+            ms_pLogger = logger;
 
             s_bInGetActiveTarget = false;
 
@@ -546,6 +608,13 @@ wxLog *wxLog::SetActiveTarget(wxLog *pLogger)
         ms_pLogger->Flush();
     }
 
+#if wxUSE_THREADS
+    // after this, the other threads don't queue their records in the old
+    // logger any more, so it can be safely deleted by the caller
+    wxCriticalSectionLocker lock(GetActiveTargetCS());
+    wxSetActiveLogAsyncQueue(pLogger);
+#endif // wxUSE_THREADS
+
     wxLog *pOldLogger = ms_pLogger;
     ms_pLogger = pLogger;
 
@@ -754,7 +823,8 @@ void wxLog::FlushThreadMessages()
               it != bufferedLogRecords.end();
               ++it )
         {
-            CallDoLogNow(it->level, it->msg, it->info);
+            if ( !DoQueueRecord(it->level, it->msg, it->info) )
+                CallDoLogNow(it->level, it->msg, it->info);
         }
     }
 }
@@ -890,6 +960,586 @@ void wxLogStream::DoLogText(const wxString& msg)
 }
 #endif // wxUSE_STD_IOSTREAM
 
+// ----------------------------------------------------------------------------
+// wxLogAsync implementation
+// ----------------------------------------------------------------------------
+
+#if wxUSE_THREADS
+
+// All buffers used by the threads logging via the same wxLogAsync object.
+//
+// This object is reference counted as it is used not only by wxLogAsync
+// itself but also by the buffers of the threads logging using it and by the
+// threads which cached it as the queue of the active log target: this allows
+// them to keep using it without locking anything global, even if the log
+// target itself is destroyed in the meanwhile.
+class wxLogAsyncQueue
+{
+public:
+    wxLogAsyncQueue(const wxLog *log_, size_t maxPending_)
+        : log(log_),
+          maxPending(maxPending_),
+          numDropped(0),
+          closed(false),
+          m_refCount(1)
+    {
+    }
+
+    void IncRef() { wxAtomicInc(m_refCount); }
+
+    void DecRef()
+    {
+        if ( !wxAtomicDec(m_refCount) )
+            delete this;
+    }
+
+    // the log target using this queue, it must not be dereferenced and is
+    // only used to find the queue of the active log target
+    const wxLog* const log;
+
+    // the maximal number of records in each buffer
+    const size_t maxPending;
+
+    // posted to wake up the writing thread before the usual delay expires
+    wxSemaphore semWakeUp;
+
+    // protects all the fields below
+    wxCriticalSection cs;
+
+    wxVector<wxLogAsyncBuffer*> buffers;
+
+    // the total number of the records dropped so far
+    size_t numDropped;
+
+    // true if no more buffers can be added to this queue
+    bool closed;
+
+private:
+    // the buffers must have been released before this object is deleted
+    ~wxLogAsyncQueue() { }
+
+    wxAtomicInt m_refCount;
+
+    wxDECLARE_NO_COPY_CLASS(wxLogAsyncQueue);
+};
+
+void wxReleaseLogAsyncQueue(wxLogAsyncQueue *queue)
+{
+    if ( queue )
+        queue->DecRef();
+}
+
+// The buffer of the records logged by a single thread: it is referenced both
+// by the thread-specific information of this thread and by the queue of the
+// wxLogAsync object and is deleted when both of them release it.
+class wxLogAsyncBuffer
+{
+public:
+    explicit wxLogAsyncBuffer(wxLogAsyncQueue *queue_)
+        : queue(queue_),
+          numDropped(0),
+          released(false),
+          closed(false),
+          m_refCount(2)
+    {
+        queue->IncRef();
+    }
+
+    void DecRef()
+    {
+        if ( !wxAtomicDec(m_refCount) )
+            delete this;
+    }
+
+    // the queue this buffer belongs to
+    wxLogAsyncQueue* const queue;
+
+    // protects the fields below as they're modified by the logging thread
+    wxCriticalSection cs;
+
+    // the records not written yet
+    wxLogRecords records;
+
+    // the number of records dropped because there were too many of them
+    size_t numDropped;
+
+    // true if the thread doesn't use this buffer any more
+    bool released;
+
+    // true if the log target doesn't accept any more records
+    bool closed;
+
+    // the records being written, only used by the writing thread: it is
+    // swapped with the records above to avoid reallocating them every time
+    wxLogRecords writing;
+
+private:
+    ~wxLogAsyncBuffer()
+    {
+        queue->DecRef();
+    }
+
+    wxAtomicInt m_refCount;
+
+    wxDECLARE_NO_COPY_CLASS(wxLogAsyncBuffer);
+};
+
+void wxReleaseLogAsyncBuffer(wxLogAsyncBuffer *buffer)
+{
+    if ( !buffer )
+        return;
+
+    {
+        wxCriticalSectionLocker lock(buffer->cs);
+        buffer->released = true;
+    }
+
+    buffer->DecRef();
+}
+
+// The thread periodically writing the queued records.
+class wxLogAsyncThread : public wxThread
+{
+public:
+    wxLogAsyncThread(wxLogAsync *log, wxSemaphore& semWakeUp)
+        : wxThread(wxTHREAD_JOINABLE),
+          m_log(log),
+          m_semWakeUp(semWakeUp),
+          m_stop(false)
+    {
+    }
+
+    // stop the thread and wait until it terminates
+    void Stop()
+    {
+        {
+            wxCriticalSectionLocker lock(m_csStop);
+            m_stop = true;
+        }
+
+        m_semWakeUp.Post();
+
+        Wait();
+    }
+
+protected:
+    virtual ExitCode Entry() wxOVERRIDE
+    {
+        for ( ;; )
+        {
+            // the delay is short enough to not make the messages appear late
+            // but long enough to write many of them at once
+            m_semWakeUp.WaitTimeout(100);
+
+            {
+                wxCriticalSectionLocker lock(m_csStop);
+                if ( m_stop )
+                    break;
+            }
+
+            m_log->WriteQueued(false);
+        }
+
+        return NULL;
+    }
+
+private:
+    wxLogAsync* const m_log;
+
+    wxSemaphore& m_semWakeUp;
+
+    wxCriticalSection m_csStop;
+    bool m_stop;
+
+    wxDECLARE_NO_COPY_CLASS(wxLogAsyncThread);
+};
+
+namespace
+{
+
+// The formatter reusing the time stamp of the previous message if it was
+// logged during the same second, which is usually the case when a lot of
+// messages are logged. It is only used from the writing thread.
+class wxLogAsyncFormatter : public wxLogFormatter
+{
+public:
+    wxLogAsyncFormatter() : m_time(0) { }
+
+protected:
+    virtual wxString FormatTime(time_t t) const wxOVERRIDE
+    {
+        const wxString format = wxLog::GetTimestamp();
+        if ( t != m_time || format != m_format || m_str.empty() )
+        {
+            m_str = wxLogFormatter::FormatTime(t);
+            m_time = t;
+            m_format = format;
+        }
+
+        return m_str;
+    }
+
+private:
+    mutable time_t m_time;
+    mutable wxString m_format;
+    mutable wxString m_str;
+
+    wxDECLARE_NO_COPY_CLASS(wxLogAsyncFormatter);
+};
+
+// the size of the formatted messages after which they're written even if the
+// writing thread is still logging more of them
+const size_t wxLOG_ASYNC_BATCH_SIZE = 64*1024;
+
+// Queue the record in the buffer of the current thread for the given queue,
+// return false if the queue doesn't accept records any more.
+bool wxQueueLogAsyncRecord(wxLogAsyncQueue *queue,
+                           wxLogLevel level,
+                           const wxString& msg,
+                           const wxLogRecordInfo& info)
+{
+    wxLogAsyncBuffer*& buffer = wxThreadInfo.logAsyncBuffer;
+    if ( !buffer || buffer->queue != queue )
+    {
+        // this thread didn't log anything using this queue yet, release the
+        // buffer used for another one, if any, and create a new one
+        wxReleaseLogAsyncBuffer(buffer);
+
+        buffer = new wxLogAsyncBuffer(queue);
+
+        wxCriticalSectionLocker lock(queue->cs);
+        if ( queue->closed )
+        {
+            // the buffer is not used by the queue, so release its reference
+            buffer->closed = true;
+            buffer->DecRef();
+        }
+        else
+        {
+            queue->buffers.push_back(buffer);
+        }
+    }
+
+    size_t count;
+    {
+        wxCriticalSectionLocker lock(buffer->cs);
+
+        if ( buffer->closed )
+            return false;
+
+        count = buffer->records.size();
+        if ( count >= queue->maxPending )
+        {
+            buffer->numDropped++;
+            return true;
+        }
+
+        buffer->records.push_back(wxLogRecord(level, msg, info));
+    }
+
+    // don't wait until the buffer becomes full to write its contents
+    if ( count + 1 == (queue->maxPending + 1) / 2 )
+        queue->semWakeUp.Post();
+
+    return true;
+}
+
+} // anonymous namespace
+
+static void wxSetActiveLogAsyncQueue(const wxLog *logger)
+{
+    // must be called with GetActiveTargetCS() locked
+    wxLogAsyncQueue *queue = NULL;
+    for ( size_t n = 0; n < gs_logAsyncQueues.size(); n++ )
+    {
+        if ( gs_logAsyncQueues[n]->log == logger )
+        {
+            queue = gs_logAsyncQueues[n];
+            break;
+        }
+    }
+
+    if ( queue == gs_activeLogAsyncQueue )
+        return;
+
+    if ( queue )
+        queue->IncRef();
+    wxReleaseLogAsyncQueue(gs_activeLogAsyncQueue);
+    gs_activeLogAsyncQueue = queue;
+
+    // let the other threads know that they must update their cached queue
+    wxAtomicInc(gs_logTargetSerial);
+}
+
+static bool wxQueueLogAsyncRecordFromThread(wxLogLevel level,
+                                            const wxString& msg,
+                                            const wxLogRecordInfo& info)
+{
+    wxThreadSpecificInfo& threadInfo = wxThreadInfo;
+
+    // only lock if the active log target changed since this thread used it,
+    // which is rare, otherwise just use the queue we already have: it might
+    // be already deactivated or closed, but it can't be deleted
+    if ( threadInfo.logTargetSerial != gs_logTargetSerial )
+    {
+        wxCriticalSectionLocker lock(GetActiveTargetCS());
+
+        wxReleaseLogAsyncQueue(threadInfo.logAsyncQueue);
+        threadInfo.logAsyncQueue = gs_activeLogAsyncQueue;
+        if ( threadInfo.logAsyncQueue )
+            threadInfo.logAsyncQueue->IncRef();
+
+        threadInfo.logTargetSerial = gs_logTargetSerial;
+    }
+
+    return threadInfo.logAsyncQueue &&
+            wxQueueLogAsyncRecord(threadInfo.logAsyncQueue, level, msg, info);
+}
+
+wxLogAsync::wxLogAsync(FILE *fp, const wxMBConv& conv, size_t maxPending)
+          : wxMessageOutputStderr(fp ? fp : stderr, conv),
+            m_queue(new wxLogAsyncQueue(this, maxPending ? maxPending : 1)),
+            m_writing(false)
+{
+    delete SetFormatter(new wxLogAsyncFormatter);
+
+    m_thread = new wxLogAsyncThread(this, m_queue->semWakeUp);
+    if ( m_thread->Run() != wxTHREAD_NO_ERROR )
+    {
+        // we can still work, but will write all messages synchronously
+        delete m_thread;
+        m_thread = NULL;
+
+        m_queue->closed = true;
+        return;
+    }
+
+    // allow SetActiveTarget() to find our queue
+    wxCriticalSectionLocker lock(GetActiveTargetCS());
+    gs_logAsyncQueues.push_back(m_queue);
+}
+
+wxLogAsync::~wxLogAsync()
+{
+    {
+        wxCriticalSectionLocker lock(GetActiveTargetCS());
+
+        for ( size_t n = 0; n < gs_logAsyncQueues.size(); n++ )
+        {
+            if ( gs_logAsyncQueues[n] == m_queue )
+            {
+                gs_logAsyncQueues.erase(gs_logAsyncQueues.begin() + n);
+                break;
+            }
+        }
+
+        // we're normally not active any more, but check for it just in case
+        if ( gs_activeLogAsyncQueue == m_queue )
+            wxSetActiveLogAsyncQueue(NULL);
+    }
+
+    if ( m_thread )
+    {
+        m_thread->Stop();
+        delete m_thread;
+    }
+
+    // the threads which still have our queue can't add anything to it after
+    // this and will log their messages as for any other log target
+    {
+        wxCriticalSectionLocker lock(m_queue->cs);
+        m_queue->closed = true;
+
+        for ( size_t n = 0; n < m_queue->buffers.size(); n++ )
+        {
+            wxLogAsyncBuffer* const buffer = m_queue->buffers[n];
+
+            wxCriticalSectionLocker lockBuffer(buffer->cs);
+            buffer->closed = true;
+        }
+    }
+
+    // write everything logged until now, including the messages logged after
+    // the thread stopped
+    WriteQueued(true);
+
+    {
+        wxCriticalSectionLocker lock(m_queue->cs);
+
+        for ( size_t n = 0; n < m_queue->buffers.size(); n++ )
+            m_queue->buffers[n]->DecRef();
+
+        m_queue->buffers.clear();
+    }
+
+    m_queue->DecRef();
+}
+
+void wxLogAsync::Flush()
+{
+    WriteQueued(true);
+}
+
+size_t wxLogAsync::GetDroppedCount() const
+{
+    wxCriticalSectionLocker lock(m_queue->cs);
+
+    return m_queue->numDropped;
+}
+
+bool wxLogAsync::DoQueueRecord(wxLogLevel level,
+                               const wxString& msg,
+                               const wxLogRecordInfo& info)
+{
+    return wxQueueLogAsyncRecord(m_queue, level, msg, info);
+}
+
+void wxLogAsync::DoLogRecord(wxLogLevel level,
+                             const wxString& msg,
+                             const wxLogRecordInfo& info)
+{
+    wxCriticalSectionLocker lock(m_csWrite);
+
+    wxLog::DoLogRecord(level, msg, info);
+
+    // write the message immediately if it is logged directly, e.g. via
+    // wxLogChain, and not from WriteQueued()
+    if ( !m_writing )
+        WriteBatch();
+}
+
+void wxLogAsync::DoLogTextAtLevel(wxLogLevel WXUNUSED(level),
+                                  const wxString& msg)
+{
+    // unlike the base class, write the debug messages to the same file too
+    DoLogText(msg);
+}
+
+void wxLogAsync::DoLogText(const wxString& msg)
+{
+    const wxCharBuffer& buf = PrepareForOutput(msg);
+    m_batch.AppendData(buf, buf.length());
+
+    if ( m_batch.GetDataLen() >= wxLOG_ASYNC_BATCH_SIZE )
+        WriteBatch();
+}
+
+void wxLogAsync::WriteBatch()
+{
+    const size_t len = m_batch.GetDataLen();
+    if ( !len )
+        return;
+
+    fwrite(m_batch.GetData(), 1, len, m_fp);
+    fflush(m_fp);
+
+    m_batch.SetDataLen(0);
+}
+
+void wxLogAsync::WriteQueued(bool flush)
+{
+    wxCriticalSectionLocker lockWrite(m_csWrite);
+
+    m_writing = true;
+
+    // the buffers can only be removed from the queue by this function, so it's
+    // safe to use them without locking the queue
+    wxVector<wxLogAsyncBuffer*> buffers;
+    {
+        wxCriticalSectionLocker lock(m_queue->cs);
+        buffers = m_queue->buffers;
+    }
+
+    size_t numDropped = 0;
+    wxVector<wxLogAsyncBuffer*> unused;
+    for ( size_t n = 0; n < buffers.size(); n++ )
+    {
+        wxLogAsyncBuffer* const buffer = buffers[n];
+
+        bool released;
+        {
+            wxCriticalSectionLocker lock(buffer->cs);
+
+            buffer->records.swap(buffer->writing);
+
+            numDropped += buffer->numDropped;
+            buffer->numDropped = 0;
+
+            // no more records can be added to the buffer once it's released
+            released = buffer->released;
+        }
+
+        wxLogRecords& records = buffer->writing;
+        if ( !records.empty() )
+        {
+            for ( wxLogRecords::const_iterator it = records.begin();
+                  it != records.end();
+                  ++it )
+            {
+                CallDoLogNow(it->level, it->msg, it->info);
+            }
+
+            // keep the memory allocated for reusing it
+            records.erase(records.begin(), records.end());
+        }
+
+        if ( released )
+            unused.push_back(buffer);
+    }
+
+    if ( numDropped )
+    {
+        {
+            wxCriticalSectionLocker lock(m_queue->cs);
+            m_queue->numDropped += numDropped;
+        }
+
+        wxString msg;
+#if wxUSE_INTL
+        msg.Printf(wxPLURAL("%lu log message was dropped.",
+                            "%lu log messages were dropped.",
+                            numDropped),
+                   static_cast<unsigned long>(numDropped));
+#else
+        msg.Printf(wxS("%lu log message(s) were dropped."),
+                   static_cast<unsigned long>(numDropped));
+#endif
+
+        wxLogRecordInfo info;
+        info.timestamp = time(NULL);
+        info.threadId = wxThread::GetCurrentId();
+        CallDoLogNow(wxLOG_Warning, msg, info);
+    }
+
+    if ( flush )
+        wxLog::Flush();
+
+    WriteBatch();
+
+    if ( !unused.empty() )
+    {
+        wxCriticalSectionLocker lock(m_queue->cs);
+
+        for ( size_t n = 0; n < unused.size(); n++ )
+        {
+            for ( size_t i = 0; i < m_queue->buffers.size(); i++ )
+            {
+                if ( m_queue->buffers[i] == unused[n] )
+                {
+                    m_queue->buffers.erase(m_queue->buffers.begin() + i);
+                    break;
+                }
+            }
+
+            unused[n]->DecRef();
+        }
+    }
+
+    m_writing = false;
+}
+
+#endif // wxUSE_THREADS
+
 // ----------------------------------------------------------------------------
 // wxLogChain
 // ----------------------------------------------------------------------------
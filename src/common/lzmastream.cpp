@@ -213,13 +213,46 @@ size_t wxLZMAInputStream::OnSysRead(void* outbuf, size_t size)
 // wxLZMAOutputStream: compression
 // ----------------------------------------------------------------------------
 
-void wxLZMAOutputStream::Init(int level)
+void wxLZMAOutputStream::Init(int level, int threads, size_t blockSize)
 {
     if ( level == -1 )
         level = LZMA_PRESET_DEFAULT;
 
+    wxASSERT_MSG( threads >= 0, "invalid number of threads" );
+
+    lzma_ret rc = LZMA_PROG_ERROR;
+
+    // The multi-threaded encoder is only available since liblzma 5.2 and
+    // may be disabled when building it, fall back to the normal one then.
+#if LZMA_VERSION_MAJOR > 5 || \
+        (LZMA_VERSION_MAJOR == 5 && LZMA_VERSION_MINOR >= 2)
+    if ( threads == 0 )
+    {
+        threads = lzma_cputhreads();
+        if ( !threads )
+            threads = 1;
+    }
+
+    if ( threads > 1 )
+    {
+        lzma_mt mt;
+        memset(&mt, 0, sizeof(mt));
+        mt.threads = threads;
+        mt.block_size = blockSize;
+        mt.preset = level;
+        mt.check = LZMA_CHECK_CRC64;
+
+        rc = lzma_stream_encoder_mt(m_stream, &mt);
+    }
+#else
+    wxUnusedVar(threads);
+    wxUnusedVar(blockSize);
+#endif
+
     // Use the check type recommended by liblzma documentation.
-    const lzma_ret rc = lzma_easy_encoder(m_stream, level, LZMA_CHECK_CRC64);
+    if ( rc != LZMA_OK )
+        rc = lzma_easy_encoder(m_stream, level, LZMA_CHECK_CRC64);
+
     switch ( rc )
     {
         case LZMA_OK:
@@ -338,8 +371,15 @@ bool wxLZMAOutputStream::DoFlush(bool finish)
                 continue;
 
             case LZMA_STREAM_END:
-                // Don't forget to output the last part of the data.
-                return UpdateOutput();
+                // Don't forget to output the last part of the data and
+                // prepare the buffer for the subsequent writes, if any.
+                if ( !UpdateOutput() )
+                    return false;
+
+                m_stream->next_out = m_streamBuf;
+                m_stream->avail_out = wxLZMA_BUF_SIZE;
+
+                return true;
 
             case LZMA_MEM_ERROR:
                 err = wxTRANSLATE("out of memory");
@@ -364,9 +404,6 @@ bool wxLZMAOutputStream::Close()
     if ( !DoFlush(true) )
         return false;
 
-    m_stream->next_out = m_streamBuf;
-    m_stream->avail_out = wxLZMA_BUF_SIZE;
-
     return wxFilterOutputStream::Close() && IsOk();
 }
 
@@ -380,6 +417,9 @@ static wxLZMAClassFactory g_wxLZMAClassFactory;
 
 wxLZMAClassFactory::wxLZMAClassFactory()
 {
+    m_threads = 1;
+    m_blockSize = 0;
+
     if ( this == &g_wxLZMAClassFactory )
         PushFront();
 }
@@ -148,6 +148,29 @@ wxFileOffset wxMemoryInputStream::OnSysTell() const
     return m_i_streambuf->Tell();
 }
 
+const void *wxMemoryInputStream::DoPeekBuffer(size_t *size)
+{
+    if ( !m_i_streambuf || m_i_streambuf->GetIntPosition() == m_length )
+    {
+        m_lasterror = wxSTREAM_EOF;
+
+        return NULL;
+    }
+
+    *size = m_length - m_i_streambuf->GetIntPosition();
+
+    return m_i_streambuf->GetBufferPos();
+}
+
+void wxMemoryInputStream::DoConsumeBuffer(size_t size)
+{
+    const size_t pos = m_i_streambuf->GetIntPosition();
+    wxCHECK_RET( size <= m_length - pos,
+                 wxT("can't consume more than PeekBuffer() returned") );
+
+    m_i_streambuf->SetIntPosition(pos + size);
+}
+
 // ----------------------------------------------------------------------------
 // wxMemoryOutputStream
 // ----------------------------------------------------------------------------
@@ -0,0 +1,435 @@
+///////////////////////////////////////////////////////////////////////////////
+// Name:        src/common/pixelconv.cpp
+// Purpose:     Bulk conversion functions between different pixel formats
+// Author:      wxWidgets development team
+// Created:     2026-10-19
+// Copyright:   (c) 2026 wxWidgets development team
+// Licence:     wxWindows licence
+///////////////////////////////////////////////////////////////////////////////
+
+// ============================================================================
+// declarations
+// ============================================================================
+
+// ----------------------------------------------------------------------------
+// headers
+// ----------------------------------------------------------------------------
+
+// For compilers that support precompilation, includes "wx.h".
+#include "wx/wxprec.h"
+
+#ifdef __BORLANDC__
+    #pragma hdrstop
+#endif
+
+#ifndef WX_PRECOMP
+    #include "wx/colour.h"
+#endif // WX_PRECOMP
+
+#include "wx/math.h"
+
+#include "wx/private/pixelconv.h"
+
+// SSE2 is always available when targeting x86-64 and can be explicitly
+// enabled for 32 bit x86 builds. Notice that we don't use any more recent
+// instruction sets as this would require checking for their availability at
+// run-time.
+#if defined(__SSE2__) || defined(_M_X64) || \
+        (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+    #define wxHAS_SSE2_PIXELCONV
+    #include <emmintrin.h>
+#endif
+
+// ----------------------------------------------------------------------------
+// helpers
+// ----------------------------------------------------------------------------
+
+namespace
+{
+
+// These functions must give exactly the same results as the code converting
+// the pixels one by one which was used before, notably in wxGraphicsContext
+// Cairo implementation.
+inline unsigned Premultiply(unsigned alpha, unsigned data)
+{
+    return alpha ? (data * alpha) / 0xff : data;
+}
+
+// Return the multiplier used by Unpremultiply() below.
+inline wxUint32 GetUnpremultiplyFactor(unsigned alpha)
+{
+    // This is the smallest value allowing to compute (x*0xff)/alpha exactly
+    // as (x*0xff*factor) >> 24 for all x and alpha in 0..255 range.
+    return alpha ? ((1u << 24) + alpha - 1) / alpha : 0;
+}
+
+inline unsigned char Unpremultiply(wxUint32 factor, unsigned data)
+{
+    // Notice that the result may overflow if the data is not correctly
+    // premultiplied, but we intentionally truncate it in this case, just as
+    // (data*0xff)/alpha cast to unsigned char would do.
+    return factor ? static_cast<unsigned char>(
+                        (static_cast<wxUint64>(data * 0xff) * factor) >> 24)
+                  : static_cast<unsigned char>(data);
+}
+
+#ifdef wxHAS_SSE2_PIXELCONV
+
+// Return the register with the alpha of each of the 2 pixels stored in the
+// 16 bit lanes of the given one repeated in all lanes used by this pixel.
+inline __m128i BroadcastAlpha(__m128i pixels)
+{
+    return _mm_shufflehi_epi16(_mm_shufflelo_epi16(pixels, 0xff), 0xff);
+}
+
+// Divide all 16 bit lanes by 255 using the fact that x/255 == (x+1+x/256)/256
+// for all x in 0..255*255 range.
+inline __m128i DivideBy255(__m128i x)
+{
+    return _mm_srli_epi16(_mm_add_epi16(_mm_add_epi16(x, _mm_set1_epi16(1)),
+                                        _mm_srli_epi16(x, 8)), 8);
+}
+
+#endif // wxHAS_SSE2_PIXELCONV
+
+inline bool IsMaskColour(const unsigned char* p, const unsigned char* mask)
+{
+    return mask && p[0] == mask[0] && p[1] == mask[1] && p[2] == mask[2];
+}
+
+// Apply the given lookup table to all components of all pixels.
+void ConvertRGBUsingTable(unsigned char* dst,
+                          const unsigned char* src,
+                          size_t count,
+                          const unsigned char table[256],
+                          const unsigned char* mask)
+{
+    for ( ; count; count--, src += 3, dst += 3 )
+    {
+        if ( IsMaskColour(src, mask) )
+        {
+            dst[0] = src[0];
+            dst[1] = src[1];
+            dst[2] = src[2];
+        }
+        else
+        {
+            dst[0] = table[src[0]];
+            dst[1] = table[src[1]];
+            dst[2] = table[src[2]];
+        }
+    }
+}
+
+} // anonymous namespace
+
+// ============================================================================
+// implementation
+// ============================================================================
+
+void wxConvertRGBToRGBA(unsigned char* dst,
+                        const unsigned char* rgb,
+                        const unsigned char* alpha,
+                        size_t count)
+{
+    if ( alpha )
+    {
+        for ( ; count; count--, rgb += 3, dst += 4 )
+        {
+            dst[0] = rgb[0];
+            dst[1] = rgb[1];
+            dst[2] = rgb[2];
+            dst[3] = *alpha++;
+        }
+    }
+    else
+    {
+        for ( ; count; count--, rgb += 3, dst += 4 )
+        {
+            dst[0] = rgb[0];
+            dst[1] = rgb[1];
+            dst[2] = rgb[2];
+            dst[3] = 0xff;
+        }
+    }
+}
+
+void wxConvertRGBAToRGB(unsigned char* rgb,
+                        unsigned char* alpha,
+                        const unsigned char* src,
+                        size_t count)
+{
+    if ( alpha )
+    {
+        for ( ; count; count--, src += 4, rgb += 3 )
+        {
+            rgb[0] = src[0];
+            rgb[1] = src[1];
+            rgb[2] = src[2];
+            *alpha++ = src[3];
+        }
+    }
+    else
+    {
+        for ( ; count; count--, src += 4, rgb += 3 )
+        {
+            rgb[0] = src[0];
+            rgb[1] = src[1];
+            rgb[2] = src[2];
+        }
+    }
+}
+
+void wxConvertRGBToARGB32(wxUint32* dst,
+                          const unsigned char* rgb,
+                          const unsigned char* alpha,
+                          size_t count)
+{
+    wxUint32* const start = dst;
+
+    if ( alpha )
+    {
+        for ( size_t n = 0; n < count; n++, rgb += 3 )
+        {
+            *dst++ = static_cast<wxUint32>(*alpha++) << 24 |
+                     rgb[0] << 16 | rgb[1] << 8 | rgb[2];
+        }
+
+        // It's faster to premultiply all pixels at once as this can be done
+        // for several pixels in parallel.
+        wxPremultiplyARGB32(start, count);
+    }
+    else
+    {
+        for ( size_t n = 0; n < count; n++, rgb += 3 )
+        {
+            *dst++ = 0xff000000u | rgb[0] << 16 | rgb[1] << 8 | rgb[2];
+        }
+    }
+}
+
+void wxConvertARGB32ToRGB(unsigned char* rgb,
+                          unsigned char* alpha,
+                          const wxUint32* src,
+                          size_t count)
+{
+    if ( alpha )
+    {
+        // Computing the factor requires a division, so avoid doing it for
+        // every pixel as there are usually long runs of pixels with the same
+        // alpha, typically either opaque or fully transparent ones.
+        unsigned lastAlpha = 0;
+        wxUint32 factor = 0;
+
+        for ( ; count; count--, rgb += 3 )
+        {
+            const wxUint32 argb = *src++;
+
+            const unsigned a = argb >> 24;
+            *alpha++ = static_cast<unsigned char>(a);
+
+            if ( a == 0xff )
+            {
+                rgb[0] = static_cast<unsigned char>(argb >> 16);
+                rgb[1] = static_cast<unsigned char>(argb >> 8);
+                rgb[2] = static_cast<unsigned char>(argb);
+                continue;
+            }
+
+            if ( a != lastAlpha )
+            {
+                lastAlpha = a;
+                factor = GetUnpremultiplyFactor(a);
+            }
+
+            rgb[0] = Unpremultiply(factor, (argb >> 16) & 0xff);
+            rgb[1] = Unpremultiply(factor, (argb >> 8) & 0xff);
+            rgb[2] = Unpremultiply(factor, argb & 0xff);
+        }
+    }
+    else
+    {
+        for ( ; count; count--, rgb += 3 )
+        {
+            const wxUint32 argb = *src++;
+
+            rgb[0] = static_cast<unsigned char>(argb >> 16);
+            rgb[1] = static_cast<unsigned char>(argb >> 8);
+            rgb[2] = static_cast<unsigned char>(argb);
+        }
+    }
+}
+
+void wxPremultiplyARGB32(wxUint32* data, size_t count)
+{
+#ifdef wxHAS_SSE2_PIXELCONV
+    // Process 4 pixels at once: notice that x86 is little endian, so each
+    // pixel is stored as B, G, R and A bytes in memory.
+    const __m128i zero = _mm_setzero_si128();
+    const __m128i alphaMask = _mm_set1_epi32(static_cast<int>(0xff000000u));
+
+    for ( ; count >= 4; count -= 4, data += 4 )
+    {
+        const __m128i
+            orig = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data));
+
+        // Compute the products of the colour components with alpha in 16 bit
+        // lanes, 2 pixels per register.
+        __m128i lo = _mm_unpacklo_epi8(orig, zero);
+        __m128i hi = _mm_unpackhi_epi8(orig, zero);
+
+        lo = DivideBy255(_mm_mullo_epi16(lo, BroadcastAlpha(lo)));
+        hi = DivideBy255(_mm_mullo_epi16(hi, BroadcastAlpha(hi)));
+
+        __m128i result = _mm_packus_epi16(lo, hi);
+
+        // Restore the original alpha values.
+        result = _mm_or_si128(_mm_andnot_si128(alphaMask, result),
+                              _mm_and_si128(alphaMask, orig));
+
+        // And keep the fully transparent pixels unchanged.
+        const __m128i transparent =
+            _mm_cmpeq_epi32(_mm_and_si128(orig, alphaMask), zero);
+        result = _mm_or_si128(_mm_andnot_si128(transparent, result),
+                              _mm_and_si128(transparent, orig));
+
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(data), result);
+    }
+#endif // wxHAS_SSE2_PIXELCONV
+
+    for ( ; count; count--, data++ )
+    {
+        const wxUint32 argb = *data;
+        const unsigned a = argb >> 24;
+        if ( a == 0xff )
+            continue;
+
+        *data = (argb & 0xff000000u) |
+                Premultiply(a, (argb >> 16) & 0xff) << 16 |
+                Premultiply(a, (argb >> 8) & 0xff) << 8 |
+                Premultiply(a, argb & 0xff);
+    }
+}
+
+void wxComposeARGB32Over(wxUint32* dst, const wxUint32* src, size_t count)
+{
+#ifdef wxHAS_SSE2_PIXELCONV
+    const __m128i zero = _mm_setzero_si128();
+    const __m128i opaque = _mm_set1_epi16(0xff);
+    const __m128i alphaMask = _mm_set1_epi32(static_cast<int>(0xff000000u));
+
+    for ( ; count >= 4; count -= 4, src += 4, dst += 4 )
+    {
+        const __m128i
+            s = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src));
+        const __m128i
+            d = _mm_loadu_si128(reinterpret_cast<const __m128i*>(dst));
+
+        // Multiply all the destination components by the source transparency.
+        const __m128i sLo = _mm_unpacklo_epi8(s, zero);
+        const __m128i sHi = _mm_unpackhi_epi8(s, zero);
+
+        __m128i lo = _mm_unpacklo_epi8(d, zero);
+        __m128i hi = _mm_unpackhi_epi8(d, zero);
+
+        lo = DivideBy255(_mm_mullo_epi16(lo,
+                            _mm_sub_epi16(opaque, BroadcastAlpha(sLo))));
+        hi = DivideBy255(_mm_mullo_epi16(hi,
+                            _mm_sub_epi16(opaque, BroadcastAlpha(sHi))));
+
+        // Saturate the sum in case the source is not really premultiplied.
+        __m128i result = _mm_adds_epu8(_mm_packus_epi16(lo, hi), s);
+
+        // Keep the destination unchanged for fully transparent source pixels.
+        const __m128i transparent =
+            _mm_cmpeq_epi32(_mm_and_si128(s, alphaMask), zero);
+        result = _mm_or_si128(_mm_andnot_si128(transparent, result),
+                              _mm_and_si128(transparent, d));
+
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(dst), result);
+    }
+#endif // wxHAS_SSE2_PIXELCONV
+
+    for ( ; count; count--, src++, dst++ )
+    {
+        const wxUint32 s = *src;
+        const unsigned a = s >> 24;
+        if ( a == 0xff )
+        {
+            *dst = s;
+            continue;
+        }
+
+        if ( !a )
+            continue;
+
+        const wxUint32 d = *dst;
+        wxUint32 result = 0;
+        for ( int shift = 0; shift < 32; shift += 8 )
+        {
+            const unsigned c = ((s >> shift) & 0xff) +
+                                (((d >> shift) & 0xff) * (0xff - a)) / 0xff;
+            result |= static_cast<wxUint32>(c > 0xff ? 0xff : c) << shift;
+        }
+
+        *dst = result;
+    }
+}
+
+void wxConvertRGBToGrey(unsigned char* dst,
+                        const unsigned char* src,
+                        size_t count,
+                        double weight_r, double weight_g, double weight_b,
+                        const unsigned char* mask)
+{
+    // Precompute the products of all possible component values with their
+    // weights, this gives exactly the same result as wxColour::MakeGrey()
+    // while being much faster.
+    double lumaR[256],
+           lumaG[256],
+           lumaB[256];
+    for ( int i = 0; i < 256; i++ )
+    {
+        lumaR[i] = i * weight_r;
+        lumaG[i] = i * weight_g;
+        lumaB[i] = i * weight_b;
+    }
+
+    for ( ; count; count--, src += 3, dst += 3 )
+    {
+        if ( IsMaskColour(src, mask) )
+        {
+            dst[0] = src[0];
+            dst[1] = src[1];
+            dst[2] = src[2];
+        }
+        else
+        {
+            const double luma = lumaR[src[0]] + lumaG[src[1]] + lumaB[src[2]];
+            dst[0] =
+            dst[1] =
+            dst[2] = (wxByte)wxRound(luma);
+        }
+    }
+}
+
+void wxConvertRGBToDisabled(unsigned char* dst,
+                            const unsigned char* src,
+                            size_t count,
+                            unsigned char brightness,
+                            const unsigned char* mask)
+{
+    // Each component is transformed independently of the others, so we can
+    // just use a lookup table.
+    unsigned char table[256];
+    for ( int i = 0; i < 256; i++ )
+    {
+        unsigned char r = i,
+                      g = i,
+                      b = i;
+        wxColour::MakeDisabled(&r, &g, &b, brightness);
+        table[i] = r;
+    }
+
+    ConvertRGBUsingTable(dst, src, count, table, mask);
+}
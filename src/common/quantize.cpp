@@ -43,12 +43,17 @@
 #ifndef WX_PRECOMP
     #include "wx/palette.h"
     #include "wx/image.h"
+    #include "wx/utils.h"
 #endif
 
+#include "wx/thread.h"
+#include "wx/vector.h"
+
 #ifdef __WXMSW__
     #include "wx/msw/private.h"
 #endif
 
+#include <limits.h>
 #include <stdlib.h>
 #include <string.h>
 
@@ -78,6 +83,7 @@ typedef struct {
         int actual_number_of_colors;
         int desired_number_of_colors;
         JSAMPLE *sample_range_limit, *srl_orig;
+        bool dither;
 } j_decompress;
 
 #if defined(__WINDOWS__)
@@ -995,7 +1001,6 @@ fill_inverse_cmap (j_decompress_ptr cinfo, int c0, int c1, int c2)
  * Map some rows of pixels to the output colormapped representation.
  */
 
-#if 0
 void
 pass2_no_dither (j_decompress_ptr cinfo,
          JSAMPARRAY input_buf, JSAMPARRAY output_buf, int num_rows)
@@ -1028,7 +1033,6 @@ pass2_no_dither (j_decompress_ptr cinfo,
     }
   }
 }
-#endif
 
 void
 pass2_fs_dither (j_decompress_ptr cinfo,
@@ -1280,7 +1284,8 @@ start_pass_2_quant (j_decompress_ptr cinfo, bool is_pre_scan)
     cquantize->needs_zeroed = true; /* Always zero histogram */
   } else {
     /* Set up method pointers */
-    cquantize->pub.color_quantize = pass2_fs_dither;
+    cquantize->pub.color_quantize = cinfo->dither ? pass2_fs_dither
+                                                  : pass2_no_dither;
     cquantize->pub.finish_pass = finish_pass2;
 
     {
@@ -1413,6 +1418,835 @@ prepare_range_limit_table (j_decompress_ptr cinfo)
       cinfo->sample_range_limit, CENTERJSAMPLE * sizeof(JSAMPLE));
 }
 
+/*
+ * Octree quantizer.
+ *
+ * This is a faster alternative to the median cut algorithm above. The colours
+ * of the image are first counted in a histogram using 5 bits per component
+ * and then inserted into an octree in which each level corresponds to one bit
+ * of each of the components. The tree is then reduced, starting from its
+ * deepest level and merging the least used nodes first, until it has no more
+ * than the desired number of leaves which become the palette entries.
+ *
+ * Both the histogram computation and the mapping of the pixels to the palette
+ * entries when not dithering are done in parallel for the big images.
+ */
+
+const int OCTREE_BITS = 5;
+const int OCTREE_SHIFT = 8 - OCTREE_BITS;
+const int OCTREE_CELLS = 1 << (3*OCTREE_BITS);
+
+// Value used in the inverse colour map for the cells not computed yet.
+const wxUint16 OCTREE_NO_COLOUR = 0xffff;
+
+inline int GetOctreeCell(int r, int g, int b)
+{
+    return ((r >> OCTREE_SHIFT) << (2*OCTREE_BITS)) |
+           ((g >> OCTREE_SHIFT) << OCTREE_BITS) |
+            (b >> OCTREE_SHIFT);
+}
+
+// The histogram only stores the number of pixels in each cell, the cell
+// colour is taken to be the colour of its centre.
+typedef wxUint32 OctreeHistCell;
+
+inline int GetOctreeCellCentre(int cell, int shift)
+{
+    return (((cell >> shift) & ((1 << OCTREE_BITS) - 1)) << OCTREE_SHIFT) +
+                (1 << (OCTREE_SHIFT - 1));
+}
+
+// Base class for the operations performed on bands of image rows, possibly in
+// parallel.
+class RowsProcessor
+{
+public:
+    virtual ~RowsProcessor() { }
+
+    // Process the rows in [first, last) range, band is the index of the band
+    // these rows belong to.
+    virtual void ProcessRows(unsigned first, unsigned last, unsigned band) = 0;
+};
+
+#if wxUSE_THREADS
+
+class RowsThread : public wxThread
+{
+public:
+    RowsThread(RowsProcessor& processor,
+               unsigned first, unsigned last, unsigned band)
+        : wxThread(wxTHREAD_JOINABLE),
+          m_processor(processor),
+          m_first(first),
+          m_last(last),
+          m_band(band)
+    {
+    }
+
+protected:
+    virtual ExitCode Entry() wxOVERRIDE
+    {
+        m_processor.ProcessRows(m_first, m_last, m_band);
+
+        return NULL;
+    }
+
+private:
+    RowsProcessor& m_processor;
+    const unsigned m_first,
+                   m_last,
+                   m_band;
+
+    wxDECLARE_NO_COPY_CLASS(RowsThread);
+};
+
+#endif // wxUSE_THREADS
+
+// Return the number of bands to split the image of the given size into.
+unsigned GetBandsCount(unsigned w, unsigned h)
+{
+#if wxUSE_THREADS
+    // Using threads for small images is not worth it, the overhead of
+    // creating them would outweigh any gains.
+    static const wxUint64 MIN_PIXELS_PER_BAND = 256*1024;
+
+    wxUint64 bands = (static_cast<wxUint64>(w)*h) / MIN_PIXELS_PER_BAND;
+
+    // GetCPUCount() returns -1 if the number of CPUs is unknown.
+    const int numCPUs = wxThread::GetCPUCount();
+    const unsigned cpus = numCPUs > 0 ? numCPUs : 1;
+    if ( bands > cpus )
+        bands = cpus;
+    if ( bands > h )
+        bands = h;
+
+    return bands > 1 ? static_cast<unsigned>(bands) : 1;
+#else // !wxUSE_THREADS
+    wxUnusedVar(w);
+    wxUnusedVar(h);
+
+    return 1;
+#endif // wxUSE_THREADS/!wxUSE_THREADS
+}
+
+// Process all the rows using the given number of bands, each of which except
+// for the first one is processed by its own thread.
+void ProcessRowsInBands(RowsProcessor& processor, unsigned h, unsigned bands)
+{
+    const unsigned rowsPerBand = (h + bands - 1) / bands;
+
+#if wxUSE_THREADS
+    wxVector<RowsThread*> threads;
+    for ( unsigned band = 1; band < bands; band++ )
+    {
+        const unsigned first = band*rowsPerBand;
+        if ( first >= h )
+            break;
+
+        const unsigned last = wxMin(first + rowsPerBand, h);
+
+        RowsThread* const thread = new RowsThread(processor, first, last, band);
+        if ( thread->Run() != wxTHREAD_NO_ERROR )
+        {
+            // Just do it in this thread then.
+            delete thread;
+            processor.ProcessRows(first, last, band);
+            continue;
+        }
+
+        threads.push_back(thread);
+    }
+#endif // wxUSE_THREADS
+
+    processor.ProcessRows(0, wxMin(rowsPerBand, h), 0);
+
+#if wxUSE_THREADS
+    for ( size_t n = 0; n < threads.size(); n++ )
+    {
+        threads[n]->Wait();
+        delete threads[n];
+    }
+#endif // wxUSE_THREADS
+}
+
+// Computes the histogram of each band separately.
+class HistogramProcessor : public RowsProcessor
+{
+public:
+    HistogramProcessor(unsigned w, unsigned char **in_rows, unsigned bands)
+        : m_width(w),
+          m_inRows(in_rows),
+          m_histograms(bands)
+    {
+    }
+
+    virtual ~HistogramProcessor()
+    {
+        for ( size_t n = 0; n < m_histograms.size(); n++ )
+            free(m_histograms[n]);
+    }
+
+    virtual void ProcessRows(unsigned first, unsigned last, unsigned band) wxOVERRIDE
+    {
+        OctreeHistCell* const
+            hist = (OctreeHistCell*)calloc(OCTREE_CELLS, sizeof(OctreeHistCell));
+
+        for ( unsigned row = first; row < last; row++ )
+        {
+            const unsigned char* p = m_inRows[row];
+            for ( unsigned col = 0; col < m_width; col++, p += 3 )
+                hist[GetOctreeCell(p[0], p[1], p[2])]++;
+        }
+
+        m_histograms[band] = hist;
+    }
+
+    // Merge all histograms into the first one and return it.
+    const OctreeHistCell* GetResult()
+    {
+        OctreeHistCell* const result = m_histograms[0];
+        for ( size_t n = 1; n < m_histograms.size(); n++ )
+        {
+            const OctreeHistCell* const hist = m_histograms[n];
+            if ( !hist )
+                continue;
+
+            for ( int i = 0; i < OCTREE_CELLS; i++ )
+                result[i] += hist[i];
+        }
+
+        return result;
+    }
+
+private:
+    const unsigned m_width;
+    unsigned char ** const m_inRows;
+    wxVector<OctreeHistCell*> m_histograms;
+
+    wxDECLARE_NO_COPY_CLASS(HistogramProcessor);
+};
+
+class Octree
+{
+public:
+    explicit Octree(const OctreeHistCell* hist)
+    {
+        m_leaves = 0;
+
+        // Create the root node.
+        m_nodes.reserve(4096);
+        m_nodes.push_back(Node(0));
+
+        for ( int i = 0; i < OCTREE_CELLS; i++ )
+        {
+            const OctreeHistCell count = hist[i];
+            if ( !count )
+                continue;
+
+            const int r = i >> (2*OCTREE_BITS),
+                      g = (i >> OCTREE_BITS) & ((1 << OCTREE_BITS) - 1),
+                      b = i & ((1 << OCTREE_BITS) - 1);
+
+            const int rc = GetOctreeCellCentre(i, 2*OCTREE_BITS),
+                      gc = GetOctreeCellCentre(i, OCTREE_BITS),
+                      bc = GetOctreeCellCentre(i, 0);
+
+            size_t node = 0;
+            for ( int level = 0; ; level++ )
+            {
+                m_nodes[node].Add(count, rc, gc, bc);
+
+                if ( level == OCTREE_BITS )
+                    break;
+
+                const int bit = OCTREE_BITS - 1 - level;
+                const int child = (((r >> bit) & 1) << 2) |
+                                  (((g >> bit) & 1) << 1) |
+                                   ((b >> bit) & 1);
+
+                if ( !m_nodes[node].children[child] )
+                {
+                    m_nodes[node].children[child] = static_cast<wxUint32>(m_nodes.size());
+                    m_nodes.push_back(Node(level + 1));
+                }
+
+                node = m_nodes[node].children[child];
+            }
+
+            m_leaves++;
+        }
+    }
+
+    // Merge the nodes until there are no more than the given number of leaves.
+    void Reduce(int maxLeaves)
+    {
+        for ( int level = OCTREE_BITS - 1; level >= 0; level-- )
+        {
+            if ( m_leaves <= maxLeaves )
+                break;
+
+            // Collect all nodes of this level sorted by their pixel count.
+            wxVector<NodeRef> nodes;
+            for ( size_t n = 0; n < m_nodes.size(); n++ )
+            {
+                if ( m_nodes[n].level == level )
+                    nodes.push_back(NodeRef(m_nodes[n].count, n));
+            }
+
+            wxVectorSort(nodes);
+
+            // All children of these nodes are leaves, merge them, starting
+            // with the least used ones.
+            for ( size_t n = 0; n < nodes.size() && m_leaves > maxLeaves; n++ )
+            {
+                Node& node = m_nodes[nodes[n].index];
+
+                int children = 0;
+                for ( int i = 0; i < 8; i++ )
+                {
+                    if ( node.children[i] )
+                    {
+                        node.children[i] = 0;
+                        children++;
+                    }
+                }
+
+                m_leaves -= children - 1;
+            }
+        }
+    }
+
+    // Fill the palette with the colours of the leaves and return their number.
+    int FillPalette(unsigned char* palette) const
+    {
+        int count = 0;
+        DoFillPalette(0, palette, count);
+        return count;
+    }
+
+private:
+    struct Node
+    {
+        explicit Node(int level_)
+            : count(0), r(0), g(0), b(0), level(level_)
+        {
+            memset(children, 0, sizeof(children));
+        }
+
+        void Add(wxUint64 n, int r_, int g_, int b_)
+        {
+            count += n;
+            r += n*r_;
+            g += n*g_;
+            b += n*b_;
+        }
+
+        wxUint64 count, r, g, b;
+        wxUint32 children[8];
+        int level;
+    };
+
+    struct NodeRef
+    {
+        NodeRef(wxUint64 count_, size_t index_)
+            : count(count_), index(index_)
+        {
+        }
+
+        bool operator<(const NodeRef& other) const
+        {
+            return count < other.count;
+        }
+
+        wxUint64 count;
+        size_t index;
+    };
+
+    void DoFillPalette(size_t n, unsigned char* palette, int& count) const
+    {
+        const Node& node = m_nodes[n];
+
+        bool isLeaf = true;
+        for ( int i = 0; i < 8; i++ )
+        {
+            if ( node.children[i] )
+            {
+                isLeaf = false;
+                DoFillPalette(node.children[i], palette, count);
+            }
+        }
+
+        if ( isLeaf && node.count )
+        {
+            palette[3*count + 0] = static_cast<unsigned char>((node.r + node.count/2) / node.count);
+            palette[3*count + 1] = static_cast<unsigned char>((node.g + node.count/2) / node.count);
+            palette[3*count + 2] = static_cast<unsigned char>((node.b + node.count/2) / node.count);
+            count++;
+        }
+    }
+
+    wxVector<Node> m_nodes;
+    int m_leaves;
+};
+
+// Maps the colours to the closest palette entries, caching the results for
+// each histogram cell.
+class OctreeColourMap
+{
+public:
+    OctreeColourMap(const unsigned char* palette, int numColours)
+        : m_palette(palette)
+    {
+        for ( int i = 0; i < numColours; i++ )
+            m_sorted.push_back(Entry(palette[3*i + 1], i));
+        wxVectorSort(m_sorted);
+
+        m_map = (wxUint16*)malloc(OCTREE_CELLS * sizeof(wxUint16));
+        for ( int i = 0; i < OCTREE_CELLS; i++ )
+            m_map[i] = OCTREE_NO_COLOUR;
+    }
+
+    ~OctreeColourMap()
+    {
+        free(m_map);
+    }
+
+    // Compute the entries for all the cells used in the histogram. After
+    // calling this, GetUsedCell() can be called from multiple threads.
+    void FillUsedCells(const OctreeHistCell* hist)
+    {
+        for ( int i = 0; i < OCTREE_CELLS; i++ )
+        {
+            if ( !hist[i] )
+                continue;
+
+            m_map[i] = FindClosest(GetOctreeCellCentre(i, 2*OCTREE_BITS),
+                                   GetOctreeCellCentre(i, OCTREE_BITS),
+                                   GetOctreeCellCentre(i, 0));
+        }
+    }
+
+    // Return the entry for a cell filled by FillUsedCells().
+    unsigned char GetUsedCell(const unsigned char* p) const
+    {
+        return static_cast<unsigned char>(m_map[GetOctreeCell(p[0], p[1], p[2])]);
+    }
+
+    // Return the entry for any colour, computing it if necessary.
+    int Get(int r, int g, int b)
+    {
+        wxUint16& entry = m_map[GetOctreeCell(r, g, b)];
+        if ( entry == OCTREE_NO_COLOUR )
+            entry = FindClosest(r, g, b);
+
+        return entry;
+    }
+
+private:
+    // Palette entry index sorted by their green component, which is used for
+    // speeding up the search for the closest colour.
+    struct Entry
+    {
+        Entry(int g_, int index_) : g(g_), index(index_) { }
+
+        bool operator<(const Entry& other) const { return g < other.g; }
+
+        int g;
+        int index;
+    };
+
+    wxUint16 FindClosest(int r, int g, int b) const
+    {
+        // Start with the entry with the closest green value and look for the
+        // closer ones in both directions until the difference in the green
+        // component alone is bigger than the best distance found so far.
+        const size_t count = m_sorted.size();
+        size_t start = 0;
+        while ( start < count && m_sorted[start].g < g )
+            start++;
+
+        int best = 0;
+        int bestDist = INT_MAX;
+
+        size_t up = start,
+               down = start;
+        for ( ;; )
+        {
+            bool more = false;
+
+            if ( up < count )
+            {
+                const int dg = m_sorted[up].g - g;
+                if ( dg*dg < bestDist )
+                {
+                    CheckEntry(m_sorted[up].index, r, g, b, best, bestDist);
+                    up++;
+                    more = true;
+                }
+            }
+
+            if ( down > 0 )
+            {
+                const int dg = g - m_sorted[down - 1].g;
+                if ( dg*dg < bestDist )
+                {
+                    down--;
+                    CheckEntry(m_sorted[down].index, r, g, b, best, bestDist);
+                    more = true;
+                }
+            }
+
+            if ( !more )
+                break;
+        }
+
+        return static_cast<wxUint16>(best);
+    }
+
+    void
+    CheckEntry(int i, int r, int g, int b, int& best, int& bestDist) const
+    {
+        const unsigned char* const c = m_palette + 3*i;
+        const int dr = r - c[0],
+                  dg = g - c[1],
+                  db = b - c[2];
+        const int dist = dr*dr + dg*dg + db*db;
+        if ( dist < bestDist )
+        {
+            bestDist = dist;
+            best = i;
+        }
+    }
+
+    const unsigned char* const m_palette;
+    wxVector<Entry> m_sorted;
+    wxUint16* m_map;
+
+    wxDECLARE_NO_COPY_CLASS(OctreeColourMap);
+};
+
+// Maps the pixels to the palette entries without dithering.
+class MapRowsProcessor : public RowsProcessor
+{
+public:
+    MapRowsProcessor(unsigned w,
+                     unsigned char **in_rows,
+                     unsigned char **out_rows,
+                     const OctreeColourMap& map)
+        : m_width(w),
+          m_inRows(in_rows),
+          m_outRows(out_rows),
+          m_map(map)
+    {
+    }
+
+    virtual void ProcessRows(unsigned first, unsigned last, unsigned WXUNUSED(band)) wxOVERRIDE
+    {
+        for ( unsigned row = first; row < last; row++ )
+        {
+            const unsigned char* in = m_inRows[row];
+            unsigned char* out = m_outRows[row];
+            for ( unsigned col = 0; col < m_width; col++, in += 3 )
+                *out++ = m_map.GetUsedCell(in);
+        }
+    }
+
+private:
+    const unsigned m_width;
+    unsigned char ** const m_inRows;
+    unsigned char ** const m_outRows;
+    const OctreeColourMap& m_map;
+
+    wxDECLARE_NO_COPY_CLASS(MapRowsProcessor);
+};
+
+inline int ClampColour(int c)
+{
+    return c < 0 ? 0 : c > MAXJSAMPLE ? MAXJSAMPLE : c;
+}
+
+// Maps the pixels to the palette entries using Floyd-Steinberg dithering.
+//
+// This uses the same approach as pass2_fs_dither() above: a single array is
+// used for storing the errors for the next row at the columns already
+// processed and for the current row at the columns not processed yet, while
+// the errors around the current pixel are kept in local variables.
+//
+// Notice that this can't be parallelized as the error is propagated from each
+// row to the next one.
+void
+OctreeMapWithDithering(unsigned w, unsigned h,
+                       unsigned char **in_rows, unsigned char **out_rows,
+                       const unsigned char* palette,
+                       OctreeColourMap& map)
+{
+    // Errors in 1/16 units, with an extra element on each side to avoid
+    // checking for the boundaries.
+    int* const errors = (int*)calloc(3*(w + 2), sizeof(int));
+
+    for ( unsigned row = 0; row < h; row++ )
+    {
+        // Use serpentine scanning to avoid directional artefacts.
+        const bool leftToRight = (row % 2) == 0;
+        const int dir = leftToRight ? 1 : -1;
+        const int dir3 = 3*dir;
+        const unsigned col0 = leftToRight ? 0 : w - 1;
+
+        const unsigned char* in = in_rows[row] + 3*col0;
+        unsigned char* out = out_rows[row] + col0;
+        // This points to the element before the current one in scan order.
+        int* errorptr = errors + 3*(col0 + 1) - dir3;
+
+        // Error propagated from the previous pixel in this row, times 7.
+        int cur0 = 0, cur1 = 0, cur2 = 0;
+
+        // Errors for the pixels below the previous and the current ones.
+        int belowerr0 = 0, belowerr1 = 0, belowerr2 = 0;
+        int bpreverr0 = 0, bpreverr1 = 0, bpreverr2 = 0;
+
+        for ( unsigned i = 0; i < w; i++ )
+        {
+            cur0 = ClampColour(in[0] + RIGHT_SHIFT(cur0 + errorptr[dir3 + 0] + 8, 4));
+            cur1 = ClampColour(in[1] + RIGHT_SHIFT(cur1 + errorptr[dir3 + 1] + 8, 4));
+            cur2 = ClampColour(in[2] + RIGHT_SHIFT(cur2 + errorptr[dir3 + 2] + 8, 4));
+
+            const int index = map.Get(cur0, cur1, cur2);
+            *out = static_cast<unsigned char>(index);
+
+            const unsigned char* const entry = palette + 3*index;
+            cur0 -= entry[0];
+            cur1 -= entry[1];
+            cur2 -= entry[2];
+
+            // Distribute the error: 1/16 of it goes below-right (in the scan
+            // direction), 5/16 below, 3/16 below-left and 7/16 right.
+            int bnexterr, delta;
+
+            bnexterr = cur0;
+            delta = cur0 * 2;
+            cur0 += delta;                  // error * 3
+            errorptr[0] = bpreverr0 + cur0;
+            cur0 += delta;                  // error * 5
+            bpreverr0 = belowerr0 + cur0;
+            belowerr0 = bnexterr;
+            cur0 += delta;                  // error * 7
+
+            bnexterr = cur1;
+            delta = cur1 * 2;
+            cur1 += delta;
+            errorptr[1] = bpreverr1 + cur1;
+            cur1 += delta;
+            bpreverr1 = belowerr1 + cur1;
+            belowerr1 = bnexterr;
+            cur1 += delta;
+
+            bnexterr = cur2;
+            delta = cur2 * 2;
+            cur2 += delta;
+            errorptr[2] = bpreverr2 + cur2;
+            cur2 += delta;
+            bpreverr2 = belowerr2 + cur2;
+            belowerr2 = bnexterr;
+            cur2 += delta;
+
+            in += dir3;
+            out += dir;
+            errorptr += dir3;
+        }
+
+        // Store the error for the last pixel of the next row.
+        errorptr[0] = bpreverr0;
+        errorptr[1] = bpreverr1;
+        errorptr[2] = bpreverr2;
+    }
+
+    free(errors);
+}
+
+// Collects the colours of the image if there are not too many of them: in
+// this case they are used as the palette directly, which preserves them
+// exactly, while the octree would replace them with the colours of the
+// centres of the histogram cells.
+class ExactColours
+{
+public:
+    explicit ExactColours(int maxColours)
+        : m_maxColours(maxColours),
+          m_count(0)
+    {
+        for ( int i = 0; i < TABLE_SIZE; i++ )
+            m_table[i] = NO_COLOUR;
+    }
+
+    // Return false if the image has more than maxColours colours.
+    bool Collect(unsigned w, unsigned h, unsigned char **in_rows)
+    {
+        wxUint32 last = NO_COLOUR;
+        for ( unsigned row = 0; row < h; row++ )
+        {
+            const unsigned char* p = in_rows[row];
+            for ( unsigned col = 0; col < w; col++, p += 3 )
+            {
+                const wxUint32 colour = GetColour(p);
+                if ( colour == last )
+                    continue;
+
+                last = colour;
+
+                int slot = FindSlot(colour);
+                if ( m_table[slot] == NO_COLOUR )
+                {
+                    if ( m_count == m_maxColours )
+                        return false;
+
+                    m_table[slot] = colour;
+                    m_indices[slot] = static_cast<unsigned char>(m_count++);
+                }
+            }
+        }
+
+        return true;
+    }
+
+    // Fill the palette with the colours found by Collect() and return their
+    // number.
+    int FillPalette(unsigned char* palette) const
+    {
+        for ( int i = 0; i < TABLE_SIZE; i++ )
+        {
+            const wxUint32 colour = m_table[i];
+            if ( colour == NO_COLOUR )
+                continue;
+
+            unsigned char* const entry = palette + 3*m_indices[i];
+            entry[0] = static_cast<unsigned char>(colour >> 16);
+            entry[1] = static_cast<unsigned char>(colour >> 8);
+            entry[2] = static_cast<unsigned char>(colour);
+        }
+
+        return m_count;
+    }
+
+    // Return the index of the colour, which must have been found by Collect().
+    unsigned char Get(const unsigned char* p) const
+    {
+        return m_indices[FindSlot(GetColour(p))];
+    }
+
+private:
+    // The table must be big enough for 256 colours and is kept at most a
+    // quarter full to make the collisions rare.
+    enum { TABLE_SIZE = 1024 };
+
+    static const wxUint32 NO_COLOUR = 0xffffffff;
+
+    static wxUint32 GetColour(const unsigned char* p)
+    {
+        return (static_cast<wxUint32>(p[0]) << 16) | (p[1] << 8) | p[2];
+    }
+
+    // Return the slot containing this colour or the empty slot for it.
+    int FindSlot(wxUint32 colour) const
+    {
+        int slot = static_cast<int>((colour * 2654435761u) >> 22);
+        while ( m_table[slot] != NO_COLOUR && m_table[slot] != colour )
+            slot = (slot + 1) % TABLE_SIZE;
+
+        return slot;
+    }
+
+    const int m_maxColours;
+    int m_count;
+
+    wxUint32 m_table[TABLE_SIZE];
+    unsigned char m_indices[TABLE_SIZE];
+
+    wxDECLARE_NO_COPY_CLASS(ExactColours);
+};
+
+// Maps the pixels to the exact palette entries.
+class ExactMapRowsProcessor : public RowsProcessor
+{
+public:
+    ExactMapRowsProcessor(unsigned w,
+                          unsigned char **in_rows,
+                          unsigned char **out_rows,
+                          const ExactColours& colours)
+        : m_width(w),
+          m_inRows(in_rows),
+          m_outRows(out_rows),
+          m_colours(colours)
+    {
+    }
+
+    virtual void ProcessRows(unsigned first, unsigned last, unsigned WXUNUSED(band)) wxOVERRIDE
+    {
+        for ( unsigned row = first; row < last; row++ )
+        {
+            const unsigned char* in = m_inRows[row];
+            unsigned char* out = m_outRows[row];
+            for ( unsigned col = 0; col < m_width; col++, in += 3 )
+                *out++ = m_colours.Get(in);
+        }
+    }
+
+private:
+    const unsigned m_width;
+    unsigned char ** const m_inRows;
+    unsigned char ** const m_outRows;
+    const ExactColours& m_colours;
+
+    wxDECLARE_NO_COPY_CLASS(ExactMapRowsProcessor);
+};
+
+void
+OctreeQuantize(unsigned w, unsigned h,
+               unsigned char **in_rows, unsigned char **out_rows,
+               unsigned char *palette, int desiredNoColours, bool dither)
+{
+    const unsigned bands = GetBandsCount(w, h);
+
+    // Images with many colours are detected after scanning only a few rows,
+    // so this doesn't cost much even when it fails. Notice that dithering is
+    // not needed when all the colours are in the palette.
+    ExactColours exact(desiredNoColours);
+    if ( exact.Collect(w, h, in_rows) )
+    {
+        const int numColours = exact.FillPalette(palette);
+        memset(palette + 3*numColours, 0, 3*(desiredNoColours - numColours));
+
+        ExactMapRowsProcessor mapProcessor(w, in_rows, out_rows, exact);
+        ProcessRowsInBands(mapProcessor, h, bands);
+        return;
+    }
+
+    HistogramProcessor histProcessor(w, in_rows, bands);
+    ProcessRowsInBands(histProcessor, h, bands);
+    const OctreeHistCell* const hist = histProcessor.GetResult();
+
+    Octree octree(hist);
+    octree.Reduce(desiredNoColours);
+
+    const int numColours = octree.FillPalette(palette);
+
+    // Fill the unused palette entries, if any, with black.
+    memset(palette + 3*numColours, 0, 3*(desiredNoColours - numColours));
+
+    OctreeColourMap map(palette, numColours);
+    if ( dither )
+    {
+        OctreeMapWithDithering(w, h, in_rows, out_rows, palette, map);
+    }
+    else
+    {
+        map.FillUsedCells(hist);
+
+        MapRowsProcessor mapProcessor(w, in_rows, out_rows, map);
+        ProcessRowsInBands(mapProcessor, h, bands);
+    }
+}
+
+
 } // anonymous namespace
 
 
@@ -1423,14 +2257,23 @@ prepare_range_limit_table (j_decompress_ptr cinfo)
 wxIMPLEMENT_DYNAMIC_CLASS(wxQuantize, wxObject);
 
 void wxQuantize::DoQuantize(unsigned w, unsigned h, unsigned char **in_rows, unsigned char **out_rows,
-    unsigned char *palette, int desiredNoColours)
+    unsigned char *palette, int desiredNoColours, int flags)
 {
+    const bool dither = !(flags & wxQUANTIZE_NO_DITHERING);
+
+    if (flags & wxQUANTIZE_OCTREE)
+    {
+        OctreeQuantize(w, h, in_rows, out_rows, palette, desiredNoColours, dither);
+        return;
+    }
+
     j_decompress dec;
     my_cquantize_ptr cquantize;
 
     dec.colormap = NULL;
     dec.output_width = w;
     dec.desired_number_of_colors = desiredNoColours;
+    dec.dither = dither;
     prepare_range_limit_table(&dec);
     jinit_2pass_quantizer(&dec);
     cquantize = (my_cquantize_ptr) dec.cquantize;
@@ -1510,7 +2353,7 @@ bool wxQuantize::Quantize(const wxImage& src, wxImage& dest,
         outrows[i] = data8bit + w * i;
 
     //RGB->palette
-    DoQuantize(w, h, rows, outrows, palette, desiredNoColours);
+    DoQuantize(w, h, rows, outrows, palette, desiredNoColours, flags);
 
     delete[] rows;
     delete[] outrows;
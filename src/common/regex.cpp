@@ -27,14 +27,18 @@
 #if wxUSE_REGEX
 
 #include "wx/regex.h"
+#include "wx/vector.h"
 
 #ifndef WX_PRECOMP
     #include "wx/object.h"
     #include "wx/log.h"
     #include "wx/intl.h"
     #include "wx/crt.h"
+    #include "wx/arrstr.h"
 #endif //WX_PRECOMP
 
+#include "wx/thread.h"
+
 // At least FreeBSD requires this.
 #if defined(__UNIX__)
 #   include <sys/types.h>
@@ -73,6 +77,21 @@
 #   define wx_regerror regerror
 #endif
 
+// WXREGEX_USING_PCRE2      defined when PCRE2 is used for wxRE_PCRE, this is
+//                          only supported together with the built-in regex
+//                          lib to ensure that wxRegChar is the same as wxChar
+#if wxUSE_LIBPCRE2 && defined(WXREGEX_USING_BUILTIN)
+#   define WXREGEX_USING_PCRE2
+#   if !wxUSE_UNICODE
+#       define PCRE2_CODE_UNIT_WIDTH 8
+#   elif SIZEOF_WCHAR_T == 2
+#       define PCRE2_CODE_UNIT_WIDTH 16
+#   else
+#       define PCRE2_CODE_UNIT_WIDTH 32
+#   endif
+#   include <pcre2.h>
+#endif
+
 // ----------------------------------------------------------------------------
 // private classes
 // ----------------------------------------------------------------------------
@@ -147,6 +166,69 @@ typedef wxChar wxRegChar;
 typedef char wxRegChar;
 #endif
 
+#ifdef WXREGEX_USING_PCRE2
+
+// PCRE2 uses its own character type which has the same size as wxRegChar
+inline PCRE2_SPTR wxToPCRE2(const wxRegChar *str)
+{
+    return reinterpret_cast<PCRE2_SPTR>(str);
+}
+
+#endif // WXREGEX_USING_PCRE2
+
+// the data used by a single match: as it is kept separately from the compiled
+// RE, the same RE can be used by several threads at once, provided that each
+// of them uses its own state
+class wxRegExMatchState
+{
+public:
+    wxRegExMatchState() { Init(); }
+    ~wxRegExMatchState() { Free(); }
+
+    // free all the data, this must be done before freeing the RE it was used
+    // with
+    void Free()
+    {
+#ifdef WXREGEX_USING_BUILTIN
+        wx_re_freectx(m_ctx);
+#endif
+#ifdef WXREGEX_USING_PCRE2
+        pcre2_match_data_free(m_pcreMatchData);
+#endif
+        delete m_matches;
+
+        Init();
+    }
+
+    // the subexpressions data, allocated when matching for the first time
+    wxRegExMatches *m_matches;
+
+#ifdef WXREGEX_USING_BUILTIN
+    // the context keeping the automata built by the previous matches, it is
+    // also only allocated when matching for the first time
+    wx_re_ctx      *m_ctx;
+#endif // WXREGEX_USING_BUILTIN
+
+#ifdef WXREGEX_USING_PCRE2
+    // the data for the matches of the RE compiled by PCRE2
+    pcre2_match_data *m_pcreMatchData;
+#endif // WXREGEX_USING_PCRE2
+
+private:
+    void Init()
+    {
+        m_matches = NULL;
+#ifdef WXREGEX_USING_BUILTIN
+        m_ctx = NULL;
+#endif
+#ifdef WXREGEX_USING_PCRE2
+        m_pcreMatchData = NULL;
+#endif
+    }
+
+    wxDECLARE_NO_COPY_CLASS(wxRegExMatchState);
+};
+
 // the real implementation of wxRegEx
 class wxRegExImpl
 {
@@ -158,36 +240,77 @@ public:
     // return true if Compile() had been called successfully
     bool IsValid() const { return m_isCompiled; }
 
+    // return true if the RE was compiled with wxRE_NOSUB
+    bool IsNoSub() const { return m_nMatches == 0; }
+
     // RE operations
     bool Compile(const wxString& expr, int flags = 0);
     bool Matches(const wxRegChar *str, int flags
-                 WXREGEX_IF_NEED_LEN(size_t len)) const;
-    bool GetMatch(size_t *start, size_t *len, size_t index = 0) const;
+                 WXREGEX_IF_NEED_LEN(size_t len)) const
+    {
+        return DoMatch(m_state, str, flags WXREGEX_IF_NEED_LEN(len));
+    }
+    bool GetMatch(size_t *start, size_t *len, size_t index = 0) const
+    {
+        return GetMatch(m_state, start, len, index);
+    }
     size_t GetMatchCount() const;
     int Replace(wxString *pattern, const wxString& replacement,
                 size_t maxMatches = 0) const;
 
+    // the same as Matches() and GetMatch() but using the given state instead
+    // of our own one
+    bool DoMatch(wxRegExMatchState& state, const wxRegChar *str, int flags
+                 WXREGEX_IF_NEED_LEN(size_t len)) const;
+    bool GetMatch(const wxRegExMatchState& state,
+                  size_t *start, size_t *len, size_t index = 0) const;
+
 private:
     // return the string containing the error message for the given err code
     wxString GetErrorMsg(int errorcode, bool badconv) const;
 
+#ifdef WXREGEX_USING_BUILTIN
+    // return true if the string contains m_literal
+    bool HasLiteral(const wxChar *str, size_t len) const;
+#endif // WXREGEX_USING_BUILTIN
+
+#ifdef WXREGEX_USING_PCRE2
+    // Compile() and DoMatch() implementations using PCRE2
+    bool CompilePCRE2(const wxString& expr, int flags);
+    bool MatchesPCRE2(wxRegExMatchState& state,
+                      const wxRegChar *str, int flags, size_t len) const;
+#endif // WXREGEX_USING_PCRE2
+
     // init the members
     void Init()
     {
         m_isCompiled = false;
-        m_Matches = NULL;
         m_nMatches = 0;
+#ifdef WXREGEX_USING_PCRE2
+        m_pcre = NULL;
+#endif
     }
 
     // free the RE if compiled
     void Free()
     {
+        // the state must be freed before the RE it was used with
+        m_state.Free();
+
+#ifdef WXREGEX_USING_PCRE2
+        if ( m_pcre )
+        {
+            pcre2_code_free(m_pcre);
+        }
+        else
+#endif // WXREGEX_USING_PCRE2
         if ( IsValid() )
         {
+#ifdef WXREGEX_USING_BUILTIN
+            m_literal.clear();
+#endif
             wx_regfree(&m_RegEx);
         }
-
-        delete m_Matches;
     }
 
     // free the RE if any and reinit the members
@@ -200,8 +323,21 @@ private:
     // compiled RE
     regex_t         m_RegEx;
 
-    // the subexpressions data
-    wxRegExMatches *m_Matches;
+#ifdef WXREGEX_USING_BUILTIN
+    // the string which must occur in any matching text or empty if we don't
+    // know of any such string
+    wxVector<wxChar> m_literal;
+#endif // WXREGEX_USING_BUILTIN
+
+#ifdef WXREGEX_USING_PCRE2
+    // the RE compiled by PCRE2, used instead of m_RegEx if non-NULL
+    pcre2_code       *m_pcre;
+#endif // WXREGEX_USING_PCRE2
+
+    // the state used by Matches() and GetMatch()
+    mutable wxRegExMatchState m_state;
+
+    // the number of subexpressions
     size_t          m_nMatches;
 
     // true if m_RegEx is valid
@@ -213,6 +349,182 @@ private:
 // implementation
 // ============================================================================
 
+#ifdef WXREGEX_USING_BUILTIN
+
+// ----------------------------------------------------------------------------
+// required literal extraction
+// ----------------------------------------------------------------------------
+
+// Skip the bracket expression starting after '[' and return true or return
+// false if it is not terminated or contains a backslash, which is an escape
+// in the advanced syntax, but not in the extended one.
+static bool SkipBracketExpr(const wxChar *&p, const wxChar *end)
+{
+    if ( p < end && *p == wxT('^') )
+        p++;
+
+    // ']' is an ordinary character if it comes first
+    if ( p < end && *p == wxT(']') )
+        p++;
+
+    while ( p < end )
+    {
+        const wxChar ch = *p++;
+        if ( ch == wxT(']') )
+            return true;
+
+        if ( ch == wxT('\\') )
+            return false;
+
+        // skip the character classes, equivalence classes and collating
+        // elements as they can contain ']' too
+        if ( ch == wxT('[') && p < end &&
+                (*p == wxT(':') || *p == wxT('=') || *p == wxT('.')) )
+        {
+            const wxChar delim = *p++;
+            for ( ;; )
+            {
+                if ( end - p < 2 )
+                    return false;
+
+                if ( p[0] == delim && p[1] == wxT(']') )
+                {
+                    p += 2;
+                    break;
+                }
+
+                p++;
+            }
+        }
+    }
+
+    return false;
+}
+
+// Find the longest string of ordinary characters which must occur in any text
+// matched by the given extended or advanced RE.
+//
+// As this is used to quickly reject the texts which can't match, it must be
+// conservative: any construct which we don't know to be safe either just
+// terminates the current string or makes us give up completely and return an
+// empty string.
+static wxVector<wxChar> GetRequiredLiteral(const wxChar *p, const wxChar *end)
+{
+    wxVector<wxChar> best,
+                     run;
+
+    // directors and embedded options, which can only occur at the start of
+    // an ARE, can change the meaning of everything following them
+    if ( end - p >= 2 &&
+            ((p[0] == wxT('*') && p[1] == wxT('*')) ||
+             (p[0] == wxT('(') && p[1] == wxT('?'))) )
+        return best;
+
+    // only the characters outside of any groups are taken into account
+    int depth = 0;
+
+    // true if the last character was appended to run
+    bool lastWasLiteral = false;
+
+    while ( p < end )
+    {
+        bool isLiteral = false;
+
+        const wxChar ch = *p++;
+        switch ( ch )
+        {
+            case wxT('\\'):
+                if ( p == end )
+                    return wxVector<wxChar>();
+
+                // a backslash followed by an alphanumeric character is a
+                // class shorthand, a constraint escape, a back-reference or an
+                // escape which may be followed by a variable number of
+                // characters (e.g. "\x41" or "\u0042"), so don't even try to
+                // interpret it, but any other escaped character is an
+                // ordinary one
+                if ( wxIsalnum(*p) )
+                    return wxVector<wxChar>();
+
+                if ( !depth )
+                {
+                    run.push_back(*p);
+                    isLiteral = true;
+                }
+
+                p++;
+                break;
+
+            case wxT('['):
+                if ( !SkipBracketExpr(p, end) )
+                    return wxVector<wxChar>();
+                break;
+
+            case wxT('('):
+                depth++;
+                break;
+
+            case wxT(')'):
+                if ( !depth-- )
+                    return wxVector<wxChar>();
+                break;
+
+            case wxT('|'):
+                // no string is required if there are alternatives
+                if ( !depth )
+                    return wxVector<wxChar>();
+                break;
+
+            case wxT('{'):
+                // skip the bound and treat it in the same way as '*'
+                while ( p < end && *p != wxT('}') )
+                    p++;
+                if ( p == end )
+                    return wxVector<wxChar>();
+                p++;
+                wxFALLTHROUGH;
+
+            case wxT('*'):
+            case wxT('?'):
+                // the previous character may be absent from the text
+                if ( lastWasLiteral )
+                    run.pop_back();
+                break;
+
+            case wxT('+'):
+                // the previous character must still be present, but the next
+                // one doesn't necessarily follow it immediately
+            case wxT('.'):
+            case wxT('^'):
+            case wxT('$'):
+                break;
+
+            default:
+                if ( !depth )
+                {
+                    run.push_back(ch);
+                    isLiteral = true;
+                }
+        }
+
+        if ( !isLiteral )
+        {
+            if ( run.size() > best.size() )
+                best = run;
+            run.clear();
+        }
+
+        lastWasLiteral = isLiteral;
+    }
+
+    if ( run.size() > best.size() )
+        best = run;
+
+    return best;
+}
+
+#endif // WXREGEX_USING_BUILTIN
+
 // ----------------------------------------------------------------------------
 // wxRegExImpl
 // ----------------------------------------------------------------------------
@@ -272,9 +584,25 @@ bool wxRegExImpl::Compile(const wxString& expr, int flags)
     wxASSERT_MSG( (flags & FLAVORS) != FLAVORS,
                   wxT("incompatible flags in wxRegEx::Compile") );
 #endif
-    wxASSERT_MSG( !(flags & ~(FLAVORS | wxRE_ICASE | wxRE_NOSUB | wxRE_NEWLINE)),
+    wxASSERT_MSG( !(flags & ~(FLAVORS | wxRE_PCRE | wxRE_ICASE | wxRE_NOSUB | wxRE_NEWLINE)),
                   wxT("unrecognized flags in wxRegEx::Compile") );
 
+    if ( flags & wxRE_PCRE )
+    {
+        wxASSERT_MSG( !(flags & FLAVORS),
+                      wxT("incompatible flags in wxRegEx::Compile") );
+
+#ifdef WXREGEX_USING_PCRE2
+        return CompilePCRE2(expr, flags);
+#else
+        // fall back to the most similar syntax supported by the library
+        flags &= ~wxRE_PCRE;
+    #ifndef WX_NO_REGEX_ADVANCED
+        flags |= wxRE_ADVANCED;
+    #endif
+#endif
+    }
+
     // translate our flags to regcomp() ones
     int flagsRE = 0;
     if ( !(flags & wxRE_BASIC) )
@@ -353,12 +681,129 @@ bool wxRegExImpl::Compile(const wxString& expr, int flags)
             }
         }
 
+#ifdef WXREGEX_USING_BUILTIN
+        // we don't bother with the required strings in the basic syntax and
+        // can't use them when ignoring case
+        if ( !(flags & (wxRE_BASIC | wxRE_ICASE)) )
+        {
+            const wxChar* const start = expr.c_str();
+            m_literal = GetRequiredLiteral(start, start + expr.length());
+        }
+#endif // WXREGEX_USING_BUILTIN
+
         m_isCompiled = true;
     }
 
     return IsValid();
 }
 
+#ifdef WXREGEX_USING_PCRE2
+
+bool wxRegExImpl::CompilePCRE2(const wxString& expr, int flags)
+{
+    uint32_t options = 0;
+#if wxUSE_UNICODE
+    options |= PCRE2_UTF;
+#ifdef PCRE2_MATCH_INVALID_UTF
+    // don't give errors for the strings with invalid surrogates &c
+    options |= PCRE2_MATCH_INVALID_UTF;
+#endif
+#endif // wxUSE_UNICODE
+
+    if ( flags & wxRE_ICASE )
+        options |= PCRE2_CASELESS;
+    if ( flags & wxRE_NOSUB )
+        options |= PCRE2_NO_AUTO_CAPTURE;
+
+    // '\n' is special only with wxRE_NEWLINE, just as with POSIX syntax
+    if ( flags & wxRE_NEWLINE )
+        options |= PCRE2_MULTILINE;
+    else
+        options |= PCRE2_DOTALL | PCRE2_DOLLAR_ENDONLY;
+
+    int errorcode;
+    PCRE2_SIZE erroroffset;
+    m_pcre = pcre2_compile(wxToPCRE2(WXREGEX_CHAR(expr)), expr.length(), options,
+                           &errorcode, &erroroffset, NULL);
+    if ( !m_pcre )
+    {
+        PCRE2_UCHAR msg[256];
+        if ( pcre2_get_error_message(errorcode, msg, WXSIZEOF(msg)) < 0 )
+            msg[0] = 0;
+
+        wxLogError(_("Invalid regular expression '%s': %s"),
+                   expr.c_str(),
+                   wxString(reinterpret_cast<const wxRegChar *>(msg)).c_str());
+
+        return false;
+    }
+
+    // compile the RE to native code if possible, matching still works, if
+    // more slowly, if the JIT compiler is not available, so ignore errors
+    pcre2_jit_compile(m_pcre, PCRE2_JIT_COMPLETE);
+
+    if ( flags & wxRE_NOSUB )
+    {
+        m_nMatches = 0;
+    }
+    else
+    {
+        uint32_t count = 0;
+        pcre2_pattern_info(m_pcre, PCRE2_INFO_CAPTURECOUNT, &count);
+
+        m_nMatches = count + 1;
+    }
+
+    m_isCompiled = true;
+
+    return true;
+}
+
+bool wxRegExImpl::MatchesPCRE2(wxRegExMatchState& state,
+                               const wxRegChar *str,
+                               int flags,
+                               size_t len) const
+{
+    if ( !state.m_pcreMatchData )
+    {
+        state.m_pcreMatchData = pcre2_match_data_create_from_pattern(m_pcre, NULL);
+        if ( !state.m_pcreMatchData )
+        {
+            wxLogError(_("Failed to find match for regular expression: %s"),
+                       _("out of memory"));
+            return false;
+        }
+    }
+
+    uint32_t options = 0;
+    if ( flags & wxRE_NOTBOL )
+        options |= PCRE2_NOTBOL;
+    if ( flags & wxRE_NOTEOL )
+        options |= PCRE2_NOTEOL;
+
+    const int rc = pcre2_match(m_pcre, wxToPCRE2(str), len, 0, options,
+                               state.m_pcreMatchData, NULL);
+
+    // 0 means that there was a match but not all subexpressions could be
+    // stored, which can't happen with the matches data created from pattern
+    if ( rc >= 0 )
+        return true;
+
+    if ( rc != PCRE2_ERROR_NOMATCH )
+    {
+        PCRE2_UCHAR msg[256];
+        if ( pcre2_get_error_message(rc, msg, WXSIZEOF(msg)) < 0 )
+            msg[0] = 0;
+
+        wxLogError(_("Failed to find match for regular expression: %s"),
+                   wxString(reinterpret_cast<const wxRegChar *>(msg)).c_str());
+    }
+
+    return false;
+}
+
+#endif // WXREGEX_USING_PCRE2
+
 #ifdef WXREGEX_USING_RE_SEARCH
 
 // On GNU, regexec is implemented as a wrapper around re_search. re_search
@@ -386,7 +831,8 @@ static int ReSearch(const regex_t *preg,
 
 #endif // WXREGEX_USING_RE_SEARCH
 
-bool wxRegExImpl::Matches(const wxRegChar *str,
+bool wxRegExImpl::DoMatch(wxRegExMatchState& state,
+                          const wxRegChar *str,
                           int flags
                           WXREGEX_IF_NEED_LEN(size_t len)) const
 {
@@ -396,6 +842,17 @@ bool wxRegExImpl::Matches(const wxRegChar *str,
     wxASSERT_MSG( !(flags & ~(wxRE_NOTBOL | wxRE_NOTEOL)),
                   wxT("unrecognized flags in wxRegEx::Matches") );
 
+#ifdef WXREGEX_USING_PCRE2
+    if ( m_pcre )
+        return MatchesPCRE2(state, str, flags, len);
+#endif // WXREGEX_USING_PCRE2
+
+#ifdef WXREGEX_USING_BUILTIN
+    // don't even run the regex engine if the string can't match
+    if ( !m_literal.empty() && !HasLiteral(str, len) )
+        return false;
+#endif // WXREGEX_USING_BUILTIN
+
     int flagsRE = 0;
     if ( flags & wxRE_NOTBOL )
         flagsRE |= REG_NOTBOL;
@@ -404,16 +861,22 @@ bool wxRegExImpl::Matches(const wxRegChar *str,
 
     // allocate matches array if needed
     wxRegExImpl *self = wxConstCast(this, wxRegExImpl);
-    if ( !m_Matches && m_nMatches )
+    if ( !state.m_matches && m_nMatches )
     {
-        self->m_Matches = new wxRegExMatches(m_nMatches);
+        state.m_matches = new wxRegExMatches(m_nMatches);
     }
 
-    wxRegExMatches::match_type matches = m_Matches ? m_Matches->get() : NULL;
+    wxRegExMatches::match_type
+        matches = state.m_matches ? state.m_matches->get() : NULL;
 
     // do match it
 #if defined WXREGEX_USING_BUILTIN
-    int rc = wx_re_exec(&self->m_RegEx, str, len, NULL, m_nMatches, matches, flagsRE);
+    // if we fail to allocate the context, we just match without it
+    if ( !state.m_ctx )
+        state.m_ctx = wx_re_newctx();
+
+    int rc = wx_re_execctx(&self->m_RegEx, str, len, NULL, m_nMatches, matches,
+                           flagsRE, state.m_ctx);
 #elif defined WXREGEX_USING_RE_SEARCH
     int rc = str ? ReSearch(&self->m_RegEx, str, len, matches, flagsRE) : REG_BADPAT;
 #else
@@ -438,17 +901,79 @@ bool wxRegExImpl::Matches(const wxRegChar *str,
     }
 }
 
-bool wxRegExImpl::GetMatch(size_t *start, size_t *len, size_t index) const
+#ifdef WXREGEX_USING_BUILTIN
+
+bool wxRegExImpl::HasLiteral(const wxChar *str, size_t len) const
+{
+    const size_t lenLiteral = m_literal.size();
+    if ( len < lenLiteral )
+        return false;
+
+    // look for the first character using wmemchr(), which is typically
+    // vectorized, and only compare the rest of the literal when it's found
+    const wxChar first = m_literal[0];
+    const wxChar* const rest = &m_literal[0] + 1;
+    const wxChar* const last = str + len - lenLiteral;
+    for ( const wxChar *p = str; p <= last; p++ )
+    {
+        p = wxTmemchr(p, first, last - p + 1);
+        if ( !p )
+            break;
+
+        if ( wxTmemcmp(p + 1, rest, lenLiteral - 1) == 0 )
+            return true;
+    }
+
+    return false;
+}
+
+#endif // WXREGEX_USING_BUILTIN
+
+bool wxRegExImpl::GetMatch(const wxRegExMatchState& state,
+                           size_t *start, size_t *len, size_t index) const
 {
     wxCHECK_MSG( IsValid(), false, wxT("must successfully Compile() first") );
     wxCHECK_MSG( m_nMatches, false, wxT("can't use with wxRE_NOSUB") );
-    wxCHECK_MSG( m_Matches, false, wxT("must call Matches() first") );
     wxCHECK_MSG( index < m_nMatches, false, wxT("invalid match index") );
 
+#ifdef WXREGEX_USING_PCRE2
+    if ( m_pcre )
+    {
+        wxCHECK_MSG( state.m_pcreMatchData, false,
+                     wxT("must call Matches() first") );
+
+        const PCRE2_SIZE* const
+            ovector = pcre2_get_ovector_pointer(state.m_pcreMatchData);
+
+        // the subexpressions which didn't participate in the match are
+        // returned in the same way as by the POSIX functions, i.e. with the
+        // start of -1 and empty length
+        if ( ovector[2*index] == PCRE2_UNSET )
+        {
+            if ( start )
+                *start = static_cast<size_t>(-1);
+            if ( len )
+                *len = 0;
+
+            return true;
+        }
+
+        if ( start )
+            *start = ovector[2*index];
+        if ( len )
+            *len = ovector[2*index + 1] - ovector[2*index];
+
+        return true;
+    }
+#endif // WXREGEX_USING_PCRE2
+
+    const wxRegExMatches* const matches = state.m_matches;
+    wxCHECK_MSG( matches, false, wxT("must call Matches() first") );
+
     if ( start )
-        *start = m_Matches->Start(index);
+        *start = matches->Start(index);
     if ( len )
-        *len = m_Matches->End(index) - m_Matches->Start(index);
+        *len = matches->End(index) - matches->Start(index);
 
     return true;
 }
@@ -618,6 +1143,431 @@ int wxRegExImpl::Replace(wxString *text,
     return countRepl;
 }
 
+// ----------------------------------------------------------------------------
+// matching many lines at once
+// ----------------------------------------------------------------------------
+
+// WXREGEX_CAN_USE_THREADS  defined if the same compiled RE can be used by
+//                          several threads at once, this is not the case with
+//                          re_search() which modifies it
+#if wxUSE_THREADS && !defined(WXREGEX_USING_RE_SEARCH)
+#   define WXREGEX_CAN_USE_THREADS
+#endif
+
+// the number of lines matched by a thread before taking the next ones
+static const size_t wxREGEX_LINES_PER_CHUNK = 256;
+
+// return the length of the line without the trailing line end, if any
+template <typename T>
+static inline size_t wxRegExStripEOL(const T *line, size_t len)
+{
+    if ( len && line[len - 1] == '\n' )
+    {
+        len--;
+        if ( len && line[len - 1] == '\r' )
+            len--;
+    }
+
+    return len;
+}
+
+// the buffer used by wxRegExLines::GetLine(), each thread uses its own one
+struct wxRegExLineBuffer
+{
+    // the line converted to wxChar
+    wxVector<wxChar> chars;
+
+#if wxUSE_UNICODE_UTF8
+    // the line from wxArrayString converted to wide chars
+    wxWCharBuffer wide;
+#endif
+
+    // true if the positions in the line returned by GetLine() are the same as
+    // in the original line, false if AdjustMatch() must be called
+    bool samePositions;
+};
+
+// the lines to match, abstracting the way they are stored
+class wxRegExLines
+{
+public:
+    virtual ~wxRegExLines() { }
+
+    // return the number of lines
+    virtual size_t GetCount() const = 0;
+
+    // return the line with the given index and its length or NULL if it
+    // can't be matched, buf may be used for storing the line if needed
+    virtual const wxChar *GetLine(size_t n,
+                                  size_t *len,
+                                  wxRegExLineBuffer& buf) const = 0;
+
+    // convert the position of the match in the line returned by GetLine() to
+    // the position in the original line
+    virtual void AdjustMatch(const wxChar * WXUNUSED(line),
+                             wxRegExLineMatch& WXUNUSED(match)) const
+    {
+    }
+};
+
+// the lines stored in wxArrayString
+class wxRegExArrayLines : public wxRegExLines
+{
+public:
+    explicit wxRegExArrayLines(const wxArrayString& lines)
+        : m_lines(lines)
+    {
+    }
+
+    virtual size_t GetCount() const wxOVERRIDE { return m_lines.size(); }
+
+    virtual const wxChar *GetLine(size_t n,
+                                  size_t *len,
+                                  wxRegExLineBuffer& buf) const wxOVERRIDE
+    {
+        const wxString& line = m_lines[n];
+
+        buf.samePositions = true;
+
+#if wxUSE_UNICODE_UTF8
+        // the RE engine works with wide chars
+        buf.wide = line.wc_str();
+        *len = buf.wide.length();
+        return buf.wide.data();
+#else
+        *len = line.length();
+        return line.wx_str();
+#endif
+    }
+
+private:
+    const wxArrayString& m_lines;
+
+    wxDECLARE_NO_COPY_CLASS(wxRegExArrayLines);
+};
+
+// the lines stored in a single buffer
+class wxRegExTextLines : public wxRegExLines
+{
+public:
+    wxRegExTextLines(const wxChar *text, const size_t *offsets, size_t count)
+        : m_text(text),
+          m_offsets(offsets),
+          m_count(count)
+    {
+    }
+
+    virtual size_t GetCount() const wxOVERRIDE { return m_count; }
+
+    virtual const wxChar *GetLine(size_t n,
+                                  size_t *len,
+                                  wxRegExLineBuffer& buf) const wxOVERRIDE
+    {
+        const wxChar* const line = m_text + m_offsets[n];
+
+        buf.samePositions = true;
+        *len = wxRegExStripEOL(line, m_offsets[n + 1] - m_offsets[n]);
+
+        return line;
+    }
+
+private:
+    const wxChar* const m_text;
+    const size_t* const m_offsets;
+    const size_t m_count;
+
+    wxDECLARE_NO_COPY_CLASS(wxRegExTextLines);
+};
+
+#if wxUSE_UNICODE
+
+// the lines stored in a single buffer in UTF-8
+class wxRegExUTF8Lines : public wxRegExLines
+{
+public:
+    wxRegExUTF8Lines(const char *text, const size_t *offsets, size_t count)
+        : m_text(text),
+          m_offsets(offsets),
+          m_count(count),
+          m_conv(wxMBConvUTF8::MAP_INVALID_UTF8_TO_PUA)
+    {
+    }
+
+    virtual size_t GetCount() const wxOVERRIDE { return m_count; }
+
+    virtual const wxChar *GetLine(size_t n,
+                                  size_t *len,
+                                  wxRegExLineBuffer& buf) const wxOVERRIDE
+    {
+        const char* const line = m_text + m_offsets[n];
+        const size_t lenLine = wxRegExStripEOL(line,
+                                               m_offsets[n + 1] - m_offsets[n]);
+
+        // each byte is converted to at most 2 UTF-16 code units (this is the
+        // case for the invalid bytes mapped to the private use area), reserve
+        // an extra one to never have an empty buffer
+        const size_t lenBuf = 2*lenLine + 1;
+        if ( buf.chars.size() < lenBuf )
+            buf.chars.resize(lenBuf);
+
+        wxChar* const dst = &buf.chars[0];
+
+        // most lines are typically ASCII and don't need to be really converted
+        size_t i;
+        for ( i = 0; i < lenLine; i++ )
+        {
+            const unsigned char ch = line[i];
+            if ( ch & 0x80 )
+                break;
+
+            dst[i] = ch;
+        }
+
+        buf.samePositions = i == lenLine;
+        if ( buf.samePositions )
+        {
+            *len = lenLine;
+            return dst;
+        }
+
+        *len = m_conv.ToWChar(dst, lenBuf, line, lenLine);
+        if ( *len == wxCONV_FAILED )
+            return NULL;
+
+        return dst;
+    }
+
+    virtual void AdjustMatch(const wxChar *line,
+                             wxRegExLineMatch& match) const wxOVERRIDE
+    {
+        const size_t start = GetUTF8Length(line, match.start);
+        match.len = GetUTF8Length(line + match.start, match.len);
+        match.start = start;
+    }
+
+private:
+    size_t GetUTF8Length(const wxChar *str, size_t len) const
+    {
+        if ( !len )
+            return 0;
+
+        const size_t lenUTF8 = m_conv.FromWChar(NULL, 0, str, len);
+
+        return lenUTF8 == wxCONV_FAILED ? 0 : lenUTF8;
+    }
+
+    const char* const m_text;
+    const size_t* const m_offsets;
+    const size_t m_count;
+
+    const wxMBConvUTF8 m_conv;
+
+    wxDECLARE_NO_COPY_CLASS(wxRegExUTF8Lines);
+};
+
+#endif // wxUSE_UNICODE
+
+// the object matching all the lines, possibly using several threads
+class wxRegExLinesMatcher
+{
+public:
+    wxRegExLinesMatcher(const wxRegExImpl& impl,
+                        const wxRegExLines& lines,
+                        int flags)
+        : m_impl(impl),
+          m_lines(lines),
+          m_flags(flags),
+          m_chunks((lines.GetCount() + wxREGEX_LINES_PER_CHUNK - 1) /
+                        wxREGEX_LINES_PER_CHUNK),
+          m_nextChunk(0)
+    {
+    }
+
+    // match all the lines using up to the given number of threads, including
+    // the current one, and return the number of matching lines
+    size_t Match(unsigned numThreads, wxRegExLineMatches *matches);
+
+    // match the chunks of lines until there are none left, this is called
+    // from all the threads
+    void MatchChunks();
+
+private:
+    // return false if there are no more chunks to match
+    bool GetNextChunk(size_t *chunk);
+
+    const wxRegExImpl& m_impl;
+    const wxRegExLines& m_lines;
+    const int m_flags;
+
+    // the matches found in each chunk of lines
+    wxVector<wxRegExLineMatches> m_chunks;
+
+    // the index of the next chunk to match
+    size_t m_nextChunk;
+#ifdef WXREGEX_CAN_USE_THREADS
+    wxCriticalSection m_csNextChunk;
+#endif // WXREGEX_CAN_USE_THREADS
+
+    wxDECLARE_NO_COPY_CLASS(wxRegExLinesMatcher);
+};
+
+#ifdef WXREGEX_CAN_USE_THREADS
+
+// the thread used by wxRegExLinesMatcher
+class wxRegExLinesThread : public wxThread
+{
+public:
+    explicit wxRegExLinesThread(wxRegExLinesMatcher& matcher)
+        : wxThread(wxTHREAD_JOINABLE),
+          m_matcher(matcher)
+    {
+    }
+
+protected:
+    virtual ExitCode Entry() wxOVERRIDE
+    {
+        m_matcher.MatchChunks();
+
+        return NULL;
+    }
+
+private:
+    wxRegExLinesMatcher& m_matcher;
+
+    wxDECLARE_NO_COPY_CLASS(wxRegExLinesThread);
+};
+
+#endif // WXREGEX_CAN_USE_THREADS
+
+bool wxRegExLinesMatcher::GetNextChunk(size_t *chunk)
+{
+#ifdef WXREGEX_CAN_USE_THREADS
+    wxCriticalSectionLocker lock(m_csNextChunk);
+#endif // WXREGEX_CAN_USE_THREADS
+
+    if ( m_nextChunk == m_chunks.size() )
+        return false;
+
+    *chunk = m_nextChunk++;
+
+    return true;
+}
+
+void wxRegExLinesMatcher::MatchChunks()
+{
+    // each thread uses its own state and buffer
+    wxRegExMatchState state;
+    wxRegExLineBuffer buf;
+
+    size_t chunk;
+    while ( GetNextChunk(&chunk) )
+    {
+        wxRegExLineMatches& matches = m_chunks[chunk];
+
+        const size_t first = chunk*wxREGEX_LINES_PER_CHUNK;
+        size_t last = first + wxREGEX_LINES_PER_CHUNK;
+        if ( last > m_lines.GetCount() )
+            last = m_lines.GetCount();
+
+        for ( size_t n = first; n < last; n++ )
+        {
+            size_t len;
+            const wxChar* const line = m_lines.GetLine(n, &len, buf);
+            if ( !line )
+                continue;
+
+#ifdef WXREGEX_USING_BUILTIN
+            if ( !m_impl.DoMatch(state, line, m_flags, len) )
+                continue;
+#else // !WXREGEX_USING_BUILTIN
+            // the line must be NUL-terminated and possibly converted
+            const wxString str(line, len);
+            if ( !m_impl.DoMatch(state, WXREGEX_CHAR(str), m_flags
+                                 WXREGEX_IF_NEED_LEN(str.length())) )
+                continue;
+#endif // WXREGEX_USING_BUILTIN/!WXREGEX_USING_BUILTIN
+
+            wxRegExLineMatch match;
+            match.line = n;
+            match.start =
+            match.len = 0;
+
+            if ( !m_impl.IsNoSub() &&
+                    m_impl.GetMatch(state, &match.start, &match.len) &&
+                        !buf.samePositions )
+            {
+                m_lines.AdjustMatch(line, match);
+            }
+
+            matches.push_back(match);
+        }
+    }
+}
+
+size_t
+wxRegExLinesMatcher::Match(unsigned numThreads, wxRegExLineMatches *matches)
+{
+#ifdef WXREGEX_CAN_USE_THREADS
+    if ( !numThreads )
+    {
+        const int numCPUs = wxThread::GetCPUCount();
+        numThreads = numCPUs > 0 ? numCPUs : 1;
+    }
+
+    // there is no sense in using more threads than there are chunks
+    if ( numThreads > m_chunks.size() )
+        numThreads = m_chunks.size();
+
+    // the current thread matches the lines too, so start one thread less
+    wxVector<wxThread *> threads;
+    for ( unsigned n = 1; n < numThreads; n++ )
+    {
+        wxThread* const thread = new wxRegExLinesThread(*this);
+        if ( thread->Run() != wxTHREAD_NO_ERROR )
+        {
+            // the lines will be matched by the already running threads
+            delete thread;
+            break;
+        }
+
+        threads.push_back(thread);
+    }
+#else // !WXREGEX_CAN_USE_THREADS
+    wxUnusedVar(numThreads);
+#endif // WXREGEX_CAN_USE_THREADS/!WXREGEX_CAN_USE_THREADS
+
+    MatchChunks();
+
+#ifdef WXREGEX_CAN_USE_THREADS
+    for ( size_t n = 0; n < threads.size(); n++ )
+    {
+        threads[n]->Wait();
+        delete threads[n];
+    }
+#endif // WXREGEX_CAN_USE_THREADS
+
+    // the chunks are in order, so concatenating them gives the matches sorted
+    // by line
+    size_t count = 0;
+    for ( size_t n = 0; n < m_chunks.size(); n++ )
+        count += m_chunks[n].size();
+
+    if ( matches )
+    {
+        matches->clear();
+        matches->reserve(count);
+
+        for ( size_t n = 0; n < m_chunks.size(); n++ )
+        {
+            const wxRegExLineMatches& chunk = m_chunks[n];
+            for ( size_t i = 0; i < chunk.size(); i++ )
+                matches->push_back(chunk[i]);
+        }
+    }
+
+    return count;
+}
+
 // ----------------------------------------------------------------------------
 // wxRegEx: all methods are mostly forwarded to wxRegExImpl
 // ----------------------------------------------------------------------------
@@ -658,6 +1608,75 @@ bool wxRegEx::Matches(const wxString& str, int flags) const
                             WXREGEX_IF_NEED_LEN(str.length()));
 }
 
+bool wxRegEx::Matches(const wxChar *str, int flags, size_t len) const
+{
+    wxCHECK_MSG( IsValid(), false, wxT("must successfully Compile() first") );
+
+#if defined(WXREGEX_USING_BUILTIN) || \
+        (defined(WXREGEX_USING_RE_SEARCH) && !defined(WXREGEX_CONVERT_TO_MB))
+    // there is no need to copy the string if it doesn't need to be converted
+    // nor NUL-terminated
+    return m_impl->Matches(str, flags, len);
+#else
+    return Matches(wxString(str, len), flags);
+#endif
+}
+
+size_t wxRegEx::MatchLines(const wxArrayString& lines,
+                           wxRegExLineMatches *matches,
+                           int flags,
+                           unsigned numThreads) const
+{
+    wxCHECK_MSG( IsValid(), 0, wxT("must successfully Compile() first") );
+    wxCHECK_MSG( !(flags & ~(wxRE_NOTBOL | wxRE_NOTEOL)), 0,
+                 wxT("unrecognized flags in wxRegEx::MatchLines") );
+
+    const wxRegExArrayLines source(lines);
+    wxRegExLinesMatcher matcher(*m_impl, source, flags);
+
+    return matcher.Match(numThreads, matches);
+}
+
+size_t wxRegEx::MatchLines(const wxChar *text,
+                           const size_t *offsets,
+                           size_t count,
+                           wxRegExLineMatches *matches,
+                           int flags,
+                           unsigned numThreads) const
+{
+    wxCHECK_MSG( IsValid(), 0, wxT("must successfully Compile() first") );
+    wxCHECK_MSG( (text && offsets) || !count, 0, wxT("NULL lines") );
+    wxCHECK_MSG( !(flags & ~(wxRE_NOTBOL | wxRE_NOTEOL)), 0,
+                 wxT("unrecognized flags in wxRegEx::MatchLines") );
+
+    const wxRegExTextLines source(text, offsets, count);
+    wxRegExLinesMatcher matcher(*m_impl, source, flags);
+
+    return matcher.Match(numThreads, matches);
+}
+
+#if wxUSE_UNICODE
+
+size_t wxRegEx::MatchLinesUTF8(const char *text,
+                               const size_t *offsets,
+                               size_t count,
+                               wxRegExLineMatches *matches,
+                               int flags,
+                               unsigned numThreads) const
+{
+    wxCHECK_MSG( IsValid(), 0, wxT("must successfully Compile() first") );
+    wxCHECK_MSG( (text && offsets) || !count, 0, wxT("NULL lines") );
+    wxCHECK_MSG( !(flags & ~(wxRE_NOTBOL | wxRE_NOTEOL)), 0,
+                 wxT("unrecognized flags in wxRegEx::MatchLines") );
+
+    const wxRegExUTF8Lines source(text, offsets, count);
+    wxRegExLinesMatcher matcher(*m_impl, source, flags);
+
+    return matcher.Match(numThreads, matches);
+}
+
+#endif // wxUSE_UNICODE
+
 bool wxRegEx::GetMatch(size_t *start, size_t *len, size_t index) const
 {
     wxCHECK_MSG( IsValid(), false, wxT("must successfully Compile() first") );
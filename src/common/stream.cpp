@@ -37,6 +37,10 @@
 #include "wx/textfile.h"
 #include "wx/scopeguard.h"
 
+#if wxUSE_THREADS
+    #include "wx/thread.h"
+#endif
+
 // ----------------------------------------------------------------------------
 // constants
 // ----------------------------------------------------------------------------
@@ -832,6 +836,87 @@ bool wxInputStream::Ungetch(char c)
     return Ungetch(&c, sizeof(c)) != 0;
 }
 
+const void *wxInputStream::PeekBuffer(size_t *size)
+{
+    wxCHECK_MSG( size, NULL, wxT("NULL size pointer") );
+
+    // the data put back into the stream must be returned first
+    if ( m_wbackcur < m_wbacksize )
+    {
+        *size = m_wbacksize - m_wbackcur;
+        return m_wback + m_wbackcur;
+    }
+
+    const void * const data = DoPeekBuffer(size);
+    if ( !data )
+        *size = 0;
+
+    return data;
+}
+
+void wxInputStream::ConsumeBuffer(size_t size)
+{
+    if ( m_wbackcur < m_wbacksize )
+    {
+        wxCHECK_RET( size <= m_wbacksize - m_wbackcur,
+                     wxT("can't consume more than PeekBuffer() returned") );
+
+        m_wbackcur += size;
+        if ( m_wbackcur == m_wbacksize )
+        {
+            free(m_wback);
+            m_wback = NULL;
+            m_wbacksize = 0;
+            m_wbackcur = 0;
+        }
+    }
+    else if ( size )
+    {
+        DoConsumeBuffer(size);
+    }
+
+    m_lastcount = size;
+}
+
+const void *wxInputStream::DoPeekBuffer(size_t *size)
+{
+    // we can't avoid copying the data for the streams not keeping it in
+    // memory, but we can at least avoid copying it once again by reading it
+    // directly into a buffer which then becomes our write-back buffer
+    char * const buf = (char *)malloc(BUF_TEMP_SIZE);
+    if ( !buf )
+        return NULL;
+
+    // notice that we call OnSysRead() only once instead of using Read() which
+    // could call it again after a partial read and so set wxSTREAM_EOF error
+    // while there is still data in the buffer, making Eof() return true too
+    // early for the streams which only set it when nothing more can be read
+    *size = OnSysRead(buf, BUF_TEMP_SIZE);
+    if ( !*size )
+    {
+        free(buf);
+        return NULL;
+    }
+
+    // the write-back buffer is empty as we're only called when it is, but it
+    // may have been allocated by Ungetch() with 0 size
+    free(m_wback);
+
+    m_wback = buf;
+    m_wbacksize = *size;
+    m_wbackcur = 0;
+
+    // also notice that, unlike Ungetch(), we don't reset wxSTREAM_EOF error
+    // here if OnSysRead() set it: many streams rely on it to avoid reading
+    // anything more from their parent stream after reaching their end
+    return buf;
+}
+
+void wxInputStream::DoConsumeBuffer(size_t WXUNUSED(size))
+{
+    wxFAIL_MSG( wxT("must be overridden if DoPeekBuffer() is") );
+}
+
 int wxInputStream::GetC()
 {
     unsigned char c;
@@ -893,18 +978,23 @@ char wxInputStream::Peek()
 wxInputStream& wxInputStream::Read(wxOutputStream& stream_out)
 {
     size_t lastcount = 0;
-    char buf[BUF_TEMP_SIZE];
 
+    // write the data directly from the stream buffer, if possible: this also
+    // ensures that the data which couldn't be written remains in the stream
     for ( ;; )
     {
-        size_t bytes_read = Read(buf, WXSIZEOF(buf)).LastRead();
-        if ( !bytes_read )
+        size_t bytes_read;
+        const void * const buf = PeekBuffer(&bytes_read);
+        if ( !buf )
             break;
 
-        if ( stream_out.Write(buf, bytes_read).LastWrite() != bytes_read )
-            break;
+        const size_t bytes_written = stream_out.Write(buf, bytes_read).LastWrite();
+        ConsumeBuffer(bytes_written);
+
+        lastcount += bytes_written;
 
-        lastcount += bytes_read;
+        if ( bytes_written != bytes_read )
+            break;
     }
 
     m_lastcount = lastcount;
@@ -1328,11 +1418,199 @@ CreateBufferIfNeeded(T& stream, wxStreamBuffer *buffer, size_t bufsize = 1024)
 
 } // anonymous namespace
 
+#if wxUSE_THREADS
+
+// This class is used by wxBufferedInputStream in read-ahead mode: it reads the
+// next chunk of data from the parent stream in a background thread while the
+// previous one is being consumed. The parent stream is only accessed by the
+// background thread while a read is in progress and by the thread using the
+// buffered stream otherwise, so all wxBufferedInputStream methods using the
+// parent stream directly must call WaitIdle() first.
+class wxBufferedReadAhead
+{
+public:
+    wxBufferedReadAhead(wxInputStream& stream, size_t bufsize);
+    ~wxBufferedReadAhead();
+
+    // Return false if the background thread couldn't be created.
+    bool IsOk() const { return m_thread != NULL; }
+
+    // Copy the data read in background to the provided buffer, waiting for it
+    // if necessary, and start reading the next chunk if all of it was taken.
+    size_t Read(void *buffer, size_t size);
+
+    // Wait until the read in progress, if any, completes and return the number
+    // of bytes read from the parent stream but not consumed yet.
+    size_t WaitIdle();
+
+    // Forget the data read from the parent stream and not consumed yet.
+    void Discard() { m_pos = m_count; }
+
+    // Functions called by the background thread.
+    bool WaitForRequest();
+    void DoRead();
+
+private:
+    void StartRead();
+
+    wxInputStream& m_stream;
+
+    // The buffer used by the background thread, m_count bytes in it are
+    // valid and the first m_pos of them were already consumed.
+    char *m_buffer;
+    const size_t m_size;
+    size_t m_count,
+           m_pos;
+
+    // True while the background thread is reading into m_buffer.
+    bool m_reading;
+    bool m_stopping;
+
+    wxMutex m_mutex;
+    wxCondition m_condRequest;  // signalled when a read is requested
+    wxCondition m_condDone;     // signalled when a read is done
+
+    wxThread *m_thread;
+
+    wxDECLARE_NO_COPY_CLASS(wxBufferedReadAhead);
+};
+
+class wxBufferedReadAheadThread : public wxThread
+{
+public:
+    explicit wxBufferedReadAheadThread(wxBufferedReadAhead& readAhead)
+        : wxThread(wxTHREAD_JOINABLE),
+          m_readAhead(readAhead)
+    {
+    }
+
+protected:
+    virtual ExitCode Entry() wxOVERRIDE
+    {
+        while ( m_readAhead.WaitForRequest() )
+            m_readAhead.DoRead();
+
+        return NULL;
+    }
+
+private:
+    wxBufferedReadAhead& m_readAhead;
+
+    wxDECLARE_NO_COPY_CLASS(wxBufferedReadAheadThread);
+};
+
+wxBufferedReadAhead::wxBufferedReadAhead(wxInputStream& stream,
+                                         size_t bufsize)
+    : m_stream(stream),
+      m_size(bufsize),
+      m_condRequest(m_mutex),
+      m_condDone(m_mutex)
+{
+    m_buffer = static_cast<char *>(malloc(m_size));
+    m_count =
+    m_pos = 0;
+    m_reading =
+    m_stopping = false;
+
+    m_thread = new wxBufferedReadAheadThread(*this);
+    if ( !m_buffer || m_thread->Run() != wxTHREAD_NO_ERROR )
+    {
+        delete m_thread;
+        m_thread = NULL;
+    }
+}
+
+wxBufferedReadAhead::~wxBufferedReadAhead()
+{
+    if ( m_thread )
+    {
+        {
+            wxMutexLocker lock(m_mutex);
+            m_stopping = true;
+            m_condRequest.Signal();
+        }
+
+        m_thread->Wait();
+        delete m_thread;
+    }
+
+    free(m_buffer);
+}
+
+void wxBufferedReadAhead::StartRead()
+{
+    // must be called with m_mutex locked
+    m_reading = true;
+    m_condRequest.Signal();
+}
+
+bool wxBufferedReadAhead::WaitForRequest()
+{
+    wxMutexLocker lock(m_mutex);
+
+    while ( !m_reading && !m_stopping )
+        m_condRequest.Wait();
+
+    return !m_stopping;
+}
+
+void wxBufferedReadAhead::DoRead()
+{
+    // m_buffer and m_stream belong to this thread until m_reading is reset,
+    // so don't keep the mutex locked while reading.
+    const size_t count = m_stream.Read(m_buffer, m_size).LastRead();
+
+    wxMutexLocker lock(m_mutex);
+    m_count = count;
+    m_pos = 0;
+    m_reading = false;
+    m_condDone.Signal();
+}
+
+size_t wxBufferedReadAhead::Read(void *buffer, size_t size)
+{
+    wxMutexLocker lock(m_mutex);
+
+    if ( !m_reading && m_pos == m_count )
+        StartRead();
+
+    while ( m_reading )
+        m_condDone.Wait();
+
+    if ( size > m_count - m_pos )
+        size = m_count - m_pos;
+
+    memcpy(buffer, m_buffer + m_pos, size);
+    m_pos += size;
+
+    // Start reading the next chunk right now, so that it happens while the
+    // caller processes this one, unless we've reached the end of the parent
+    // stream (or an error occurred), in which case it would be useless and
+    // we'll try reading again only if we're explicitly asked to.
+    if ( m_pos == m_count && m_count )
+        StartRead();
+
+    return size;
+}
+
+size_t wxBufferedReadAhead::WaitIdle()
+{
+    wxMutexLocker lock(m_mutex);
+
+    while ( m_reading )
+        m_condDone.Wait();
+
+    return m_count - m_pos;
+}
+
+#endif // wxUSE_THREADS
+
 wxBufferedInputStream::wxBufferedInputStream(wxInputStream& stream,
                                              wxStreamBuffer *buffer)
                      : wxFilterInputStream(stream)
 {
     m_i_streambuf = CreateBufferIfNeeded(*this, buffer);
+    m_readAhead = NULL;
 }
 
 wxBufferedInputStream::wxBufferedInputStream(wxInputStream& stream,
@@ -1340,16 +1618,67 @@ wxBufferedInputStream::wxBufferedInputStream(wxInputStream& stream,
                      : wxFilterInputStream(stream)
 {
     m_i_streambuf = CreateBufferIfNeeded(*this, NULL, bufsize);
+    m_readAhead = NULL;
 }
 
 wxBufferedInputStream::~wxBufferedInputStream()
 {
-    m_parent_i_stream->SeekI(-(wxFileOffset)m_i_streambuf->GetBytesLeft(),
-                             wxFromCurrent);
+    wxFileOffset unread = m_i_streambuf->GetBytesLeft();
+
+#if wxUSE_THREADS
+    // the data read in background was not consumed neither
+    if ( m_readAhead )
+    {
+        unread += m_readAhead->WaitIdle();
+        delete m_readAhead;
+    }
+#endif // wxUSE_THREADS
+
+    m_parent_i_stream->SeekI(-unread, wxFromCurrent);
 
     delete m_i_streambuf;
 }
 
+bool wxBufferedInputStream::EnableReadAhead(bool enable)
+{
+#if wxUSE_THREADS
+    if ( enable == IsReadAheadEnabled() )
+        return true;
+
+    if ( enable )
+    {
+        // there is no point in reading ahead without a buffer
+        if ( !m_i_streambuf->HasBuffer() )
+            return false;
+
+        m_readAhead = new wxBufferedReadAhead(*m_parent_i_stream,
+                                              m_i_streambuf->GetBufferSize());
+        if ( !m_readAhead->IsOk() )
+        {
+            delete m_readAhead;
+            m_readAhead = NULL;
+            return false;
+        }
+    }
+    else // disable
+    {
+        // we can only stop reading ahead if we can give the data already read
+        // in background back to the parent stream
+        const size_t unread = m_readAhead->WaitIdle();
+        if ( unread &&
+                m_parent_i_stream->SeekI(-(wxFileOffset)unread,
+                                         wxFromCurrent) == wxInvalidOffset )
+            return false;
+
+        wxDELETE(m_readAhead);
+    }
+
+    return true;
+#else // !wxUSE_THREADS
+    return !enable;
+#endif // wxUSE_THREADS/!wxUSE_THREADS
+}
+
 char wxBufferedInputStream::Peek()
 {
     return m_i_streambuf->Peek();
@@ -1414,21 +1743,98 @@ wxFileOffset wxBufferedInputStream::TellI() const
     return pos;
 }
 
+bool wxBufferedInputStream::IsSeekable() const
+{
+#if wxUSE_THREADS
+    // the parent stream can't be used while it's being read in background
+    if ( m_readAhead )
+        m_readAhead->WaitIdle();
+#endif // wxUSE_THREADS
+
+    return m_parent_i_stream->IsSeekable();
+}
+
+wxFileOffset wxBufferedInputStream::GetLength() const
+{
+#if wxUSE_THREADS
+    if ( m_readAhead )
+        m_readAhead->WaitIdle();
+#endif // wxUSE_THREADS
+
+    return m_parent_i_stream->GetLength();
+}
+
 size_t wxBufferedInputStream::OnSysRead(void *buffer, size_t bufsize)
 {
+#if wxUSE_THREADS
+    if ( m_readAhead )
+        return m_readAhead->Read(buffer, bufsize);
+#endif // wxUSE_THREADS
+
     return m_parent_i_stream->Read(buffer, bufsize).LastRead();
 }
 
 wxFileOffset wxBufferedInputStream::OnSysSeek(wxFileOffset seek, wxSeekMode mode)
 {
+#if wxUSE_THREADS
+    if ( m_readAhead )
+    {
+        // the parent stream position is after the data read in background
+        const size_t unread = m_readAhead->WaitIdle();
+        m_readAhead->Discard();
+
+        if ( mode == wxFromCurrent )
+            seek -= unread;
+    }
+#endif // wxUSE_THREADS
+
     return m_parent_i_stream->SeekI(seek, mode);
 }
 
 wxFileOffset wxBufferedInputStream::OnSysTell() const
 {
+#if wxUSE_THREADS
+    if ( m_readAhead )
+    {
+        const size_t unread = m_readAhead->WaitIdle();
+
+        const wxFileOffset pos = m_parent_i_stream->TellI();
+        return pos == wxInvalidOffset ? pos : pos - unread;
+    }
+#endif // wxUSE_THREADS
+
     return m_parent_i_stream->TellI();
 }
 
+const void *wxBufferedInputStream::DoPeekBuffer(size_t *size)
+{
+    // without a buffer, we can only do the same thing as the base class
+    if ( !m_i_streambuf->HasBuffer() )
+        return wxFilterInputStream::DoPeekBuffer(size);
+
+    // this refills the buffer from the parent stream if it's empty
+    *size = m_i_streambuf->GetDataLeft();
+    if ( !*size )
+    {
+        // propagate the parent stream error, if any, or signal EOF
+        m_lasterror = m_parent_i_stream->GetLastError();
+        if ( m_lasterror == wxSTREAM_NO_ERROR )
+            m_lasterror = wxSTREAM_EOF;
+
+        return NULL;
+    }
+
+    return m_i_streambuf->GetBufferPos();
+}
+
+void wxBufferedInputStream::DoConsumeBuffer(size_t size)
+{
+    wxCHECK_RET( size <= m_i_streambuf->GetBytesLeft(),
+                 wxT("can't consume more than PeekBuffer() returned") );
+
+    m_i_streambuf->SetIntPosition(m_i_streambuf->GetIntPosition() + size);
+}
+
 void wxBufferedInputStream::SetInputStreamBuffer(wxStreamBuffer *buffer)
 {
     wxCHECK_RET( buffer, wxT("wxBufferedInputStream needs buffer") );
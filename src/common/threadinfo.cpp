@@ -72,6 +72,14 @@ wxThreadSpecificInfo& wxThreadSpecificInfo::Get()
     return *wxTHIS_THREAD_INFO;
 }
 
+wxThreadSpecificInfo::~wxThreadSpecificInfo()
+{
+#if wxUSE_LOG
+    wxReleaseLogAsyncBuffer(logAsyncBuffer);
+    wxReleaseLogAsyncQueue(logAsyncQueue);
+#endif
+}
+
 void wxThreadSpecificInfo::ThreadCleanUp()
 {
     if ( !wxTHIS_THREAD_INFO )
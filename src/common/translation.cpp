@@ -34,6 +34,7 @@
     #include "wx/utils.h"
     #include "wx/hashmap.h"
     #include "wx/module.h"
+    #include "wx/thread.h"
 #endif // WX_PRECOMP
 
 // standard headers
@@ -43,11 +44,13 @@
 #include "wx/arrstr.h"
 #include "wx/dir.h"
 #include "wx/file.h"
+#include "wx/filemapping.h"
 #include "wx/filename.h"
 #include "wx/tokenzr.h"
 #include "wx/fontmap.h"
 #include "wx/scopedptr.h"
 #include "wx/stdpaths.h"
+#include "wx/atomic.h"
 #include "wx/private/threadinfo.h"
 
 #ifdef __WINDOWS__
@@ -1007,6 +1010,15 @@ wxPluralFormsCalculator* wxPluralFormsCalculator::make(const char* s)
 
 
 
+#if wxUSE_UNICODE
+
+// map from the translations in the catalog data to the corresponding strings
+typedef const char *wxMsgCatalogDataPtr;
+WX_DECLARE_HASH_MAP(wxMsgCatalogDataPtr, wxString, wxPointerHash, wxPointerEqual,
+                    wxMsgCatalogStringsCache);
+
+#endif // wxUSE_UNICODE
+
 // ----------------------------------------------------------------------------
 // wxMsgCatalogFile corresponds to one disk-file message catalog.
 //
@@ -1025,15 +1037,28 @@ public:
     wxMsgCatalogFile();
     ~wxMsgCatalogFile();
 
-    // load the catalog from disk
+    // load the catalog from disk, mapping it into memory instead of reading
+    // it if possible if map is true
     bool LoadFile(const wxString& filename,
-                  wxPluralFormsCalculatorPtr& rPluralFormsCalculator);
+                  wxPluralFormsCalculatorPtr& rPluralFormsCalculator,
+                  bool map = false);
     bool LoadData(const DataBuffer& data,
                   wxPluralFormsCalculatorPtr& rPluralFormsCalculator);
 
     // fills the hash with string-translation pairs
     bool FillHash(wxStringToStringHashMap& hash, const wxString& domain) const;
 
+#if wxUSE_UNICODE
+    // prepare for using GetString() instead of FillHash(), return false if
+    // the catalog is invalid
+    bool InitLazyLookup();
+
+    // look up the translation of the given string, which must be already
+    // combined with its context, if any, in the catalog, returns NULL if
+    // there is no translation
+    const wxString *GetString(const wxString& str, int index) const;
+#endif // wxUSE_UNICODE
+
     // return the charset of the strings in this catalog or empty string if
     // none/unknown
     wxString GetCharset() const { return m_charset; }
@@ -1063,6 +1088,9 @@ private:
     // all data is stored here
     DataBuffer m_data;
 
+    // if the file is mapped into memory, m_data points into this mapping
+    wxFileMapping m_mapping;
+
     // data description
     size_t32          m_numStrings;   // number of strings in this domain
     wxMsgTableEntry  *m_pOrigTable,   // pointer to original   strings
@@ -1095,6 +1123,34 @@ private:
 
     bool m_bSwapped;   // wrong endianness?
 
+#if wxUSE_UNICODE
+    // hash function used by GNU gettext for the hash table in .mo files
+    static size_t32 HashString(const char *str);
+
+    // find the index of the given original string in the catalog or return
+    // m_numStrings if it's not found
+    size_t32 FindString(const char *str) const;
+
+    // the rest of the fields are only used with InitLazyLookup()
+
+    // the hash table from the catalog, NULL if it doesn't have it
+    const size_t32 *m_pHashTable;
+    size_t32 m_nHashSize;
+
+    // conversion from the catalog charset
+    wxMBConv *m_inputConv;
+    wxScopedPtr<wxMBConv> m_inputConvPtr;
+
+    // cache of the translations already converted to wxString, it only
+    // contains the strings present in the catalog, so it can't grow bigger
+    // than it: notice that pointers to the elements of the hash map remain
+    // valid when new elements are added to it
+    mutable wxMsgCatalogStringsCache m_cache;
+#if wxUSE_THREADS
+    mutable wxCriticalSection m_cacheLock;
+#endif // wxUSE_THREADS
+#endif // wxUSE_UNICODE
+
     wxDECLARE_NO_COPY_CLASS(wxMsgCatalogFile);
 };
 
@@ -1104,6 +1160,11 @@ private:
 
 wxMsgCatalogFile::wxMsgCatalogFile()
 {
+#if wxUSE_UNICODE
+    m_pHashTable = NULL;
+    m_nHashSize = 0;
+    m_inputConv = NULL;
+#endif // wxUSE_UNICODE
 }
 
 wxMsgCatalogFile::~wxMsgCatalogFile()
@@ -1112,8 +1173,28 @@ wxMsgCatalogFile::~wxMsgCatalogFile()
 
 // open disk file and read in it's contents
 bool wxMsgCatalogFile::LoadFile(const wxString& filename,
-                                wxPluralFormsCalculatorPtr& rPluralFormsCalculator)
+                                wxPluralFormsCalculatorPtr& rPluralFormsCalculator,
+                                bool map)
 {
+    if ( map && m_mapping.Open(filename) )
+    {
+        const DataBuffer
+            data = DataBuffer::CreateNonOwned
+                   (
+                        static_cast<const char *>(m_mapping.GetData()),
+                        m_mapping.GetSize()
+                   );
+
+        if ( !LoadData(data, rPluralFormsCalculator) )
+        {
+            wxLogWarning(_("'%s' is not a valid message catalog."), filename.c_str());
+            return false;
+        }
+
+        return true;
+    }
+    //else: fall back to reading the file, this may still work
+
     wxFile fileMsg(filename);
     if ( !fileMsg.IsOpened() )
         return false;
@@ -1340,14 +1421,218 @@ bool wxMsgCatalogFile::FillHash(wxStringToStringHashMap& hash,
     return true;
 }
 
+#if wxUSE_UNICODE
+
+bool wxMsgCatalogFile::InitLazyLookup()
+{
+    // we access the tables directly, so check that they're entirely inside
+    // the data first
+    const size_t len = m_data.length();
+    const size_t ofsOrig = (const char *)m_pOrigTable - m_data.data(),
+                 ofsTrans = (const char *)m_pTransTable - m_data.data();
+    const size_t entrySize = sizeof(wxMsgTableEntry);
+    if ( ofsOrig > len || (len - ofsOrig) / entrySize < m_numStrings ||
+            ofsTrans > len || (len - ofsTrans) / entrySize < m_numStrings )
+    {
+        wxLogWarning(_("Invalid message catalog."));
+        return false;
+    }
+
+    // the hash table is optional (and the double hashing used with it can't
+    // work for the sizes less than 3), we use binary search without it
+    const wxMsgCatalogHeader *pHeader = (wxMsgCatalogHeader *)m_data.data();
+    const size_t32 nHashSize = Swap(pHeader->nHashSize),
+                   ofsHash = Swap(pHeader->ofsHashTable);
+    if ( nHashSize > 2 && ofsHash <= len &&
+            (len - ofsHash) / sizeof(size_t32) >= nHashSize )
+    {
+        m_nHashSize = nHashSize;
+        m_pHashTable = (const size_t32 *)(m_data.data() + ofsHash);
+    }
+
+    // use the same conversion as FillHash(), except that we use wxConvUTF8
+    // directly for UTF-8 catalogs as wxCSConv may be much slower and, unlike
+    // with FillHash(), the strings are converted for each lookup here
+    if ( m_charset.IsSameAs(wxS("UTF-8"), false) ||
+            m_charset.IsSameAs(wxS("UTF8"), false) )
+    {
+        m_inputConv = &wxConvUTF8;
+    }
+    else if ( !m_charset.empty() )
+    {
+        m_inputConv = new wxCSConv(m_charset);
+        m_inputConvPtr.reset(m_inputConv);
+    }
+    else
+    {
+        m_inputConv = wxConvCurrent;
+    }
+
+    return true;
+}
+
+/* static */
+size_t32 wxMsgCatalogFile::HashString(const char *str)
+{
+    // this is hash_string() from gettext sources
+    size_t32 hval = 0;
+    for ( ; *str; ++str )
+    {
+        hval <<= 4;
+        hval += static_cast<unsigned char>(*str);
+
+        const size_t32 g = hval & (0xfu << 28);
+        if ( g )
+        {
+            hval ^= g >> 24;
+            hval ^= g;
+        }
+    }
+
+    return hval;
+}
+
+size_t32 wxMsgCatalogFile::FindString(const char *str) const
+{
+    if ( m_pHashTable )
+    {
+        // see gettext dcigettext.c for the description of the algorithm
+        const size_t32 hval = HashString(str);
+        const size_t32 incr = 1 + hval % (m_nHashSize - 2);
+        size_t32 idx = hval % m_nHashSize;
+
+        // limit the number of iterations to avoid looping forever if the hash
+        // table is corrupted
+        for ( size_t32 n = 0; n < m_nHashSize; n++ )
+        {
+            const size_t32 nStr = Swap(m_pHashTable[idx]);
+            if ( !nStr )
+                break;
+
+            // indices greater than the number of strings correspond to the
+            // system-dependent strings which we don't support
+            if ( nStr <= m_numStrings )
+            {
+                const char * const orig = StringAtOfs(m_pOrigTable, nStr - 1);
+                if ( orig && strcmp(orig, str) == 0 )
+                    return nStr - 1;
+            }
+
+            if ( idx >= m_nHashSize - incr )
+                idx -= m_nHashSize - incr;
+            else
+                idx += incr;
+        }
+    }
+    else // no hash table, but original strings are sorted
+    {
+        size_t32 lo = 0,
+                 hi = m_numStrings;
+        while ( lo < hi )
+        {
+            const size_t32 mid = lo + (hi - lo) / 2;
+            const char * const orig = StringAtOfs(m_pOrigTable, mid);
+            if ( !orig )
+                break;
+
+            const int cmp = strcmp(str, orig);
+            if ( cmp == 0 )
+                return mid;
+
+            if ( cmp < 0 )
+                hi = mid;
+            else
+                lo = mid + 1;
+        }
+    }
+
+    return m_numStrings;
+}
+
+const wxString *wxMsgCatalogFile::GetString(const wxString& str, int index) const
+{
+    // the catalog data is never modified after loading, so we can search it
+    // without locking and only need to lock the cache if the string is found
+
+    // the strings are usually short and ASCII, which is represented in the
+    // same way in all the charsets that can be used in MO files, so avoid
+    // the conversion, which is relatively expensive, for them
+    char ascii[256];
+    const char *msgid = NULL;
+    const size_t len = str.length();
+    if ( len < WXSIZEOF(ascii) )
+    {
+        size_t i = 0;
+        for ( wxString::const_iterator it = str.begin(); it != str.end(); ++it )
+        {
+            const wxUniChar ch = *it;
+            if ( !ch.IsAscii() )
+                break;
+
+            ascii[i++] = static_cast<char>(ch.GetValue());
+        }
+
+        if ( i == len )
+        {
+            ascii[i] = '\0';
+            msgid = ascii;
+        }
+    }
+
+    wxScopedCharBuffer msgidBuf;
+    if ( !msgid )
+    {
+        // an empty buffer is returned if the string can't be converted, in
+        // which case it can't be in the catalog neither
+        msgidBuf = str.mb_str(*m_inputConv);
+        if ( !msgidBuf.length() )
+            return NULL;
+
+        msgid = msgidBuf.data();
+    }
+
+    // notice that the empty string corresponds to the catalog header
+    const size_t32 n = FindString(msgid);
+
+    const char * const data = n < m_numStrings
+                                ? StringAtOfs(m_pTransTable, n)
+                                : NULL;
+    if ( !data )
+        return NULL;
+
+    // find the plural form with the given index, see FillHash()
+    const size_t length = Swap(m_pTransTable[n].nLen);
+    size_t offset = 0;
+    for ( int i = 0; i < index && offset < length; i++ )
+        offset += wxStrnlen(data + offset, length - offset) + 1;
+
+    if ( offset >= length )
+        return NULL;
+
+#if wxUSE_THREADS
+    wxCriticalSectionLocker lock(m_cacheLock);
+#endif // wxUSE_THREADS
+
+    // an empty string is cached if the translation can't be converted
+    wxString& msgstr = m_cache[data + offset];
+    if ( msgstr.empty() )
+        msgstr = wxString(data + offset, *m_inputConv);
+
+    return msgstr.empty() ? NULL : &msgstr;
+}
+
+#endif // wxUSE_UNICODE
+
 
 // ----------------------------------------------------------------------------
 // wxMsgCatalog class
 // ----------------------------------------------------------------------------
 
-#if !wxUSE_UNICODE
+wxDEFINE_SCOPED_PTR(wxMsgCatalogFile, wxMsgCatalogFilePtr)
+
 wxMsgCatalog::~wxMsgCatalog()
 {
+#if !wxUSE_UNICODE
     if ( m_conv )
     {
         if ( wxConvUI == m_conv )
@@ -1359,21 +1644,42 @@ wxMsgCatalog::~wxMsgCatalog()
 
         delete m_conv;
     }
-}
 #endif // !wxUSE_UNICODE
+}
+
+bool wxMsgCatalog::FinishLoading(int flags)
+{
+#if wxUSE_UNICODE
+    if ( flags & wxMSGCATALOG_LAZY )
+        return m_file->InitLazyLookup();
+#else // !wxUSE_UNICODE
+    // lazy loading is not supported in this build, the message ids may need
+    // to be converted to another encoding, see FillHash()
+    wxUnusedVar(flags);
+#endif // wxUSE_UNICODE/!wxUSE_UNICODE
+
+    const bool ok = m_file->FillHash(m_messages, m_domain);
+
+    // we don't need the data any more once we have all the messages
+    m_file.reset();
+
+    return ok;
+}
 
 /* static */
 wxMsgCatalog *wxMsgCatalog::CreateFromFile(const wxString& filename,
-                                           const wxString& domain)
+                                           const wxString& domain,
+                                           int flags)
 {
     wxScopedPtr<wxMsgCatalog> cat(new wxMsgCatalog(domain));
 
-    wxMsgCatalogFile file;
+    cat->m_file.reset(new wxMsgCatalogFile);
 
-    if ( !file.LoadFile(filename, cat->m_pluralFormsCalculator) )
+    if ( !cat->m_file->LoadFile(filename, cat->m_pluralFormsCalculator,
+                                (flags & wxMSGCATALOG_LAZY) != 0) )
         return NULL;
 
-    if ( !file.FillHash(cat->m_messages, domain) )
+    if ( !cat->FinishLoading(flags) )
         return NULL;
 
     return cat.release();
@@ -1381,16 +1687,17 @@ wxMsgCatalog *wxMsgCatalog::CreateFromFile(const wxString& filename,
 
 /* static */
 wxMsgCatalog *wxMsgCatalog::CreateFromData(const wxScopedCharBuffer& data,
-                                           const wxString& domain)
+                                           const wxString& domain,
+                                           int flags)
 {
     wxScopedPtr<wxMsgCatalog> cat(new wxMsgCatalog(domain));
 
-    wxMsgCatalogFile file;
+    cat->m_file.reset(new wxMsgCatalogFile);
 
-    if ( !file.LoadData(data, cat->m_pluralFormsCalculator) )
+    if ( !cat->m_file->LoadData(data, cat->m_pluralFormsCalculator) )
         return NULL;
 
-    if ( !file.FillHash(cat->m_messages, domain) )
+    if ( !cat->FinishLoading(flags) )
         return NULL;
 
     return cat.release();
@@ -1403,6 +1710,17 @@ const wxString *wxMsgCatalog::GetString(const wxString& str, unsigned n, const w
     {
         index = m_pluralFormsCalculator->evaluate(n);
     }
+
+#if wxUSE_UNICODE
+    if ( m_file.get() )
+    {
+        if ( context.IsEmpty() )
+            return m_file->GetString(str, index);
+        else
+            return m_file->GetString(wxString(context) + wxString('\x04') + wxString(str), index);
+    }
+#endif // wxUSE_UNICODE
+
     wxStringToStringHashMap::const_iterator i;
     if (index != 0)
     {
@@ -1438,6 +1756,19 @@ namespace
 wxTranslations *gs_translations = NULL;
 bool gs_translationsOwned = false;
 
+// incremented whenever the result of GetTranslatedString() can change for any
+// wxTranslations object to invalidate the per-thread translations caches
+wxAtomicInt gs_translationsGeneration = 1;
+
+// don't let the caches grow indefinitely if many different strings are
+// translated, just clear them when they become too big
+const size_t TRANSLATIONS_CACHE_MAX_SIZE = 4096;
+
+inline void InvalidateTranslationsCaches()
+{
+    wxAtomicInc(gs_translationsGeneration);
+}
+
 } // anonymous namespace
 
 
@@ -1454,6 +1785,8 @@ void wxTranslations::Set(wxTranslations *t)
         delete gs_translations;
     gs_translations = t;
     gs_translationsOwned = true;
+
+    InvalidateTranslationsCaches();
 }
 
 /*static*/
@@ -1463,6 +1796,8 @@ void wxTranslations::SetNonOwned(wxTranslations *t)
         delete gs_translations;
     gs_translations = t;
     gs_translationsOwned = false;
+
+    InvalidateTranslationsCaches();
 }
 
 
@@ -1470,6 +1805,10 @@ wxTranslations::wxTranslations()
 {
     m_pMsgCat = NULL;
     m_loader = new wxFileTranslationsLoader;
+
+    // this object could have been allocated at the same address as a
+    // previously destroyed one, whose translations could be still cached
+    InvalidateTranslationsCaches();
 }
 
 
@@ -1485,6 +1824,8 @@ wxTranslations::~wxTranslations()
         m_pMsgCat = m_pMsgCat->m_pNext;
         delete pTmpCat;
     }
+
+    InvalidateTranslationsCaches();
 }
 
 
@@ -1508,6 +1849,8 @@ void wxTranslations::SetLanguage(wxLanguage lang)
 void wxTranslations::SetLanguage(const wxString& lang)
 {
     m_lang = lang;
+
+    InvalidateTranslationsCaches();
 }
 
 
@@ -1622,6 +1965,8 @@ bool wxTranslations::LoadCatalog(const wxString& domain, const wxString& lang, c
         m_pMsgCat = cat;
         m_catalogMap[domain] = cat;
 
+        InvalidateTranslationsCaches();
+
         return true;
     }
     else
@@ -1695,6 +2040,42 @@ const wxString *wxTranslations::GetTranslatedString(const wxString& origString,
     if ( origString.empty() )
         return NULL;
 
+    // Use the per-thread cache of the previous results to avoid looking up the
+    // string in all catalogs every time, which is relatively slow. This
+    // doesn't need any locking, but only works for the singular strings, as
+    // the translations of plural ones depend on n.
+    wxTranslationsCache *cache = NULL;
+    wxString key;
+    if ( n == UINT_MAX )
+    {
+        cache = &wxThreadInfo.translationsCache;
+
+        const int generation = gs_translationsGeneration;
+        if ( cache->translations != this || cache->generation != generation )
+        {
+            cache->map.clear();
+            cache->translations = this;
+            cache->generation = generation;
+        }
+
+        // avoid making a copy of the string in the most common case
+        wxTranslationsCacheMap::const_iterator it;
+        if ( domain.empty() && context.empty() )
+        {
+            it = cache->map.find(origString);
+        }
+        else
+        {
+            // '\x04' is used as context separator in the catalogs, so it can't
+            // occur in the strings
+            key << domain << wxS('\x04') << context << wxS('\x04') << origString;
+            it = cache->map.find(key);
+        }
+
+        if ( it != cache->map.end() )
+            return it->second;
+    }
+
     const wxString *trans = NULL;
     wxMsgCatalog *pMsgCat;
 
@@ -1731,6 +2112,14 @@ const wxString *wxTranslations::GetTranslatedString(const wxString& origString,
         );
     }
 
+    if ( cache )
+    {
+        if ( cache->map.size() >= TRANSLATIONS_CACHE_MAX_SIZE )
+            cache->map.clear();
+
+        cache->map[key.empty() ? origString : key] = trans;
+    }
+
     return trans;
 }
 
@@ -1944,7 +2333,7 @@ wxMsgCatalog *wxFileTranslationsLoader::LoadCatalog(const wxString& domain,
     wxLogVerbose(_("using catalog '%s' from '%s'."), domain, strFullName.c_str());
     wxLogTrace(TRACE_I18N, wxS("Using catalog \"%s\"."), strFullName.c_str());
 
-    return wxMsgCatalog::CreateFromFile(strFullName, domain);
+    return wxMsgCatalog::CreateFromFile(strFullName, domain, m_flags);
 }
 
 
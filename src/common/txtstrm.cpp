@@ -41,6 +41,8 @@ wxTextInputStream::wxTextInputStream(wxInputStream &s,
 #if SIZEOF_WCHAR_T == 2
     m_lastWChar = 0;
 #endif // SIZEOF_WCHAR_T == 2
+
+    m_hasDecoded = false;
 }
 #else
 wxTextInputStream::wxTextInputStream(wxInputStream &s, const wxString &sep)
@@ -139,6 +141,7 @@ wxChar wxTextInputStream::GetChar()
                 // just the first byte and keep the other ones for the next
                 // time.
                 m_validBegin = 1;
+                m_hasDecoded = true;
                 return wbuf[0];
 
 #if SIZEOF_WCHAR_T == 2
@@ -154,6 +157,7 @@ wxChar wxTextInputStream::GetChar()
 
             case 1:
                 m_validBegin = inlen + 1;
+                m_hasDecoded = true;
 
                 // we finally decoded a character
                 return wbuf[0];
@@ -299,10 +303,170 @@ double wxTextInputStream::ReadDouble()
     return wxStrtod(word.c_str(), 0);
 }
 
+bool wxTextInputStream::CanReadLineFromBuffer() const
+{
+#if wxUSE_UNICODE
+    // Any data remaining from the last GetChar() call must be returned first.
+    if ( m_validBegin < m_validEnd )
+        return false;
+
+#if SIZEOF_WCHAR_T == 2
+    if ( m_lastWChar )
+        return false;
+#endif // SIZEOF_WCHAR_T == 2
+
+    // We need to be able to find the end of line by just looking for the
+    // corresponding bytes, which is the case for UTF-8 and all the other
+    // encodings using a single NUL byte, but not for UTF-16 or UTF-32.
+    return m_hasDecoded && m_conv->GetMBNulLen() == 1;
+#else // !wxUSE_UNICODE
+    return true;
+#endif // wxUSE_UNICODE/!wxUSE_UNICODE
+}
+
+bool
+wxTextInputStream::DecodeLine(wxString& line, const char* data, size_t len) const
+{
+    if ( !len )
+        return true;
+
+#if wxUSE_UNICODE
+    const size_t wlen = m_conv->ToWChar(NULL, 0, data, len);
+    if ( wlen == wxCONV_FAILED )
+        return false;
+
+    wxWCharBuffer wbuf(wlen);
+    if ( m_conv->ToWChar(wbuf.data(), wlen, data, len) == wxCONV_FAILED )
+        return false;
+
+    line.assign(wbuf.data(), wlen);
+#else // !wxUSE_UNICODE
+    line.assign(data, len);
+#endif // wxUSE_UNICODE/!wxUSE_UNICODE
+
+    return true;
+}
+
+bool wxTextInputStream::ReadLineFromBuffer(wxString& line)
+{
+    // The bytes of the line found in the previous chunks of data, only used
+    // if the line doesn't fit into a single chunk.
+    wxMemoryBuffer pending;
+
+    for ( ;; )
+    {
+        size_t size;
+        const char* const
+            data = static_cast<const char*>(m_input.PeekBuffer(&size));
+        if ( !data )
+        {
+            // Last line without the trailing EOL.
+            if ( !DecodeLine(line,
+                             static_cast<const char*>(pending.GetData()),
+                             pending.GetDataLen()) )
+                break;
+
+            // Signal the error just as the code using GetChar() does.
+            if ( !m_input.Eof() )
+                m_input.Reset(wxSTREAM_READ_ERROR);
+
+            return true;
+        }
+
+        // Find the end of the line in this chunk, if it's there, using
+        // memchr() as it's much faster than checking the bytes one by one.
+        const char* end = static_cast<const char*>(memchr(data, '\n', size));
+        if ( !end )
+            end = data + size;
+
+        const char* const
+            cr = static_cast<const char*>(memchr(data, '\r', end - data));
+        if ( cr )
+            end = cr;
+
+        // NUL bytes are interpreted as errors by GetChar() and we want to
+        // preserve this behaviour, so let it handle them.
+        if ( memchr(data, '\0', end - data) )
+            break;
+
+        if ( end == data + size )
+        {
+            // No EOL in this chunk, remember it and continue with the next one.
+            pending.AppendData(data, size);
+            m_input.ConsumeBuffer(size);
+            continue;
+        }
+
+        // We found the end of line, decode it, directly from the stream
+        // buffer if possible.
+        bool ok;
+        if ( pending.IsEmpty() )
+        {
+            ok = DecodeLine(line, data, end - data);
+        }
+        else
+        {
+            const size_t lenPending = pending.GetDataLen();
+            pending.AppendData(data, end - data);
+            ok = DecodeLine(line,
+                            static_cast<const char*>(pending.GetData()),
+                            pending.GetDataLen());
+            pending.SetDataLen(lenPending);
+        }
+
+        if ( !ok )
+            break;
+
+        // Consume the line and EOL, which can be "\n", "\r" or "\r\n".
+        size_t count = end - data + 1;
+        if ( *end == '\r' )
+        {
+            if ( count < size )
+            {
+                if ( end[1] == '\n' )
+                    count++;
+            }
+            else // "\r" is the last byte of this chunk, check the next one.
+            {
+                m_input.ConsumeBuffer(count);
+
+                count = 0;
+                const char* const
+                    next = static_cast<const char*>(m_input.PeekBuffer(&size));
+                if ( next && *next == '\n' )
+                    count = 1;
+            }
+        }
+
+        m_input.ConsumeBuffer(count);
+
+        return true;
+    }
+
+    // Put back the data we consumed so that it can be read by GetChar().
+    if ( !pending.IsEmpty() )
+        m_input.Ungetch(pending.GetData(), pending.GetDataLen());
+
+    line.clear();
+
+    return false;
+}
+
 wxString wxTextInputStream::ReadLine()
 {
     wxString line;
 
+    // Reading the line directly from the stream buffer is much faster than
+    // using GetChar() below, so do it whenever possible.
+    if ( CanReadLineFromBuffer() && ReadLineFromBuffer(line) )
+    {
+        // Ensure that UngetLast() doesn't put back the bytes we didn't read.
+        m_validBegin =
+        m_validEnd = 0;
+
+        return line;
+    }
+
     for ( ;; )
     {
         wxChar c = GetChar();
@@ -236,6 +236,83 @@ bool wxFileStream::IsOk() const
     return wxFileOutputStream::IsOk() && wxFileInputStream::IsOk();
 }
 
+// ----------------------------------------------------------------------------
+// wxMappedFileInputStream
+// ----------------------------------------------------------------------------
+
+wxMappedFileInputStream::wxMappedFileInputStream(const wxString& fileName)
+                       : m_mapping(fileName)
+{
+    m_pos = 0;
+
+    if ( !m_mapping.IsOk() )
+        m_lasterror = wxSTREAM_READ_ERROR;
+}
+
+size_t wxMappedFileInputStream::OnSysRead(void *buffer, size_t size)
+{
+    const size_t left = m_mapping.GetSize() - m_pos;
+    if ( !left )
+    {
+        m_lasterror = wxSTREAM_EOF;
+        return 0;
+    }
+
+    if ( size > left )
+        size = left;
+
+    memcpy(buffer, static_cast<const char*>(m_mapping.GetData()) + m_pos, size);
+    m_pos += size;
+
+    return size;
+}
+
+wxFileOffset wxMappedFileInputStream::OnSysSeek(wxFileOffset pos, wxSeekMode mode)
+{
+    const wxFileOffset length = GetLength();
+
+    switch ( mode )
+    {
+        case wxFromStart:
+            break;
+
+        case wxFromCurrent:
+            pos += m_pos;
+            break;
+
+        case wxFromEnd:
+            pos += length;
+            break;
+    }
+
+    if ( pos < 0 || pos > length )
+        return wxInvalidOffset;
+
+    m_pos = static_cast<size_t>(pos);
+
+    return pos;
+}
+
+const void *wxMappedFileInputStream::DoPeekBuffer(size_t *size)
+{
+    *size = m_mapping.GetSize() - m_pos;
+    if ( !*size )
+    {
+        m_lasterror = wxSTREAM_EOF;
+        return NULL;
+    }
+
+    return static_cast<const char*>(m_mapping.GetData()) + m_pos;
+}
+
+void wxMappedFileInputStream::DoConsumeBuffer(size_t size)
+{
+    wxCHECK_RET( size <= m_mapping.GetSize() - m_pos,
+                 "can't consume more than PeekBuffer() returned" );
+
+    m_pos += size;
+}
+
 #endif // wxUSE_FILE
 
 #if wxUSE_FFILE
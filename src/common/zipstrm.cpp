@@ -29,6 +29,7 @@
 #include "wx/mstream.h"
 #include "wx/scopedptr.h"
 #include "wx/wfstream.h"
+#include "wx/filemapping.h"
 #include "zlib.h"
 
 // value for the 'version needed to extract' field (20 means 2.0)
@@ -554,8 +555,8 @@ size_t wxRawInputStream::OnSysRead(void *buffer, size_t size)
 class wxZlibOutputStream2 : public wxZlibOutputStream
 {
 public:
-    wxZlibOutputStream2(wxOutputStream& stream, int level) :
-        wxZlibOutputStream(stream, level, wxZLIB_NO_HEADER) { }
+    wxZlibOutputStream2(wxOutputStream& stream, int level, int flags) :
+        wxZlibOutputStream(stream, level, flags | wxZLIB_NO_HEADER) { }
 
     bool Open(wxOutputStream& stream);
     bool Close() wxOVERRIDE { DoFlush(true); m_pos = wxInvalidOffset; return IsOk(); }
@@ -565,13 +566,11 @@ bool wxZlibOutputStream2::Open(wxOutputStream& stream)
 {
     wxCHECK(m_pos == wxInvalidOffset, false);
 
-    m_deflate->next_out = m_z_buffer;
-    m_deflate->avail_out = m_z_size;
     m_pos = 0;
     m_lasterror = wxSTREAM_NO_ERROR;
     m_parent_o_stream = &stream;
 
-    if (deflateReset(m_deflate) != Z_OK) {
+    if (!ResetDeflate()) {
         wxLogError(_("can't re-initialize zlib deflate stream"));
         m_lasterror = wxSTREAM_WRITE_ERROR;
         return false;
@@ -800,33 +799,45 @@ wxZipEntry::wxZipEntry(const wxZipEntry& e)
 wxZipEntry& wxZipEntry::operator=(const wxZipEntry& e)
 {
     if (&e != this) {
-        m_SystemMadeBy = e.m_SystemMadeBy;
-        m_VersionMadeBy = e.m_VersionMadeBy;
-        m_VersionNeeded = e.m_VersionNeeded;
-        m_Flags = e.m_Flags;
-        m_Method = e.m_Method;
-        m_DateTime = e.m_DateTime;
-        m_Crc = e.m_Crc;
-        m_CompressedSize = e.m_CompressedSize;
-        m_Size = e.m_Size;
-        m_Name = e.m_Name;
-        m_Key = e.m_Key;
-        m_Offset = e.m_Offset;
-        m_Comment = e.m_Comment;
-        m_DiskStart = e.m_DiskStart;
-        m_InternalAttributes = e.m_InternalAttributes;
-        m_ExternalAttributes = e.m_ExternalAttributes;
+        AssignFields(e);
         Copy(m_Extra, e.m_Extra);
         Copy(m_LocalExtra, e.m_LocalExtra);
-        m_zipnotifier = NULL;
-        if (m_backlink) {
-            m_backlink->Release(m_Key);
-            m_backlink = NULL;
-        }
     }
     return *this;
 }
 
+void wxZipEntry::AssignUnshared(const wxZipEntry& e)
+{
+    AssignFields(e);
+    SetExtra(e.GetExtra(), e.GetExtraLen());
+    SetLocalExtra(e.GetLocalExtra(), e.GetLocalExtraLen());
+}
+
+void wxZipEntry::AssignFields(const wxZipEntry& e)
+{
+    m_SystemMadeBy = e.m_SystemMadeBy;
+    m_VersionMadeBy = e.m_VersionMadeBy;
+    m_VersionNeeded = e.m_VersionNeeded;
+    m_Flags = e.m_Flags;
+    m_Method = e.m_Method;
+    m_DateTime = e.m_DateTime;
+    m_Crc = e.m_Crc;
+    m_CompressedSize = e.m_CompressedSize;
+    m_Size = e.m_Size;
+    m_Name = e.m_Name;
+    m_Key = e.m_Key;
+    m_Offset = e.m_Offset;
+    m_Comment = e.m_Comment;
+    m_DiskStart = e.m_DiskStart;
+    m_InternalAttributes = e.m_InternalAttributes;
+    m_ExternalAttributes = e.m_ExternalAttributes;
+    m_zipnotifier = NULL;
+    if (m_backlink) {
+        m_backlink->Release(m_Key);
+        m_backlink = NULL;
+    }
+}
+
 wxString wxZipEntry::GetName(wxPathFormat format /*=wxPATH_NATIVE*/) const
 {
     bool isDir = IsDir() && !m_Name.empty();
@@ -2156,6 +2167,178 @@ size_t wxZipInputStream::OnSysRead(void *buffer, size_t size)
     return count;
 }
 
+bool wxZipInputStream::OpenIndexedEntry(const wxZipEntry& entry)
+{
+    // the central directory has already been read, so don't look for the
+    // end record, and make GetNextEntry() report the end of the archive
+    if (!m_parent_i_stream->IsSeekable())
+        return false;
+
+    m_parentSeekable = true;
+    m_position = 0;
+    m_signature = END_MAGIC;
+
+    // DoOpen() updates the local extra field of the entry it is given, so
+    // use a copy of it. Notice that it must not share the extra fields with
+    // the original entry, as their reference count is not atomic and the
+    // same entry of wxZipIndex can be opened by several threads at once.
+    wxZipEntry copy;
+    copy.AssignUnshared(entry);
+    return DoOpen(&copy);
+}
+
+/////////////////////////////////////////////////////////////////////////////
+// Index
+
+WX_DECLARE_STRING_HASH_MAP(size_t, wxZipIndexNames_);
+
+wxZipIndex::wxZipIndex(const wxString& filename,
+                       wxMBConv& conv /*=wxConvLocal*/)
+{
+    Init(conv);
+
+    m_filename = filename;
+
+#if wxUSE_FILE
+    // mapping the file allows the entries to be read without any system calls
+    // and without opening the file again for every entry
+    {
+        wxLogNull nolog;
+        m_mapping = new wxFileMapping(filename);
+    }
+
+    if (m_mapping->IsOk() && m_mapping->GetData()) {
+        m_data = m_mapping->GetData();
+        m_size = m_mapping->GetSize();
+    }
+    else {
+        wxDELETE(m_mapping);
+    }
+#endif // wxUSE_FILE
+
+    Load();
+}
+
+wxZipIndex::wxZipIndex(const void *data,
+                       size_t size,
+                       wxMBConv& conv /*=wxConvLocal*/)
+{
+    Init(conv);
+
+    m_data = data;
+    m_size = size;
+
+    Load();
+}
+
+void wxZipIndex::Init(wxMBConv& conv)
+{
+    m_conv = &conv;
+    m_mapping = NULL;
+    m_data = NULL;
+    m_size = 0;
+    m_names = new wxZipIndexNames_;
+    m_ok = false;
+}
+
+wxZipIndex::~wxZipIndex()
+{
+    for (size_t n = 0; n < m_entries.size(); n++)
+        delete m_entries[n];
+
+    delete m_names;
+
+#if wxUSE_FILE
+    delete m_mapping;
+#endif
+}
+
+wxInputStream *wxZipIndex::OpenSource() const
+{
+    if (m_data)
+        return new wxMemoryInputStream(m_data, m_size);
+
+#if wxUSE_FILE
+    if (!m_filename.empty()) {
+        wxFileInputStream *file = new wxFileInputStream(m_filename);
+        if (file->IsOk())
+            return file;
+        delete file;
+    }
+#endif // wxUSE_FILE
+
+    return NULL;
+}
+
+void wxZipIndex::Load()
+{
+    wxInputStream *source = OpenSource();
+    if (!source)
+        return;
+
+    wxZipInputStream zip(source, *m_conv);
+
+    const int total = zip.GetTotalEntries();
+    if (total > 0)
+        m_entries.reserve(total);
+
+    for (;;) {
+        wxZipEntryPtr_ entry(zip.GetNextEntry());
+        if (!entry.get())
+            break;
+
+        // store a copy not linked to the temporary stream used here
+        m_entries.push_back(new wxZipEntry(*entry));
+
+        // if there are several entries with the same name, the first one
+        // is found, as when searching the archive sequentially
+        const wxString& name = entry->GetInternalName();
+        if (m_names->find(name) == m_names->end())
+            (*m_names)[name] = m_entries.size() - 1;
+    }
+
+    m_comment = zip.GetComment();
+    m_ok = zip.GetLastError() == wxSTREAM_EOF;
+}
+
+int wxZipIndex::Find(const wxString& name,
+                     wxPathFormat format /*=wxPATH_NATIVE*/) const
+{
+    const wxZipIndexNames_::const_iterator
+        it = m_names->find(wxZipEntry::GetInternalName(name, format));
+    if (it == m_names->end())
+        return wxNOT_FOUND;
+
+    return static_cast<int>(it->second);
+}
+
+wxZipInputStream *wxZipIndex::OpenEntry(size_t n) const
+{
+    wxCHECK_MSG(n < m_entries.size(), NULL, wxS("invalid zip entry index"));
+
+    wxInputStream *source = OpenSource();
+    if (!source)
+        return NULL;
+
+    wxZipInputStream *zip = new wxZipInputStream(source, *m_conv);
+    if (!zip->OpenIndexedEntry(*m_entries[n])) {
+        delete zip;
+        return NULL;
+    }
+
+    return zip;
+}
+
+wxZipInputStream *wxZipIndex::OpenEntry(const wxString& name,
+                                        wxPathFormat format) const
+{
+    const int n = Find(name, format);
+    if (n == wxNOT_FOUND)
+        return NULL;
+
+    return OpenEntry(static_cast<size_t>(n));
+}
+
 /////////////////////////////////////////////////////////////////////////////
 // Output stream
 
@@ -2192,6 +2375,7 @@ void wxZipOutputStream::Init(int level)
     m_entrySize = 0;
     m_comp = NULL;
     m_level = level;
+    m_parallel = false;
     m_offsetAdjustment = wxInvalidOffset;
     m_endrecWritten = false;
     m_format = wxZIP_FORMAT_DEFAULT;
@@ -2282,6 +2466,16 @@ void wxZipOutputStream::SetLevel(int level)
     }
 }
 
+void wxZipOutputStream::EnableParallelDeflate(bool enable)
+{
+    if (enable != m_parallel) {
+        if (m_comp != m_deflate)
+            delete m_deflate;
+        m_deflate = NULL;
+        m_parallel = enable;
+    }
+}
+
 bool wxZipOutputStream::DoCreate(wxZipEntry *entry, bool raw /*=false*/)
 {
     CloseEntry();
@@ -2370,7 +2564,8 @@ wxOutputStream *wxZipOutputStream::OpenCompressor(
                             defbits | wxZIP_SUMS_FOLLOW);
 
             if (!m_deflate)
-                m_deflate = new wxZlibOutputStream2(stream, GetLevel());
+                m_deflate = new wxZlibOutputStream2(stream, GetLevel(),
+                                        m_parallel ? wxZLIB_PARALLEL : 0);
             else
                 m_deflate->Open(stream);
 
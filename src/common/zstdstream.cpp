@@ -0,0 +1,350 @@
+///////////////////////////////////////////////////////////////////////////////
+// Name:        src/common/zstdstream.cpp
+// Purpose:     Implementation of Zstandard stream classes
+// Author:      wxWidgets development team
+// Created:     2026-10-19
+// Copyright:   (c) 2026 wxWidgets development team
+// Licence:     wxWindows licence
+///////////////////////////////////////////////////////////////////////////////
+
+// ============================================================================
+// declarations
+// ============================================================================
+
+// ----------------------------------------------------------------------------
+// headers
+// ----------------------------------------------------------------------------
+
+// for compilers that support precompilation, includes "wx.h".
+#include "wx/wxprec.h"
+
+#ifdef __BORLANDC__
+    #pragma hdrstop
+#endif
+
+#if wxUSE_LIBZSTD && wxUSE_STREAMS
+
+#include "wx/zstdstream.h"
+
+#ifndef WX_PRECOMP
+    #include "wx/log.h"
+    #include "wx/translation.h"
+#endif // WX_PRECOMP
+
+#if wxUSE_THREADS
+    #include "wx/thread.h"
+#endif
+
+#include <zstd.h>
+
+// ============================================================================
+// implementation
+// ============================================================================
+
+// ----------------------------------------------------------------------------
+// Functions
+// ----------------------------------------------------------------------------
+
+wxVersionInfo wxGetLibZstdVersionInfo()
+{
+    const unsigned ver = ZSTD_versionNumber();
+
+    return wxVersionInfo
+           (
+            "libzstd",
+            ver / 10000,
+            (ver % 10000) / 100,
+            ver % 100
+           );
+}
+
+// ----------------------------------------------------------------------------
+// wxZstdInputStream: decompression
+// ----------------------------------------------------------------------------
+
+void wxZstdInputStream::Init()
+{
+    m_inBufSize = ZSTD_DStreamInSize();
+    m_inBuf = new wxUint8[m_inBufSize];
+    m_inPos =
+    m_inSize = 0;
+    m_inFrame = false;
+    m_hasOutput = false;
+    m_pos = 0;
+
+    m_dctx = ZSTD_createDCtx();
+    if ( !m_dctx )
+    {
+        wxLogError(_("Failed to allocate memory for Zstandard decompression."));
+
+        m_lasterror = wxSTREAM_READ_ERROR;
+    }
+}
+
+wxZstdInputStream::~wxZstdInputStream()
+{
+    ZSTD_freeDCtx(m_dctx);
+
+    delete [] m_inBuf;
+}
+
+size_t wxZstdInputStream::OnSysRead(void* outbuf, size_t size)
+{
+    ZSTD_outBuffer out = { outbuf, size, 0 };
+
+    // Decompress input as long as we don't have any errors (including EOF, as
+    // it doesn't make sense to continue after it neither) and have space to
+    // decompress it to.
+    while ( m_lasterror == wxSTREAM_NO_ERROR && out.pos < out.size )
+    {
+        // Get more input data if needed, but only if the decompressor doesn't
+        // have any buffered output left, as it could be the last part of it.
+        if ( m_inPos == m_inSize && !m_hasOutput )
+        {
+            m_parent_i_stream->Read(m_inBuf, m_inBufSize);
+            m_inPos = 0;
+            m_inSize = m_parent_i_stream->LastRead();
+
+            if ( !m_inSize )
+            {
+                if ( m_parent_i_stream->GetLastError() != wxSTREAM_EOF )
+                {
+                    m_lasterror = wxSTREAM_READ_ERROR;
+                    return 0;
+                }
+
+                if ( m_inFrame )
+                {
+                    wxLogError(_("Zstandard decompression error: %s"),
+                               _("input is truncated"));
+
+                    m_lasterror = wxSTREAM_READ_ERROR;
+                    return 0;
+                }
+
+                // We have reached end of the underlying stream.
+                m_lasterror = wxSTREAM_EOF;
+                break;
+            }
+        }
+
+        ZSTD_inBuffer in = { m_inBuf, m_inSize, m_inPos };
+        const size_t outPos = out.pos;
+        const size_t rc = ZSTD_decompressStream(m_dctx, &out, &in);
+        if ( ZSTD_isError(rc) )
+        {
+            wxLogError(_("Zstandard decompression error: %s"),
+                       ZSTD_getErrorName(rc));
+
+            m_lasterror = wxSTREAM_READ_ERROR;
+            return 0;
+        }
+
+        // Non-zero return value means that the current frame is not complete
+        // yet, several frames can follow each other, so we only stop at the
+        // end of the underlying stream. Notice that we must not take it into
+        // account if nothing was done at all, as the decompressor returns
+        // non-zero when called at the end of a frame without any new input.
+        if ( in.pos != m_inPos || out.pos != outPos )
+            m_inFrame = rc != 0;
+
+        m_inPos = in.pos;
+
+        // If the output buffer is full, there might be more output pending.
+        m_hasOutput = out.pos == out.size;
+    }
+
+    // Return the number of bytes actually read, this may be less than the
+    // requested size if we hit EOF.
+    m_pos += out.pos;
+    return out.pos;
+}
+
+// ----------------------------------------------------------------------------
+// wxZstdOutputStream: compression
+// ----------------------------------------------------------------------------
+
+/* static */
+int wxZstdOutputStream::GetMaxLevel()
+{
+    return ZSTD_maxCLevel();
+}
+
+void wxZstdOutputStream::Init(int level, int threads)
+{
+    m_outBufSize = ZSTD_CStreamOutSize();
+    m_outBuf = new wxUint8[m_outBufSize];
+    m_finished = false;
+    m_pos = 0;
+
+    m_cctx = ZSTD_createCCtx();
+    if ( !m_cctx )
+    {
+        wxLogError(_("Failed to allocate memory for Zstandard compression."));
+
+        m_lasterror = wxSTREAM_WRITE_ERROR;
+        return;
+    }
+
+    if ( level == -1 )
+        level = ZSTD_CLEVEL_DEFAULT;
+
+    size_t rc = ZSTD_CCtx_setParameter(m_cctx, ZSTD_c_compressionLevel, level);
+    if ( ZSTD_isError(rc) )
+    {
+        wxLogError(_("Failed to initialize Zstandard compression: %s"),
+                   ZSTD_getErrorName(rc));
+
+        m_lasterror = wxSTREAM_WRITE_ERROR;
+        return;
+    }
+
+    wxASSERT_MSG( threads >= 0, "invalid number of threads" );
+
+    if ( threads == 0 )
+    {
+#if wxUSE_THREADS
+        threads = wxThread::GetCPUCount();
+#endif
+        if ( threads < 1 )
+            threads = 1;
+    }
+
+    // Using workers makes the compression asynchronous, so only do it when
+    // really using more than one thread. This fails if the library was built
+    // without multithreading support and compression is just done in the
+    // current thread then.
+    if ( threads > 1 )
+    {
+        rc = ZSTD_CCtx_setParameter(m_cctx, ZSTD_c_nbWorkers, threads);
+        wxUnusedVar(rc);
+    }
+}
+
+wxZstdOutputStream::~wxZstdOutputStream()
+{
+    Close();
+
+    ZSTD_freeCCtx(m_cctx);
+
+    delete [] m_outBuf;
+}
+
+bool wxZstdOutputStream::Compress(const void *buffer, size_t size, int directive)
+{
+    ZSTD_inBuffer in = { buffer, size, 0 };
+    const ZSTD_EndDirective op = static_cast<ZSTD_EndDirective>(directive);
+
+    // When just compressing, stop as soon as all input is consumed, but when
+    // flushing continue until the compressor indicates that it's done.
+    for ( ;; )
+    {
+        ZSTD_outBuffer out = { m_outBuf, m_outBufSize, 0 };
+
+        const size_t rc = ZSTD_compressStream2(m_cctx, &out, &in, op);
+        if ( ZSTD_isError(rc) )
+        {
+            wxLogError(_("Zstandard compression error: %s"),
+                       ZSTD_getErrorName(rc));
+
+            m_lasterror = wxSTREAM_WRITE_ERROR;
+            return false;
+        }
+
+        if ( out.pos )
+        {
+            m_parent_o_stream->Write(m_outBuf, out.pos);
+            if ( m_parent_o_stream->LastWrite() != out.pos )
+            {
+                m_lasterror = wxSTREAM_WRITE_ERROR;
+                return false;
+            }
+        }
+
+        if ( op == ZSTD_e_continue ? in.pos == in.size : rc == 0 )
+            break;
+    }
+
+    return true;
+}
+
+size_t wxZstdOutputStream::OnSysWrite(const void *inbuf, size_t size)
+{
+    // It's useless to try to continue after an error (or even starting if the
+    // stream had already been in an error state).
+    if ( m_lasterror != wxSTREAM_NO_ERROR || !size )
+        return 0;
+
+    // Writing after closing the stream starts a new frame.
+    m_finished = false;
+
+    if ( !Compress(inbuf, size, ZSTD_e_continue) )
+        return 0;
+
+    m_pos += size;
+    return size;
+}
+
+bool wxZstdOutputStream::DoFlush(bool finish)
+{
+    if ( m_lasterror != wxSTREAM_NO_ERROR )
+        return false;
+
+    // Don't output an extra empty frame if the stream is closed twice.
+    if ( m_finished )
+        return true;
+
+    if ( !Compress(NULL, 0, finish ? ZSTD_e_end : ZSTD_e_flush) )
+        return false;
+
+    if ( finish )
+        m_finished = true;
+
+    return true;
+}
+
+bool wxZstdOutputStream::Close()
+{
+    if ( !DoFlush(true) )
+        return false;
+
+    return wxFilterOutputStream::Close() && IsOk();
+}
+
+// ----------------------------------------------------------------------------
+// wxZstdClassFactory: allow creating streams from extension/MIME type
+// ----------------------------------------------------------------------------
+
+wxIMPLEMENT_DYNAMIC_CLASS(wxZstdClassFactory, wxFilterClassFactory);
+
+static wxZstdClassFactory g_wxZstdClassFactory;
+
+wxZstdClassFactory::wxZstdClassFactory()
+{
+    m_level = -1;
+    m_threads = 1;
+
+    if ( this == &g_wxZstdClassFactory )
+        PushFront();
+}
+
+const wxChar * const *
+wxZstdClassFactory::GetProtocols(wxStreamProtocolType type) const
+{
+    static const wxChar *mime[] = { wxT("application/zstd"), NULL };
+    static const wxChar *encs[] = { wxT("zstd"), NULL };
+    static const wxChar *exts[] = { wxT(".zst"), NULL };
+
+    const wxChar* const* ret = NULL;
+    switch ( type )
+    {
+        case wxSTREAM_PROTOCOL: ret = encs; break;
+        case wxSTREAM_MIMETYPE: ret = mime; break;
+        case wxSTREAM_ENCODING: ret = encs; break;
+        case wxSTREAM_FILEEXT:  ret = exts; break;
+    }
+
+    return ret;
+}
+
+#endif // wxUSE_LIBZSTD && wxUSE_STREAMS
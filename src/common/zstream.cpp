@@ -26,6 +26,11 @@
     #include "wx/utils.h"
 #endif
 
+#if wxUSE_THREADS
+    #include "wx/thread.h"
+    #include "wx/vector.h"
+#endif // wxUSE_THREADS
+
 
 // normally, the compiler options should contain -I../zlib, but it is
 // apparently not the case for all MSW makefiles and so, unless we use
@@ -277,6 +282,561 @@ bool wxZlibInputStream::SetDictionary(const wxMemoryBuffer &buf)
 }
 
 
+#if wxUSE_THREADS
+
+//////////////////////
+// wxZlibParallelDeflate
+//////////////////////
+
+// Parallel compression works by splitting the input into blocks compressed
+// independently by the worker threads, using the end of the previous block
+// as dictionary to avoid losing compression ratio, and concatenating the
+// results which are all byte aligned as each block except the last one ends
+// with a sync flush. This is the same approach as used by pigz.
+
+namespace
+{
+
+const size_t ZSTREAM_PARALLEL_BLOCK_SIZE = 131072;
+const size_t ZSTREAM_DICT_SIZE = 32768;     // maximal deflate window size
+
+struct wxZlibBlock
+{
+    wxZlibBlock() { m_check = 0; m_last = m_done = m_ok = false; }
+
+    wxMemoryBuffer m_in;    // uncompressed data
+    wxMemoryBuffer m_dict;  // dictionary to use for compressing it
+    wxMemoryBuffer m_out;   // compressed data
+    uLong m_check;          // adler32 or crc32 of m_in, depending on format
+    bool m_last;            // true for the last block of the stream
+    bool m_done;            // true once the worker thread is done with it
+    bool m_ok;              // false if compression failed
+};
+
+void WriteBigEndian32(unsigned char *p, uLong value)
+{
+    p[0] = (unsigned char)(value >> 24);
+    p[1] = (unsigned char)(value >> 16);
+    p[2] = (unsigned char)(value >> 8);
+    p[3] = (unsigned char)value;
+}
+
+void WriteLittleEndian32(unsigned char *p, uLong value)
+{
+    p[0] = (unsigned char)value;
+    p[1] = (unsigned char)(value >> 8);
+    p[2] = (unsigned char)(value >> 16);
+    p[3] = (unsigned char)(value >> 24);
+}
+
+} // anonymous namespace
+
+class wxZlibParallelDeflate
+{
+public:
+    // Format is one of wxZLIB_NO_HEADER, wxZLIB_ZLIB or wxZLIB_GZIP.
+    wxZlibParallelDeflate(int level, int format);
+    ~wxZlibParallelDeflate();
+
+    // Return false if no worker threads could be created.
+    bool IsOk() const { return !m_threads.empty(); }
+
+    // Forget any data written so far and prepare for compressing another
+    // stream.
+    void Reset();
+
+    bool SetDictionary(const char *data, size_t datalen);
+
+    // Compress the data, writing the compressed blocks that are ready to the
+    // output stream.
+    bool Write(wxOutputStream& out, const void *buffer, size_t size);
+
+    // Compress all the data written so far and write it out, either ending
+    // the stream if final is true or just flushing it otherwise.
+    bool Flush(wxOutputStream& out, bool final);
+
+    // Functions called by the worker threads.
+    wxZlibBlock *GetNextBlock();
+    void Compress(wxZlibBlock *block) const;
+    void OnBlockDone(wxZlibBlock *block);
+
+private:
+    void SubmitBlock(bool last);
+    bool WriteBlocks(wxOutputStream& out, size_t maxPending);
+    bool WriteBlock(wxOutputStream& out, const wxZlibBlock& block);
+    void DiscardBlocks();
+
+    const int m_level;
+    const int m_format;
+
+    // Data for the block being currently filled.
+    wxMemoryBuffer m_current;
+
+    // Dictionary for the next block, i.e. the end of the last one.
+    wxMemoryBuffer m_dict;
+
+    // True if SetDictionary() was called and the checksum of the dictionary.
+    bool m_hasInitialDict;
+    uLong m_initialDictId;
+
+    // Combined checksum and total size of all blocks written so far.
+    uLong m_check;
+    uLong m_total;
+
+    bool m_headerWritten;
+    bool m_finished;
+
+    // All the blocks not written out yet, in order, only used by the thread
+    // using the stream.
+    wxVector<wxZlibBlock *> m_blocks;
+
+    // The blocks waiting to be compressed, protected by m_mutex.
+    wxVector<wxZlibBlock *> m_queue;
+    bool m_stopping;
+
+    wxMutex m_mutex;
+    wxCondition m_condQueue;    // signalled when a block is queued
+    wxCondition m_condDone;     // signalled when a block is done
+
+    wxVector<wxThread *> m_threads;
+
+    wxDECLARE_NO_COPY_CLASS(wxZlibParallelDeflate);
+};
+
+class wxZlibDeflateThread : public wxThread
+{
+public:
+    explicit wxZlibDeflateThread(wxZlibParallelDeflate& deflate)
+        : wxThread(wxTHREAD_JOINABLE),
+          m_deflate(deflate)
+    {
+    }
+
+protected:
+    virtual ExitCode Entry() wxOVERRIDE
+    {
+        for ( ;; )
+        {
+            wxZlibBlock * const block = m_deflate.GetNextBlock();
+            if ( !block )
+                break;
+
+            m_deflate.Compress(block);
+            m_deflate.OnBlockDone(block);
+        }
+
+        return NULL;
+    }
+
+private:
+    wxZlibParallelDeflate& m_deflate;
+
+    wxDECLARE_NO_COPY_CLASS(wxZlibDeflateThread);
+};
+
+wxZlibParallelDeflate::wxZlibParallelDeflate(int level, int format)
+    : m_level(level == Z_DEFAULT_COMPRESSION ? 6 : level),
+      m_format(format),
+      m_condQueue(m_mutex),
+      m_condDone(m_mutex)
+{
+    m_stopping = false;
+
+    Reset();
+
+    // Use at least 2 threads even on single CPU systems as parallel mode was
+    // explicitly requested and this still allows overlapping compression with
+    // writing the output.
+    const int numThreads = wxMax(wxThread::GetCPUCount(), 2);
+    for ( int n = 0; n < numThreads; n++ )
+    {
+        wxThread * const thread = new wxZlibDeflateThread(*this);
+        if ( thread->Run() != wxTHREAD_NO_ERROR )
+        {
+            delete thread;
+            break;
+        }
+
+        m_threads.push_back(thread);
+    }
+}
+
+wxZlibParallelDeflate::~wxZlibParallelDeflate()
+{
+    {
+        wxMutexLocker lock(m_mutex);
+        m_stopping = true;
+        m_condQueue.Broadcast();
+    }
+
+    for ( size_t n = 0; n < m_threads.size(); n++ )
+    {
+        m_threads[n]->Wait();
+        delete m_threads[n];
+    }
+
+    for ( size_t n = 0; n < m_blocks.size(); n++ )
+        delete m_blocks[n];
+}
+
+void wxZlibParallelDeflate::Reset()
+{
+    DiscardBlocks();
+
+    m_current = wxMemoryBuffer(ZSTREAM_PARALLEL_BLOCK_SIZE);
+    m_dict = wxMemoryBuffer(ZSTREAM_DICT_SIZE);
+    m_hasInitialDict = false;
+    m_initialDictId = 0;
+    m_check = m_format == wxZLIB_GZIP ? crc32(0, Z_NULL, 0)
+                                      : adler32(0, Z_NULL, 0);
+    m_total = 0;
+    m_headerWritten = false;
+    m_finished = false;
+}
+
+void wxZlibParallelDeflate::DiscardBlocks()
+{
+    {
+        wxMutexLocker lock(m_mutex);
+
+        // Blocks which are not being compressed yet can be just deleted, but
+        // we need to wait until the worker threads are done with the others.
+        for ( size_t n = 0; n < m_queue.size(); n++ )
+            m_queue[n]->m_done = true;
+        m_queue.clear();
+
+        for ( size_t n = 0; n < m_blocks.size(); n++ )
+        {
+            while ( !m_blocks[n]->m_done )
+                m_condDone.Wait();
+        }
+    }
+
+    for ( size_t n = 0; n < m_blocks.size(); n++ )
+        delete m_blocks[n];
+    m_blocks.clear();
+}
+
+bool wxZlibParallelDeflate::SetDictionary(const char *data, size_t datalen)
+{
+    // As with the serial compression, the dictionary can only be used with
+    // zlib or raw deflate streams and only before anything was written.
+    if ( m_format == wxZLIB_GZIP || m_headerWritten ||
+            !m_blocks.empty() || m_current.GetDataLen() )
+        return false;
+
+    m_dict.SetDataLen(0);
+    m_dict.AppendData(data, datalen);
+
+    m_hasInitialDict = true;
+    m_initialDictId = adler32(adler32(0, Z_NULL, 0),
+                              reinterpret_cast<const Bytef *>(data), datalen);
+
+    return true;
+}
+
+bool wxZlibParallelDeflate::Write(wxOutputStream& out,
+                                  const void *buffer,
+                                  size_t size)
+{
+    const char *p = static_cast<const char *>(buffer);
+    while ( size )
+    {
+        const size_t len = wxMin(size, ZSTREAM_PARALLEL_BLOCK_SIZE -
+                                            m_current.GetDataLen());
+        m_current.AppendData(p, len);
+        p += len;
+        size -= len;
+
+        if ( m_current.GetDataLen() == ZSTREAM_PARALLEL_BLOCK_SIZE )
+        {
+            SubmitBlock(false);
+
+            // Write out whatever is ready and wait if too many blocks are
+            // pending to limit the amount of memory used.
+            if ( !WriteBlocks(out, 2*m_threads.size()) )
+                return false;
+        }
+    }
+
+    return true;
+}
+
+bool wxZlibParallelDeflate::Flush(wxOutputStream& out, bool final)
+{
+    // Closing the stream twice must not do anything, as with zlib.
+    if ( m_finished )
+        return true;
+
+    if ( final || m_current.GetDataLen() )
+        SubmitBlock(final);
+
+    if ( final )
+        m_finished = true;
+
+    return WriteBlocks(out, 0);
+}
+
+void wxZlibParallelDeflate::SubmitBlock(bool last)
+{
+    wxZlibBlock * const block = new wxZlibBlock;
+    block->m_in = m_current;
+    block->m_dict = m_dict;
+    block->m_last = last;
+
+    // Remember the last part of the data as dictionary for the next block,
+    // taking it from the previous dictionary too if this block is small.
+    const size_t len = m_current.GetDataLen();
+    const size_t lenNew = wxMin(len, ZSTREAM_DICT_SIZE);
+    const size_t lenOld = wxMin(m_dict.GetDataLen(),
+                                ZSTREAM_DICT_SIZE - lenNew);
+
+    wxMemoryBuffer dict(ZSTREAM_DICT_SIZE);
+    dict.AppendData(static_cast<char *>(m_dict.GetData()) +
+                        m_dict.GetDataLen() - lenOld, lenOld);
+    dict.AppendData(static_cast<char *>(m_current.GetData()) + len - lenNew,
+                    lenNew);
+    m_dict = dict;
+
+    m_current = wxMemoryBuffer(ZSTREAM_PARALLEL_BLOCK_SIZE);
+
+    m_blocks.push_back(block);
+
+    wxMutexLocker lock(m_mutex);
+    m_queue.push_back(block);
+    m_condQueue.Signal();
+}
+
+wxZlibBlock *wxZlibParallelDeflate::GetNextBlock()
+{
+    wxMutexLocker lock(m_mutex);
+
+    while ( m_queue.empty() && !m_stopping )
+        m_condQueue.Wait();
+
+    if ( m_stopping )
+        return NULL;
+
+    wxZlibBlock * const block = m_queue[0];
+    m_queue.erase(m_queue.begin());
+
+    return block;
+}
+
+void wxZlibParallelDeflate::OnBlockDone(wxZlibBlock *block)
+{
+    wxMutexLocker lock(m_mutex);
+
+    block->m_done = true;
+    m_condDone.Broadcast();
+}
+
+void wxZlibParallelDeflate::Compress(wxZlibBlock *block) const
+{
+    Bytef * const in = static_cast<Bytef *>(block->m_in.GetData());
+    const size_t len = block->m_in.GetDataLen();
+
+    switch ( m_format )
+    {
+        case wxZLIB_ZLIB:
+            block->m_check = adler32(adler32(0, Z_NULL, 0), in, len);
+            break;
+
+        case wxZLIB_GZIP:
+            block->m_check = crc32(crc32(0, Z_NULL, 0), in, len);
+            break;
+    }
+
+    // Always produce raw deflate data, the header and trailer are written by
+    // the thread using the stream.
+    z_stream z;
+    memset(&z, 0, sizeof(z));
+    if ( deflateInit2(&z, m_level, Z_DEFLATED, -MAX_WBITS,
+                      8, Z_DEFAULT_STRATEGY) != Z_OK )
+        return;
+
+    bool ok = true;
+    if ( block->m_dict.GetDataLen() )
+    {
+        ok = deflateSetDictionary(&z,
+                                  static_cast<Bytef *>(block->m_dict.GetData()),
+                                  block->m_dict.GetDataLen()) == Z_OK;
+    }
+
+    z.next_in = in;
+    z.avail_in = len;
+
+    // deflateBound() doesn't account for the sync flush marker, so add a bit
+    // of extra space for it.
+    size_t size = deflateBound(&z, len) + 16;
+    size_t used = 0;
+    while ( ok )
+    {
+        Bytef * const out = static_cast<Bytef *>(block->m_out.GetWriteBuf(size));
+        z.next_out = out + used;
+        z.avail_out = size - used;
+
+        const int err = deflate(&z, block->m_last ? Z_FINISH : Z_SYNC_FLUSH);
+
+        used = size - z.avail_out;
+        block->m_out.UngetWriteBuf(used);
+
+        if ( err == Z_STREAM_END || (err == Z_OK && z.avail_out) )
+        {
+            block->m_ok = true;
+            break;
+        }
+
+        if ( err != Z_OK && err != Z_BUF_ERROR )
+            ok = false;
+
+        // Otherwise we just need more space for the output.
+        size *= 2;
+    }
+
+    deflateEnd(&z);
+}
+
+bool wxZlibParallelDeflate::WriteBlocks(wxOutputStream& out, size_t maxPending)
+{
+    while ( !m_blocks.empty() )
+    {
+        wxZlibBlock * const block = m_blocks[0];
+
+        {
+            wxMutexLocker lock(m_mutex);
+            while ( !block->m_done )
+            {
+                if ( m_blocks.size() <= maxPending )
+                    return true;
+
+                m_condDone.Wait();
+            }
+        }
+
+        m_blocks.erase(m_blocks.begin());
+
+        const bool ok = WriteBlock(out, *block);
+        delete block;
+
+        if ( !ok )
+            return false;
+    }
+
+    return true;
+}
+
+bool wxZlibParallelDeflate::WriteBlock(wxOutputStream& out,
+                                       const wxZlibBlock& block)
+{
+    if ( !block.m_ok )
+    {
+        wxLogError(_("Can't compress data in deflate stream."));
+        return false;
+    }
+
+    unsigned char buf[10];
+    size_t len = 0;
+
+    if ( !m_headerWritten )
+    {
+        switch ( m_format )
+        {
+            case wxZLIB_ZLIB:
+                {
+                    // Use the same compression level flags as zlib itself.
+                    unsigned levelFlags = 3;
+                    if ( m_level < 2 )
+                        levelFlags = 0;
+                    else if ( m_level < 6 )
+                        levelFlags = 1;
+                    else if ( m_level == 6 )
+                        levelFlags = 2;
+
+                    unsigned header = (0x78 << 8) | (levelFlags << 6);
+                    if ( m_hasInitialDict )
+                        header |= 0x20;
+                    header += 31 - header % 31;
+
+                    buf[len++] = (unsigned char)(header >> 8);
+                    buf[len++] = (unsigned char)header;
+
+                    if ( m_hasInitialDict )
+                    {
+                        WriteBigEndian32(buf + len, m_initialDictId);
+                        len += 4;
+                    }
+                }
+                break;
+
+            case wxZLIB_GZIP:
+                {
+                    // Minimal gzip header without file name nor time stamp
+                    // and with "unknown" OS.
+                    static const unsigned char header[] =
+                        { 0x1f, 0x8b, Z_DEFLATED, 0, 0, 0, 0, 0, 0, 255 };
+                    memcpy(buf, header, sizeof(header));
+                    len = sizeof(header);
+
+                    // Extra flags indicating the compression level.
+                    if ( m_level == 9 )
+                        buf[8] = 2;
+                    else if ( m_level < 2 )
+                        buf[8] = 4;
+                }
+                break;
+        }
+
+        if ( out.Write(buf, len).LastWrite() != len )
+            return false;
+
+        m_headerWritten = true;
+    }
+
+    const size_t size = block.m_out.GetDataLen();
+    if ( out.Write(block.m_out.GetData(), size).LastWrite() != size )
+        return false;
+
+    const size_t sizeIn = block.m_in.GetDataLen();
+    switch ( m_format )
+    {
+        case wxZLIB_ZLIB:
+            m_check = adler32_combine(m_check, block.m_check, sizeIn);
+            break;
+
+        case wxZLIB_GZIP:
+            m_check = crc32_combine(m_check, block.m_check, sizeIn);
+            break;
+    }
+
+    m_total += sizeIn;
+
+    if ( block.m_last )
+    {
+        len = 0;
+        switch ( m_format )
+        {
+            case wxZLIB_ZLIB:
+                WriteBigEndian32(buf, m_check);
+                len = 4;
+                break;
+
+            case wxZLIB_GZIP:
+                WriteLittleEndian32(buf, m_check);
+                WriteLittleEndian32(buf + 4, m_total);
+                len = 8;
+                break;
+        }
+
+        if ( out.Write(buf, len).LastWrite() != len )
+            return false;
+    }
+
+    return true;
+}
+
+#endif // wxUSE_THREADS
+
 //////////////////////
 // wxZlibOutputStream
 //////////////////////
@@ -300,6 +860,7 @@ wxZlibOutputStream::wxZlibOutputStream(wxOutputStream *stream,
 void wxZlibOutputStream::Init(int level, int flags)
 {
   m_deflate = NULL;
+  m_parallel = NULL;
   m_z_buffer = new unsigned char[ZSTREAM_BUFFER_SIZE];
   m_z_size = ZSTREAM_BUFFER_SIZE;
   m_pos = 0;
@@ -313,8 +874,10 @@ void wxZlibOutputStream::Init(int level, int flags)
     wxASSERT_MSG(level >= 0 && level <= 9, wxT("wxZlibOutputStream compression level must be between 0 and 9!"));
   }
 
+  const int format = flags & ~wxZLIB_PARALLEL;
+
   // if gzip is asked for but not supported...
-  if (flags == wxZLIB_GZIP && !CanHandleGZip()) {
+  if (format == wxZLIB_GZIP && !CanHandleGZip()) {
     wxLogError(_("Gzip not supported by this version of zlib"));
     m_lasterror = wxSTREAM_WRITE_ERROR;
     return;
@@ -330,7 +893,7 @@ void wxZlibOutputStream::Init(int level, int flags)
 
       // see zlib.h for documentation on windowBits
       int windowBits = MAX_WBITS;
-      switch (flags) {
+      switch (format) {
         case wxZLIB_NO_HEADER:  windowBits = -MAX_WBITS; break;
         case wxZLIB_ZLIB:       windowBits = MAX_WBITS; break;
         case wxZLIB_GZIP:       windowBits = MAX_WBITS | ZSTREAM_GZIP; break;
@@ -338,8 +901,18 @@ void wxZlibOutputStream::Init(int level, int flags)
       }
 
       if (deflateInit2(m_deflate, level, Z_DEFLATED, windowBits,
-                       8, Z_DEFAULT_STRATEGY) == Z_OK)
+                       8, Z_DEFAULT_STRATEGY) == Z_OK) {
+#if wxUSE_THREADS
+        if (flags & wxZLIB_PARALLEL) {
+          m_parallel = new wxZlibParallelDeflate(level, format);
+
+          // fall back to compressing in this thread if we can't use others
+          if (!m_parallel->IsOk())
+            wxDELETE(m_parallel);
+        }
+#endif // wxUSE_THREADS
         return;
+      }
     }
   }
 
@@ -350,6 +923,9 @@ void wxZlibOutputStream::Init(int level, int flags)
 bool wxZlibOutputStream::Close()
  {
   DoFlush(true);
+#if wxUSE_THREADS
+  wxDELETE(m_parallel);
+#endif // wxUSE_THREADS
    deflateEnd(m_deflate);
    wxDELETE(m_deflate);
    wxDELETEA(m_z_buffer);
@@ -364,6 +940,16 @@ void wxZlibOutputStream::DoFlush(bool final)
   if (!IsOk())
     return;
 
+#if wxUSE_THREADS
+  if (m_parallel) {
+    if (!m_parallel->Flush(*m_parent_o_stream, final)) {
+      m_lasterror = wxSTREAM_WRITE_ERROR;
+      wxLogDebug(wxT("wxZlibOutputStream: Error writing to underlying stream"));
+    }
+    return;
+  }
+#endif // wxUSE_THREADS
+
   int err = Z_OK;
   bool done = false;
 
@@ -399,6 +985,19 @@ size_t wxZlibOutputStream::OnSysWrite(const void *buffer, size_t size)
   if (!IsOk() || !size)
     return 0;
 
+#if wxUSE_THREADS
+  if (m_parallel) {
+    if (!m_parallel->Write(*m_parent_o_stream, buffer, size)) {
+      m_lasterror = wxSTREAM_WRITE_ERROR;
+      wxLogDebug(wxT("wxZlibOutputStream: Error writing to underlying stream"));
+      return 0;
+    }
+
+    m_pos += size;
+    return size;
+  }
+#endif // wxUSE_THREADS
+
   int err = Z_OK;
   m_deflate->next_in = (unsigned char *)buffer;
   m_deflate->avail_in = size;
@@ -437,8 +1036,26 @@ size_t wxZlibOutputStream::OnSysWrite(const void *buffer, size_t size)
   return wxZlibInputStream::CanHandleGZip();
 }
 
+bool wxZlibOutputStream::ResetDeflate()
+{
+  m_deflate->next_out = m_z_buffer;
+  m_deflate->avail_out = m_z_size;
+
+#if wxUSE_THREADS
+  if (m_parallel)
+    m_parallel->Reset();
+#endif // wxUSE_THREADS
+
+  return deflateReset(m_deflate) == Z_OK;
+}
+
 bool wxZlibOutputStream::SetDictionary(const char *data, size_t datalen)
 {
+#if wxUSE_THREADS
+    if (m_parallel)
+        return m_parallel->SetDictionary(data, datalen);
+#endif // wxUSE_THREADS
+
     return (deflateSetDictionary(m_deflate, (Bytef*)data, datalen) == Z_OK);
 }
 
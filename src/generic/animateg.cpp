@@ -457,7 +457,14 @@ bool wxAnimationCtrl::RebuildBackingStoreUpToFrame(unsigned int frame)
     DisposeToBackground(dc);
 
     // Draw all intermediate frames that haven't been removed from the animation
-    for (unsigned int i = 0; i < frame; i++)
+    // starting from the last one completely covering all the previous ones:
+    // this avoids decoding all the frames from the beginning when seeking
+    // in a long animation
+    unsigned int start = frame;
+    while ( start > 0 && !IsKeyFrame(start) )
+        start--;
+
+    for (unsigned int i = start; i < frame; i++)
     {
         if (m_animation.GetDisposalMethod(i) == wxANIM_DONOTREMOVE ||
             m_animation.GetDisposalMethod(i) == wxANIM_UNSPECIFIED)
@@ -476,6 +483,26 @@ bool wxAnimationCtrl::RebuildBackingStoreUpToFrame(unsigned int frame)
     return true;
 }
 
+bool wxAnimationCtrl::IsKeyFrame(unsigned int frame) const
+{
+    // An opaque frame covering the entire animation area and not removed
+    // after being shown hides everything drawn before it.
+    switch ( m_animation.GetDisposalMethod(frame) )
+    {
+        case wxANIM_DONOTREMOVE:
+        case wxANIM_UNSPECIFIED:
+            break;
+
+        case wxANIM_TOBACKGROUND:
+        case wxANIM_TOPREVIOUS:
+            return false;
+    }
+
+    return m_animation.GetFramePosition(frame) == wxPoint(0, 0) &&
+           m_animation.GetFrameSize(frame) == m_animation.GetSize() &&
+           !m_animation.GetTransparentColour(frame).IsOk();
+}
+
 void wxAnimationCtrl::IncrementalUpdateBackingStore()
 {
     wxMemoryDC dc;
@@ -39,6 +39,7 @@ bool wxCairoInit();
 #endif
 
 #include "wx/private/graphics.h"
+#include "wx/private/pixelconv.h"
 #include "wx/rawbmp.h"
 #include "wx/vector.h"
 #ifdef __WXMSW__
@@ -105,22 +106,6 @@ using namespace std;
 #include <cairo-quartz.h>
 #endif
 
-// Helper functions for dealing with alpha pre-multiplication.
-namespace
-{
-
-    inline unsigned char Premultiply(unsigned char alpha, unsigned char data)
-    {
-        return alpha ? (data * alpha) / 0xff : data;
-    }
-
-    inline unsigned char Unpremultiply(unsigned char alpha, unsigned char data)
-    {
-        return alpha ? (data * 0xff) / alpha : data;
-    }
-
-} // anonymous namespace
-
 class WXDLLIMPEXP_CORE wxCairoPathData : public wxGraphicsPathData
 {
 public :
@@ -1618,20 +1603,22 @@ wxCairoBitmapData::wxCairoBitmapData( wxGraphicsRenderer* renderer, const wxBitm
                     // MSW and OSX bitmap pixel bits are already premultiplied.
                     *data = (alpha << 24 | p.Red() << 16 | p.Green() << 8 | p.Blue());
 #else // !__WXMSW__ , !__WXOSX__
-                    // We always have alpha, but we need to premultiply it.
+                    // We always have alpha, but we need to premultiply it,
+                    // which is done for the entire row below.
                     unsigned char alpha = p.Alpha();
                     if (alpha == wxALPHA_TRANSPARENT)
                         *data = 0;
                     else
-                        *data = (alpha << 24
-                            | Premultiply(alpha, p.Red()) << 16
-                            | Premultiply(alpha, p.Green()) << 8
-                            | Premultiply(alpha, p.Blue()));
+                        *data = (alpha << 24 | p.Red() << 16 | p.Green() << 8 | p.Blue());
 #endif // __WXMSW__, __WXOSX__ / !__WXMSW__, !__WXOSX__
                     ++data;
                     ++p;
                 }
 
+#if !defined(__WXMSW__) && !defined(__WXOSX__)
+                wxPremultiplyARGB32(rowStartDst, pixData.GetWidth());
+#endif // !__WXMSW__ && !__WXOSX__
+
                 data = rowStartDst + stride / 4;
                 p = rowStart;
                 p.OffsetY(pixData, 1);
@@ -1724,44 +1711,21 @@ wxCairoBitmapData::wxCairoBitmapData(wxGraphicsRenderer* renderer,
     wxUint32* dst = reinterpret_cast<wxUint32*>(m_buffer);
     const unsigned char* src = image.GetData();
 
-    if ( bufferFormat == CAIRO_FORMAT_ARGB32 )
-    {
-        const unsigned char* alpha = image.GetAlpha();
+    // Alpha is premultiplied by wxConvertRGBToARGB32() if we have it and the
+    // unused upper byte is set to 0xff for RGB24 format if we don't.
+    const unsigned char* alpha = bufferFormat == CAIRO_FORMAT_ARGB32
+                                    ? image.GetAlpha()
+                                    : NULL;
 
-        for ( int y = 0; y < m_height; y++ )
-        {
-            wxUint32* const rowStartDst = dst;
-
-            for ( int x = 0; x < m_width; x++ )
-            {
-                const unsigned char a = *alpha++;
-
-                *dst++ = a                      << 24 |
-                         Premultiply(a, src[0]) << 16 |
-                         Premultiply(a, src[1]) <<  8 |
-                         Premultiply(a, src[2]);
-                src += 3;
-            }
-
-            dst = rowStartDst + stride / 4;
-        }
-    }
-    else // RGB
+    for ( int y = 0; y < m_height; y++ )
     {
-        for ( int y = 0; y < m_height; y++ )
-        {
-            wxUint32* const rowStartDst = dst;
+        wxConvertRGBToARGB32(dst, src, alpha, m_width);
 
-            for ( int x = 0; x < m_width; x++ )
-            {
-                *dst++ = src[0] << 16 |
-                         src[1] <<  8 |
-                         src[2];
-                src += 3;
-            }
+        src += 3*m_width;
+        if ( alpha )
+            alpha += m_width;
 
-            dst = rowStartDst + stride / 4;
-        }
+        dst += stride / 4;
     }
 
     InitSurface(bufferFormat, stride);
@@ -1813,46 +1777,19 @@ wxImage wxCairoBitmapData::ConvertToImage() const
 
     unsigned char* dst = image.GetData();
     unsigned char *alpha = image.GetAlpha();
-    if ( alpha )
-    {
-        // We need to also copy alpha and undo the pre-multiplication as Cairo
-        // stores pre-multiplied values in this format while wxImage does not.
-        for ( int y = 0; y < m_height; y++ )
-        {
-            const wxUint32* const rowStart = src;
-            for ( int x = 0; x < m_width; x++ )
-            {
-                const wxUint32 argb = *src++;
-
-                const unsigned char a = argb >> 24;
-                *alpha++ = a;
 
-                // Copy the RGB data undoing the pre-multiplication.
-                *dst++ = Unpremultiply(a, argb >> 16);
-                *dst++ = Unpremultiply(a, argb >>  8);
-                *dst++ = Unpremultiply(a, argb);
-            }
-
-            src = rowStart + stride;
-        }
-    }
-    else // RGB
+    // If we have alpha, we need to also copy it and undo the pre-multiplication
+    // as Cairo stores pre-multiplied values in this format while wxImage does
+    // not, wxConvertARGB32ToRGB() takes care of it.
+    for ( int y = 0; y < m_height; y++ )
     {
-        // Things are pretty simple in this case, just copy RGB bytes.
-        for ( int y = 0; y < m_height; y++ )
-        {
-            const wxUint32* const rowStart = src;
-            for ( int x = 0; x < m_width; x++ )
-            {
-                const wxUint32 argb = *src++;
+        wxConvertARGB32ToRGB(dst, alpha, src, m_width);
 
-                *dst++ = (argb & 0x00ff0000) >> 16;
-                *dst++ = (argb & 0x0000ff00) >>  8;
-                *dst++ = (argb & 0x000000ff);
-            }
+        dst += 3*m_width;
+        if ( alpha )
+            alpha += m_width;
 
-            src = rowStart + stride;
-        }
+        src += stride;
     }
 
     return image;
@@ -19,6 +19,7 @@
 #endif
 
 #include "wx/rawbmp.h"
+#include "wx/private/pixelconv.h"
 
 #include "wx/gtk/private/object.h"
 #include "wx/gtk/private.h"
@@ -541,10 +542,15 @@ bool wxBitmap::Create( int width, int height, int depth )
     return true;
 }
 
+// Copy the image data between 3 and 4 channel formats. When converting from
+// 3 to 4 channels, srcAlpha is used for the alpha channel, if non-NULL, and
+// when converting from 4 to 3 channels, the alpha channel is copied to
+// dstAlpha, if it's non-NULL.
 static void CopyImageData(
     guchar* dst, int dstChannels, int dstStride,
     const guchar* src, int srcChannels, int srcStride,
-    int w, int h)
+    int w, int h,
+    const guchar* srcAlpha = NULL, guchar* dstAlpha = NULL)
 {
     if (dstChannels == srcChannels)
     {
@@ -561,27 +567,15 @@ static void CopyImageData(
     {
         for (int j = 0; j < h; j++, src += srcStride, dst += dstStride)
         {
-            guchar* d = dst;
-            const guchar* s = src;
             if (dstChannels == 4)
-            {
-                for (int i = 0; i < w; i++, d += 4, s += 3)
-                {
-                    d[0] = s[0];
-                    d[1] = s[1];
-                    d[2] = s[2];
-                    d[3] = 0xff;
-                }
-            }
+                wxConvertRGBToRGBA(dst, src, srcAlpha, w);
             else
-            {
-                for (int i = 0; i < w; i++, d += 3, s += 4)
-                {
-                    d[0] = s[0];
-                    d[1] = s[1];
-                    d[2] = s[2];
-                }
-            }
+                wxConvertRGBAToRGB(dst, dstAlpha, src, w);
+
+            if (srcAlpha)
+                srcAlpha += w;
+            if (dstAlpha)
+                dstAlpha += w;
         }
     }
 }
@@ -609,14 +603,8 @@ wxBitmap::wxBitmap(const wxImage& image, int depth, double scale)
 
     guchar* dst = gdk_pixbuf_get_pixels(pixbuf_dst);
     const int dstStride = gdk_pixbuf_get_rowstride(pixbuf_dst);
-    CopyImageData(dst, gdk_pixbuf_get_n_channels(pixbuf_dst), dstStride, src, 3, 3 * w, w, h);
-
-    if (depth == 32 && alpha)
-    {
-        for (int j = 0; j < h; j++, dst += dstStride)
-            for (int i = 0; i < w; i++)
-                dst[i * 4 + 3] = *alpha++;
-    }
+    CopyImageData(dst, gdk_pixbuf_get_n_channels(pixbuf_dst), dstStride, src, 3, 3 * w, w, h,
+                  depth == 32 ? alpha : NULL);
     if (image.HasMask())
     {
         const guchar r = image.GetMaskRed();
@@ -784,19 +772,13 @@ wxImage wxBitmap::ConvertToImage() const
         const guchar* src = gdk_pixbuf_get_pixels(pixbuf_src);
         const int srcStride = gdk_pixbuf_get_rowstride(pixbuf_src);
         const int srcChannels = gdk_pixbuf_get_n_channels(pixbuf_src);
-        CopyImageData(dst, 3, 3 * w, src, srcChannels, srcStride, w, h);
-
+        guchar* alpha = NULL;
         if (srcChannels == 4)
         {
             image.SetAlpha();
-            guchar* alpha = image.GetAlpha();
-            for (int j = 0; j < h; j++, src += srcStride)
-            {
-                const guchar* s = src;
-                for (int i = 0; i < w; i++, s += 4)
-                    *alpha++ = s[3];
-            }
+            alpha = image.GetAlpha();
         }
+        CopyImageData(dst, 3, 3 * w, src, srcChannels, srcStride, w, h, NULL, alpha);
     }
     cairo_surface_t* maskSurf = NULL;
     if (bmpData->m_mask)
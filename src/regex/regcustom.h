@@ -117,6 +117,9 @@ typedef int celt;               /* type to hold chr, MCCE number, or NOCELT */
 /* name the external functions */
 #define compile         wx_re_comp
 #define exec            wx_re_exec
+#define execctx         wx_re_execctx
+#define newctx          wx_re_newctx
+#define freectx         wx_re_freectx
 
 /* enable/disable debugging code (by whether REG_DEBUG is defined or not) */
 #if 0           /* no debug unless requested by makefile */
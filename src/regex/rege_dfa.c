@@ -273,10 +273,21 @@ struct smalldfa *small;		/* preallocated space, may be NULL */
 	struct dfa *d;
 	size_t nss = cnfa->nstates * 2;
 	int wordsper = (cnfa->nstates + UBITS - 1) / UBITS;
-	struct smalldfa *smallwas = small;
+	struct smalldfa *smallwas;
+	int cacheit = 0;
 
 	assert(cnfa != NULL && cnfa->nstates != 0);
 
+	if (v->ctx != NULL && !(v->eflags&REG_SMALL)) {
+		d = ctxdfa(v, cnfa);
+		if (d != NULL)
+			return d;
+		/* a DFA outliving this call can't use the preallocated space */
+		small = DOMALLOC;
+		cacheit = 1;
+	}
+	smallwas = small;
+
 	if (nss <= FEWSTATES && cnfa->ncolors <= FEWCOLORS) {
 		assert(wordsper == 1);
 		if (small == NULL) {
@@ -301,6 +312,7 @@ struct smalldfa *small;		/* preallocated space, may be NULL */
 			ERR(REG_ESPACE);
 			return NULL;
 		}
+		d->cached = 0;
 		d->ssets = (struct sset *)MALLOC(nss * sizeof(struct sset));
 		d->statesarea = (unsigned *)MALLOC((nss+WORK) * wordsper *
 							sizeof(unsigned));
@@ -329,12 +341,62 @@ struct smalldfa *small;		/* preallocated space, may be NULL */
 	d->lastpost = NULL;
 	d->lastnopr = NULL;
 	d->search = d->ssets;
+	d->cached = 0;
+	d->busy = 0;
+	if (cacheit)
+		cachedfa(v, d);
 
 	/* initialization of sset fields is done as needed */
 
 	return d;
 }
 
+/*
+ - ctxdfa - find a DFA for the given NFA in the execution context
+ * The DFA keeps the state sets it had built, which are independent of the
+ * string being matched, so the subsequent matches run mostly from the cache.
+ ^ static struct dfa *ctxdfa(struct vars *, struct cnfa *);
+ */
+static struct dfa *		/* NULL if not cached or already in use */
+ctxdfa(v, cnfa)
+struct vars *v;
+struct cnfa *cnfa;
+{
+	struct dfa *d;
+	int i;
+
+	for (i = 0; i < CTXDFAS; i++) {
+		d = v->ctx->dfas[i];
+		if (d != NULL && d->cnfa == cnfa && !d->busy) {
+			d->busy = 1;
+			d->lastpost = NULL;
+			d->lastnopr = NULL;
+			return d;
+		}
+	}
+	return NULL;
+}
+
+/*
+ - cachedfa - store a new DFA in the execution context, if there is room
+ ^ static VOID cachedfa(struct vars *, struct dfa *);
+ */
+static VOID
+cachedfa(v, d)
+struct vars *v;
+struct dfa *d;
+{
+	int i;
+
+	for (i = 0; i < CTXDFAS; i++)
+		if (v->ctx->dfas[i] == NULL) {
+			v->ctx->dfas[i] = d;
+			d->cached = 1;
+			d->busy = 1;
+			return;
+		}
+}
+
 /*
  - freedfa - free a DFA
  ^ static VOID freedfa(struct dfa *);
@@ -343,6 +405,11 @@ static VOID
 freedfa(d)
 struct dfa *d;
 {
+	if (d->cached) {		/* just give it back to its context */
+		d->busy = 0;
+		return;
+	}
+
 	if (d->cptsmalloced) {
 		if (d->ssets != NULL)
 			FREE(d->ssets);
@@ -194,6 +194,9 @@ typedef struct {
 	regmatch_t rm_extend;	/* see REG_EXPECT */
 } rm_detail_t;
 
+/* execution context reusable by several matches of the same RE (wx extension) */
+typedef struct wx_re_ctx wx_re_ctx;
+
 
 
 /*
@@ -318,6 +321,14 @@ int regexec _ANSI_ARGS_((regex_t *, __REG_CONST char *, size_t, regmatch_t [], i
 #ifdef __REG_WIDE_T
 int __REG_WIDE_EXEC _ANSI_ARGS_((regex_t *, __REG_CONST __REG_WIDE_T *, size_t, rm_detail_t *, size_t, regmatch_t [], int));
 #endif
+#ifndef __REG_NOCHAR
+int wx_re_execctx _ANSI_ARGS_((regex_t *, __REG_CONST char *, size_t, rm_detail_t *, size_t, regmatch_t [], int, wx_re_ctx *));
+#endif
+#ifdef __REG_WIDE_T
+int wx_re_execctx _ANSI_ARGS_((regex_t *, __REG_CONST __REG_WIDE_T *, size_t, rm_detail_t *, size_t, regmatch_t [], int, wx_re_ctx *));
+#endif
+wx_re_ctx *wx_re_newctx _ANSI_ARGS_((re_void));
+re_void wx_re_freectx _ANSI_ARGS_((wx_re_ctx *));
 re_void wx_regfree _ANSI_ARGS_((regex_t *));
 extern size_t wx_regerror _ANSI_ARGS_((int, __REG_CONST regex_t *, char *, size_t));
 /* automatically gathered by fwd; do not hand-edit */
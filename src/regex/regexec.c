@@ -74,6 +74,8 @@ struct dfa {
 	struct sset *search;	/* replacement-search-pointer memory */
 	int cptsmalloced;	/* were the areas individually malloced? */
 	char *mallocarea;	/* self, or master malloced area, or NULL */
+	int cached;		/* owned by an execution context? */
+	int busy;		/* cached and currently in use? */
 };
 
 #define	WORK	1		/* number of work bitvectors needed */
@@ -90,6 +92,13 @@ struct smalldfa {
 };
 #define	DOMALLOC	((struct smalldfa *)NULL)	/* force malloc */
 
+/* execution context keeping the DFAs between the calls to execctx() */
+#define	CTXDFAS	8		/* max number of DFAs cached in a context */
+struct wx_re_ctx {
+	char *guts;		/* guts of the RE the DFAs were built for */
+	struct dfa *dfas[CTXDFAS];
+};
+
 
 
 /* internal variables, bundled for easy passing around */
@@ -104,6 +113,7 @@ struct vars {
 	chr *stop;		/* just past end of string */
 	int err;		/* error code if any (0 none) */
 	regoff_t *mem;		/* memory vector for backtracking */
+	struct wx_re_ctx *ctx;	/* where to cache the DFAs, may be NULL */
 	struct smalldfa dfa1;
 	struct smalldfa dfa2;
 };
@@ -124,6 +134,10 @@ struct vars {
 /* automatically gathered by fwd; do not hand-edit */
 /* === regexec.c === */
 int exec _ANSI_ARGS_((regex_t *, CONST chr *, size_t, rm_detail_t *, size_t, regmatch_t [], int));
+int execctx _ANSI_ARGS_((regex_t *, CONST chr *, size_t, rm_detail_t *, size_t, regmatch_t [], int, wx_re_ctx *));
+wx_re_ctx *newctx _ANSI_ARGS_((VOID));
+VOID freectx _ANSI_ARGS_((wx_re_ctx *));
+static VOID flushctx _ANSI_ARGS_((wx_re_ctx *));
 static int find _ANSI_ARGS_((struct vars *, struct cnfa *, struct colormap *));
 static int cfind _ANSI_ARGS_((struct vars *, struct cnfa *, struct colormap *));
 static int cfindloop _ANSI_ARGS_((struct vars *, struct cnfa *, struct colormap *, struct dfa *, struct dfa *, chr **));
@@ -144,6 +158,8 @@ static chr *shortest _ANSI_ARGS_((struct vars *, struct dfa *, chr *, chr *, chr
 static chr *lastcold _ANSI_ARGS_((struct vars *, struct dfa *));
 static struct dfa *newdfa _ANSI_ARGS_((struct vars *, struct cnfa *, struct colormap *, struct smalldfa *));
 static VOID freedfa _ANSI_ARGS_((struct dfa *));
+static struct dfa *ctxdfa _ANSI_ARGS_((struct vars *, struct cnfa *));
+static VOID cachedfa _ANSI_ARGS_((struct vars *, struct dfa *));
 static unsigned hash _ANSI_ARGS_((unsigned *, int));
 static struct sset *initialize _ANSI_ARGS_((struct vars *, struct dfa *, chr *));
 static struct sset *miss _ANSI_ARGS_((struct vars *, struct dfa *, struct sset *, pcolor, chr *, chr *));
@@ -169,6 +185,83 @@ rm_detail_t *details;
 size_t nmatch;
 regmatch_t pmatch[];
 int flags;
+{
+	return execctx(re, string, len, details, nmatch, pmatch, flags,
+							(wx_re_ctx *)NULL);
+}
+
+/*
+ - newctx - create an execution context
+ * The context keeps the DFAs built while matching, so that the subsequent
+ * matches of the same RE don't need to allocate and build them again.
+ ^ wx_re_ctx *newctx(VOID);
+ */
+wx_re_ctx *
+newctx()
+{
+	wx_re_ctx *ctx;
+	int i;
+
+	ctx = (wx_re_ctx *)MALLOC(sizeof(wx_re_ctx));
+	if (ctx == NULL)
+		return NULL;
+	ctx->guts = NULL;
+	for (i = 0; i < CTXDFAS; i++)
+		ctx->dfas[i] = NULL;
+	return ctx;
+}
+
+/*
+ - freectx - free an execution context
+ * This must be done before freeing the RE it was used with.
+ ^ VOID freectx(wx_re_ctx *);
+ */
+VOID
+freectx(ctx)
+wx_re_ctx *ctx;
+{
+	if (ctx == NULL)
+		return;
+	flushctx(ctx);
+	FREE(ctx);
+}
+
+/*
+ - flushctx - free all DFAs cached in an execution context
+ ^ static VOID flushctx(wx_re_ctx *);
+ */
+static VOID
+flushctx(ctx)
+wx_re_ctx *ctx;
+{
+	int i;
+
+	for (i = 0; i < CTXDFAS; i++)
+		if (ctx->dfas[i] != NULL) {
+			assert(!ctx->dfas[i]->busy);
+			ctx->dfas[i]->cached = 0;
+			freedfa(ctx->dfas[i]);
+			ctx->dfas[i] = NULL;
+		}
+	ctx->guts = NULL;
+}
+
+/*
+ - execctx - match regular expression using an execution context
+ * The context, if not NULL, can't be used by several threads at once.
+ ^ int execctx(regex_t *, CONST chr *, size_t, rm_detail_t *,
+ ^					size_t, regmatch_t [], int, wx_re_ctx *);
+ */
+int
+execctx(re, string, len, details, nmatch, pmatch, flags, ctx)
+regex_t *re;
+CONST chr *string;
+size_t len;
+rm_detail_t *details;
+size_t nmatch;
+regmatch_t pmatch[];
+int flags;
+wx_re_ctx *ctx;
 {
 	struct vars var;
 	register struct vars *v = &var;
@@ -214,6 +307,12 @@ int flags;
 	v->start = (chr *)string;
 	v->stop = (chr *)string + len;
 	v->err = 0;
+	if (ctx != NULL && ctx->guts != re->re_guts) {
+		/* the cached DFAs are for another RE */
+		flushctx(ctx);
+		ctx->guts = re->re_guts;
+	}
+	v->ctx = ctx;
 	if (backref) {
 		/* need retry memory */
 		assert(v->g->ntree >= 0);
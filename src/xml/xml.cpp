@@ -30,6 +30,9 @@
 #include "wx/strconv.h"
 #include "wx/scopedptr.h"
 #include "wx/versioninfo.h"
+#include "wx/vector.h"
+#include "wx/atomic.h"
+#include "wx/hashmap.h"
 
 #include "expat.h" // from Expat
 
@@ -44,6 +47,229 @@ wxIMPLEMENT_CLASS(wxXmlDocument, wxObject);
 static bool wxIsWhiteOnly(const wxString& buf);
 
 
+//-----------------------------------------------------------------------------
+//  wxXmlArena
+//-----------------------------------------------------------------------------
+
+// Each object allocated from the arena is preceded in memory by a header
+// containing the pointer to the arena. The header is big enough to preserve
+// the alignment. Notice that the nodes and attributes allocated on the heap
+// don't have it, the objects allocated from the arena are always of the
+// private classes below using their own operator delete.
+static const size_t wxXML_ALLOC_HEADER_SIZE = 16;
+
+// Memory arena used by wxXmlDocument::Load() with wxXMLDOC_USE_ARENA flag: the
+// nodes and attributes are allocated from big blocks which are all freed
+// together when the last object allocated from them is deleted, and a single
+// copy of each distinct element or attribute name is shared by all of them.
+class wxXmlArena
+{
+public:
+    // The arena is created with a reference which must be released by calling
+    // Release() when no more nodes will be allocated from it.
+    wxXmlArena();
+
+    // Allocate memory for a node or an attribute, each allocated object keeps
+    // a reference to the arena until it is deleted.
+    void *Alloc(size_t size);
+
+    void Release()
+    {
+        if ( wxAtomicDec(m_refCount) == 0 )
+            delete this;
+    }
+
+    // Return the string corresponding to the given UTF-8 one: this is always
+    // the same object for the same string.
+    const wxString *Intern(wxMBConv *conv, const char *s);
+
+    // Create a node with the given name, which may be NULL for an empty one,
+    // and content, which is taken from the provided string that is left
+    // empty.
+    wxXmlNode *NewNode(wxXmlNodeType type,
+                       const wxString *name,
+                       wxString& content,
+                       int lineNo);
+
+    // Create an attribute with the given name and value, which is taken from
+    // the provided string that is left empty.
+    wxXmlAttribute *NewAttribute(const wxString *name, wxString& value);
+
+    // Create an element node with the given attributes, as passed to the
+    // expat element handler.
+    wxXmlNode *NewElement(wxMBConv *conv,
+                          const char *name,
+                          const char **atts,
+                          int lineNo);
+
+private:
+    // Only Release() can delete this object.
+    ~wxXmlArena();
+
+    // Allocate memory without taking a reference on the arena.
+    void *DoAlloc(size_t size);
+
+    struct InternEntry
+    {
+        size_t hash;
+        size_t len;
+        const char *key;
+        wxString *value;    // NULL for unused entries
+    };
+
+    void GrowInternTable();
+
+    wxAtomicInt m_refCount;
+
+    // The blocks of memory allocated so far and the free space in the last
+    // one of them.
+    wxVector<char *> m_blocks;
+    char *m_ptr;
+    size_t m_left;
+
+    // Hash table with the interned strings using open addressing, its size is
+    // always a power of 2.
+    wxVector<InternEntry> m_interned;
+    size_t m_internedCount;
+
+    wxDECLARE_NO_COPY_CLASS(wxXmlArena);
+};
+
+static inline void wxXmlArenaFree(void *p)
+{
+    if ( !p )
+        return;
+
+    void * const block = static_cast<char *>(p) - wxXML_ALLOC_HEADER_SIZE;
+    (*static_cast<wxXmlArena **>(block))->Release();
+}
+
+// Node allocated from the arena: as wxXmlNode has a virtual destructor, its
+// operator delete is used when deleting it via a pointer to the base class.
+class wxXmlArenaNode : public wxXmlNode
+{
+public:
+    wxXmlArenaNode(wxXmlNodeType type, const wxString *name, int lineNo)
+        : wxXmlNode(type, wxString(), wxString(), lineNo),
+          m_sharedName(name)
+    {
+    }
+
+    static void *operator new(size_t size, wxXmlArena& arena);
+    static void operator delete(void *p) { wxXmlArenaFree(p); }
+    static void operator delete(void *p, wxXmlArena& WXUNUSED(arena))
+        { wxXmlArenaFree(p); }
+
+    // interned name owned by the arena, only used if m_hasSharedName is set
+    const wxString * const m_sharedName;
+};
+
+// Attribute allocated from the arena, see wxXmlArenaNode.
+class wxXmlArenaAttribute : public wxXmlAttribute
+{
+public:
+    explicit wxXmlArenaAttribute(const wxString& name)
+        : wxXmlAttribute(name, wxString())
+    {
+    }
+
+    static void *operator new(size_t size, wxXmlArena& arena);
+    static void operator delete(void *p) { wxXmlArenaFree(p); }
+    static void operator delete(void *p, wxXmlArena& WXUNUSED(arena))
+        { wxXmlArenaFree(p); }
+};
+
+wxXmlArena::wxXmlArena()
+    : m_refCount(1),
+      m_ptr(NULL),
+      m_left(0),
+      m_interned(256),
+      m_internedCount(0)
+{
+    // wxVector value-initializes its elements, so all entries are unused.
+}
+
+wxXmlArena::~wxXmlArena()
+{
+    for ( size_t n = 0; n < m_interned.size(); n++ )
+    {
+        if ( m_interned[n].value )
+            m_interned[n].value->~wxString();
+    }
+
+    for ( size_t n = 0; n < m_blocks.size(); n++ )
+        ::operator delete(m_blocks[n]);
+}
+
+void *wxXmlArena::DoAlloc(size_t size)
+{
+    static const size_t BLOCK_SIZE = 64*1024;
+
+    size = (size + wxXML_ALLOC_HEADER_SIZE - 1) & ~(wxXML_ALLOC_HEADER_SIZE - 1);
+
+    // Don't waste the rest of the current block for unusually big objects.
+    if ( size > BLOCK_SIZE / 4 )
+    {
+        char * const p = static_cast<char *>(::operator new(size));
+        m_blocks.push_back(p);
+        return p;
+    }
+
+    if ( size > m_left )
+    {
+        m_ptr = static_cast<char *>(::operator new(BLOCK_SIZE));
+        m_blocks.push_back(m_ptr);
+        m_left = BLOCK_SIZE;
+    }
+
+    void * const p = m_ptr;
+    m_ptr += size;
+    m_left -= size;
+    return p;
+}
+
+void *wxXmlArena::Alloc(size_t size)
+{
+    void * const p = DoAlloc(size + wxXML_ALLOC_HEADER_SIZE);
+    wxAtomicInc(m_refCount);
+
+    *static_cast<wxXmlArena **>(p) = this;
+    return static_cast<char *>(p) + wxXML_ALLOC_HEADER_SIZE;
+}
+
+void wxXmlArena::GrowInternTable()
+{
+    wxVector<InternEntry> interned(m_interned.size() * 2);
+    const size_t mask = interned.size() - 1;
+
+    for ( size_t n = 0; n < m_interned.size(); n++ )
+    {
+        const InternEntry& e = m_interned[n];
+        if ( !e.value )
+            continue;
+
+        size_t i = e.hash & mask;
+        while ( interned[i].value )
+            i = (i + 1) & mask;
+
+        interned[i] = e;
+    }
+
+    m_interned.swap(interned);
+}
+
+
+void *wxXmlArenaNode::operator new(size_t size, wxXmlArena& arena)
+{
+    return arena.Alloc(size);
+}
+
+void *wxXmlArenaAttribute::operator new(size_t size, wxXmlArena& arena)
+{
+    return arena.Alloc(size);
+}
+
+
 //-----------------------------------------------------------------------------
 //  wxXmlNode
 //-----------------------------------------------------------------------------
@@ -55,7 +281,8 @@ wxXmlNode::wxXmlNode(wxXmlNode *parent,wxXmlNodeType type,
       m_attrs(attrs), m_parent(parent),
       m_children(NULL), m_next(next),
       m_lineNo(lineNo),
-      m_noConversion(false)
+      m_noConversion(false),
+      m_hasSharedName(false)
 {
     wxASSERT_MSG ( type != wxXML_ELEMENT_NODE || content.empty(), "element nodes can't have content" );
 
@@ -77,7 +304,7 @@ wxXmlNode::wxXmlNode(wxXmlNodeType type, const wxString& name,
     : m_type(type), m_name(name), m_content(content),
       m_attrs(NULL), m_parent(NULL),
       m_children(NULL), m_next(NULL),
-      m_lineNo(lineNo), m_noConversion(false)
+      m_lineNo(lineNo), m_noConversion(false), m_hasSharedName(false)
 {
     wxASSERT_MSG ( type != wxXML_ELEMENT_NODE || content.empty(), "element nodes can't have content" );
 }
@@ -105,6 +332,11 @@ wxXmlNode& wxXmlNode::operator=(const wxXmlNode& node)
     return *this;
 }
 
+const wxString& wxXmlNode::GetSharedName() const
+{
+    return *static_cast<const wxXmlArenaNode *>(this)->m_sharedName;
+}
+
 void wxXmlNode::DoFree()
 {
     wxXmlNode *c, *c2;
@@ -125,7 +357,8 @@ void wxXmlNode::DoFree()
 void wxXmlNode::DoCopy(const wxXmlNode& node)
 {
     m_type = node.m_type;
-    m_name = node.m_name;
+    m_name = node.GetName();
+    m_hasSharedName = false;
     m_content = node.m_content;
     m_lineNo = node.m_lineNo;
     m_noConversion = node.m_noConversion;
@@ -652,6 +885,93 @@ static wxString CharToString(wxMBConv *conv,
     return wxString::FromUTF8Unchecked(s, len);
 }
 
+const wxString *wxXmlArena::Intern(wxMBConv *conv, const char *s)
+{
+    // FNV-1a hash
+    const size_t len = strlen(s);
+    size_t hash = 2166136261u;
+    for ( size_t n = 0; n < len; n++ )
+    {
+        hash ^= static_cast<unsigned char>(s[n]);
+        hash *= 16777619u;
+    }
+
+    const size_t mask = m_interned.size() - 1;
+    size_t i = hash & mask;
+    for ( ;; )
+    {
+        const InternEntry& e = m_interned[i];
+        if ( !e.value )
+            break;
+
+        if ( e.hash == hash && e.len == len && memcmp(e.key, s, len) == 0 )
+            return e.value;
+
+        i = (i + 1) & mask;
+    }
+
+    char * const key = static_cast<char *>(DoAlloc(len + 1));
+    memcpy(key, s, len);
+
+    InternEntry& e = m_interned[i];
+    e.hash = hash;
+    e.len = len;
+    e.key = key;
+    e.value = ::new(DoAlloc(sizeof(wxString))) wxString(CharToString(conv, s, len));
+
+    const wxString * const value = e.value;
+
+    // Keep the table at most half full.
+    if ( ++m_internedCount * 2 > m_interned.size() )
+        GrowInternTable();
+
+    return value;
+}
+
+wxXmlNode *wxXmlArena::NewNode(wxXmlNodeType type,
+                               const wxString *name,
+                               wxString& content,
+                               int lineNo)
+{
+    wxXmlNode * const node = new(*this) wxXmlArenaNode(type, name, lineNo);
+    node->m_hasSharedName = name != NULL;
+    node->m_content.swap(content);
+
+    return node;
+}
+
+wxXmlAttribute *wxXmlArena::NewAttribute(const wxString *name, wxString& value)
+{
+    wxXmlAttribute * const attr = new(*this) wxXmlArenaAttribute(*name);
+    attr->m_value.swap(value);
+
+    return attr;
+}
+
+wxXmlNode *wxXmlArena::NewElement(wxMBConv *conv,
+                                  const char *name,
+                                  const char **atts,
+                                  int lineNo)
+{
+    wxString noContent;
+    wxXmlNode * const
+        node = NewNode(wxXML_ELEMENT_NODE, Intern(conv, name), noContent, lineNo);
+
+    // append the attributes directly to the end of the list instead of using
+    // AddAttribute() which would need to find it every time
+    wxXmlAttribute **link = &node->m_attrs;
+    for ( const char **a = atts; *a; a += 2 )
+    {
+        wxString value = CharToString(conv, a[1]);
+        wxXmlAttribute * const attr = NewAttribute(Intern(conv, a[0]), value);
+
+        *link = attr;
+        link = &attr->m_next;
+    }
+
+    return node;
+}
+
 // returns true if the given string contains only whitespaces
 bool wxIsWhiteOnly(const wxString& buf)
 {
@@ -673,6 +993,7 @@ struct wxXmlParsingContext
           lastChild(NULL),
           lastAsText(NULL),
           doctype(NULL),
+          arena(NULL),
           removeWhiteOnlyNodes(false)
     {}
 
@@ -684,9 +1005,27 @@ struct wxXmlParsingContext
     wxString   encoding;
     wxString   version;
     wxXmlDoctype *doctype;
+    wxXmlArena *arena;                  // non-NULL if wxXMLDOC_USE_ARENA is used
     bool       removeWhiteOnlyNodes;
 };
 
+// creates a new non-element node with the given name and content, which is
+// consumed by this function, using the arena if there is one
+static wxXmlNode *CreateNode(wxXmlParsingContext *ctx,
+                             wxXmlNodeType type,
+                             const char *name,
+                             wxString& content)
+{
+    const int lineNo = XML_GetCurrentLineNumber(ctx->parser);
+    if ( ctx->arena )
+    {
+        return ctx->arena->NewNode(type, ctx->arena->Intern(ctx->conv, name),
+                                   content, lineNo);
+    }
+
+    return new wxXmlNode(type, CharToString(ctx->conv, name), content, lineNo);
+}
+
 // checks that ctx->lastChild is in consistent state
 #define ASSERT_LAST_CHILD_OK(ctx)                                   \
     wxASSERT( ctx->lastChild == NULL ||                             \
@@ -698,17 +1037,26 @@ extern "C" {
 static void StartElementHnd(void *userData, const char *name, const char **atts)
 {
     wxXmlParsingContext *ctx = (wxXmlParsingContext*)userData;
-    wxXmlNode *node = new wxXmlNode(wxXML_ELEMENT_NODE,
-                                    CharToString(ctx->conv, name),
-                                    wxEmptyString,
-                                    XML_GetCurrentLineNumber(ctx->parser));
-    const char **a = atts;
-
-    // add node attributes
-    while (*a)
+    wxXmlNode *node;
+    if ( ctx->arena )
+    {
+        node = ctx->arena->NewElement(ctx->conv, name, atts,
+                                      XML_GetCurrentLineNumber(ctx->parser));
+    }
+    else
     {
-        node->AddAttribute(CharToString(ctx->conv, a[0]), CharToString(ctx->conv, a[1]));
-        a += 2;
+        node = new wxXmlNode(wxXML_ELEMENT_NODE,
+                             CharToString(ctx->conv, name),
+                             wxEmptyString,
+                             XML_GetCurrentLineNumber(ctx->parser));
+        const char **a = atts;
+
+        // add node attributes
+        while (*a)
+        {
+            node->AddAttribute(CharToString(ctx->conv, a[0]), CharToString(ctx->conv, a[1]));
+            a += 2;
+        }
     }
 
     ASSERT_LAST_CHILD_OK(ctx);
@@ -750,8 +1098,7 @@ static void TextHnd(void *userData, const char *s, int len)
         if (!whiteOnly)
         {
             wxXmlNode *textnode =
-                new wxXmlNode(wxXML_TEXT_NODE, wxS("text"), str,
-                              XML_GetCurrentLineNumber(ctx->parser));
+                CreateNode(ctx, wxXML_TEXT_NODE, "text", str);
 
             ASSERT_LAST_CHILD_OK(ctx);
             ctx->node->InsertChildAfter(textnode, ctx->lastChild);
@@ -764,9 +1111,9 @@ static void StartCdataHnd(void *userData)
 {
     wxXmlParsingContext *ctx = (wxXmlParsingContext*)userData;
 
+    wxString content;
     wxXmlNode *textnode =
-        new wxXmlNode(wxXML_CDATA_SECTION_NODE, wxS("cdata"), wxS(""),
-                      XML_GetCurrentLineNumber(ctx->parser));
+        CreateNode(ctx, wxXML_CDATA_SECTION_NODE, "cdata", content);
 
     ASSERT_LAST_CHILD_OK(ctx);
     ctx->node->InsertChildAfter(textnode, ctx->lastChild);
@@ -788,10 +1135,9 @@ static void CommentHnd(void *userData, const char *data)
 {
     wxXmlParsingContext *ctx = (wxXmlParsingContext*)userData;
 
+    wxString content = CharToString(ctx->conv, data);
     wxXmlNode *commentnode =
-        new wxXmlNode(wxXML_COMMENT_NODE,
-                      wxS("comment"), CharToString(ctx->conv, data),
-                      XML_GetCurrentLineNumber(ctx->parser));
+        CreateNode(ctx, wxXML_COMMENT_NODE, "comment", content);
 
     ASSERT_LAST_CHILD_OK(ctx);
     ctx->node->InsertChildAfter(commentnode, ctx->lastChild);
@@ -803,10 +1149,8 @@ static void PIHnd(void *userData, const char *target, const char *data)
 {
     wxXmlParsingContext *ctx = (wxXmlParsingContext*)userData;
 
-    wxXmlNode *pinode =
-        new wxXmlNode(wxXML_PI_NODE, CharToString(ctx->conv, target),
-                      CharToString(ctx->conv, data),
-                      XML_GetCurrentLineNumber(ctx->parser));
+    wxString content = CharToString(ctx->conv, data);
+    wxXmlNode *pinode = CreateNode(ctx, wxXML_PI_NODE, target, content);
 
     ASSERT_LAST_CHILD_OK(ctx);
     ctx->node->InsertChildAfter(pinode, ctx->lastChild);
@@ -893,7 +1237,23 @@ bool wxXmlDocument::Load(wxInputStream& stream, const wxString& encoding, int fl
     wxXmlParsingContext ctx;
     bool done;
     XML_Parser parser = XML_ParserCreate(NULL);
-    wxXmlNode *root = new wxXmlNode(wxXML_DOCUMENT_NODE, wxEmptyString);
+
+    // when using the arena, we keep a reference to it while loading and all
+    // the nodes keep their own references, so that it is destroyed when both
+    // the loading is done and all the nodes are deleted
+    wxXmlArena *arena = NULL;
+    wxXmlNode *root;
+    if ( flags & wxXMLDOC_USE_ARENA )
+    {
+        arena = new wxXmlArena;
+
+        wxString noContent;
+        root = arena->NewNode(wxXML_DOCUMENT_NODE, NULL, noContent, -1);
+    }
+    else
+    {
+        root = new wxXmlNode(wxXML_DOCUMENT_NODE, wxEmptyString);
+    }
 
     ctx.encoding = wxS("UTF-8"); // default in absence of encoding=""
     ctx.conv = NULL;
@@ -905,6 +1265,7 @@ bool wxXmlDocument::Load(wxInputStream& stream, const wxString& encoding, int fl
     ctx.removeWhiteOnlyNodes = (flags & wxXMLDOC_KEEP_WHITESPACE_NODES) == 0;
     ctx.parser = parser;
     ctx.node = root;
+    ctx.arena = arena;
 
     XML_SetUserData(parser, (void*)&ctx);
     XML_SetElementHandler(parser, StartElementHnd, EndElementHnd);
@@ -952,12 +1313,1040 @@ bool wxXmlDocument::Load(wxInputStream& stream, const wxString& encoding, int fl
         delete ctx.conv;
 #endif
 
+    if ( arena )
+        arena->Release();
+
     return ok;
 
 }
 
 
 
+//-----------------------------------------------------------------------------
+//  wxXmlReader
+//-----------------------------------------------------------------------------
+
+// A single node read by wxXmlReader: these objects are reused for the
+// subsequent nodes to avoid reallocating their strings all the time.
+struct wxXmlReaderItem
+{
+    wxXmlReaderItem()
+        : type(wxXML_READER_NONE), attrCount(0), depth(-1), lineNo(-1)
+    {}
+
+    wxXmlReaderNodeType type;
+    wxString name;
+    wxString content;
+
+    // Names and values of the attributes, alternating, only the first
+    // 2*attrCount elements of this vector are used.
+    wxVector<wxString> attrs;
+    size_t attrCount;
+
+    int depth;
+    int lineNo;
+};
+
+class wxXmlReaderImpl
+{
+public:
+    wxXmlReaderImpl(wxInputStream& stream_, int flags)
+        : stream(stream_),
+          removeWhiteOnlyNodes((flags & wxXMLDOC_KEEP_WHITESPACE_NODES) == 0),
+          done(false),
+          error(false),
+          count(0),
+          current(0),
+          depth(0),
+          inCdata(false),
+          textLine(-1)
+    {
+        parser = XML_ParserCreate(NULL);
+    }
+
+    ~wxXmlReaderImpl()
+    {
+        XML_ParserFree(parser);
+    }
+
+    // Return the current item or NULL if there is none.
+    const wxXmlReaderItem *GetCurrent() const
+    {
+        return current < count ? &items[current] : NULL;
+    }
+
+    // Add a new item of the given type at the current depth.
+    wxXmlReaderItem& AddItem(wxXmlReaderNodeType type, int lineNo)
+    {
+        if ( count == items.size() )
+            items.push_back(wxXmlReaderItem());
+
+        wxXmlReaderItem& item = items[count++];
+        item.type = type;
+        item.attrCount = 0;
+        item.depth = depth;
+        item.lineNo = lineNo;
+
+        return item;
+    }
+
+    int GetLineNumber() const
+    {
+        return XML_GetCurrentLineNumber(parser);
+    }
+
+    // Add the text accumulated so far as a new item, if any.
+    void FlushText()
+    {
+        if ( text.empty() )
+            return;
+
+        if ( !removeWhiteOnlyNodes || !wxIsWhiteOnly(text) )
+            AddItem(wxXML_READER_TEXT, textLine).content = text;
+
+        text.clear();
+    }
+
+    // Parse the next chunk of input, return false on error or if there is
+    // nothing more to parse.
+    bool ParseMore()
+    {
+        if ( done || error )
+            return false;
+
+        const size_t len = stream.Read(buf, WXSIZEOF(buf)).LastRead();
+        done = len < WXSIZEOF(buf);
+        if ( !XML_Parse(parser, buf, len, done) )
+        {
+            wxString err(XML_ErrorString(XML_GetErrorCode(parser)),
+                         *wxConvCurrent);
+            wxLogError(_("XML parsing error: '%s' at line %d"),
+                       err.c_str(),
+                       GetLineNumber());
+            error = true;
+            return false;
+        }
+
+        if ( done )
+            FlushText();
+
+        return true;
+    }
+
+    XML_Parser parser;
+    wxInputStream& stream;
+    const bool removeWhiteOnlyNodes;
+    bool done,
+         error;
+
+    // The items produced by the last parsed chunk of input, only the first
+    // count of them are used and current is the index of the current one.
+    wxVector<wxXmlReaderItem> items;
+    size_t count,
+           current;
+
+    // The depth of the node being parsed.
+    int depth;
+
+    // The text or CDATA section contents not added as an item yet.
+    wxString text;
+    bool inCdata;
+    int textLine;
+
+    char buf[16384];
+
+    wxDECLARE_NO_COPY_CLASS(wxXmlReaderImpl);
+};
+
+extern "C" {
+static void ReaderStartElementHnd(void *userData,
+                                  const char *name, const char **atts)
+{
+    wxXmlReaderImpl *impl = (wxXmlReaderImpl*)userData;
+
+    impl->FlushText();
+
+    wxXmlReaderItem& item = impl->AddItem(wxXML_READER_START_ELEMENT,
+                                          impl->GetLineNumber());
+    item.name = CharToString(NULL, name);
+
+    for ( const char **a = atts; *a; a += 2 )
+    {
+        const size_t n = 2*item.attrCount++;
+        if ( item.attrs.size() < n + 2 )
+            item.attrs.resize(n + 2);
+
+        item.attrs[n] = CharToString(NULL, a[0]);
+        item.attrs[n + 1] = CharToString(NULL, a[1]);
+    }
+
+    impl->depth++;
+}
+
+static void ReaderEndElementHnd(void *userData, const char *name)
+{
+    wxXmlReaderImpl *impl = (wxXmlReaderImpl*)userData;
+
+    impl->FlushText();
+    impl->depth--;
+
+    impl->AddItem(wxXML_READER_END_ELEMENT, impl->GetLineNumber()).name =
+        CharToString(NULL, name);
+}
+
+static void ReaderTextHnd(void *userData, const char *s, int len)
+{
+    wxXmlReaderImpl *impl = (wxXmlReaderImpl*)userData;
+
+    if ( impl->text.empty() && !impl->inCdata )
+        impl->textLine = impl->GetLineNumber();
+
+    impl->text += CharToString(NULL, s, len);
+}
+
+static void ReaderStartCdataHnd(void *userData)
+{
+    wxXmlReaderImpl *impl = (wxXmlReaderImpl*)userData;
+
+    impl->FlushText();
+    impl->inCdata = true;
+    impl->textLine = impl->GetLineNumber();
+}
+
+static void ReaderEndCdataHnd(void *userData)
+{
+    wxXmlReaderImpl *impl = (wxXmlReaderImpl*)userData;
+
+    // unlike text nodes, CDATA sections are never discarded
+    impl->AddItem(wxXML_READER_CDATA, impl->textLine).content = impl->text;
+    impl->text.clear();
+    impl->inCdata = false;
+}
+
+static void ReaderCommentHnd(void *userData, const char *data)
+{
+    wxXmlReaderImpl *impl = (wxXmlReaderImpl*)userData;
+
+    impl->FlushText();
+
+    wxXmlReaderItem& item = impl->AddItem(wxXML_READER_COMMENT,
+                                          impl->GetLineNumber());
+    item.name = wxS("comment");
+    item.content = CharToString(NULL, data);
+}
+
+static void ReaderPIHnd(void *userData, const char *target, const char *data)
+{
+    wxXmlReaderImpl *impl = (wxXmlReaderImpl*)userData;
+
+    impl->FlushText();
+
+    wxXmlReaderItem& item = impl->AddItem(wxXML_READER_PI,
+                                          impl->GetLineNumber());
+    item.name = CharToString(NULL, target);
+    item.content = CharToString(NULL, data);
+}
+} // extern "C"
+
+// The item returned when there is no current node.
+static const wxXmlReaderItem gs_noReaderItem;
+
+static const wxXmlReaderItem& GetReaderItem(const wxXmlReaderImpl *impl)
+{
+    const wxXmlReaderItem * const item = impl ? impl->GetCurrent() : NULL;
+
+    return item ? *item : gs_noReaderItem;
+}
+
+wxXmlReader::wxXmlReader()
+{
+    m_impl = NULL;
+}
+
+wxXmlReader::wxXmlReader(wxInputStream& stream, int flags)
+{
+    m_impl = NULL;
+
+    Open(stream, flags);
+}
+
+wxXmlReader::~wxXmlReader()
+{
+    Close();
+}
+
+bool wxXmlReader::Open(wxInputStream& stream, int flags)
+{
+    Close();
+
+    m_impl = new wxXmlReaderImpl(stream, flags);
+
+    XML_Parser parser = m_impl->parser;
+    XML_SetUserData(parser, m_impl);
+    XML_SetElementHandler(parser, ReaderStartElementHnd, ReaderEndElementHnd);
+    XML_SetCharacterDataHandler(parser, ReaderTextHnd);
+    XML_SetCdataSectionHandler(parser, ReaderStartCdataHnd, ReaderEndCdataHnd);
+    XML_SetCommentHandler(parser, ReaderCommentHnd);
+    XML_SetProcessingInstructionHandler(parser, ReaderPIHnd);
+    XML_SetUnknownEncodingHandler(parser, UnknownEncodingHnd, NULL);
+
+    return stream.IsOk();
+}
+
+void wxXmlReader::Close()
+{
+    wxDELETE(m_impl);
+}
+
+bool wxXmlReader::Read()
+{
+    wxCHECK_MSG( m_impl, false, wxS("must be opened first") );
+
+    if ( m_impl->current + 1 < m_impl->count )
+    {
+        m_impl->current++;
+        return true;
+    }
+
+    // We're done with all the items from the last chunk, parse the next one,
+    // reusing the existing items.
+    m_impl->count =
+    m_impl->current = 0;
+
+    while ( !m_impl->count )
+    {
+        if ( !m_impl->ParseMore() )
+            return false;
+    }
+
+    return true;
+}
+
+bool wxXmlReader::Parse(wxXmlReaderHandler& handler)
+{
+    while ( Read() )
+    {
+        bool cont = true;
+        switch ( GetNodeType() )
+        {
+            case wxXML_READER_START_ELEMENT:
+                cont = handler.OnStartElement(*this);
+                break;
+
+            case wxXML_READER_END_ELEMENT:
+                cont = handler.OnEndElement(*this);
+                break;
+
+            case wxXML_READER_TEXT:
+            case wxXML_READER_CDATA:
+                cont = handler.OnText(*this);
+                break;
+
+            case wxXML_READER_COMMENT:
+                cont = handler.OnComment(*this);
+                break;
+
+            case wxXML_READER_PI:
+                cont = handler.OnProcessingInstruction(*this);
+                break;
+
+            case wxXML_READER_NONE:
+                wxFAIL_MSG( wxS("unexpected node type") );
+                break;
+        }
+
+        if ( !cont )
+            break;
+    }
+
+    return !HasError();
+}
+
+bool wxXmlReader::HasError() const
+{
+    return m_impl && m_impl->error;
+}
+
+wxXmlReaderNodeType wxXmlReader::GetNodeType() const
+{
+    return GetReaderItem(m_impl).type;
+}
+
+const wxString& wxXmlReader::GetName() const
+{
+    return GetReaderItem(m_impl).name;
+}
+
+const wxString& wxXmlReader::GetContent() const
+{
+    return GetReaderItem(m_impl).content;
+}
+
+int wxXmlReader::GetDepth() const
+{
+    return GetReaderItem(m_impl).depth;
+}
+
+int wxXmlReader::GetLineNumber() const
+{
+    return GetReaderItem(m_impl).lineNo;
+}
+
+size_t wxXmlReader::GetAttributeCount() const
+{
+    return GetReaderItem(m_impl).attrCount;
+}
+
+const wxString& wxXmlReader::GetAttributeName(size_t n) const
+{
+    const wxXmlReaderItem& item = GetReaderItem(m_impl);
+    wxCHECK_MSG( n < item.attrCount, gs_noReaderItem.name,
+                 wxS("invalid attribute index") );
+
+    return item.attrs[2*n];
+}
+
+const wxString& wxXmlReader::GetAttributeValue(size_t n) const
+{
+    const wxXmlReaderItem& item = GetReaderItem(m_impl);
+    wxCHECK_MSG( n < item.attrCount, gs_noReaderItem.name,
+                 wxS("invalid attribute index") );
+
+    return item.attrs[2*n + 1];
+}
+
+bool wxXmlReader::GetAttribute(const wxString& attrName, wxString *value) const
+{
+    const size_t count = GetAttributeCount();
+    for ( size_t n = 0; n < count; n++ )
+    {
+        if ( GetAttributeName(n) == attrName )
+        {
+            if ( value )
+                *value = GetAttributeValue(n);
+            return true;
+        }
+    }
+
+    return false;
+}
+
+wxString wxXmlReader::GetAttribute(const wxString& attrName,
+                                   const wxString& defaultVal) const
+{
+    wxString tmp;
+    return GetAttribute(attrName, &tmp) ? tmp : defaultVal;
+}
+
+bool wxXmlReader::HasAttribute(const wxString& attrName) const
+{
+    return GetAttribute(attrName, NULL);
+}
+
+wxXmlNode *wxXmlReader::ReadNode()
+{
+    wxCHECK_MSG( GetNodeType() == wxXML_READER_START_ELEMENT, NULL,
+                 wxS("must be positioned on a start element") );
+
+    const int depth = GetDepth();
+
+    wxXmlNode *node = NULL;
+    wxXmlNode *parent = NULL;
+    wxXmlNode *lastChild = NULL;
+    for ( ;; )
+    {
+        wxXmlNode *child = NULL;
+        switch ( GetNodeType() )
+        {
+            case wxXML_READER_START_ELEMENT:
+                child = new wxXmlNode(wxXML_ELEMENT_NODE, GetName(),
+                                      wxString(), GetLineNumber());
+                for ( size_t n = GetAttributeCount(); n > 0; n-- )
+                {
+                    // prepending the attributes is faster than appending them
+                    child->SetAttributes(new wxXmlAttribute
+                                             (
+                                                GetAttributeName(n - 1),
+                                                GetAttributeValue(n - 1),
+                                                child->GetAttributes()
+                                             ));
+                }
+                break;
+
+            case wxXML_READER_END_ELEMENT:
+                if ( GetDepth() == depth )
+                    return node;
+
+                lastChild = parent;
+                parent = parent->GetParent();
+                break;
+
+            case wxXML_READER_TEXT:
+                child = new wxXmlNode(wxXML_TEXT_NODE, wxS("text"),
+                                      GetContent(), GetLineNumber());
+                break;
+
+            case wxXML_READER_CDATA:
+                child = new wxXmlNode(wxXML_CDATA_SECTION_NODE, wxS("cdata"),
+                                      GetContent(), GetLineNumber());
+                break;
+
+            case wxXML_READER_COMMENT:
+                child = new wxXmlNode(wxXML_COMMENT_NODE, wxS("comment"),
+                                      GetContent(), GetLineNumber());
+                break;
+
+            case wxXML_READER_PI:
+                child = new wxXmlNode(wxXML_PI_NODE, GetName(),
+                                      GetContent(), GetLineNumber());
+                break;
+
+            case wxXML_READER_NONE:
+                wxFAIL_MSG( wxS("unexpected node type") );
+                break;
+        }
+
+        if ( child )
+        {
+            if ( !node )
+            {
+                node = child;
+            }
+            else
+            {
+                parent->InsertChildAfter(child, lastChild);
+                lastChild = child;
+            }
+
+            if ( child->GetType() == wxXML_ELEMENT_NODE )
+            {
+                parent = child;
+                lastChild = NULL;
+            }
+        }
+
+        if ( !Read() )
+            break;
+    }
+
+    // we didn't find the end of the element, the document must be truncated
+    delete node;
+
+    return NULL;
+}
+
+bool wxXmlReader::Skip()
+{
+    wxCHECK_MSG( GetNodeType() == wxXML_READER_START_ELEMENT, false,
+                 wxS("must be positioned on a start element") );
+
+    const int depth = GetDepth();
+    while ( Read() )
+    {
+        if ( GetNodeType() == wxXML_READER_END_ELEMENT && GetDepth() == depth )
+            return true;
+    }
+
+    return false;
+}
+
+
+//-----------------------------------------------------------------------------
+//  wxXmlBinaryDocument
+//-----------------------------------------------------------------------------
+
+// The binary format consists of:
+//  - The header: signature, format version, number of strings, number of
+//    children of the root element and offsets of the root element record, of
+//    the index and of the children records.
+//  - The string table: each string is stored as its length followed by its
+//    UTF-8 representation and a NUL terminator. Strings are referenced by
+//    their index in this table.
+//  - The root element record, stored without children.
+//  - The index: the name, the key and the offset of the record relative to
+//    the start of the children records for each child of the root.
+//  - The children records: each record contains the node type, name, content,
+//    line number, the attributes as pairs of strings and the children records.
+// All numbers are stored as 32-bit little endian integers.
+
+static const char wxXML_BINARY_SIGNATURE[] = "wxXMLbin";
+static const size_t wxXML_BINARY_SIGNATURE_LEN = 8;
+static const size_t wxXML_BINARY_HEADER_SIZE = wxXML_BINARY_SIGNATURE_LEN + 6*4;
+static const wxUint32 wxXML_BINARY_VERSION = 1;
+static const wxUint32 wxXML_BINARY_NO_STRING = 0xffffffff;
+
+// Maximal nesting level of the nodes, deeper documents can't be saved and
+// are considered to be invalid when loading, as reading them would overflow
+// the stack.
+static const unsigned wxXML_BINARY_MAX_DEPTH = 1024;
+
+WX_DECLARE_STRING_HASH_MAP(wxUint32, wxXmlBinaryStringIds);
+WX_DECLARE_STRING_HASH_MAP(int, wxXmlBinaryKeys);
+
+static void wxXmlBinaryAppendU32(wxMemoryBuffer& buf, wxUint32 value)
+{
+    value = wxUINT32_SWAP_ON_BE(value);
+    buf.AppendData(&value, sizeof(value));
+}
+
+// Helper class collecting the strings used by the document being saved.
+class wxXmlBinaryWriter
+{
+public:
+    wxXmlBinaryWriter() : m_count(0) { }
+
+    wxUint32 AddString(const wxString& str)
+    {
+        wxXmlBinaryStringIds::const_iterator it = m_ids.find(str);
+        if ( it != m_ids.end() )
+            return it->second;
+
+        const wxScopedCharBuffer utf8(str.utf8_str());
+        wxXmlBinaryAppendU32(m_strings, static_cast<wxUint32>(utf8.length()));
+        m_strings.AppendData(utf8.data(), utf8.length() + 1);
+
+        m_ids[str] = m_count;
+        return m_count++;
+    }
+
+    // Returns false if the node is nested too deeply.
+    bool WriteNode(wxMemoryBuffer& buf,
+                   const wxXmlNode *node,
+                   bool withChildren,
+                   unsigned depth)
+    {
+        if ( depth > wxXML_BINARY_MAX_DEPTH )
+            return false;
+
+        wxXmlBinaryAppendU32(buf, node->GetType());
+        wxXmlBinaryAppendU32(buf, AddString(node->GetName()));
+        wxXmlBinaryAppendU32(buf, node->GetContent().empty()
+                                    ? wxXML_BINARY_NO_STRING
+                                    : AddString(node->GetContent()));
+        wxXmlBinaryAppendU32(buf, static_cast<wxUint32>(node->GetLineNumber()));
+
+        wxUint32 count = 0;
+        const wxXmlAttribute *attr;
+        for ( attr = node->GetAttributes(); attr; attr = attr->GetNext() )
+            count++;
+
+        wxXmlBinaryAppendU32(buf, count);
+        for ( attr = node->GetAttributes(); attr; attr = attr->GetNext() )
+        {
+            wxXmlBinaryAppendU32(buf, AddString(attr->GetName()));
+            wxXmlBinaryAppendU32(buf, AddString(attr->GetValue()));
+        }
+
+        count = 0;
+        const wxXmlNode *child;
+        if ( withChildren )
+        {
+            for ( child = node->GetChildren(); child; child = child->GetNext() )
+                count++;
+        }
+
+        wxXmlBinaryAppendU32(buf, count);
+        if ( withChildren )
+        {
+            for ( child = node->GetChildren(); child; child = child->GetNext() )
+            {
+                if ( !WriteNode(buf, child, true, depth + 1) )
+                    return false;
+            }
+        }
+
+        return true;
+    }
+
+    wxUint32 GetCount() const { return m_count; }
+    const wxMemoryBuffer& GetStrings() const { return m_strings; }
+
+private:
+    wxXmlBinaryStringIds m_ids;
+    wxMemoryBuffer m_strings;
+    wxUint32 m_count;
+
+    wxDECLARE_NO_COPY_CLASS(wxXmlBinaryWriter);
+};
+
+class wxXmlBinaryDocumentImpl
+{
+public:
+    wxXmlBinaryDocumentImpl()
+        : arena(NULL),
+          rootOffset(0),
+          nodesOffset(0)
+    {
+    }
+
+    ~wxXmlBinaryDocumentImpl()
+    {
+        if ( arena )
+            arena->Release();
+    }
+
+    bool Load(wxInputStream& stream);
+
+    // All the functions below check that the data is valid and return false
+    // or NULL if it isn't.
+    bool ReadU32(size_t& pos, wxUint32& value) const
+    {
+        if ( data.GetDataLen() < 4 || pos > data.GetDataLen() - 4 )
+            return false;
+
+        memcpy(&value, static_cast<const char *>(data.GetData()) + pos, 4);
+        value = wxUINT32_SWAP_ON_BE(value);
+        pos += 4;
+        return true;
+    }
+
+    bool IsValidString(wxUint32 n) const
+    {
+        return n == wxXML_BINARY_NO_STRING || n < strings.size();
+    }
+
+    wxString GetString(wxUint32 n) const
+    {
+        if ( n == wxXML_BINARY_NO_STRING )
+            return wxString();
+
+        const StringInfo& info = strings[n];
+        return wxString::FromUTF8Unchecked(info.str, info.len);
+    }
+
+    // The depth is used to reject too deeply nested nodes.
+    wxXmlNode *ReadNode(size_t& pos, unsigned depth) const;
+
+    struct StringInfo
+    {
+        const char *str;
+        wxUint32 len;
+    };
+
+    struct Entry
+    {
+        wxUint32 name;
+        wxUint32 key;
+        wxUint32 offset;
+        int next;           // next entry with the same key or wxNOT_FOUND
+    };
+
+    // The nodes created from the data are allocated from this arena, which is
+    // only created if the data was loaded successfully.
+    wxXmlArena *arena;
+
+    wxMemoryBuffer data;
+    wxVector<StringInfo> strings;
+    size_t rootOffset;
+    size_t nodesOffset;
+    wxVector<Entry> entries;
+    wxXmlBinaryKeys keys;
+};
+
+bool wxXmlBinaryDocumentImpl::Load(wxInputStream& stream)
+{
+    static const size_t CHUNK_SIZE = 64*1024;
+    for ( ;; )
+    {
+        void * const buf = data.GetAppendBuf(CHUNK_SIZE);
+        const size_t len = stream.Read(buf, CHUNK_SIZE).LastRead();
+        data.UngetAppendBuf(len);
+        if ( !len || !stream.IsOk() )
+            break;
+    }
+
+    if ( stream.GetLastError() == wxSTREAM_READ_ERROR )
+        return false;
+
+    const char * const p = static_cast<const char *>(data.GetData());
+    const size_t size = data.GetDataLen();
+    if ( size < wxXML_BINARY_HEADER_SIZE ||
+            memcmp(p, wxXML_BINARY_SIGNATURE, wxXML_BINARY_SIGNATURE_LEN) != 0 )
+        return false;
+
+    size_t pos = wxXML_BINARY_SIGNATURE_LEN;
+    wxUint32 version, stringCount, count, root, index, nodes;
+    if ( !ReadU32(pos, version) || version != wxXML_BINARY_VERSION ||
+            !ReadU32(pos, stringCount) ||
+                !ReadU32(pos, count) ||
+                    !ReadU32(pos, root) ||
+                        !ReadU32(pos, index) ||
+                            !ReadU32(pos, nodes) )
+        return false;
+
+    // Each string takes at least 5 bytes, check for this to avoid allocating
+    // huge amounts of memory for corrupted data.
+    if ( stringCount > size / 5 )
+        return false;
+
+    strings.reserve(stringCount);
+    for ( wxUint32 n = 0; n < stringCount; n++ )
+    {
+        StringInfo info;
+        if ( !ReadU32(pos, info.len) || info.len >= size - pos ||
+                p[pos + info.len] != '\0' )
+            return false;
+
+        info.str = p + pos;
+        strings.push_back(info);
+        pos += info.len + 1;
+    }
+
+    rootOffset = root;
+    nodesOffset = nodes;
+    if ( rootOffset >= size || nodesOffset > size || count > size / 12 )
+        return false;
+
+    pos = index;
+    entries.resize(count);
+    for ( wxUint32 n = 0; n < count; n++ )
+    {
+        Entry& e = entries[n];
+        if ( !ReadU32(pos, e.name) || e.name >= strings.size() ||
+                !ReadU32(pos, e.key) || !IsValidString(e.key) ||
+                    !ReadU32(pos, e.offset) || e.offset >= size - nodesOffset )
+            return false;
+    }
+
+    // Iterate in reverse order to link the entries with the same key in
+    // the direct order.
+    for ( wxUint32 n = count; n > 0; n-- )
+    {
+        Entry& e = entries[n - 1];
+        e.next = wxNOT_FOUND;
+        if ( e.key == wxXML_BINARY_NO_STRING )
+            continue;
+
+        const wxString key = GetString(e.key);
+        wxXmlBinaryKeys::iterator it = keys.find(key);
+        if ( it != keys.end() )
+        {
+            e.next = it->second;
+            it->second = n - 1;
+        }
+        else
+        {
+            keys[key] = n - 1;
+        }
+    }
+
+    arena = new wxXmlArena;
+
+    return true;
+}
+
+wxXmlNode *wxXmlBinaryDocumentImpl::ReadNode(size_t& pos, unsigned depth) const
+{
+    if ( depth > wxXML_BINARY_MAX_DEPTH )
+        return NULL;
+
+    wxUint32 type, name, content, lineNo, count;
+    if ( !ReadU32(pos, type) ||
+            !ReadU32(pos, name) || name >= strings.size() ||
+                !ReadU32(pos, content) || !IsValidString(content) ||
+                    !ReadU32(pos, lineNo) )
+        return NULL;
+
+    wxString value = GetString(content);
+    wxScopedPtr<wxXmlNode> node(arena->NewNode(static_cast<wxXmlNodeType>(type),
+                                               arena->Intern(NULL, strings[name].str),
+                                               value,
+                                               static_cast<int>(lineNo)));
+
+    if ( !ReadU32(pos, count) )
+        return NULL;
+
+    wxXmlAttribute *lastAttr = NULL;
+    for ( wxUint32 n = 0; n < count; n++ )
+    {
+        wxUint32 attrName, attrValue;
+        if ( !ReadU32(pos, attrName) || attrName >= strings.size() ||
+                !ReadU32(pos, attrValue) || attrValue >= strings.size() )
+            return NULL;
+
+        value = GetString(attrValue);
+        wxXmlAttribute * const
+            attr = arena->NewAttribute(arena->Intern(NULL, strings[attrName].str),
+                                       value);
+        if ( lastAttr )
+            lastAttr->SetNext(attr);
+        else
+            node->SetAttributes(attr);
+        lastAttr = attr;
+    }
+
+    if ( !ReadU32(pos, count) )
+        return NULL;
+
+    wxXmlNode *lastChild = NULL;
+    for ( wxUint32 n = 0; n < count; n++ )
+    {
+        wxXmlNode * const child = ReadNode(pos, depth + 1);
+        if ( !child )
+            return NULL;
+
+        child->SetParent(node.get());
+        if ( lastChild )
+            lastChild->SetNext(child);
+        else
+            node->SetChildren(child);
+        lastChild = child;
+    }
+
+    return node.release();
+}
+
+wxXmlBinaryDocument::wxXmlBinaryDocument()
+    : m_impl(new wxXmlBinaryDocumentImpl)
+{
+}
+
+wxXmlBinaryDocument::~wxXmlBinaryDocument()
+{
+    delete m_impl;
+}
+
+/* static */
+bool wxXmlBinaryDocument::Save(const wxXmlDocument& doc,
+                               wxOutputStream& stream,
+                               const wxString& indexAttr)
+{
+    const wxXmlNode * const root = doc.GetRoot();
+    wxCHECK_MSG( root, false, wxS("can't save an empty document") );
+
+    wxXmlBinaryWriter writer;
+    wxMemoryBuffer rootData, index, nodes;
+    writer.WriteNode(rootData, root, false, 0);
+
+    wxUint32 count = 0;
+    for ( const wxXmlNode *node = root->GetChildren(); node; node = node->GetNext() )
+    {
+        wxString key;
+        wxXmlBinaryAppendU32(index, writer.AddString(node->GetName()));
+        wxXmlBinaryAppendU32(index, node->GetAttribute(indexAttr, &key)
+                                        ? writer.AddString(key)
+                                        : wxXML_BINARY_NO_STRING);
+        wxXmlBinaryAppendU32(index, static_cast<wxUint32>(nodes.GetDataLen()));
+
+        if ( !writer.WriteNode(nodes, node, true, 1) )
+            return false;
+        count++;
+    }
+
+    const wxMemoryBuffer& strings = writer.GetStrings();
+    const size_t rootOffset = wxXML_BINARY_HEADER_SIZE + strings.GetDataLen();
+    const size_t indexOffset = rootOffset + rootData.GetDataLen();
+    const size_t nodesOffset = indexOffset + index.GetDataLen();
+
+    wxMemoryBuffer header;
+    header.AppendData(wxXML_BINARY_SIGNATURE, wxXML_BINARY_SIGNATURE_LEN);
+    wxXmlBinaryAppendU32(header, wxXML_BINARY_VERSION);
+    wxXmlBinaryAppendU32(header, writer.GetCount());
+    wxXmlBinaryAppendU32(header, count);
+    wxXmlBinaryAppendU32(header, static_cast<wxUint32>(rootOffset));
+    wxXmlBinaryAppendU32(header, static_cast<wxUint32>(indexOffset));
+    wxXmlBinaryAppendU32(header, static_cast<wxUint32>(nodesOffset));
+
+    stream.Write(header.GetData(), header.GetDataLen());
+    stream.Write(strings.GetData(), strings.GetDataLen());
+    stream.Write(rootData.GetData(), rootData.GetDataLen());
+    stream.Write(index.GetData(), index.GetDataLen());
+    stream.Write(nodes.GetData(), nodes.GetDataLen());
+
+    return stream.IsOk();
+}
+
+/* static */
+bool wxXmlBinaryDocument::CanRead(wxInputStream& stream)
+{
+    char buf[wxXML_BINARY_SIGNATURE_LEN];
+    const size_t len = stream.Read(buf, sizeof(buf)).LastRead();
+    stream.Ungetch(buf, len);
+
+    return len == wxXML_BINARY_SIGNATURE_LEN &&
+            memcmp(buf, wxXML_BINARY_SIGNATURE, len) == 0;
+}
+
+bool wxXmlBinaryDocument::Load(wxInputStream& stream)
+{
+    delete m_impl;
+    m_impl = new wxXmlBinaryDocumentImpl;
+
+    if ( !m_impl->Load(stream) )
+    {
+        wxLogError(_("Invalid binary XML data."));
+
+        delete m_impl;
+        m_impl = new wxXmlBinaryDocumentImpl;
+        return false;
+    }
+
+    return true;
+}
+
+bool wxXmlBinaryDocument::IsOk() const
+{
+    return m_impl->arena != NULL;
+}
+
+wxXmlNode *wxXmlBinaryDocument::CreateRoot() const
+{
+    wxCHECK_MSG( IsOk(), NULL, wxS("no data loaded") );
+
+    size_t pos = m_impl->rootOffset;
+    wxXmlNode * const root = m_impl->ReadNode(pos, 0);
+    if ( !root )
+        wxLogError(_("Invalid binary XML data."));
+
+    return root;
+}
+
+size_t wxXmlBinaryDocument::GetCount() const
+{
+    return m_impl->entries.size();
+}
+
+wxString wxXmlBinaryDocument::GetNodeName(size_t n) const
+{
+    wxCHECK_MSG( n < GetCount(), wxString(), wxS("invalid node index") );
+
+    return m_impl->GetString(m_impl->entries[n].name);
+}
+
+wxString wxXmlBinaryDocument::GetKey(size_t n) const
+{
+    wxCHECK_MSG( n < GetCount(), wxString(), wxS("invalid node index") );
+
+    return m_impl->GetString(m_impl->entries[n].key);
+}
+
+int wxXmlBinaryDocument::Find(const wxString& key) const
+{
+    const wxXmlBinaryKeys::const_iterator it = m_impl->keys.find(key);
+
+    return it == m_impl->keys.end() ? wxNOT_FOUND : it->second;
+}
+
+int wxXmlBinaryDocument::FindNext(size_t n) const
+{
+    wxCHECK_MSG( n < GetCount(), wxNOT_FOUND, wxS("invalid node index") );
+
+    return m_impl->entries[n].next;
+}
+
+wxXmlNode *wxXmlBinaryDocument::CreateNode(size_t n) const
+{
+    wxCHECK_MSG( n < GetCount(), NULL, wxS("invalid node index") );
+
+    size_t pos = m_impl->nodesOffset + m_impl->entries[n].offset;
+    wxXmlNode * const node = m_impl->ReadNode(pos, 1);
+    if ( !node )
+        wxLogError(_("Invalid binary XML data."));
+
+    return node;
+}
+
+
 //-----------------------------------------------------------------------------
 //  wxXmlDocument saving routines
 //-----------------------------------------------------------------------------
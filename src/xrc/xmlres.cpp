@@ -45,6 +45,7 @@
 #include "wx/hashset.h"
 #include "wx/scopedptr.h"
 #include "wx/config.h"
+#include "wx/thread.h"
 
 #include <limits.h>
 #include <locale.h>
@@ -76,24 +77,345 @@ wxDateTime GetXRCFileModTime(const wxString& filename)
 // name.
 static void XRCID_Assign(const wxString& str_id, int value);
 
+// Open the resource file with the given name, return NULL and log an error if
+// it couldn't be done. The returned stream must be deleted by the caller.
+static wxInputStream *OpenResourceFile(const wxString& filename);
+
+// Return the encoding to use for loading the resource files.
+static wxString GetResourceEncoding(int flags);
+
+// Parse the contents of the resource file, which may be either an XRC file or
+// a compiled one: see wxXmlResource::DoLoadFile() for the meaning of binary.
+static wxXmlDocument *ParseResourceFile(wxInputStream& stream,
+                                        const wxString& filename,
+                                        const wxString& encoding,
+                                        wxXmlBinaryDocument **binary);
+
+#if wxUSE_THREADS
+
+class wxXmlResourceLoader;
+
+// A resource file being loaded in the background when wxXRC_LOAD_ASYNC is
+// used: the file is opened in the main thread but parsed by a worker one.
+class wxXmlResourceLoadJob
+{
+public:
+    // Ctor takes ownership of the stream.
+    wxXmlResourceLoadJob(wxXmlResourceLoader& loader,
+                         wxInputStream *stream,
+                         const wxString& filename,
+                         const wxString& encoding)
+        : m_loader(loader),
+          m_stream(stream),
+          m_filename(filename),
+          m_encoding(encoding)
+    {
+        m_state = State_Queued;
+        m_doc = NULL;
+        m_binary = NULL;
+    }
+
+    // Cancels the job if it's still running.
+    ~wxXmlResourceLoadJob();
+
+    // Parse the file: called by the worker thread or, if the file is needed
+    // before any worker got to it, by the main one.
+    void Parse()
+    {
+        m_doc = ParseResourceFile(*m_stream, m_filename, m_encoding, &m_binary);
+        m_stream.reset();
+    }
+
+    // Wait until the file is parsed and return the results, transferring
+    // their ownership to the caller. The returned document is NULL if parsing
+    // it failed.
+    wxXmlDocument *Finish(wxXmlBinaryDocument **binary);
+
+private:
+    wxXmlResourceLoader& m_loader;
+
+    wxScopedPtr<wxInputStream> m_stream;
+    const wxString m_filename;
+    const wxString m_encoding;
+
+    // All the fields below are protected by wxXmlResourceLoader mutex.
+    enum State
+    {
+        State_Queued,   // Waiting for a worker thread.
+        State_Running,  // Being parsed.
+        State_Done      // Parsed, successfully or not.
+    } m_state;
+
+    wxXmlDocument *m_doc;
+    wxXmlBinaryDocument *m_binary;
+
+    friend class wxXmlResourceLoader;
+
+    wxDECLARE_NO_COPY_CLASS(wxXmlResourceLoadJob);
+};
+
+// Manages the threads parsing the files loaded asynchronously: there is at
+// most one thread per CPU and the threads exit when there are no more files
+// to parse.
+class wxXmlResourceLoader
+{
+public:
+    wxXmlResourceLoader() : m_condition(m_mutex)
+    {
+    }
+
+    // Wait for all the worker threads to terminate, all the jobs must have
+    // been already cancelled.
+    ~wxXmlResourceLoader();
+
+    // Queue the job for parsing it in a worker thread.
+    void Add(wxXmlResourceLoadJob *job);
+
+    // Wait until the job is done, parsing it in this thread if no worker
+    // thread started doing it yet and parse is true, or just cancelling it
+    // if it's false.
+    void Wait(wxXmlResourceLoadJob *job, bool parse);
+
+    // Parse all the queued files, called from the worker threads.
+    void ProcessQueue();
+
+private:
+    // Wait for the threads which have exited ProcessQueue() to terminate and
+    // delete them, must be called without locking the mutex.
+    void DeleteFinishedThreads();
+
+    wxMutex m_mutex;
+    wxCondition m_condition;    // Signalled whenever a job is done.
+    wxVector<wxXmlResourceLoadJob *> m_queue;
+    wxVector<wxThread *> m_threads;  // Threads running ProcessQueue().
+    wxVector<wxThread *> m_finished; // Threads which exited it.
+
+    wxDECLARE_NO_COPY_CLASS(wxXmlResourceLoader);
+};
+
+class wxXmlResourceLoaderThread : public wxThread
+{
+public:
+    explicit wxXmlResourceLoaderThread(wxXmlResourceLoader& loader)
+        : wxThread(wxTHREAD_JOINABLE),
+          m_loader(loader)
+    {
+    }
+
+protected:
+    virtual ExitCode Entry() wxOVERRIDE
+    {
+        m_loader.ProcessQueue();
+        return NULL;
+    }
+
+private:
+    wxXmlResourceLoader& m_loader;
+
+    wxDECLARE_NO_COPY_CLASS(wxXmlResourceLoaderThread);
+};
+
+wxXmlResourceLoadJob::~wxXmlResourceLoadJob()
+{
+    m_loader.Wait(this, false);
+
+    delete m_doc;
+    delete m_binary;
+}
+
+wxXmlDocument *wxXmlResourceLoadJob::Finish(wxXmlBinaryDocument **binary)
+{
+    m_loader.Wait(this, true);
+
+    wxXmlDocument * const doc = m_doc;
+    m_doc = NULL;
+    *binary = m_binary;
+    m_binary = NULL;
+
+    return doc;
+}
+
+wxXmlResourceLoader::~wxXmlResourceLoader()
+{
+    wxASSERT_MSG( m_queue.empty(), wxS("all jobs should have been cancelled") );
+
+    // No new threads can be started any more, so the ones still in
+    // m_threads will be moved to m_finished soon.
+    for ( ;; )
+    {
+        {
+            wxMutexLocker lock(m_mutex);
+            if ( m_threads.empty() && m_finished.empty() )
+                break;
+
+            while ( !m_threads.empty() && m_finished.empty() )
+                m_condition.Wait();
+        }
+
+        DeleteFinishedThreads();
+    }
+}
+
+void wxXmlResourceLoader::DeleteFinishedThreads()
+{
+    wxVector<wxThread *> finished;
+    {
+        wxMutexLocker lock(m_mutex);
+        finished.swap(m_finished);
+    }
+
+    for ( size_t n = 0; n < finished.size(); n++ )
+    {
+        finished[n]->Wait();
+        delete finished[n];
+    }
+}
+
+void wxXmlResourceLoader::Add(wxXmlResourceLoadJob *job)
+{
+    // Don't keep the threads which are done with their work around.
+    DeleteFinishedThreads();
+
+    wxMutexLocker lock(m_mutex);
+
+    m_queue.push_back(job);
+
+    // Start another thread unless we already have enough of them: notice
+    // that if we can't do it, the job will be done by the main thread when
+    // the file is needed.
+    if ( static_cast<int>(m_threads.size()) < wxMax(wxThread::GetCPUCount(), 1) )
+    {
+        wxThread * const thread = new wxXmlResourceLoaderThread(*this);
+        if ( thread->Run() != wxTHREAD_NO_ERROR )
+        {
+            delete thread;
+            return;
+        }
+
+        m_threads.push_back(thread);
+    }
+}
+
+void wxXmlResourceLoader::Wait(wxXmlResourceLoadJob *job, bool parse)
+{
+    DeleteFinishedThreads();
+
+    wxMutexLocker lock(m_mutex);
+
+    if ( job->m_state == wxXmlResourceLoadJob::State_Queued )
+    {
+        // Don't wait until a worker thread gets to this file, which could
+        // take a while, just do it ourselves.
+        for ( size_t n = 0; n < m_queue.size(); n++ )
+        {
+            if ( m_queue[n] == job )
+            {
+                m_queue.erase(m_queue.begin() + n);
+                break;
+            }
+        }
+
+        job->m_state = wxXmlResourceLoadJob::State_Done;
+
+        if ( parse )
+        {
+            // There is no need to keep the mutex locked while doing it, the
+            // job is not accessible to the other threads any more.
+            m_mutex.Unlock();
+            job->Parse();
+            m_mutex.Lock();
+        }
+
+        return;
+    }
+
+    while ( job->m_state != wxXmlResourceLoadJob::State_Done )
+        m_condition.Wait();
+}
+
+void wxXmlResourceLoader::ProcessQueue()
+{
+    wxMutexLocker lock(m_mutex);
+
+    while ( !m_queue.empty() )
+    {
+        wxXmlResourceLoadJob * const job = m_queue.front();
+        m_queue.erase(m_queue.begin());
+        job->m_state = wxXmlResourceLoadJob::State_Running;
+
+        m_mutex.Unlock();
+        job->Parse();
+        m_mutex.Lock();
+
+        job->m_state = wxXmlResourceLoadJob::State_Done;
+        m_condition.Broadcast();
+    }
+
+    // Let the other threads know that this one can be deleted now.
+    wxThread * const self = wxThread::This();
+    for ( size_t n = 0; n < m_threads.size(); n++ )
+    {
+        if ( m_threads[n] == self )
+        {
+            m_threads.erase(m_threads.begin() + n);
+            m_finished.push_back(self);
+            m_condition.Broadcast();
+            break;
+        }
+    }
+}
+
+#endif // wxUSE_THREADS
+
 class wxXmlResourceDataRecord
 {
 public:
-    // Ctor takes ownership of the document pointer.
+    // Ctor takes ownership of the document and binary document pointers.
     wxXmlResourceDataRecord(const wxString& File_,
-                            wxXmlDocument *Doc_
+                            wxXmlDocument *Doc_,
+                            wxXmlBinaryDocument *Binary_ = NULL
                            )
-        : File(File_), Doc(Doc_)
+        : File(File_), Doc(Doc_), Binary(NULL)
     {
+#if wxUSE_THREADS
+        Job = NULL;
+#endif
+        SetBinary(Binary_);
 #if wxUSE_DATETIME
         Time = GetXRCFileModTime(File);
 #endif
     }
 
-    ~wxXmlResourceDataRecord() {delete Doc;}
+    ~wxXmlResourceDataRecord()
+    {
+#if wxUSE_THREADS
+        delete Job;
+#endif
+        delete Doc;
+        delete Binary;
+    }
+
+    // Set the compiled XRC file whose top-level resources haven't been added
+    // to Doc yet, takes ownership of the pointer which may be NULL.
+    void SetBinary(wxXmlBinaryDocument *Binary_)
+    {
+        delete Binary;
+        Binary = Binary_;
+        Loaded.assign(Binary ? Binary->GetCount() : 0, false);
+    }
 
     wxString File;
     wxXmlDocument *Doc;
+
+    // Only non-NULL for compiled XRC files which are loaded lazily: Loaded
+    // indicates which of their top-level resources were already added to Doc.
+    wxXmlBinaryDocument *Binary;
+    wxVector<bool> Loaded;
+#if wxUSE_THREADS
+    // Only non-NULL while the file is loaded in the background, in which case
+    // Doc is still NULL.
+    wxXmlResourceLoadJob *Job;
+#endif
 #if wxUSE_DATETIME
     wxDateTime Time;
 #endif
@@ -104,6 +426,25 @@ public:
 class wxXmlResourceDataRecords : public wxVector<wxXmlResourceDataRecord*>
 {
     // this is a class so that it can be forward-declared
+
+#if wxUSE_THREADS
+public:
+    wxXmlResourceDataRecords() : m_loader(NULL) { }
+    ~wxXmlResourceDataRecords() { delete m_loader; }
+
+    // Return the object used for loading files in the background, creating it
+    // if necessary.
+    wxXmlResourceLoader& GetLoader()
+    {
+        if ( !m_loader )
+            m_loader = new wxXmlResourceLoader;
+
+        return *m_loader;
+    }
+
+private:
+    wxXmlResourceLoader *m_loader;
+#endif // wxUSE_THREADS
 };
 
 WX_DECLARE_HASH_SET_PTR(int, wxIntegerHash, wxIntegerEqual, wxHashSetInt);
@@ -213,7 +554,7 @@ GetFileNameFromNode(const wxXmlNode *node, const wxXmlResourceDataRecords& files
     for ( wxXmlResourceDataRecords::const_iterator i = files.begin();
           i != files.end(); ++i )
     {
-        if ( (*i)->Doc->GetRoot() == node )
+        if ( (*i)->Doc && (*i)->Doc->GetRoot() == node )
         {
             return (*i)->File;
         }
@@ -372,12 +713,35 @@ bool wxXmlResource::Load(const wxString& filemask_)
         }
         else // a single resource URL
 #endif // wxUSE_FILESYSTEM
+#if wxUSE_THREADS
+        // Files inside archives can't be read from a different thread as
+        // they share the archive stream, so always load them synchronously.
+        if ( (m_flags & wxXRC_LOAD_ASYNC) && fnd.find('#') == wxString::npos )
         {
-            wxXmlDocument * const doc = DoLoadFile(fnd);
+            wxInputStream * const stream = OpenResourceFile(fnd);
+            if ( !stream )
+            {
+                allOK = false;
+            }
+            else
+            {
+                wxXmlResourceDataRecord * const
+                    rec = new wxXmlResourceDataRecord(fnd, NULL);
+                rec->Job = new wxXmlResourceLoadJob(Data().GetLoader(), stream,
+                                                    fnd, GetResourceEncoding(m_flags));
+                Data().push_back(rec);
+                Data().GetLoader().Add(rec->Job);
+            }
+        }
+        else
+#endif // wxUSE_THREADS
+        {
+            wxXmlBinaryDocument *binary = NULL;
+            wxXmlDocument * const doc = DoLoadFile(fnd, &binary);
             if ( !doc )
                 allOK = false;
             else
-                Data().push_back(new wxXmlResourceDataRecord(fnd, doc));
+                Data().push_back(new wxXmlResourceDataRecord(fnd, doc, binary));
         }
 
         fnd = wxXmlFindNext;
@@ -571,39 +935,38 @@ bool wxXmlResource::AttachUnknownControl(const wxString& name,
 }
 
 
-static void ProcessPlatformProperty(wxXmlNode *node)
+// returns true if the node doesn't have the "platform" attribute or if the
+// current platform is one of the platforms specified by it
+static bool IsForCurrentPlatform(const wxXmlNode *node)
 {
     wxString s;
-    bool isok;
+    if (!node->GetAttribute(wxT("platform"), &s))
+        return true;
 
-    wxXmlNode *c = node->GetChildren();
-    while (c)
-    {
-        isok = false;
-        if (!c->GetAttribute(wxT("platform"), &s))
-            isok = true;
-        else
-        {
-            wxStringTokenizer tkn(s, wxT(" |"));
+    wxStringTokenizer tkn(s, wxT(" |"));
 
-            while (tkn.HasMoreTokens())
-            {
-                s = tkn.GetNextToken();
+    while (tkn.HasMoreTokens())
+    {
+        s = tkn.GetNextToken();
 #ifdef __WINDOWS__
-                if (s == wxT("win")) isok = true;
+        if (s == wxT("win")) return true;
 #endif
 #if defined(__MAC__) || defined(__APPLE__)
-                if (s == wxT("mac")) isok = true;
+        if (s == wxT("mac")) return true;
 #elif defined(__UNIX__)
-                if (s == wxT("unix")) isok = true;
+        if (s == wxT("unix")) return true;
 #endif
+    }
 
-                if (isok)
-                    break;
-            }
-        }
+    return false;
+}
 
-        if (isok)
+static void ProcessPlatformProperty(wxXmlNode *node)
+{
+    wxXmlNode *c = node->GetChildren();
+    while (c)
+    {
+        if (IsForCurrentPlatform(c))
         {
             ProcessPlatformProperty(c);
             c = c->GetNext();
@@ -644,6 +1007,60 @@ static void PreprocessForIdRanges(wxXmlNode *rootnode)
     }
 }
 
+// adds the n-th top-level resource of the compiled XRC file to the record
+// document unless it had been already done
+static void LoadBinaryResource(wxXmlResourceDataRecord& rec, size_t n)
+{
+    if ( rec.Loaded[n] )
+        return;
+
+    rec.Loaded[n] = true;
+
+    wxXmlNode * const node = rec.Binary->CreateNode(n);
+    if ( !node )
+        return;
+
+    if ( !IsForCurrentPlatform(node) )
+    {
+        delete node;
+        return;
+    }
+
+    ProcessPlatformProperty(node);
+
+    // do the same thing as PreprocessForIdRanges() does for the whole file
+    const wxString name = node->GetAttribute(wxT("name"));
+    if (name.find('[') != wxString::npos)
+        wxIdRangeManager::Get()->NotifyRangeOfItem(rec.Doc->GetRoot(), name);
+    PreprocessForIdRanges(node);
+
+    rec.Doc->GetRoot()->AddChild(node);
+}
+
+// adds the top-level resources with the given name, or all of them if the name
+// is empty, from the compiled XRC file, if any, to the record document
+static void LoadBinaryResources(wxXmlResourceDataRecord& rec,
+                                const wxString& name)
+{
+    wxXmlBinaryDocument * const binary = rec.Binary;
+    if ( !binary )
+        return;
+
+    if ( name.empty() )
+    {
+        for ( size_t n = 0; n < binary->GetCount(); n++ )
+            LoadBinaryResource(rec, n);
+
+        // all resources are in the document now, we don't need this any more
+        rec.SetBinary(NULL);
+    }
+    else
+    {
+        for ( int n = binary->Find(name); n != wxNOT_FOUND; n = binary->FindNext(n) )
+            LoadBinaryResource(rec, n);
+    }
+}
+
 bool wxXmlResource::UpdateResources()
 {
     bool rt = true;
@@ -659,6 +1076,12 @@ bool wxXmlResource::UpdateResources()
         if ( m_flags & wxXRC_NO_RELOADING )
             continue;
 
+#if wxUSE_THREADS
+        // Nor while it's still being loaded in the background.
+        if ( rec->Job )
+            continue;
+#endif // wxUSE_THREADS
+
         // Otherwise check its modification time if we can.
 #if wxUSE_DATETIME
         const wxDateTime lastModTime = GetXRCFileModTime(rec->File);
@@ -677,7 +1100,8 @@ bool wxXmlResource::UpdateResources()
             continue;
         }
 
-        wxXmlDocument * const doc = DoLoadFile(rec->File);
+        wxXmlBinaryDocument *binary = NULL;
+        wxXmlDocument * const doc = DoLoadFile(rec->File, &binary);
         if ( !doc )
         {
             // Notice that we keep the old XML document: it seems better to
@@ -690,6 +1114,7 @@ bool wxXmlResource::UpdateResources()
         // Replace the old resource contents with the new one.
         delete rec->Doc;
         rec->Doc = doc;
+        rec->SetBinary(binary);
 
         // And, now that we loaded it successfully, update the last load time.
 #if wxUSE_DATETIME
@@ -701,23 +1126,23 @@ bool wxXmlResource::UpdateResources()
 }
 
 wxXmlDocument *wxXmlResource::DoLoadFile(const wxString& filename)
+{
+    return DoLoadFile(filename, NULL);
+}
+
+static wxInputStream *OpenResourceFile(const wxString& filename)
 {
     wxLogTrace(wxT("xrc"), wxT("opening file '%s'"), filename);
 
-    wxInputStream *stream = NULL;
+    wxScopedPtr<wxInputStream> stream;
 
 #if wxUSE_FILESYSTEM
     wxFileSystem fsys;
     wxScopedPtr<wxFSFile> file(fsys.OpenFile(filename));
     if (file)
-    {
-        // Notice that we don't have ownership of the stream in this case, it
-        // remains owned by wxFSFile.
-        stream = file->GetStream();
-    }
+        stream.reset(file->DetachStream());
 #else // !wxUSE_FILESYSTEM
-    wxFileInputStream fstream(filename);
-    stream = &fstream;
+    stream.reset(new wxFileInputStream(filename));
 #endif // wxUSE_FILESYSTEM/!wxUSE_FILESYSTEM
 
     if ( !stream || !stream->IsOk() )
@@ -726,25 +1151,119 @@ wxXmlDocument *wxXmlResource::DoLoadFile(const wxString& filename)
         return NULL;
     }
 
+    return stream.release();
+}
+
+static wxString GetResourceEncoding(int flags)
+{
     wxString encoding(wxT("UTF-8"));
 #if !wxUSE_UNICODE && wxUSE_INTL
-    if ( (GetFlags() & wxXRC_USE_LOCALE) == 0 )
+    if ( (flags & wxXRC_USE_LOCALE) == 0 )
     {
         // In case we are not using wxLocale to translate strings, convert the
         // strings GUI's charset. This must not be done when wxXRC_USE_LOCALE
         // is on, because it could break wxGetTranslation lookup.
         encoding = wxLocale::GetSystemEncodingName();
     }
+#else
+    wxUnusedVar(flags);
 #endif
 
+    return encoding;
+}
+
+static wxXmlDocument *ParseResourceFile(wxInputStream& stream,
+                                        const wxString& filename,
+                                        const wxString& encoding,
+                                        wxXmlBinaryDocument **binary)
+{
+    if ( binary )
+        *binary = NULL;
+
     wxScopedPtr<wxXmlDocument> doc(new wxXmlDocument);
-    if (!doc->Load(*stream, encoding))
+    wxScopedPtr<wxXmlBinaryDocument> bin;
+    if ( wxXmlBinaryDocument::CanRead(stream) )
+    {
+        // this is a compiled XRC file created by wxrc: load just its index
+        bin.reset(new wxXmlBinaryDocument);
+        wxXmlNode * const root = bin->Load(stream) ? bin->CreateRoot() : NULL;
+        if ( !root )
+        {
+            wxLogError(_("Cannot load resources from file '%s'."), filename);
+            return NULL;
+        }
+
+        doc->SetRoot(root);
+
+        // ID ranges must be known before loading any resources using them, so
+        // load everything immediately if the file defines any of them (or if
+        // lazy loading is not wanted at all)
+        bool lazy = binary != NULL;
+        for ( size_t n = 0; lazy && n < bin->GetCount(); n++ )
+        {
+            if ( bin->GetNodeName(n) == wxT("ids-range") )
+                lazy = false;
+        }
+
+        if ( !lazy )
+        {
+            wxXmlNode *last = NULL;
+            for ( size_t n = 0; n < bin->GetCount(); n++ )
+            {
+                wxXmlNode * const node = bin->CreateNode(n);
+                if ( !node )
+                {
+                    wxLogError(_("Cannot load resources from file '%s'."),
+                               filename);
+                    return NULL;
+                }
+
+                root->InsertChildAfter(node, last);
+                last = node;
+            }
+
+            bin.reset();
+        }
+    }
+    else if (!doc->Load(stream, encoding))
     {
         wxLogError(_("Cannot load resources from file '%s'."), filename);
         return NULL;
     }
 
-    wxXmlNode * const root = doc->GetRoot();
+    if ( binary )
+        *binary = bin.release();
+
+    return doc.release();
+}
+
+wxXmlDocument *wxXmlResource::DoLoadFile(const wxString& filename,
+                                         wxXmlBinaryDocument **binary)
+{
+    if ( binary )
+        *binary = NULL;
+
+    wxScopedPtr<wxInputStream> stream(OpenResourceFile(filename));
+    if ( !stream )
+        return NULL;
+
+    wxXmlBinaryDocument *bin = NULL;
+    wxScopedPtr<wxXmlDocument>
+        doc(ParseResourceFile(*stream, filename, GetResourceEncoding(m_flags),
+                              binary ? &bin : NULL));
+    wxScopedPtr<wxXmlBinaryDocument> binPtr(bin);
+    if ( !doc || !DoPreprocessDocument(*doc) )
+        return NULL;
+
+    if ( binary )
+        *binary = binPtr.release();
+
+    return doc.release();
+}
+
+bool wxXmlResource::DoPreprocessDocument(wxXmlDocument& doc)
+{
+    wxXmlNode * const root = doc.GetRoot();
     if (root->GetName() != wxT("resource"))
     {
         ReportError
@@ -752,7 +1271,7 @@ wxXmlDocument *wxXmlResource::DoLoadFile(const wxString& filename)
             root,
             "invalid XRC resource, doesn't have root node <resource>"
         );
-        return NULL;
+        return false;
     }
 
     long version;
@@ -773,7 +1292,31 @@ wxXmlDocument *wxXmlResource::DoLoadFile(const wxString& filename)
     PreprocessForIdRanges(root);
     wxIdRangeManager::Get()->FinaliseRanges(root);
 
-    return doc.release();
+    return true;
+}
+
+void wxXmlResource::DoFinishLoadFile(wxXmlResourceDataRecord& rec)
+{
+#if wxUSE_THREADS
+    if ( !rec.Job )
+        return;
+
+    wxXmlBinaryDocument *bin = NULL;
+    wxScopedPtr<wxXmlDocument> doc(rec.Job->Finish(&bin));
+    wxScopedPtr<wxXmlBinaryDocument> binPtr(bin);
+
+    wxDELETE(rec.Job);
+
+    // Notice that in case of error, the record remains without any document
+    // and will be loaded again by UpdateResources() if the file is modified.
+    if ( doc && DoPreprocessDocument(*doc) )
+    {
+        rec.Doc = doc.release();
+        rec.SetBinary(binPtr.release());
+    }
+#else // !wxUSE_THREADS
+    wxUnusedVar(rec);
+#endif // wxUSE_THREADS/!wxUSE_THREADS
 }
 
 wxXmlNode *wxXmlResource::DoFindResource(wxXmlNode *parent,
@@ -876,10 +1419,20 @@ wxXmlResource::GetResourceNodeAndLocation(const wxString& name,
           f != Data().end(); ++f )
     {
         wxXmlResourceDataRecord *const rec = *f;
+
+        // if this file is being loaded in the background, we need to wait
+        // until it's done before looking in it
+        const_cast<wxXmlResource *>(this)->DoFinishLoadFile(*rec);
+
         wxXmlDocument * const doc = rec->Doc;
         if ( !doc || !doc->GetRoot() )
             continue;
 
+        // add the resources we may need from the compiled XRC file, if any:
+        // only the ones with the given name, unless we need to look for it
+        // in all of them
+        LoadBinaryResources(*rec, recursive ? wxString() : name);
+
         wxXmlNode * const
             found = DoFindResource(doc->GetRoot(), name, classname, recursive);
         if ( found )
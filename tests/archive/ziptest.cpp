@@ -20,6 +20,10 @@
 
 #include "archivetest.h"
 #include "wx/zipstrm.h"
+#include "wx/mstream.h"
+#include "wx/wfstream.h"
+#include "wx/scopedptr.h"
+#include "wx/thread.h"
 
 using std::string;
 
@@ -252,4 +256,244 @@ CppUnit::Test *ziptest::makeTest(
 CPPUNIT_TEST_SUITE_REGISTRATION(ziptest);
 CPPUNIT_TEST_SUITE_NAMED_REGISTRATION(ziptest, "archive/zip");
 
+TEST_CASE("wxZipOutputStream::ParallelDeflate", "[archive][zip]")
+{
+    // Use an entry bigger than the block size used for parallel compression
+    // and another, small, one.
+    wxString big;
+    for ( int n = 0; n < 50000; n++ )
+        big << "Line " << n << "\n";
+
+    const wxString small("Small entry");
+
+    wxMemoryOutputStream mo;
+    {
+        wxZipOutputStream zip(mo);
+        zip.EnableParallelDeflate();
+        CHECK( zip.IsParallelDeflateEnabled() );
+
+        REQUIRE( zip.PutNextEntry("big.txt") );
+        zip.Write(big.utf8_str(), big.length());
+
+        REQUIRE( zip.PutNextEntry("small.txt") );
+        zip.Write(small.utf8_str(), small.length());
+
+        REQUIRE( zip.Close() );
+    }
+
+    wxMemoryInputStream mi(mo);
+    wxZipInputStream zip(mi);
+
+    const wxString* const expected[] = { &big, &small };
+    for ( size_t n = 0; n < WXSIZEOF(expected); n++ )
+    {
+        wxScopedPtr<wxZipEntry> entry(zip.GetNextEntry());
+        REQUIRE( entry );
+
+        // Tiny entries are stored if compressing them doesn't help.
+        if ( expected[n] == &big )
+            CHECK( entry->GetMethod() == wxZIP_METHOD_DEFLATE );
+
+        wxMemoryOutputStream out;
+        out.Write(zip);
+        CHECK( zip.Eof() );
+
+        const size_t len = out.GetLength();
+        wxCharBuffer buf(len);
+        out.CopyTo(buf.data(), len);
+
+        CHECK( wxString::FromUTF8(buf.data(), len) == *expected[n] );
+    }
+
+    CHECK( !zip.GetNextEntry() );
+}
+
+namespace
+{
+
+// Extra field, with an unknown header ID, used for all entries of the archive
+// created below: it is preserved when reading them.
+const char indexTestExtra[] = { '\xfe', '\xca', 4, 0, 'w', 'x', 'z', 'i' };
+
+// Create a zip archive with the given number of entries called "dir/N.txt",
+// each containing its name repeated N times and having the extra field above,
+// and return its contents.
+wxMemoryBuffer CreateIndexTestZip(int count)
+{
+    wxMemoryOutputStream mo;
+    {
+        wxZipOutputStream zip(mo);
+        zip.SetComment("Index test");
+        for ( int n = 0; n < count; n++ )
+        {
+            const wxString name = wxString::Format("dir/%d.txt", n);
+            wxZipEntry* const entry = new wxZipEntry(name);
+            entry->SetExtra(indexTestExtra, sizeof(indexTestExtra));
+            entry->SetLocalExtra(indexTestExtra, sizeof(indexTestExtra));
+            zip.PutNextEntry(entry);
+            for ( int i = 0; i < n; i++ )
+                zip.Write(name.utf8_str(), name.length());
+        }
+    }
+
+    wxMemoryBuffer buf;
+    const size_t len = mo.GetLength();
+    mo.CopyTo(buf.GetWriteBuf(len), len);
+    buf.UngetWriteBuf(len);
+    return buf;
+}
+
+// Check that the given entry of the archive above can be read.
+bool CheckIndexTestEntry(const wxZipIndex& index, int n)
+{
+    const wxString name = wxString::Format("dir/%d.txt", n);
+    wxScopedPtr<wxZipInputStream> zip(index.OpenEntry(name, wxPATH_UNIX));
+    if ( !zip )
+        return false;
+
+    const wxZipEntry& entry = index.GetEntry(n);
+    if ( entry.GetExtraLen() != sizeof(indexTestExtra) ||
+            memcmp(entry.GetExtra(), indexTestExtra, sizeof(indexTestExtra)) )
+        return false;
+
+    wxMemoryOutputStream out;
+    out.Write(*zip);
+    if ( !zip->Eof() ||
+            out.GetLength() != static_cast<wxFileOffset>(n*name.length()) )
+        return false;
+
+    wxCharBuffer buf(n*name.length());
+    out.CopyTo(buf.data(), buf.length());
+    for ( int i = 0; i < n; i++ )
+    {
+        if ( memcmp(buf.data() + i*name.length(), name.utf8_str(), name.length()) )
+            return false;
+    }
+
+    return true;
+}
+
+#if wxUSE_THREADS
+
+class ZipIndexReaderThread : public wxThread
+{
+public:
+    ZipIndexReaderThread(const wxZipIndex& index, int start, int count)
+        : wxThread(wxTHREAD_JOINABLE),
+          m_index(index),
+          m_start(start),
+          m_count(count)
+    {
+        m_ok = false;
+    }
+
+    virtual ExitCode Entry() wxOVERRIDE
+    {
+        m_ok = true;
+        for ( int n = 0; n < m_count; n++ )
+        {
+            // read the entries in different order in each thread
+            if ( !CheckIndexTestEntry(m_index, (m_start + n) % m_count) )
+                m_ok = false;
+        }
+
+        return NULL;
+    }
+
+    bool IsOk() const { return m_ok; }
+
+private:
+    const wxZipIndex& m_index;
+    const int m_start;
+    const int m_count;
+    bool m_ok;
+};
+
+#endif // wxUSE_THREADS
+
+} // anonymous namespace
+
+TEST_CASE("wxZipIndex", "[archive][zip]")
+{
+    const int count = 100;
+    const wxMemoryBuffer buf = CreateIndexTestZip(count);
+
+    wxZipIndex index(buf.GetData(), buf.GetDataLen());
+    REQUIRE( index.IsOk() );
+    CHECK( index.GetCount() == count );
+    CHECK( index.GetComment() == "Index test" );
+
+    SECTION("Find")
+    {
+        CHECK( index.Find("dir/17.txt", wxPATH_UNIX) == 17 );
+        CHECK( index.GetEntry(17).GetInternalName() == "dir/17.txt" );
+        CHECK( index.Find("dir\\42.txt", wxPATH_DOS) == 42 );
+        CHECK( index.Find("./dir/99.txt", wxPATH_UNIX) == 99 );
+        CHECK( index.Find("dir/100.txt", wxPATH_UNIX) == wxNOT_FOUND );
+        CHECK( !index.OpenEntry("nonexistent", wxPATH_UNIX) );
+    }
+
+    SECTION("Read")
+    {
+        CHECK( CheckIndexTestEntry(index, 0) );
+        CHECK( CheckIndexTestEntry(index, 57) );
+        CHECK( CheckIndexTestEntry(index, 3) );
+
+        // The stream can only be used for reading a single entry.
+        wxScopedPtr<wxZipInputStream> zip(index.OpenEntry(5));
+        REQUIRE( zip );
+        CHECK( !zip->GetNextEntry() );
+        CHECK( zip->GetLastError() == wxSTREAM_EOF );
+    }
+
+    SECTION("File")
+    {
+        const wxString filename("zipindex.test");
+        {
+            wxFileOutputStream out(filename);
+            out.Write(buf.GetData(), buf.GetDataLen());
+        }
+
+        {
+            wxZipIndex fileIndex(filename);
+            REQUIRE( fileIndex.IsOk() );
+            CHECK( fileIndex.GetCount() == count );
+            CHECK( CheckIndexTestEntry(fileIndex, 99) );
+        }
+
+        wxRemoveFile(filename);
+    }
+
+    SECTION("Invalid")
+    {
+        wxLogNull noLog;
+
+        static const char data[] = "This is not a zip file";
+        wxZipIndex invalid(data, sizeof(data));
+        CHECK( !invalid.IsOk() );
+
+        wxZipIndex nonexistent("no-such-file.zip");
+        CHECK( !nonexistent.IsOk() );
+    }
+
+#if wxUSE_THREADS
+    SECTION("Threads")
+    {
+        wxVector<ZipIndexReaderThread*> threads;
+        for ( int n = 0; n < 4; n++ )
+        {
+            threads.push_back(new ZipIndexReaderThread(index, n*25, count));
+            REQUIRE( threads.back()->Run() == wxTHREAD_NO_ERROR );
+        }
+
+        for ( size_t n = 0; n < threads.size(); n++ )
+        {
+            threads[n]->Wait();
+            CHECK( threads[n]->IsOk() );
+            delete threads[n];
+        }
+    }
+#endif // wxUSE_THREADS
+}
+
 #endif // wxUSE_STREAMS && wxUSE_ZIPSTREAM
@@ -8,6 +8,7 @@
 /////////////////////////////////////////////////////////////////////////////
 
 #include "wx/image.h"
+#include "wx/quantize.h"
 
 #include "bench.h"
 
@@ -90,3 +91,58 @@ BENCHMARK_FUNC(ShrinkHighQuality)
 {
     return GetTestImage().Scale(50, 50, wxIMAGE_QUALITY_HIGH).IsOk();
 }
+
+BENCHMARK_FUNC(ConvertToGreyscale)
+{
+    return GetTestImage().ConvertToGreyscale().IsOk();
+}
+
+BENCHMARK_FUNC(ConvertToDisabled)
+{
+    return GetTestImage().ConvertToDisabled().IsOk();
+}
+
+// ----------------------------------------------------------------------------
+// Colour quantization benchmarks
+// ----------------------------------------------------------------------------
+
+static const wxImage& GetBigTestImage()
+{
+    // Use a big enough image for the parallel code paths to be used.
+    static wxImage s_image;
+    if ( !s_image.IsOk() && GetTestImage().IsOk() )
+        s_image = GetTestImage().Scale(1600, 1600, wxIMAGE_QUALITY_BILINEAR);
+
+    return s_image;
+}
+
+static bool DoQuantize(int flags)
+{
+    const wxImage& src = GetBigTestImage();
+    if ( !src.IsOk() )
+        return false;
+
+    wxImage dst;
+    return wxQuantize::Quantize(src, dst, NULL, 236, NULL,
+                                flags | wxQUANTIZE_FILL_DESTINATION_IMAGE);
+}
+
+BENCHMARK_FUNC(QuantizeMedianCut)
+{
+    return DoQuantize(0);
+}
+
+BENCHMARK_FUNC(QuantizeMedianCutNoDithering)
+{
+    return DoQuantize(wxQUANTIZE_NO_DITHERING);
+}
+
+BENCHMARK_FUNC(QuantizeOctree)
+{
+    return DoQuantize(wxQUANTIZE_OCTREE);
+}
+
+BENCHMARK_FUNC(QuantizeOctreeNoDithering)
+{
+    return DoQuantize(wxQUANTIZE_OCTREE | wxQUANTIZE_NO_DITHERING);
+}
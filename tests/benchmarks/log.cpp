@@ -106,3 +106,160 @@ BENCHMARK_FUNC(LogTraceInactive)
 
     return true;
 }
+
+// ----------------------------------------------------------------------------
+// Log targets writing to a file
+// ----------------------------------------------------------------------------
+
+#if wxUSE_THREADS
+
+#include "wx/thread.h"
+#include "wx/vector.h"
+
+namespace
+{
+
+FILE* gs_logFile = NULL;
+wxLog* gs_logOld = NULL;
+
+bool InitLogTarget(wxLog* log)
+{
+    gs_logOld = wxLog::SetActiveTarget(log);
+
+    return true;
+}
+
+bool InitLogStderr()
+{
+    gs_logFile = tmpfile();
+    if ( !gs_logFile )
+        return false;
+
+    return InitLogTarget(new wxLogStderr(gs_logFile));
+}
+
+bool InitLogAsync()
+{
+    gs_logFile = tmpfile();
+    if ( !gs_logFile )
+        return false;
+
+    return InitLogTarget(new wxLogAsync(gs_logFile));
+}
+
+void DoneLogTarget()
+{
+    delete wxLog::SetActiveTarget(gs_logOld);
+    gs_logOld = NULL;
+
+    if ( gs_logFile )
+    {
+        fclose(gs_logFile);
+        gs_logFile = NULL;
+    }
+}
+
+// Return the number of messages to log, given by the numeric parameter or 100
+// by default.
+long GetMessagesCount()
+{
+    const long count = Bench::GetNumericParameter();
+
+    return count > 0 ? count : 100;
+}
+
+void LogMessages(long count)
+{
+    for ( long n = 0; n < count; n++ )
+        wxLogMessage("Message %ld logged by the benchmark", n);
+}
+
+class LogBenchThread : public wxThread
+{
+public:
+    explicit LogBenchThread(long count)
+        : wxThread(wxTHREAD_JOINABLE),
+          m_count(count)
+    {
+    }
+
+protected:
+    virtual ExitCode Entry() wxOVERRIDE
+    {
+        LogMessages(m_count);
+
+        return NULL;
+    }
+
+private:
+    const long m_count;
+};
+
+// Log the messages from several threads and flush them from the main one.
+bool LogMessagesFromThreads()
+{
+    static const int NUM_THREADS = 4;
+
+    wxVector<wxThread*> threads;
+    for ( int n = 0; n < NUM_THREADS; n++ )
+    {
+        wxThread* const thread = new LogBenchThread(GetMessagesCount());
+        if ( thread->Run() != wxTHREAD_NO_ERROR )
+        {
+            delete thread;
+            break;
+        }
+
+        threads.push_back(thread);
+    }
+
+    for ( size_t n = 0; n < threads.size(); n++ )
+    {
+        threads[n]->Wait();
+        delete threads[n];
+    }
+
+    wxLog::FlushActive();
+
+    return threads.size() == NUM_THREADS;
+}
+
+} // anonymous namespace
+
+// Writing the messages to the file from the main thread directly.
+BENCHMARK_FUNC_WITH_INIT(LogStderr, InitLogStderr, DoneLogTarget)
+{
+    LogMessages(GetMessagesCount());
+
+    return true;
+}
+
+// Only queuing the messages to be written by the background thread.
+BENCHMARK_FUNC_WITH_INIT(LogAsync, InitLogAsync, DoneLogTarget)
+{
+    LogMessages(GetMessagesCount());
+
+    return true;
+}
+
+// Queuing the messages and writing them immediately.
+BENCHMARK_FUNC_WITH_INIT(LogAsyncFlush, InitLogAsync, DoneLogTarget)
+{
+    LogMessages(GetMessagesCount());
+
+    wxLog::FlushActive();
+
+    return true;
+}
+
+BENCHMARK_FUNC_WITH_INIT(LogStderrThreads, InitLogStderr, DoneLogTarget)
+{
+    return LogMessagesFromThreads();
+}
+
+BENCHMARK_FUNC_WITH_INIT(LogAsyncThreads, InitLogAsync, DoneLogTarget)
+{
+    return LogMessagesFromThreads();
+}
+
+#endif // wxUSE_THREADS
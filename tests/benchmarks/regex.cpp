@@ -0,0 +1,127 @@
+/////////////////////////////////////////////////////////////////////////////
+// Name:        tests/benchmarks/regex.cpp
+// Purpose:     wxRegEx benchmarks
+// Author:      wxWidgets development team
+// Created:     2026-10-19
+// Copyright:   (c) 2026 wxWidgets development team
+// Licence:     wxWindows licence
+/////////////////////////////////////////////////////////////////////////////
+
+#include "wx/defs.h"
+
+#if wxUSE_REGEX
+
+#include "wx/arrstr.h"
+#include "wx/regex.h"
+
+#include "bench.h"
+
+namespace
+{
+
+// lines of a fake log file matched by the benchmarks below
+wxArrayString gs_lines;
+
+// Create the lines to match, their number is given by the numeric parameter
+// or is 10000 by default.
+bool CreateLines()
+{
+    long count = Bench::GetNumericParameter();
+    if ( count <= 1 )
+        count = 10000;
+
+    static const char* const levels[] = { "info", "debug", "warning", "error" };
+
+    for ( long n = 0; n < count; n++ )
+    {
+        gs_lines.push_back(wxString::Format
+                           (
+                                "12:%02ld:%02ld.%03ld [%s] worker %ld: "
+                                "request %ld processed in %ldms",
+                                (n / 3600) % 60, (n / 60) % 60, n % 1000,
+                                levels[n % WXSIZEOF(levels)],
+                                n % 16, n, n % 500
+                           ));
+    }
+
+    return true;
+}
+
+void DeleteLines()
+{
+    gs_lines.clear();
+}
+
+// Return the flags to use for compiling the expressions: the string parameter
+// may be "advanced" or "pcre" to use the corresponding syntax.
+int GetCompileFlags()
+{
+    const wxString& syntax = Bench::GetStringParameter();
+#ifdef wxHAS_REGEX_ADVANCED
+    if ( syntax == "advanced" )
+        return wxRE_ADVANCED | wxRE_NOSUB;
+#endif
+    if ( syntax == "pcre" )
+        return wxRE_PCRE | wxRE_NOSUB;
+
+    return wxRE_EXTENDED | wxRE_NOSUB;
+}
+
+// Count the lines matching the given expression.
+size_t CountMatches(const wxRegEx& re)
+{
+    size_t count = 0;
+    for ( size_t n = 0; n < gs_lines.size(); n++ )
+    {
+        if ( re.Matches(gs_lines[n]) )
+            count++;
+    }
+
+    return count;
+}
+
+} // anonymous namespace
+
+// The expression containing a required literal: most lines are rejected
+// without running the regex engine.
+BENCHMARK_FUNC_WITH_INIT(RegExFilterLiteral, CreateLines, DeleteLines)
+{
+    static wxRegEx re;
+    if ( !re.IsValid() && !re.Compile("\\[error\\] worker 1[0-5]", GetCompileFlags()) )
+        return false;
+
+    return CountMatches(re) > 0;
+}
+
+// The expression without any literals which requires running the engine for
+// all lines.
+BENCHMARK_FUNC_WITH_INIT(RegExFilterPattern, CreateLines, DeleteLines)
+{
+    static wxRegEx re;
+    if ( !re.IsValid() && !re.Compile("[0-9]+[0-9]{2}ms$", GetCompileFlags()) )
+        return false;
+
+    return CountMatches(re) > 0;
+}
+
+// Matching all lines at once using a single thread.
+BENCHMARK_FUNC_WITH_INIT(RegExMatchLines, CreateLines, DeleteLines)
+{
+    static wxRegEx re;
+    if ( !re.IsValid() && !re.Compile("[0-9]+[0-9]{2}ms$", GetCompileFlags()) )
+        return false;
+
+    return re.MatchLines(gs_lines, NULL) > 0;
+}
+
+// Matching all lines at once using as many threads as there are CPUs.
+BENCHMARK_FUNC_WITH_INIT(RegExMatchLinesThreads, CreateLines, DeleteLines)
+{
+    static wxRegEx re;
+    if ( !re.IsValid() && !re.Compile("[0-9]+[0-9]{2}ms$", GetCompileFlags()) )
+        return false;
+
+    return re.MatchLines(gs_lines, NULL, 0, 0) > 0;
+}
+
+#endif // wxUSE_REGEX
@@ -0,0 +1,437 @@
+/////////////////////////////////////////////////////////////////////////////
+// Name:        tests/benchmarks/streams.cpp
+// Purpose:     Streams-related benchmarks
+// Author:      wxWidgets development team
+// Created:     2026-10-19
+// Copyright:   (c) 2026 wxWidgets development team
+// Licence:     wxWindows licence
+/////////////////////////////////////////////////////////////////////////////
+
+#include "wx/wfstream.h"
+#include "wx/txtstrm.h"
+#include "wx/datstrm.h"
+#include "wx/mstream.h"
+#include "wx/vector.h"
+#include "wx/zstream.h"
+#include "wx/lzmastream.h"
+#include "wx/zstdstream.h"
+#include "wx/scopedptr.h"
+#include "wx/buffer.h"
+#include "wx/filename.h"
+
+#include "bench.h"
+
+namespace
+{
+
+wxString gs_fileName;
+
+// Create a file of the size given by the numeric parameter, in MiB, or 16MiB
+// by default, for the benchmarks below to read.
+bool CreateDataFile()
+{
+    gs_fileName = wxFileName::CreateTempFileName("wxbench");
+    if ( gs_fileName.empty() )
+        return false;
+
+    wxFileOutputStream out(gs_fileName);
+
+    char buf[1024];
+    for ( size_t n = 0; n < WXSIZEOF(buf); n++ )
+        buf[n] = static_cast<char>(n * 7);
+
+    long size = Bench::GetNumericParameter();
+    if ( !size )
+        size = 16;
+
+    size *= 1024;
+    for ( long n = 0; n < size; n++ )
+        out.Write(buf, sizeof(buf));
+
+    return out.Close();
+}
+
+void RemoveDataFile()
+{
+    wxRemoveFile(gs_fileName);
+}
+
+// Read the entire stream in small chunks, as most parsers do, and return a
+// checksum of its contents to prevent the loop from being optimized away.
+unsigned ReadInChunks(wxInputStream& in)
+{
+    char buf[4096];
+    unsigned sum = 0;
+    while ( in.Read(buf, sizeof(buf)).LastRead() )
+    {
+        for ( size_t n = 0; n < in.LastRead(); n += 64 )
+            sum += static_cast<unsigned char>(buf[n]);
+    }
+
+    return sum;
+}
+
+// Create a UTF-8 text file of the size given by the numeric parameter, in
+// MiB, or 4MiB by default, consisting of lines of varying length.
+bool CreateTextFile()
+{
+    gs_fileName = wxFileName::CreateTempFileName("wxbench");
+    if ( gs_fileName.empty() )
+        return false;
+
+    wxFileOutputStream out(gs_fileName);
+
+    long size = Bench::GetNumericParameter();
+    if ( !size )
+        size = 4;
+
+    size *= 1024*1024;
+
+    // The lines contain a couple of non-ASCII characters, take care to never
+    // split their UTF-8 representation.
+    static const char text[] = "Lorem ipsum dolor sit amet, "
+                               "\xc3\xa9t\xc3\xa9 consectetur adipiscing elit";
+    for ( long n = 0; n < size; )
+    {
+        size_t len = 10 + n % (sizeof(text) - 11);
+        if ( len == 29 || len == 32 )
+            len--;
+        out.Write(text, len);
+        out.PutC('\n');
+
+        n += len + 1;
+    }
+
+    return out.Close();
+}
+
+// Read all lines from the given stream and return their total length.
+size_t ReadAllLines(wxInputStream& in)
+{
+    wxTextInputStream text(in, wxS(" \t"), wxConvUTF8);
+
+    size_t len = 0;
+    while ( in.IsOk() )
+        len += text.ReadLine().length();
+
+    return len;
+}
+
+// Data used by the wxDataStream benchmarks: the number of values is given by
+// the numeric parameter, in millions, or 1 million by default.
+wxVector<double> gs_doubles;
+wxMemoryBuffer gs_dataStreamBuffer;
+
+bool InitDataStreamValues()
+{
+    long count = Bench::GetNumericParameter();
+    if ( !count )
+        count = 1;
+
+    count *= 1000*1000;
+
+    gs_doubles.resize(count);
+    for ( long n = 0; n < count; n++ )
+        gs_doubles[n] = n * 0.75;
+
+    // Store the data in big endian order to exercise byte swapping on the
+    // usual little endian platforms.
+    wxMemoryOutputStream mo;
+    wxDataOutputStream dos(mo);
+    dos.BigEndianOrdered(true);
+    dos.UseBasicPrecisions();
+    dos.WriteDouble(&gs_doubles[0], gs_doubles.size());
+
+    const size_t len = mo.GetLength();
+    mo.CopyTo(gs_dataStreamBuffer.GetWriteBuf(len), len);
+    gs_dataStreamBuffer.UngetWriteBuf(len);
+
+    return true;
+}
+
+void FreeDataStreamValues()
+{
+    gs_doubles.clear();
+    gs_dataStreamBuffer.Clear();
+}
+
+// Data used by the compression benchmarks: the size is given by the numeric
+// parameter, in MiB, or 8MiB by default.
+wxMemoryBuffer gs_compressBuffer;
+
+bool InitCompressData()
+{
+    long size = Bench::GetNumericParameter();
+    if ( !size )
+        size = 8;
+
+    wxMemoryOutputStream mo;
+    wxTextOutputStream text(mo);
+    const wxFileOffset total = size*1024*1024;
+    for ( int n = 0; mo.GetLength() < total; n++ )
+        text << "Line " << n << ": value=" << n * 37 % 1000 << "\n";
+
+    const size_t len = mo.GetLength();
+    mo.CopyTo(gs_compressBuffer.GetWriteBuf(len), len);
+    gs_compressBuffer.UngetWriteBuf(len);
+
+    return true;
+}
+
+void FreeCompressData()
+{
+    gs_compressBuffer.Clear();
+}
+
+bool DoCompress(int flags)
+{
+    wxMemoryOutputStream mo;
+    wxZlibOutputStream zout(mo, wxZ_DEFAULT_COMPRESSION, flags);
+    zout.Write(gs_compressBuffer.GetData(), gs_compressBuffer.GetDataLen());
+
+    return zout.Close() && mo.GetLength() != 0;
+}
+
+// Compress the data using the filter created by the given factory.
+bool DoFilterCompress(const wxFilterClassFactory& factory)
+{
+    wxMemoryOutputStream mo;
+    wxScopedPtr<wxFilterOutputStream> out(factory.NewStream(mo));
+    out->Write(gs_compressBuffer.GetData(), gs_compressBuffer.GetDataLen());
+
+    return out->Close() && mo.GetLength() != 0;
+}
+
+// Compressed data used by the decompression benchmarks.
+wxMemoryBuffer gs_compressedBuffer;
+
+bool InitDecompressData(const wxFilterClassFactory& factory)
+{
+    if ( !InitCompressData() )
+        return false;
+
+    wxMemoryOutputStream mo;
+    {
+        wxScopedPtr<wxFilterOutputStream> out(factory.NewStream(mo));
+        out->Write(gs_compressBuffer.GetData(), gs_compressBuffer.GetDataLen());
+        if ( !out->Close() )
+            return false;
+    }
+
+    const size_t len = mo.GetLength();
+    mo.CopyTo(gs_compressedBuffer.GetWriteBuf(len), len);
+    gs_compressedBuffer.UngetWriteBuf(len);
+
+    return true;
+}
+
+void FreeDecompressData()
+{
+    FreeCompressData();
+    gs_compressedBuffer.Clear();
+}
+
+bool DoFilterDecompress(const wxFilterClassFactory& factory)
+{
+    wxMemoryInputStream mi(gs_compressedBuffer.GetData(),
+                           gs_compressedBuffer.GetDataLen());
+    wxScopedPtr<wxFilterInputStream> in(factory.NewStream(mi));
+    ReadInChunks(*in);
+
+    return in->GetLastError() == wxSTREAM_EOF &&
+            in->TellI() == wxFileOffset(gs_compressBuffer.GetDataLen());
+}
+
+// Create a gzip-compressed text file, with the uncompressed size given by the
+// numeric parameter as for InitCompressData(), for the pipeline benchmarks.
+bool CreateGzipFile()
+{
+    gs_fileName = wxFileName::CreateTempFileName("wxbench");
+    if ( gs_fileName.empty() || !InitCompressData() )
+        return false;
+
+    wxFileOutputStream file(gs_fileName);
+    wxZlibOutputStream zout(file, wxZ_DEFAULT_COMPRESSION, wxZLIB_GZIP);
+    zout.Write(gs_compressBuffer.GetData(), gs_compressBuffer.GetDataLen());
+
+    FreeCompressData();
+
+    return zout.Close() && file.Close();
+}
+
+// Decompress the file created by the function above and parse its lines,
+// optionally reading both the compressed and decompressed data ahead.
+size_t ReadGzipLines(bool readAhead)
+{
+    wxFileInputStream file(gs_fileName);
+    wxBufferedInputStream bufferedFile(file, 65536);
+    wxZlibInputStream zin(bufferedFile);
+    wxBufferedInputStream bufferedData(zin, 65536);
+
+    if ( readAhead )
+    {
+        if ( !bufferedFile.EnableReadAhead() ||
+                !bufferedData.EnableReadAhead() )
+            return 0;
+    }
+
+    return ReadAllLines(bufferedData);
+}
+
+bool InitDecompressZlib() { return InitDecompressData(wxGzipClassFactory()); }
+
+#if wxUSE_LIBLZMA
+bool InitDecompressLZMA() { return InitDecompressData(wxLZMAClassFactory()); }
+#endif // wxUSE_LIBLZMA
+
+#if wxUSE_LIBZSTD
+bool InitDecompressZstd() { return InitDecompressData(wxZstdClassFactory()); }
+#endif // wxUSE_LIBZSTD
+
+} // anonymous namespace
+
+BENCHMARK_FUNC_WITH_INIT(ReadFileStream, CreateDataFile, RemoveDataFile)
+{
+    wxFileInputStream in(gs_fileName);
+    return ReadInChunks(in) != 0;
+}
+
+BENCHMARK_FUNC_WITH_INIT(ReadBufferedFileStream, CreateDataFile, RemoveDataFile)
+{
+    wxFileInputStream in(gs_fileName);
+    wxBufferedInputStream buffered(in);
+    return ReadInChunks(buffered) != 0;
+}
+
+BENCHMARK_FUNC_WITH_INIT(ReadMappedFileStream, CreateDataFile, RemoveDataFile)
+{
+    wxMappedFileInputStream in(gs_fileName);
+    return ReadInChunks(in) != 0;
+}
+
+BENCHMARK_FUNC_WITH_INIT(ReadMappedFileData, CreateDataFile, RemoveDataFile)
+{
+    wxMappedFileInputStream in(gs_fileName);
+
+    const unsigned char* const
+        data = static_cast<const unsigned char*>(in.GetData());
+    const size_t size = in.GetSize();
+
+    unsigned sum = 0;
+    for ( size_t n = 0; n < size; n += 64 )
+        sum += data[n];
+
+    return sum != 0;
+}
+
+BENCHMARK_FUNC_WITH_INIT(ReadLinesFileStream, CreateTextFile, RemoveDataFile)
+{
+    wxFileInputStream in(gs_fileName);
+    return ReadAllLines(in) != 0;
+}
+
+BENCHMARK_FUNC_WITH_INIT(ReadLinesBufferedFileStream, CreateTextFile, RemoveDataFile)
+{
+    wxFileInputStream in(gs_fileName);
+    wxBufferedInputStream buffered(in);
+    return ReadAllLines(buffered) != 0;
+}
+
+BENCHMARK_FUNC_WITH_INIT(ReadLinesGzipFileStream, CreateGzipFile, RemoveDataFile)
+{
+    return ReadGzipLines(false) != 0;
+}
+
+BENCHMARK_FUNC_WITH_INIT(ReadLinesGzipFileStreamReadAhead, CreateGzipFile, RemoveDataFile)
+{
+    return ReadGzipLines(true) != 0;
+}
+
+BENCHMARK_FUNC_WITH_INIT(ReadLinesMappedFileStream, CreateTextFile, RemoveDataFile)
+{
+    wxMappedFileInputStream in(gs_fileName);
+    return ReadAllLines(in) != 0;
+}
+
+BENCHMARK_FUNC_WITH_INIT(DataStreamWriteDoubles, InitDataStreamValues, FreeDataStreamValues)
+{
+    wxMemoryOutputStream mo(NULL, 0);
+    wxDataOutputStream dos(mo);
+    dos.BigEndianOrdered(true);
+    dos.UseBasicPrecisions();
+    dos.WriteDouble(&gs_doubles[0], gs_doubles.size());
+
+    return mo.GetLength() == gs_dataStreamBuffer.GetDataLen();
+}
+
+BENCHMARK_FUNC_WITH_INIT(DataStreamReadDoubles, InitDataStreamValues, FreeDataStreamValues)
+{
+    wxMemoryInputStream mi(gs_dataStreamBuffer.GetData(),
+                           gs_dataStreamBuffer.GetDataLen());
+    wxDataInputStream dis(mi);
+    dis.BigEndianOrdered(true);
+    dis.UseBasicPrecisions();
+
+    wxVector<double> values(gs_doubles.size());
+    dis.ReadDouble(&values[0], values.size());
+
+    return values.back() == gs_doubles.back();
+}
+
+BENCHMARK_FUNC_WITH_INIT(DataStreamReadDoublesOneByOne, InitDataStreamValues, FreeDataStreamValues)
+{
+    wxMemoryInputStream mi(gs_dataStreamBuffer.GetData(),
+                           gs_dataStreamBuffer.GetDataLen());
+    wxDataInputStream dis(mi);
+    dis.BigEndianOrdered(true);
+    dis.UseBasicPrecisions();
+
+    double value = 0;
+    for ( size_t n = 0; n < gs_doubles.size(); n++ )
+        value = dis.ReadDouble();
+
+    return value == gs_doubles.back();
+}
+
+BENCHMARK_FUNC_WITH_INIT(ZlibCompress, InitCompressData, FreeCompressData)
+{
+    return DoCompress(wxZLIB_GZIP);
+}
+
+BENCHMARK_FUNC_WITH_INIT(ZlibCompressParallel, InitCompressData, FreeCompressData)
+{
+    return DoCompress(wxZLIB_GZIP | wxZLIB_PARALLEL);
+}
+
+BENCHMARK_FUNC_WITH_INIT(ZlibDecompress, InitDecompressZlib, FreeDecompressData)
+{
+    return DoFilterDecompress(wxGzipClassFactory());
+}
+
+#if wxUSE_LIBLZMA
+
+BENCHMARK_FUNC_WITH_INIT(LZMACompress, InitCompressData, FreeCompressData)
+{
+    return DoFilterCompress(wxLZMAClassFactory());
+}
+
+BENCHMARK_FUNC_WITH_INIT(LZMADecompress, InitDecompressLZMA, FreeDecompressData)
+{
+    return DoFilterDecompress(wxLZMAClassFactory());
+}
+
+#endif // wxUSE_LIBLZMA
+
+#if wxUSE_LIBZSTD
+
+BENCHMARK_FUNC_WITH_INIT(ZstdCompress, InitCompressData, FreeCompressData)
+{
+    return DoFilterCompress(wxZstdClassFactory());
+}
+
+BENCHMARK_FUNC_WITH_INIT(ZstdDecompress, InitDecompressZstd, FreeDecompressData)
+{
+    return DoFilterDecompress(wxZstdClassFactory());
+}
+
+#endif // wxUSE_LIBZSTD
@@ -0,0 +1,190 @@
+/////////////////////////////////////////////////////////////////////////////
+// Name:        tests/benchmarks/translation.cpp
+// Purpose:     wxTranslations-related benchmarks
+// Author:      wxWidgets development team
+// Created:     2026-10-19
+// Copyright:   (c) 2026 wxWidgets development team
+// Licence:     wxWindows licence
+/////////////////////////////////////////////////////////////////////////////
+
+#include "wx/defs.h"
+
+#if wxUSE_INTL
+
+#include "wx/arrstr.h"
+#include "wx/translation.h"
+#include "wx/vector.h"
+
+#include <string>
+
+#include "bench.h"
+
+namespace
+{
+
+// number of catalogs loaded by the benchmarks below
+const int NUM_DOMAINS = 4;
+
+// strings looked up by the benchmarks
+wxVector<wxString> gs_found,
+                   gs_missing;
+
+// Create .mo file data for a catalog with the given number of strings.
+wxCharBuffer MakeCatalogData(long count, int domain)
+{
+    wxVector<std::string> orig, trans;
+    orig.push_back("");
+    trans.push_back("Content-Type: text/plain; charset=UTF-8\n"
+                    "Plural-Forms: nplurals=2; plural=(n != 1);\n");
+
+    // the strings must be sorted as there is no hash table in this catalog
+    for ( long n = 0; n < count; n++ )
+    {
+        orig.push_back(wxString::Format("String %d/%08ld", domain, n).ToStdString());
+        trans.push_back(wxString::Format("Translation %d/%08ld", domain, n).ToStdString());
+    }
+
+    const wxUint32 num = orig.size();
+    const wxUint32 ofsOrigTable = 7*sizeof(wxUint32);
+    const wxUint32 ofsTransTable = ofsOrigTable + 2*num*sizeof(wxUint32);
+
+    wxVector<wxUint32> header;
+    header.push_back(0x950412de);   // magic
+    header.push_back(0);            // revision
+    header.push_back(num);
+    header.push_back(ofsOrigTable);
+    header.push_back(ofsTransTable);
+    header.push_back(0);            // no hash table
+    header.push_back(0);
+
+    std::string strings;
+    wxUint32 ofs = ofsTransTable + 2*num*sizeof(wxUint32);
+    for ( int table = 0; table < 2; table++ )
+    {
+        const wxVector<std::string>& v = table == 0 ? orig : trans;
+        for ( wxUint32 n = 0; n < num; n++ )
+        {
+            header.push_back(v[n].length());
+            header.push_back(ofs);
+
+            strings += v[n];
+            strings += '\0';
+            ofs += v[n].length() + 1;
+        }
+    }
+
+    const size_t headerSize = header.size()*sizeof(wxUint32);
+    wxCharBuffer buf(headerSize + strings.length());
+    memcpy(buf.data(), &header[0], headerSize);
+    memcpy(buf.data() + headerSize, strings.data(), strings.length());
+
+    return buf;
+}
+
+// Loader creating the catalogs in memory, using wxMSGCATALOG_LAZY if the
+// string parameter is "lazy".
+class BenchTranslationsLoader : public wxTranslationsLoader
+{
+public:
+    BenchTranslationsLoader(long count) : m_count(count) { }
+
+    virtual wxMsgCatalog *LoadCatalog(const wxString& domain,
+                                      const wxString& WXUNUSED(lang)) wxOVERRIDE
+    {
+        long n;
+        if ( !domain.AfterLast('_').ToLong(&n) )
+            return NULL;
+
+        m_data.push_back(MakeCatalogData(m_count, n));
+
+        return wxMsgCatalog::CreateFromData
+               (
+                    m_data.back(),
+                    domain,
+                    Bench::GetStringParameter() == "lazy" ? wxMSGCATALOG_LAZY : 0
+               );
+    }
+
+    virtual wxArrayString
+    GetAvailableTranslations(const wxString& WXUNUSED(domain)) const wxOVERRIDE
+    {
+        return wxArrayString(1, "fr");
+    }
+
+private:
+    const long m_count;
+
+    // the data must be kept alive when using wxMSGCATALOG_LAZY
+    wxVector<wxCharBuffer> m_data;
+};
+
+// Load NUM_DOMAINS catalogs with the number of strings given by the numeric
+// parameter, or 1000 by default, and prepare the strings to look up: the
+// strings found are in the catalog loaded first, i.e. searched last.
+bool LoadCatalogs()
+{
+    long count = Bench::GetNumericParameter();
+    if ( count <= 1 )
+        count = 1000;
+
+    wxTranslations* const trans = new wxTranslations;
+    wxTranslations::Set(trans);
+    trans->SetLoader(new BenchTranslationsLoader(count));
+    trans->SetLanguage("fr");
+
+    for ( int n = 0; n < NUM_DOMAINS; n++ )
+    {
+        if ( !trans->AddCatalog(wxString::Format("bench_%d", n)) )
+            return false;
+    }
+
+    for ( long n = 0; n < 100; n++ )
+    {
+        const long i = n*(count/100);
+        gs_found.push_back(wxString::Format("String 0/%08ld", i));
+        gs_missing.push_back(wxString::Format("Missing %08ld", i));
+    }
+
+    return true;
+}
+
+void UnloadCatalogs()
+{
+    wxTranslations::Set(NULL);
+
+    gs_found.clear();
+    gs_missing.clear();
+}
+
+} // anonymous namespace
+
+BENCHMARK_FUNC_WITH_INIT(TranslateFound, LoadCatalogs, UnloadCatalogs)
+{
+    size_t len = 0;
+    for ( size_t n = 0; n < gs_found.size(); n++ )
+        len += wxGetTranslation(gs_found[n]).length();
+
+    return len > 0;
+}
+
+BENCHMARK_FUNC_WITH_INIT(TranslateMissing, LoadCatalogs, UnloadCatalogs)
+{
+    size_t len = 0;
+    for ( size_t n = 0; n < gs_missing.size(); n++ )
+        len += wxGetTranslation(gs_missing[n]).length();
+
+    return len > 0;
+}
+
+// Lookups of the plural forms don't use the cache, so this benchmark shows
+// the cost of searching all the catalogs.
+BENCHMARK_FUNC_WITH_INIT(TranslatePlural, LoadCatalogs, UnloadCatalogs)
+{
+    size_t len = 0;
+    for ( size_t n = 0; n < gs_found.size(); n++ )
+        len += wxGetTranslation(gs_found[n], gs_found[n], 1).length();
+
+    return len > 0;
+}
+
+#endif // wxUSE_INTL
@@ -0,0 +1,102 @@
+/////////////////////////////////////////////////////////////////////////////
+// Name:        tests/benchmarks/xml.cpp
+// Purpose:     XML-related benchmarks
+// Author:      wxWidgets development team
+// Created:     2026-10-19
+// Copyright:   (c) 2026 wxWidgets development team
+// Licence:     wxWindows licence
+/////////////////////////////////////////////////////////////////////////////
+
+#include "wx/defs.h"
+
+#if wxUSE_XML
+
+#include "wx/xml/xml.h"
+#include "wx/mstream.h"
+#include "wx/buffer.h"
+
+#include "bench.h"
+
+namespace
+{
+
+wxCharBuffer gs_xml;
+
+// Create an XRC-like document in memory with the number of dialogs given by
+// the numeric parameter, or 100 by default, for the benchmarks below.
+bool CreateXmlData()
+{
+    long count = Bench::GetNumericParameter();
+    if ( !count )
+        count = 100;
+
+    wxString xml("<?xml version=\"1.0\" encoding=\"UTF-8\"?>\n"
+                 "<resource version=\"2.3.0.1\">\n");
+    for ( long n = 0; n < count; n++ )
+    {
+        xml += wxString::Format
+               (
+                "  <object class=\"wxDialog\" name=\"dialog%ld\">\n"
+                "    <title>Dialog %ld</title>\n"
+                "    <object class=\"wxBoxSizer\">\n"
+                "      <orient>wxVERTICAL</orient>\n",
+                n, n
+               );
+
+        for ( int i = 0; i < 10; i++ )
+        {
+            xml += wxString::Format
+                   (
+                    "      <object class=\"sizeritem\">\n"
+                    "        <flag>wxALL|wxEXPAND</flag>\n"
+                    "        <border>5</border>\n"
+                    "        <object class=\"wxTextCtrl\" name=\"text%d\">\n"
+                    "          <value>Initial value %d</value>\n"
+                    "          <size>100,-1d</size>\n"
+                    "        </object>\n"
+                    "      </object>\n",
+                    i, i
+                   );
+        }
+
+        xml += "    </object>\n"
+               "  </object>\n";
+    }
+
+    xml += "</resource>\n";
+
+    gs_xml = xml.utf8_str();
+
+    return true;
+}
+
+void FreeXmlData()
+{
+    gs_xml.reset();
+}
+
+// Load the document using the given flags and destroy it.
+bool DoLoadXml(int flags)
+{
+    wxMemoryInputStream mis(gs_xml.data(), gs_xml.length());
+
+    wxXmlDocument doc;
+    if ( !doc.Load(mis, "UTF-8", flags) )
+        return false;
+
+    return doc.GetRoot() && doc.GetRoot()->GetChildren();
+}
+
+} // anonymous namespace
+
+BENCHMARK_FUNC_WITH_INIT(XmlLoad, CreateXmlData, FreeXmlData)
+{
+    return DoLoadXml(wxXMLDOC_NONE);
+}
+
+BENCHMARK_FUNC_WITH_INIT(XmlLoadArena, CreateXmlData, FreeXmlData)
+{
+    return DoLoadXml(wxXMLDOC_USE_ARENA);
+}
+
+#endif // wxUSE_XML
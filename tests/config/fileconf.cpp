@@ -24,6 +24,9 @@
 #include "wx/fileconf.h"
 #include "wx/sstream.h"
 #include "wx/log.h"
+#include "wx/file.h"
+
+#include "testfile.h"
 
 static const wxChar *testconfig =
 wxT("[root]\n")
@@ -83,6 +86,8 @@ private:
         CPPUNIT_TEST( ReadNonExistent );
         CPPUNIT_TEST( ReadEmpty );
         CPPUNIT_TEST( ReadFloat );
+        CPPUNIT_TEST( ManyEntries );
+        CPPUNIT_TEST( Journal );
     CPPUNIT_TEST_SUITE_END();
 
     void Path();
@@ -108,6 +113,8 @@ private:
     void ReadNonExistent();
     void ReadEmpty();
     void ReadFloat();
+    void ManyEntries();
+    void Journal();
 
 
     static wxString ChangePath(wxFileConfig& fc, const wxChar *path)
@@ -699,5 +706,189 @@ void FileConfigTestCase::ReadFloat()
     CPPUNIT_ASSERT_EQUAL( -9876.5432f, f );
 }
 
+void FileConfigTestCase::ManyEntries()
+{
+    wxStringInputStream sis(testconfig);
+    wxFileConfig fc(sis);
+
+    // add the entries and groups in reverse order to check that they're still
+    // enumerated in the sorted order
+    const int count = 1000;
+    for ( int n = count - 1; n >= 0; n-- )
+    {
+        fc.Write(wxString::Format("/many/key%04d", n), n);
+        fc.Write(wxString::Format("/many/group%04d/entry", n), n);
+    }
+
+    fc.SetPath("/many");
+    CPPUNIT_ASSERT_EQUAL( (size_t)count, fc.GetNumberOfEntries() );
+    CPPUNIT_ASSERT_EQUAL( (size_t)count, fc.GetNumberOfGroups() );
+
+    wxString name;
+    long cookie;
+    int n = 0;
+    for ( bool cont = fc.GetFirstEntry(name, cookie);
+          cont;
+          cont = fc.GetNextEntry(name, cookie), n++ )
+    {
+        CPPUNIT_ASSERT_EQUAL( wxString::Format("key%04d", n), name );
+    }
+    CPPUNIT_ASSERT_EQUAL( count, n );
+
+    n = 0;
+    for ( bool cont = fc.GetFirstGroup(name, cookie);
+          cont;
+          cont = fc.GetNextGroup(name, cookie), n++ )
+    {
+        CPPUNIT_ASSERT_EQUAL( wxString::Format("group%04d", n), name );
+    }
+    CPPUNIT_ASSERT_EQUAL( count, n );
+
+    // names are case-insensitive
+    CPPUNIT_ASSERT( fc.HasEntry("KEY0042") );
+    CPPUNIT_ASSERT( fc.HasGroup("Group0042") );
+    CPPUNIT_ASSERT_EQUAL( 17, fc.ReadLong("/MANY/GROUP0017/Entry", 0) );
+
+    // adding an entry differing only in case modifies the existing one
+    fc.Write("Key0042", 17);
+    CPPUNIT_ASSERT_EQUAL( (size_t)count, fc.GetNumberOfEntries() );
+    CPPUNIT_ASSERT_EQUAL( 17, fc.ReadLong("key0042", 0) );
+
+    // deleting and renaming must keep the index consistent
+    CPPUNIT_ASSERT( fc.DeleteEntry("key0500") );
+    CPPUNIT_ASSERT( !fc.HasEntry("key0500") );
+    CPPUNIT_ASSERT( fc.RenameGroup("group0001", "renamed") );
+    CPPUNIT_ASSERT( !fc.HasGroup("group0001") );
+    CPPUNIT_ASSERT_EQUAL( 1, fc.ReadLong("renamed/entry", 0) );
+    CPPUNIT_ASSERT( fc.DeleteGroup("/many/renamed") );
+    CPPUNIT_ASSERT( !fc.HasGroup("renamed") );
+    CPPUNIT_ASSERT_EQUAL( (size_t)count - 1, fc.GetNumberOfGroups() );
+}
+
+// helper for Journal() test: read the entire file contents
+static wxString ReadAll(const wxString& name)
+{
+    wxFile file(name);
+    wxString s;
+    CPPUNIT_ASSERT( file.ReadAll(&s) );
+    return wxTextFile::Translate(s, wxTextFileType_Unix);
+}
+
+void FileConfigTestCase::Journal()
+{
+    const wxString name = wxFileName::CreateTempFileName("fileconf");
+    TempFile tempFile(name);
+    TempFile tempJournal(name + ".journal");
+
+    {
+        wxFile file(name, wxFile::write);
+        CPPUNIT_ASSERT( file.Write(testconfig) );
+    }
+
+    const long style = wxCONFIG_USE_LOCAL_FILE | wxCONFIG_USE_JOURNAL;
+
+    {
+        wxFileConfig fc("", "", name, "", style);
+        fc.Write("/root/entry", "new value");
+        fc.Write("/root/group1/subgroup/new", "=\"quoted\"=");
+        fc.Write("/root/group3/created", 17);
+        CPPUNIT_ASSERT( fc.DeleteEntry("/root/group1/subgroup/subentry2") );
+        CPPUNIT_ASSERT( fc.Flush() );
+
+        // the changes should have been written to the journal only
+        CPPUNIT_ASSERT( wxFile::Exists(tempJournal.GetName()) );
+        CPPUNIT_ASSERT_EQUAL( wxString(testconfig), ReadAll(name) );
+
+        // flushing again must not change anything
+        CPPUNIT_ASSERT( fc.Flush() );
+        fc.Write("/root/entry", "newer value");
+    }
+
+    {
+        wxFileConfig fc("", "", name, "", style);
+        CPPUNIT_ASSERT_EQUAL( "newer value", fc.Read("/root/entry", "") );
+        CPPUNIT_ASSERT_EQUAL( "=\"quoted\"=",
+                              fc.Read("/root/group1/subgroup/new", "") );
+        CPPUNIT_ASSERT_EQUAL( 17, fc.ReadLong("/root/group3/created", 0) );
+        CPPUNIT_ASSERT( !fc.HasEntry("/root/group1/subgroup/subentry2") );
+        CPPUNIT_ASSERT_EQUAL( "subvalue",
+                              fc.Read("/root/group1/subgroup/subentry", "") );
+
+        // deleting a group can't be journaled and results in the file being
+        // rewritten and the journal deleted
+        CPPUNIT_ASSERT( fc.DeleteGroup("/root/group2") );
+        CPPUNIT_ASSERT( fc.Flush() );
+        CPPUNIT_ASSERT( !wxFile::Exists(tempJournal.GetName()) );
+    }
+
+    const wxString contents = ReadAll(name);
+    CPPUNIT_ASSERT( contents.Contains("entry=newer value") );
+    CPPUNIT_ASSERT( !contents.Contains("group2") );
+
+    {
+        wxFileConfig fc("", "", name, "", style);
+        fc.Write("/root/entry", "journaled");
+    }
+
+    // a journal which doesn't correspond to the file must be ignored
+    CPPUNIT_ASSERT( wxFile::Exists(tempJournal.GetName()) );
+    {
+        wxFile file(name, wxFile::write_append);
+        CPPUNIT_ASSERT( file.Write("[other]\n") );
+    }
+
+    {
+        wxFileConfig fc("", "", name, "", style);
+        CPPUNIT_ASSERT_EQUAL( "newer value", fc.Read("/root/entry", "") );
+        CPPUNIT_ASSERT( fc.HasGroup("/other") );
+        CPPUNIT_ASSERT( !wxFile::Exists(tempJournal.GetName()) );
+    }
+
+    // and this must also be the case if the file size didn't change
+    {
+        wxFileConfig fc("", "", name, "", style);
+        fc.Write("/root/entry", "journaled");
+    }
+
+    CPPUNIT_ASSERT( wxFile::Exists(tempJournal.GetName()) );
+    {
+        wxString modified = ReadAll(name);
+        CPPUNIT_ASSERT( modified.Replace("entry=newer value",
+                                         "entry=older value") );
+
+        wxFile file(name, wxFile::write);
+        CPPUNIT_ASSERT( file.Write(modified) );
+    }
+
+    {
+        wxFileConfig fc("", "", name, "", style);
+        CPPUNIT_ASSERT_EQUAL( "older value", fc.Read("/root/entry", "") );
+        CPPUNIT_ASSERT( !wxFile::Exists(tempJournal.GetName()) );
+    }
+
+    // without wxCONFIG_USE_JOURNAL the file is always rewritten
+    {
+        wxFileConfig fc("", "", name, "", wxCONFIG_USE_LOCAL_FILE);
+        fc.Write("/root/entry", "direct");
+    }
+
+    CPPUNIT_ASSERT( !wxFile::Exists(tempJournal.GetName()) );
+    CPPUNIT_ASSERT( ReadAll(name).Contains("entry=direct") );
+
+    // the journal is merged into the file when it becomes too big
+    {
+        wxFileConfig fc("", "", name, "", style);
+        fc.Write("/root/big", wxString('x', 40000));
+        CPPUNIT_ASSERT( fc.Flush() );
+        CPPUNIT_ASSERT( wxFile::Exists(tempJournal.GetName()) );
+
+        fc.Write("/root/big", wxString('y', 40000));
+        CPPUNIT_ASSERT( fc.Flush() );
+        CPPUNIT_ASSERT( !wxFile::Exists(tempJournal.GetName()) );
+    }
+
+    CPPUNIT_ASSERT( ReadAll(name).Contains("big=yyyy") );
+}
+
 #endif // wxUSE_FILECONFIG
 
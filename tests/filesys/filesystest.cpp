@@ -21,6 +21,11 @@
 #endif // WX_PRECOMP
 
 #include "wx/filesys.h"
+#include "wx/fs_arc.h"
+#include "wx/zipstrm.h"
+#include "wx/wfstream.h"
+#include "wx/mstream.h"
+#include "wx/scopedptr.h"
 
 #if wxUSE_FILESYSTEM
 
@@ -199,4 +204,131 @@ void FileSystemTestCase::UnicodeFileNameToUrlConversion()
     CPPUNIT_ASSERT( filename.SameAs(wxFileName::URLToFileName(url)) );
 }
 
+#if wxUSE_FS_ARCHIVE && wxUSE_ZIPSTREAM
+
+namespace
+{
+
+// Read the contents of the given file using the given handler.
+wxString ReadArchiveFSFile(wxArchiveFSHandler& handler, const wxString& location)
+{
+    wxFileSystem fs;
+    wxScopedPtr<wxFSFile> file(handler.OpenFile(fs, location));
+    if ( !file )
+        return "<error>";
+
+    wxMemoryOutputStream out;
+    out.Write(*file->GetStream());
+
+    wxCharBuffer buf(out.GetLength());
+    out.CopyTo(buf.data(), buf.length());
+    return wxString::FromUTF8(buf.data(), buf.length());
+}
+
+} // anonymous namespace
+
+TEST_CASE("wxArchiveFSHandler::Cache", "[filesys][archive]")
+{
+    const wxString small1(100, 'a'),
+                   small2(100, 'b'),
+                   big(100000, 'c');
+
+    const wxString filename("fsarchive.zip");
+    {
+        wxFileOutputStream out(filename);
+        wxZipOutputStream zip(out);
+        zip.PutNextEntry("small1.txt");
+        zip.Write(small1.utf8_str(), small1.length());
+        zip.PutNextEntry("small2.txt");
+        zip.Write(small2.utf8_str(), small2.length());
+        zip.PutNextEntry("dir/big.txt");
+        zip.Write(big.utf8_str(), big.length());
+    }
+
+    const wxString
+        base = wxFileSystem::FileNameToURL(wxFileName(filename)) + "#zip:";
+
+    wxArchiveFSHandler handler;
+
+    SECTION("Default")
+    {
+        CHECK( ReadArchiveFSFile(handler, base + "small1.txt") == small1 );
+        CHECK( ReadArchiveFSFile(handler, base + "small1.txt") == small1 );
+        CHECK( ReadArchiveFSFile(handler, base + "dir/big.txt") == big );
+        CHECK( ReadArchiveFSFile(handler, base + "dir/big.txt") == big );
+
+        wxArchiveFSCacheStats stats = handler.GetCacheStats();
+        CHECK( stats.archiveMisses == 1 );
+        CHECK( stats.archiveHits == 3 );
+        CHECK( stats.dataHits == 1 );
+        CHECK( stats.dataMisses == 3 );
+        CHECK( stats.dataCount == 1 );
+        CHECK( stats.dataSize == small1.length() );
+
+        handler.ResetCacheStats();
+        stats = handler.GetCacheStats();
+        CHECK( stats.dataHits == 0 );
+        CHECK( stats.dataCount == 1 );
+
+        handler.Cleanup();
+        stats = handler.GetCacheStats();
+        CHECK( stats.dataCount == 0 );
+        CHECK( stats.dataSize == 0 );
+
+        // The files not in the archive can't be opened, whether their
+        // directory exists or not.
+        wxFileSystem fs;
+        CHECK( !handler.OpenFile(fs, base + "nonexistent.txt") );
+        CHECK( !handler.OpenFile(fs, base + "dir/nonexistent.txt") );
+    }
+
+    SECTION("Disabled")
+    {
+        handler.SetCacheLimits(0, 0);
+
+        CHECK( ReadArchiveFSFile(handler, base + "small1.txt") == small1 );
+        CHECK( ReadArchiveFSFile(handler, base + "small1.txt") == small1 );
+
+        const wxArchiveFSCacheStats stats = handler.GetCacheStats();
+        CHECK( stats.dataHits == 0 );
+        CHECK( stats.dataMisses == 2 );
+        CHECK( stats.dataCount == 0 );
+    }
+
+    SECTION("LRU")
+    {
+        // Only one of the small files fits into the cache.
+        handler.SetCacheLimits(1000, 150);
+
+        CHECK( ReadArchiveFSFile(handler, base + "small1.txt") == small1 );
+        CHECK( ReadArchiveFSFile(handler, base + "small2.txt") == small2 );
+        CHECK( ReadArchiveFSFile(handler, base + "small2.txt") == small2 );
+        CHECK( ReadArchiveFSFile(handler, base + "small1.txt") == small1 );
+
+        const wxArchiveFSCacheStats stats = handler.GetCacheStats();
+        CHECK( stats.dataHits == 1 );
+        CHECK( stats.dataMisses == 3 );
+        CHECK( stats.dataCount == 1 );
+        CHECK( stats.dataSize == small1.length() );
+    }
+
+    SECTION("StreamOutlivesCache")
+    {
+        wxFileSystem fs;
+        wxScopedPtr<wxFSFile> file(handler.OpenFile(fs, base + "small1.txt"));
+        REQUIRE( file );
+
+        // Discard the cached data while the stream still uses it.
+        handler.SetCacheLimits(0, 0);
+
+        char buf[200];
+        CHECK( file->GetStream()->Read(buf, sizeof(buf)).LastRead() == 100 );
+        CHECK( wxString(buf, 100) == small1 );
+    }
+
+    wxRemoveFile(filename);
+}
+
+#endif // wxUSE_FS_ARCHIVE && wxUSE_ZIPSTREAM
+
 #endif // wxUSE_FILESYSTEM
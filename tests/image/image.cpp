@@ -20,16 +20,23 @@
 #endif
 
 #ifndef WX_PRECOMP
+    #include "wx/app.h"
 #endif // WX_PRECOMP
 
 #include "wx/anidecod.h" // wxImageArray
+#include "wx/gifdecod.h"
+#include "wx/imageloader.h"
 #include "wx/palette.h"
+#include "wx/quantize.h"
 #include "wx/url.h"
 #include "wx/log.h"
 #include "wx/mstream.h"
+#include "wx/stopwatch.h"
 #include "wx/zstream.h"
 #include "wx/wfstream.h"
 
+#include "wx/private/pixelconv.h"
+
 #include "testimage.h"
 
 struct testData {
@@ -68,6 +75,10 @@ private:
         CPPUNIT_TEST( LoadFromSocketStream );
         CPPUNIT_TEST( LoadFromZipStream );
         CPPUNIT_TEST( LoadFromFile );
+        CPPUNIT_TEST( LoadMaxSize );
+#if wxUSE_THREADS
+        CPPUNIT_TEST( LoadInBackground );
+#endif // wxUSE_THREADS
         CPPUNIT_TEST( SizeImage );
         CPPUNIT_TEST( CompareLoadedImage );
         CPPUNIT_TEST( CompareSavedImage );
@@ -78,16 +89,24 @@ private:
         CPPUNIT_TEST( ReadCorruptedTGA );
 #if wxUSE_GIF
         CPPUNIT_TEST( SaveAnimatedGIF );
+        CPPUNIT_TEST( GIFDecoderCache );
+        CPPUNIT_TEST( GIFCorruptFrame );
         CPPUNIT_TEST( GIFComment );
 #endif // wxUSE_GIF
         CPPUNIT_TEST( DibPadding );
         CPPUNIT_TEST( BMPFlippingAndRLECompression );
         CPPUNIT_TEST( ScaleCompare );
+        CPPUNIT_TEST( QuantizeColours );
+        CPPUNIT_TEST( PixelConversions );
     CPPUNIT_TEST_SUITE_END();
 
     void LoadFromSocketStream();
     void LoadFromZipStream();
     void LoadFromFile();
+    void LoadMaxSize();
+#if wxUSE_THREADS
+    void LoadInBackground();
+#endif // wxUSE_THREADS
     void SizeImage();
     void CompareLoadedImage();
     void CompareSavedImage();
@@ -98,11 +117,15 @@ private:
     void ReadCorruptedTGA();
 #if wxUSE_GIF
     void SaveAnimatedGIF();
+    void GIFDecoderCache();
+    void GIFCorruptFrame();
     void GIFComment();
 #endif // wxUSE_GIF
     void DibPadding();
     void BMPFlippingAndRLECompression();
     void ScaleCompare();
+    void QuantizeColours();
+    void PixelConversions();
 
     wxDECLARE_NO_COPY_CLASS(ImageTestCase);
 };
@@ -145,6 +168,131 @@ void ImageTestCase::LoadFromFile()
         CPPUNIT_ASSERT(img.LoadFile(g_testfiles[i].file));
 }
 
+void ImageTestCase::LoadMaxSize()
+{
+    // horse.jpg is 200*200, so it can be scaled down to 50*50 directly by the
+    // JPEG handler
+    wxImage img;
+    img.SetOption(wxIMAGE_OPTION_MAX_WIDTH, 60);
+    img.SetOption(wxIMAGE_OPTION_MAX_HEIGHT, 60);
+    CPPUNIT_ASSERT( img.LoadFile("horse.jpg", wxBITMAP_TYPE_JPEG) );
+    CPPUNIT_ASSERT_EQUAL( 50, img.GetWidth() );
+    CPPUNIT_ASSERT_EQUAL( 50, img.GetHeight() );
+    CPPUNIT_ASSERT_EQUAL( 200, img.GetOptionInt(wxIMAGE_OPTION_ORIGINAL_WIDTH) );
+    CPPUNIT_ASSERT_EQUAL( 200, img.GetOptionInt(wxIMAGE_OPTION_ORIGINAL_HEIGHT) );
+
+    // but it can't be scaled by more than 1/8 in the DCT domain, so the rest
+    // has to be done after loading it
+    img = wxImage();
+    img.SetOption(wxIMAGE_OPTION_MAX_WIDTH, 20);
+    CPPUNIT_ASSERT( img.LoadFile("horse.jpg", wxBITMAP_TYPE_JPEG) );
+    CPPUNIT_ASSERT_EQUAL( 12, img.GetWidth() );
+    CPPUNIT_ASSERT_EQUAL( 12, img.GetHeight() );
+    CPPUNIT_ASSERT_EQUAL( 200, img.GetOptionInt(wxIMAGE_OPTION_ORIGINAL_WIDTH) );
+
+    // and the generic code works for the other formats too
+    img = wxImage();
+    img.SetOption(wxIMAGE_OPTION_MAX_HEIGHT, 100);
+    CPPUNIT_ASSERT( img.LoadFile("horse.png", wxBITMAP_TYPE_PNG) );
+    CPPUNIT_ASSERT_EQUAL( 100, img.GetWidth() );
+    CPPUNIT_ASSERT_EQUAL( 100, img.GetHeight() );
+}
+
+#if wxUSE_THREADS
+
+namespace
+{
+
+class ImageLoaderHandler : public wxEvtHandler
+{
+public:
+    ImageLoaderHandler()
+    {
+        Bind(wxEVT_IMAGE_LOADED, &ImageLoaderHandler::OnLoaded, this);
+    }
+
+    wxVector<wxImageLoaderEvent> m_events;
+
+private:
+    void OnLoaded(wxImageLoaderEvent& event)
+    {
+        m_events.push_back(event);
+    }
+};
+
+} // anonymous namespace
+
+void ImageTestCase::LoadInBackground()
+{
+    ImageLoaderHandler handler;
+    wxImageLoader loader(&handler);
+    loader.SetMaxThreads(2);
+
+    const int idPNG = loader.Load("horse.png");
+    const int idJPEG = loader.Load(new wxFileInputStream("horse.jpg"), 0,
+                                   wxBITMAP_TYPE_JPEG);
+    const int idBad = loader.Load("nosuchfile.png");
+    const int idCancelled = loader.Load("horse.bmp", -1);
+    loader.Cancel(idCancelled);
+
+    wxStopWatch sw;
+    while ( handler.m_events.size() < 3 )
+    {
+        CPPUNIT_ASSERT( sw.Time() < 10000 );
+
+        wxMilliSleep(10);
+        wxTheApp->ProcessPendingEvents();
+    }
+
+    CPPUNIT_ASSERT_EQUAL( 0, loader.GetPendingCount() );
+    CPPUNIT_ASSERT_EQUAL( 3, handler.m_events.size() );
+
+    for ( size_t n = 0; n < handler.m_events.size(); n++ )
+    {
+        const wxImageLoaderEvent& event = handler.m_events[n];
+        if ( event.GetRequestId() == idPNG )
+        {
+            CPPUNIT_ASSERT( event.IsOk() );
+            CPPUNIT_ASSERT_EQUAL( "horse.png", event.GetFileName() );
+            CPPUNIT_ASSERT_EQUAL( 200, event.GetImage().GetWidth() );
+        }
+        else if ( event.GetRequestId() == idJPEG )
+        {
+            CPPUNIT_ASSERT( event.IsOk() );
+            CPPUNIT_ASSERT( event.GetFileName().empty() );
+            CPPUNIT_ASSERT_EQUAL( 200, event.GetImage().GetHeight() );
+        }
+        else
+        {
+            CPPUNIT_ASSERT_EQUAL( idBad, event.GetRequestId() );
+            CPPUNIT_ASSERT( !event.IsOk() );
+        }
+    }
+
+    // Check that the images are still loaded, one by one, if the memory
+    // limit is smaller than any of them.
+    handler.m_events.clear();
+    loader.SetMemoryLimit(1);
+
+    for ( int n = 0; n < 3; n++ )
+        loader.Load("horse.png");
+
+    sw.Start();
+    while ( handler.m_events.size() < 3 )
+    {
+        CPPUNIT_ASSERT( sw.Time() < 10000 );
+
+        wxMilliSleep(10);
+        wxTheApp->ProcessPendingEvents();
+    }
+
+    CPPUNIT_ASSERT_EQUAL( 0, loader.GetPendingCount() );
+    for ( size_t n = 0; n < handler.m_events.size(); n++ )
+        CPPUNIT_ASSERT( handler.m_events[n].IsOk() );
+}
+
+#endif // wxUSE_THREADS
+
 void ImageTestCase::LoadFromSocketStream()
 {
     if (!IsNetworkAvailable())      // implemented in test.cpp
@@ -1222,6 +1370,186 @@ void ImageTestCase::SaveAnimatedGIF()
 #endif // #if wxUSE_PALETTE
 }
 
+void ImageTestCase::GIFDecoderCache()
+{
+#if wxUSE_PALETTE
+    wxImage image("horse.gif");
+    CPPUNIT_ASSERT( image.IsOk() );
+
+    wxImageArray images;
+    images.Add(image);
+    for (int i = 0; i < 4-1; ++i)
+    {
+        images.Add( images[i].Rotate90() );
+
+        images[i+1].SetPalette(images[0].GetPalette());
+    }
+
+    wxMemoryOutputStream memOut;
+    CPPUNIT_ASSERT( wxGIFHandler().SaveAnimation(images, &memOut) );
+
+    wxMemoryInputStream memIn(memOut);
+    wxGIFDecoder decoder;
+    CPPUNIT_ASSERT_EQUAL( wxGIF_OK, decoder.LoadGIF(memIn) );
+    CPPUNIT_ASSERT_EQUAL( 4u, decoder.GetFrameCount() );
+
+    // Use the smallest possible cache to check that the frames discarded from
+    // it are decoded again correctly.
+    decoder.SetMaxCacheSize(1);
+
+    static const unsigned frames[] = { 3, 0, 2, 2, 1, 3, 0 };
+    for ( size_t n = 0; n < WXSIZEOF(frames); n++ )
+    {
+        const unsigned i = frames[n];
+
+        CPPUNIT_ASSERT( decoder.ConvertToImage(i, &image) );
+
+        wxINFO_FMT("Compare test for GIF frame number %u failed", i);
+        CHECK_THAT(image, RGBSameAs(images[i]));
+    }
+#endif // #if wxUSE_PALETTE
+}
+
+// Helper for writing the GIF LZW codes: they are packed starting from the
+// least significant bits and split into sub-blocks of at most 255 bytes.
+class GIFCodeWriter
+{
+public:
+    GIFCodeWriter() : m_acc(0), m_bits(0) { }
+
+    void Write(unsigned code, int bits)
+    {
+        m_acc |= code << m_bits;
+        m_bits += bits;
+        while ( m_bits >= 8 )
+        {
+            m_bytes.push_back(m_acc & 0xff);
+            m_acc >>= 8;
+            m_bits -= 8;
+        }
+    }
+
+    void Flush(wxMemoryOutputStream& out)
+    {
+        if ( m_bits )
+            Write(0, 8 - m_bits);
+
+        for ( size_t n = 0; n < m_bytes.size(); n += 255 )
+        {
+            const size_t len = wxMin(m_bytes.size() - n, size_t(255));
+            out.PutC(static_cast<char>(len));
+            out.Write(&m_bytes[n], len);
+        }
+
+        out.PutC(0);
+    }
+
+private:
+    wxVector<unsigned char> m_bytes;
+    unsigned m_acc;
+    int m_bits;
+};
+
+void ImageTestCase::GIFCorruptFrame()
+{
+    // Create a 2 frame 64*64 animation using 4 colours, in which the first
+    // frame is valid while the second one never clears the LZW alphabet and
+    // so overflows it, which is an error.
+    static const unsigned char header[] =
+    {
+        'G', 'I', 'F', '8', '9', 'a',
+        64, 0, 64, 0, 0x81, 0, 0,
+        0x00, 0x00, 0x00,   0xff, 0x00, 0x00,
+        0x00, 0xff, 0x00,   0x00, 0x00, 0xff,
+    };
+
+    static const unsigned char descriptor[] =
+    {
+        0x2c, 0, 0, 0, 0, 64, 0, 64, 0, 0,
+        2 // LZW minimum code size
+    };
+
+    static const unsigned CODE_CLEAR = 4;
+    static const unsigned CODE_END = 5;
+
+    wxMemoryOutputStream memOut;
+    memOut.Write(header, sizeof(header));
+
+    // The first frame only sets its top left pixel to colour 1.
+    memOut.Write(descriptor, sizeof(descriptor));
+    GIFCodeWriter first;
+    first.Write(CODE_CLEAR, 3);
+    first.Write(1, 3);
+    first.Write(CODE_END, 3);
+    first.Flush(memOut);
+
+    // The second one fills the image with colour 2 pixels one by one, each
+    // of them (except the first one) adding a new entry to the alphabet,
+    // until it becomes full and the next entry is invalid.
+    memOut.Write(descriptor, sizeof(descriptor));
+    GIFCodeWriter second;
+    second.Write(CODE_CLEAR, 3);
+    second.Write(2, 3);
+
+    int bits = 3;
+    unsigned next = CODE_END + 1;
+    for ( ;; )
+    {
+        second.Write(2, bits);
+
+        // The alphabet is full, so this code is invalid.
+        if ( next == 1u << bits )
+            break;
+
+        next++;
+        if ( next == 1u << bits && bits < 12 )
+            bits++;
+    }
+
+    second.Write(CODE_END, bits);
+    second.Flush(memOut);
+
+    memOut.PutC(0x3b);
+
+    // Only the first frame is decoded when loading, so this succeeds.
+    wxMemoryInputStream memIn(memOut);
+    wxGIFDecoder decoder;
+    CPPUNIT_ASSERT_EQUAL( wxGIF_OK, decoder.LoadGIF(memIn) );
+    CPPUNIT_ASSERT_EQUAL( 2u, decoder.GetFrameCount() );
+
+    wxImage image;
+    CPPUNIT_ASSERT( decoder.ConvertToImage(0, &image) );
+    CPPUNIT_ASSERT_EQUAL( wxSize(64, 64), image.GetSize() );
+    CPPUNIT_ASSERT_EQUAL( 0xff, (int)image.GetRed(0, 0) );
+    CPPUNIT_ASSERT_EQUAL( 0x00, (int)image.GetRed(1, 0) );
+    CPPUNIT_ASSERT_EQUAL( 0x00, (int)image.GetGreen(63, 63) );
+
+    // And the corrupted frame is decoded up to the error, with the rest of
+    // it using the first colour as it has no transparency.
+    CPPUNIT_ASSERT( decoder.GetData(1) );
+    CPPUNIT_ASSERT( decoder.ConvertToImage(1, &image) );
+    CPPUNIT_ASSERT_EQUAL( wxSize(64, 64), image.GetSize() );
+    CPPUNIT_ASSERT_EQUAL( 0xff, (int)image.GetGreen(0, 0) );
+    CPPUNIT_ASSERT_EQUAL( 0xff, (int)image.GetGreen(0, 63) );
+    CPPUNIT_ASSERT_EQUAL( 0x00, (int)image.GetGreen(63, 63) );
+
+    // Loading it using wxImage works too.
+    wxMemoryInputStream memIn2(memOut);
+    CPPUNIT_ASSERT( image.LoadFile(memIn2, wxBITMAP_TYPE_GIF, 1) );
+    CPPUNIT_ASSERT_EQUAL( 0xff, (int)image.GetGreen(0, 0) );
+
+    // While the first frame is still checked when loading.
+    wxMemoryOutputStream memBad;
+    memBad.Write(header, sizeof(header));
+    memBad.Write(descriptor, sizeof(descriptor));
+    second.Flush(memBad);
+    memBad.PutC(0x3b);
+
+    wxMemoryInputStream memBadIn(memBad);
+    wxGIFDecoder decoderBad;
+    CPPUNIT_ASSERT_EQUAL( wxGIF_INVFORMAT, decoderBad.LoadGIF(memBadIn) );
+}
+
 static void TestGIFComment(const wxString& comment)
 {
     wxImage image("horse.gif");
@@ -1452,6 +1780,356 @@ void ImageTestCase::ScaleCompare()
                                "image/cross_nearest_neighb_256x256.png");
 }
 
+static wxImage
+QuantizeImage(const wxImage& image, int numColours, int flags)
+{
+    wxImage quantized;
+    CPPUNIT_ASSERT( wxQuantize::Quantize(image, quantized, NULL, numColours,
+                                         NULL,
+                                         flags | wxQUANTIZE_FILL_DESTINATION_IMAGE) );
+    return quantized;
+}
+
+static double
+GetMeanSquaredError(const wxImage& i1, const wxImage& i2)
+{
+    const unsigned char* p1 = i1.GetData();
+    const unsigned char* p2 = i2.GetData();
+    const int numBytes = i1.GetWidth()*i1.GetHeight()*3;
+    double error = 0;
+    for ( int n = 0; n < numBytes; n++, p1++, p2++ )
+    {
+        const int diff = *p1 - *p2;
+        error += diff*diff;
+    }
+
+    return error / numBytes;
+}
+
+void ImageTestCase::QuantizeColours()
+{
+    // Use the size which is not a multiple of anything to test the handling
+    // of the image edges.
+    const int w = 257,
+              h = 131;
+
+    // Check that an image with only a few colours, including some very close
+    // to each other, is preserved exactly.
+    static const unsigned char colours[][3] =
+    {
+        {   1,   2,   3 },
+        {   1,   2,   4 },
+        { 250,   0,   7 },
+        {   0,   0,   0 },
+        { 255, 255, 255 },
+    };
+
+    wxImage few(w, h);
+    unsigned char* p = few.GetData();
+    for ( int y = 0; y < h; y++ )
+    {
+        for ( int x = 0; x < w; x++, p += 3 )
+            memcpy(p, colours[(7*x + 3*y + x*y) % WXSIZEOF(colours)], 3);
+    }
+
+    for ( int numColours = WXSIZEOF(colours); numColours <= 256; numColours *= 2 )
+    {
+        CPPUNIT_ASSERT_EQUAL( 0, FindMaxChannelDiff(few,
+            QuantizeImage(few, numColours, wxQUANTIZE_OCTREE)) );
+        CPPUNIT_ASSERT_EQUAL( 0, FindMaxChannelDiff(few,
+            QuantizeImage(few, numColours,
+                          wxQUANTIZE_OCTREE | wxQUANTIZE_NO_DITHERING)) );
+    }
+
+    // Check that the number of colours in the palette is never exceeded for
+    // an image with many colours and that the octree quantizer error is not
+    // much worse than that of the median cut one.
+    wxImage many(w, h);
+    p = many.GetData();
+    for ( int y = 0; y < h; y++ )
+    {
+        for ( int x = 0; x < w; x++, p += 3 )
+        {
+            p[0] = static_cast<unsigned char>(x*255/(w - 1));
+            p[1] = static_cast<unsigned char>(y*255/(h - 1));
+            p[2] = static_cast<unsigned char>(((x + y)*255/(w + h - 2)) ^
+                                              ((x/8 + y/8) % 2 ? 0x40 : 0));
+        }
+    }
+
+    static const int numColoursToTest[] = { 2, 16, 64, 236, 256 };
+    for ( size_t n = 0; n < WXSIZEOF(numColoursToTest); n++ )
+    {
+        const int numColours = numColoursToTest[n];
+
+        for ( int dither = 0; dither < 2; dither++ )
+        {
+            const int flags = dither ? 0 : wxQUANTIZE_NO_DITHERING;
+
+            const wxImage medianCut = QuantizeImage(many, numColours, flags);
+            CPPUNIT_ASSERT( medianCut.CountColours() <= (unsigned long)numColours );
+
+            const wxImage octree = QuantizeImage(many, numColours,
+                                                 flags | wxQUANTIZE_OCTREE);
+            CPPUNIT_ASSERT( octree.CountColours() <= (unsigned long)numColours );
+
+            const double errorMedianCut = GetMeanSquaredError(many, medianCut),
+                         errorOctree = GetMeanSquaredError(many, octree);
+            WX_ASSERT_MESSAGE
+            (
+                (
+                    "Octree error %g too big compared to median cut %g "
+                    "for %d colours %s dithering",
+                    errorOctree, errorMedianCut, numColours,
+                    dither ? "with" : "without"
+                ),
+                errorOctree <= 2*errorMedianCut
+            );
+        }
+    }
+}
+
+// Simple deterministic pseudo-random bytes generator for PixelConversions.
+class PixelBytesGenerator
+{
+public:
+    PixelBytesGenerator() : m_state(12345) { }
+
+    unsigned char Next()
+    {
+        m_state = m_state*1103515245u + 12345u;
+        return static_cast<unsigned char>(m_state >> 16);
+    }
+
+    // Return alpha values with many fully opaque or transparent ones, as
+    // they're handled specially.
+    unsigned char NextAlpha()
+    {
+        const unsigned char a = Next();
+        switch ( a % 4 )
+        {
+            case 0: return 0;
+            case 1: return 0xff;
+        }
+
+        return a;
+    }
+
+    wxUint32 NextARGB()
+    {
+        return static_cast<wxUint32>(NextAlpha()) << 24 |
+               Next() << 16 | Next() << 8 | Next();
+    }
+
+    // Return a premultiplied ARGB32 pixel.
+    wxUint32 NextPremultipliedARGB()
+    {
+        const unsigned a = NextAlpha();
+        return a << 24 |
+               (Next()*a/0xff) << 16 | (Next()*a/0xff) << 8 | Next()*a/0xff;
+    }
+
+private:
+    wxUint32 m_state;
+};
+
+static unsigned PremultiplyRef(unsigned a, unsigned c)
+{
+    return a ? c*a/0xff : c;
+}
+
+void ImageTestCase::PixelConversions()
+{
+    // Use sizes which are not multiples of the number of pixels processed at
+    // once by the SIMD code to check the handling of the remaining ones.
+    static const size_t counts[] = { 0, 1, 3, 4, 5, 7, 8, 13, 31, 257 };
+
+    PixelBytesGenerator gen;
+    for ( size_t n = 0; n < WXSIZEOF(counts); n++ )
+    {
+        const size_t count = counts[n];
+        wxINFO_FMT("Converting %u pixels", static_cast<unsigned>(count));
+
+        // Allocate one more pixel to check that it's not overwritten.
+        wxVector<unsigned char> rgb(3*count + 3), alpha(count + 1);
+        for ( size_t i = 0; i < rgb.size(); i++ )
+            rgb[i] = gen.Next();
+        for ( size_t i = 0; i < alpha.size(); i++ )
+            alpha[i] = gen.NextAlpha();
+
+        // Make some pixels of the mask colour used below.
+        for ( size_t i = 0; i < count; i += 5 )
+        {
+            rgb[3*i] = 1;
+            rgb[3*i + 1] = 2;
+            rgb[3*i + 2] = 3;
+        }
+        static const unsigned char mask[] = { 1, 2, 3 };
+
+        // RGB <-> RGBA
+        wxVector<unsigned char> rgba(4*count + 4, 0xcc);
+        wxConvertRGBToRGBA(&rgba[0], &rgb[0], &alpha[0], count);
+        for ( size_t i = 0; i < count; i++ )
+        {
+            CHECK( rgba[4*i] == rgb[3*i] );
+            CHECK( rgba[4*i + 1] == rgb[3*i + 1] );
+            CHECK( rgba[4*i + 2] == rgb[3*i + 2] );
+            CHECK( rgba[4*i + 3] == alpha[i] );
+        }
+        CHECK( rgba[4*count] == 0xcc );
+
+        wxConvertRGBToRGBA(&rgba[0], &rgb[0], NULL, count);
+        for ( size_t i = 0; i < count; i++ )
+        {
+            CHECK( rgba[4*i] == rgb[3*i] );
+            CHECK( rgba[4*i + 3] == 0xff );
+        }
+
+        wxVector<unsigned char> rgb2(3*count + 3, 0xcc), alpha2(count + 1, 0xcc);
+        for ( size_t i = 0; i < count; i++ )
+            rgba[4*i + 3] = alpha[i];
+        wxConvertRGBAToRGB(&rgb2[0], &alpha2[0], &rgba[0], count);
+        for ( size_t i = 0; i < 3*count; i++ )
+            CHECK( rgb2[i] == rgb[i] );
+        for ( size_t i = 0; i < count; i++ )
+            CHECK( alpha2[i] == alpha[i] );
+        CHECK( rgb2[3*count] == 0xcc );
+        CHECK( alpha2[count] == 0xcc );
+
+        // RGB <-> ARGB32
+        wxVector<wxUint32> argb(count + 1, 0xcccccccc);
+        wxConvertRGBToARGB32(&argb[0], &rgb[0], &alpha[0], count);
+        for ( size_t i = 0; i < count; i++ )
+        {
+            const unsigned a = alpha[i];
+            const wxUint32 expected = a << 24 |
+                                      PremultiplyRef(a, rgb[3*i]) << 16 |
+                                      PremultiplyRef(a, rgb[3*i + 1]) << 8 |
+                                      PremultiplyRef(a, rgb[3*i + 2]);
+            CHECK( argb[i] == expected );
+        }
+        CHECK( argb[count] == 0xcccccccc );
+
+        wxConvertRGBToARGB32(&argb[0], &rgb[0], NULL, count);
+        for ( size_t i = 0; i < count; i++ )
+        {
+            CHECK( argb[i] == (0xff000000u | rgb[3*i] << 16 |
+                               rgb[3*i + 1] << 8 | rgb[3*i + 2]) );
+        }
+
+        // Use arbitrary, and not necessarily correctly premultiplied, data
+        // for the reverse conversion.
+        for ( size_t i = 0; i < count; i++ )
+            argb[i] = gen.NextARGB();
+
+        wxConvertARGB32ToRGB(&rgb2[0], &alpha2[0], &argb[0], count);
+        for ( size_t i = 0; i < count; i++ )
+        {
+            const unsigned a = argb[i] >> 24;
+            CHECK( alpha2[i] == a );
+            for ( int c = 0; c < 3; c++ )
+            {
+                const unsigned v = (argb[i] >> (16 - 8*c)) & 0xff;
+                CHECK( rgb2[3*i + c] ==
+                        (a ? static_cast<unsigned char>(v*0xff/a) : v) );
+            }
+        }
+        CHECK( rgb2[3*count] == 0xcc );
+        CHECK( alpha2[count] == 0xcc );
+
+        wxConvertARGB32ToRGB(&rgb2[0], NULL, &argb[0], count);
+        for ( size_t i = 0; i < count; i++ )
+        {
+            for ( int c = 0; c < 3; c++ )
+                CHECK( rgb2[3*i + c] == ((argb[i] >> (16 - 8*c)) & 0xff) );
+        }
+
+        // Premultiplication
+        wxVector<wxUint32> premult(argb);
+        wxPremultiplyARGB32(&premult[0], count);
+        for ( size_t i = 0; i < count; i++ )
+        {
+            const unsigned a = argb[i] >> 24;
+            const wxUint32 expected =
+                a << 24 |
+                PremultiplyRef(a, (argb[i] >> 16) & 0xff) << 16 |
+                PremultiplyRef(a, (argb[i] >> 8) & 0xff) << 8 |
+                PremultiplyRef(a, argb[i] & 0xff);
+            CHECK( premult[i] == expected );
+        }
+        CHECK( premult[count] == 0xcccccccc );
+
+        // Composition
+        wxVector<wxUint32> src(count + 1), dst(count + 1);
+        for ( size_t i = 0; i < count; i++ )
+        {
+            src[i] = gen.NextPremultipliedARGB();
+            dst[i] = gen.NextPremultipliedARGB();
+        }
+
+        // Also use some transparent pixels with non-zero colour.
+        for ( size_t i = 0; i < count; i += 3 )
+            src[i] &= 0x00ffffff;
+
+        src[count] = 0xff000000;
+        dst[count] = 0xcccccccc;
+
+        wxVector<wxUint32> composed(dst);
+        wxComposeARGB32Over(&composed[0], &src[0], count);
+        for ( size_t i = 0; i < count; i++ )
+        {
+            const unsigned a = src[i] >> 24;
+            wxUint32 expected = 0;
+            for ( int shift = 0; shift < 32; shift += 8 )
+            {
+                const unsigned s = (src[i] >> shift) & 0xff,
+                               d = (dst[i] >> shift) & 0xff;
+                expected |= (a ? wxMin(s + d*(0xff - a)/0xff, 0xffu) : d)
+                                << shift;
+            }
+            CHECK( composed[i] == expected );
+        }
+        CHECK( composed[count] == 0xcccccccc );
+
+        // Grey and disabled conversions
+        for ( int useMask = 0; useMask < 2; useMask++ )
+        {
+            const unsigned char* const m = useMask ? mask : NULL;
+
+            wxConvertRGBToGrey(&rgb2[0], &rgb[0], count,
+                               0.299, 0.587, 0.114, m);
+            for ( size_t i = 0; i < count; i++ )
+            {
+                unsigned char r = rgb[3*i],
+                              g = rgb[3*i + 1],
+                              b = rgb[3*i + 2];
+                if ( !m || memcmp(&rgb[3*i], m, 3) != 0 )
+                    wxColour::MakeGrey(&r, &g, &b, 0.299, 0.587, 0.114);
+
+                CHECK( rgb2[3*i] == r );
+                CHECK( rgb2[3*i + 1] == g );
+                CHECK( rgb2[3*i + 2] == b );
+            }
+
+            wxConvertRGBToDisabled(&rgb2[0], &rgb[0], count, 200, m);
+            for ( size_t i = 0; i < count; i++ )
+            {
+                unsigned char r = rgb[3*i],
+                              g = rgb[3*i + 1],
+                              b = rgb[3*i + 2];
+                if ( !m || memcmp(&rgb[3*i], m, 3) != 0 )
+                    wxColour::MakeDisabled(&r, &g, &b, 200);
+
+                CHECK( rgb2[3*i] == r );
+                CHECK( rgb2[3*i + 1] == g );
+                CHECK( rgb2[3*i + 2] == b );
+            }
+
+            CHECK( rgb2[3*count] == 0xcc );
+        }
+    }
+}
+
 #endif //wxUSE_IMAGE
 
 
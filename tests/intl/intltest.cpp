@@ -21,6 +21,9 @@
 #endif // WX_PRECOMP
 
 #include "wx/intl.h"
+#include "wx/scopedptr.h"
+
+#include <string>
 
 #if wxUSE_INTL
 
@@ -220,4 +223,239 @@ void IntlTestCase::IsAvailable()
     CPPUNIT_ASSERT_EQUAL( origLocale, setlocale(LC_ALL, NULL) );
 }
 
+// ----------------------------------------------------------------------------
+// wxMsgCatalog tests
+// ----------------------------------------------------------------------------
+
+namespace
+{
+
+// Create the contents of a .mo file without the hash table from the given
+// sorted arrays of original and translated strings.
+wxCharBuffer
+MakeMsgCatalogData(const wxVector<std::string>& orig,
+                   const wxVector<std::string>& trans)
+{
+    const wxUint32 count = orig.size();
+    const wxUint32 ofsOrigTable = 7*sizeof(wxUint32);
+    const wxUint32 ofsTransTable = ofsOrigTable + 2*count*sizeof(wxUint32);
+
+    wxVector<wxUint32> header;
+    header.push_back(0x950412de);   // magic
+    header.push_back(0);            // revision
+    header.push_back(count);
+    header.push_back(ofsOrigTable);
+    header.push_back(ofsTransTable);
+    header.push_back(0);            // no hash table
+    header.push_back(0);
+
+    std::string strings;
+    wxUint32 ofs = ofsTransTable + 2*count*sizeof(wxUint32);
+    for ( int table = 0; table < 2; table++ )
+    {
+        const wxVector<std::string>& v = table == 0 ? orig : trans;
+        for ( wxUint32 n = 0; n < count; n++ )
+        {
+            header.push_back(v[n].length());
+            header.push_back(ofs);
+
+            strings += v[n];
+            strings += '\0';
+            ofs += v[n].length() + 1;
+        }
+    }
+
+    const size_t headerSize = header.size()*sizeof(wxUint32);
+    wxCharBuffer buf(headerSize + strings.length());
+    memcpy(buf.data(), &header[0], headerSize);
+    memcpy(buf.data() + headerSize, strings.data(), strings.length());
+
+    return buf;
+}
+
+void CheckMsgCatalog(const wxMsgCatalog& cat)
+{
+    const wxString* s = cat.GetString("word");
+    REQUIRE( s );
+    CHECK( *s == "mot" );
+
+    s = cat.GetString("word", UINT_MAX, "ctx");
+    REQUIRE( s );
+    CHECK( *s == "mot en contexte" );
+
+    s = cat.GetString("file", 1);
+    REQUIRE( s );
+    CHECK( *s == "fichier" );
+
+    s = cat.GetString("file", 2);
+    REQUIRE( s );
+    CHECK( *s == "fichiers" );
+
+    s = cat.GetString(wxString::FromUTF8("\xc3\xa9t\xc3\xa9"));
+    REQUIRE( s );
+    CHECK( *s == "summer" );
+
+    s = cat.GetString("");
+    REQUIRE( s );
+    CHECK( s->Contains("Plural-Forms") );
+
+    CHECK( !cat.GetString("missing") );
+    CHECK( !cat.GetString("word", UINT_MAX, "other") );
+    CHECK( !cat.GetString("untranslated") );
+}
+
+} // anonymous namespace
+
+TEST_CASE("wxMsgCatalog::Lazy", "[intl][translations]")
+{
+    SECTION("Data")
+    {
+        wxVector<std::string> orig, trans;
+        orig.push_back("");
+        trans.push_back("Content-Type: text/plain; charset=UTF-8\n"
+                        "Plural-Forms: nplurals=2; plural=(n != 1);\n");
+        orig.push_back("ctx\x04word");
+        trans.push_back("mot en contexte");
+        orig.push_back(std::string("file\0files", 10));
+        trans.push_back(std::string("fichier\0fichiers", 16));
+        orig.push_back("untranslated");
+        trans.push_back("");
+        orig.push_back("word");
+        trans.push_back("mot");
+        orig.push_back("\xc3\xa9t\xc3\xa9");
+        trans.push_back("summer");
+
+        const wxCharBuffer data = MakeMsgCatalogData(orig, trans);
+
+        wxScopedPtr<wxMsgCatalog>
+            cat(wxMsgCatalog::CreateFromData(data, "test"));
+        REQUIRE( cat );
+        CheckMsgCatalog(*cat);
+
+        cat.reset(wxMsgCatalog::CreateFromData(data, "test", wxMSGCATALOG_LAZY));
+        REQUIRE( cat );
+        CheckMsgCatalog(*cat);
+
+        // check that the cached results are correct too
+        CheckMsgCatalog(*cat);
+        CHECK( cat->GetString("word") == cat->GetString("word") );
+
+        // long strings are handled differently from the short ones
+        CHECK( !cat->GetString(wxString('x', 1000)) );
+    }
+
+    SECTION("File")
+    {
+        // unlike the catalog above, this one does have a hash table
+        wxScopedPtr<wxMsgCatalog>
+            cat(wxMsgCatalog::CreateFromFile("intl/fr/internat.mo", "internat")),
+            lazy(wxMsgCatalog::CreateFromFile("intl/fr/internat.mo", "internat",
+                                              wxMSGCATALOG_LAZY));
+        REQUIRE( cat );
+        REQUIRE( lazy );
+
+        static const char* const strings[] =
+        {
+            "",
+            "International wxWindows App",
+            "&About",
+            "E&xit",
+            "&Open bogus file",
+            "&Play a game",
+            "&File",
+            "&Test",
+            "I18n sample\n\xc2\xa9 1998, 1999 Vadim Zeitlin and Julian Smart",
+            "About Internat",
+            "Enter your number:",
+            "Try to guess my number!",
+            "Bad luck! try again...",
+            "Result",
+            "Not in the catalog",
+        };
+
+        for ( size_t n = 0; n < WXSIZEOF(strings); n++ )
+        {
+            const wxString str = wxString::FromUTF8(strings[n]);
+            INFO("String: \"" << str << "\"");
+
+            const wxString* const s = cat->GetString(str);
+            const wxString* const l = lazy->GetString(str);
+            if ( s )
+            {
+                REQUIRE( l );
+                CHECK( *s == *l );
+            }
+            else
+            {
+                CHECK( !l );
+            }
+        }
+
+        const wxString* const s = lazy->GetString("&Open bogus file");
+        REQUIRE( s );
+        CHECK( *s == "&Ouvrir un fichier" );
+
+        CHECK( !lazy->GetString("Not in the catalog") );
+    }
+}
+
+namespace
+{
+
+// Loader returning a catalog with a single translation depending on domain.
+class TestTranslationsLoader : public wxTranslationsLoader
+{
+public:
+    virtual wxMsgCatalog *LoadCatalog(const wxString& domain,
+                                      const wxString& WXUNUSED(lang)) wxOVERRIDE
+    {
+        wxVector<std::string> orig, trans;
+        orig.push_back("");
+        trans.push_back("Content-Type: text/plain; charset=UTF-8\n");
+        orig.push_back("word");
+        trans.push_back(domain == "first" ? "mot" : "MOT");
+
+        return wxMsgCatalog::CreateFromData(MakeMsgCatalogData(orig, trans),
+                                            domain);
+    }
+
+    virtual wxArrayString
+    GetAvailableTranslations(const wxString& WXUNUSED(domain)) const wxOVERRIDE
+    {
+        return wxArrayString(1, "fr");
+    }
+};
+
+} // anonymous namespace
+
+TEST_CASE("wxTranslations::Cache", "[intl][translations]")
+{
+    wxTranslations* const trans = new wxTranslations;
+    wxTranslations::Set(trans);
+    trans->SetLoader(new TestTranslationsLoader);
+    trans->SetLanguage("fr");
+
+    // The results of all these lookups are cached, check that the cache is
+    // invalidated when the translations change.
+    CHECK( _("word") == "word" );
+
+    REQUIRE( trans->AddCatalog("first") );
+    CHECK( _("word") == "mot" );
+    CHECK( _("word") == "mot" );
+    CHECK( wxGetTranslation("word", "first") == "mot" );
+    CHECK( wxGetTranslation("word", "second") == "word" );
+    CHECK( wxGETTEXT_IN_CONTEXT("ctx", "word") == "word" );
+
+    REQUIRE( trans->AddCatalog("second") );
+    CHECK( _("word") == "MOT" );
+    CHECK( wxGetTranslation("word", "first") == "mot" );
+    CHECK( wxGetTranslation("word", "second") == "MOT" );
+
+    // Plural forms are not cached, but check that they still work.
+    CHECK( wxPLURAL("word", "words", 1) == "MOT" );
+
+    wxTranslations::Set(NULL);
+    CHECK( _("word") == "word" );
+}
+
 #endif // wxUSE_INTL
@@ -391,3 +391,181 @@ void LogTestCase::NoWarnings()
 
     CPPUNIT_ASSERT_EQUAL( "If", m_log->GetLog(wxLOG_Error) );
 }
+
+#if wxUSE_THREADS
+
+#include "wx/thread.h"
+#include "wx/vector.h"
+
+namespace
+{
+
+class AsyncLogThread : public wxThread
+{
+public:
+    AsyncLogThread(int id, int count)
+        : wxThread(wxTHREAD_JOINABLE),
+          m_id(id),
+          m_count(count)
+    {
+    }
+
+protected:
+    virtual ExitCode Entry() wxOVERRIDE
+    {
+        for ( int n = 0; n < m_count; n++ )
+            wxLogMessage("Thread %d message %d", m_id, n);
+
+        return NULL;
+    }
+
+private:
+    const int m_id;
+    const int m_count;
+};
+
+// Return the contents of the given file.
+wxString ReadAsyncLogFile(FILE* fp)
+{
+    wxString s;
+
+    rewind(fp);
+
+    char buf[4096];
+    size_t len;
+    while ( (len = fread(buf, 1, sizeof(buf), fp)) > 0 )
+        s += wxString::FromUTF8(buf, len);
+
+    return s;
+}
+
+} // anonymous namespace
+
+TEST_CASE("wxLogAsync", "[log]")
+{
+    FILE* const fp = tmpfile();
+    REQUIRE( fp );
+
+    wxON_BLOCK_EXIT1( fclose, fp );
+
+    const bool logWasEnabled = wxLog::EnableLogging();
+    wxON_BLOCK_EXIT1( wxLog::EnableLogging, logWasEnabled );
+
+    SECTION("Main")
+    {
+        wxLogAsync* const log = new wxLogAsync(fp, wxConvUTF8);
+        wxLog* const logOld = wxLog::SetActiveTarget(log);
+
+        wxLogMessage("First");
+        wxLogWarning("Second");
+
+        log->Flush();
+
+        const wxString s = ReadAsyncLogFile(fp);
+        const size_t pos = s.find("First\n");
+        CHECK( pos != wxString::npos );
+        CHECK( s.find("Warning: Second\n", pos) != wxString::npos );
+        CHECK( log->GetDroppedCount() == 0 );
+
+        delete wxLog::SetActiveTarget(logOld);
+    }
+
+    SECTION("Threads")
+    {
+        static const int NUM_THREADS = 4;
+        static const int NUM_MESSAGES = 1000;
+
+        // use a small buffer to check that all the messages are either
+        // written or accounted for as dropped
+        wxLogAsync* const log = new wxLogAsync(fp, wxConvUTF8, 16);
+        wxLog* const logOld = wxLog::SetActiveTarget(log);
+
+        wxVector<wxThread*> threads;
+        for ( int n = 0; n < NUM_THREADS; n++ )
+        {
+            threads.push_back(new AsyncLogThread(n, NUM_MESSAGES));
+            REQUIRE( threads.back()->Run() == wxTHREAD_NO_ERROR );
+        }
+
+        for ( int n = 0; n < NUM_THREADS; n++ )
+        {
+            threads[n]->Wait();
+            delete threads[n];
+        }
+
+        log->Flush();
+
+        const size_t dropped = log->GetDroppedCount();
+        delete wxLog::SetActiveTarget(logOld);
+
+        const wxString s = ReadAsyncLogFile(fp);
+
+        size_t written = 0;
+        for ( size_t pos = s.find("Thread "); pos != wxString::npos;
+              pos = s.find("Thread ", pos + 1) )
+        {
+            written++;
+        }
+
+        CHECK( written + dropped == NUM_THREADS*NUM_MESSAGES );
+
+        if ( dropped )
+            CHECK( s.find(" dropped.") != wxString::npos );
+    }
+
+    SECTION("Replace")
+    {
+        static const int NUM_THREADS = 4;
+        static const int NUM_MESSAGES = 1000;
+
+        // the active target may be changed and the old one deleted while the
+        // other threads are logging
+        wxLog* const logOld =
+            wxLog::SetActiveTarget(new wxLogAsync(fp, wxConvUTF8, 16));
+
+        wxVector<wxThread*> threads;
+        for ( int n = 0; n < NUM_THREADS; n++ )
+        {
+            threads.push_back(new AsyncLogThread(n, NUM_MESSAGES));
+            REQUIRE( threads.back()->Run() == wxTHREAD_NO_ERROR );
+        }
+
+        size_t dropped = 0;
+        for ( int n = 0; n < 50; n++ )
+        {
+            wxLogAsync* const log = static_cast<wxLogAsync*>(
+                wxLog::SetActiveTarget(new wxLogAsync(fp, wxConvUTF8, 16)));
+
+            log->Flush();
+            dropped += log->GetDroppedCount();
+            delete log;
+
+            wxMilliSleep(1);
+        }
+
+        for ( int n = 0; n < NUM_THREADS; n++ )
+        {
+            threads[n]->Wait();
+            delete threads[n];
+        }
+
+        wxLogAsync* const log =
+            static_cast<wxLogAsync*>(wxLog::SetActiveTarget(logOld));
+        log->Flush();
+        dropped += log->GetDroppedCount();
+        delete log;
+
+        const wxString s = ReadAsyncLogFile(fp);
+
+        size_t written = 0;
+        for ( size_t pos = s.find("Thread "); pos != wxString::npos;
+              pos = s.find("Thread ", pos + 1) )
+        {
+            written++;
+        }
+
+        CHECK( written + dropped == NUM_THREADS*NUM_MESSAGES );
+    }
+}
+
+#endif // wxUSE_THREADS
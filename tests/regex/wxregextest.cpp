@@ -344,4 +344,316 @@ TEST_CASE("wxRegEx::QuoteMeta", "[regex][meta]")
     CHECK( wxRegEx::QuoteMeta(":foo.*bar") == ":foo\\.\\*bar" );
 }
 
+// Check that the result of matching the given text is the same as expected,
+// this is mostly useful for checking that the optimizations done by wxRegEx
+// don't prevent it from finding the matches.
+static void CheckMatch(const char* pattern, const char* text,
+                       const char* expected, int flags = wxRE_DEFAULT)
+{
+    INFO( "Pattern: /" << pattern << "/, text: \"" << text << "\"" );
+
+    wxRegEx re(pattern, flags);
+    REQUIRE( re.IsValid() );
+
+    if ( !expected )
+    {
+        CHECK( !re.Matches(text) );
+        return;
+    }
+
+    REQUIRE( re.Matches(text) );
+    CHECK( re.GetMatch(text) == expected );
+}
+
+TEST_CASE("wxRegEx::Literal", "[regex]")
+{
+    CheckMatch("colou?r", "color", "color");
+    CheckMatch("colou*r", "color", "color");
+    CheckMatch("colou{0,1}r", "color", "color");
+    CheckMatch("colou+r", "colouur", "colouur");
+    CheckMatch("colou+r", "color", NULL);
+    CheckMatch("x(abc)*y", "xy", "xy");
+    CheckMatch("x(abc)+y", "xy", NULL);
+    CheckMatch("foo|bar", "bar", "bar");
+    CheckMatch("(foo|bar)baz", "barbaz", "barbaz");
+    CheckMatch("[]x]abc", "]abc", "]abc");
+    CheckMatch("[[:digit:]]+ms", "took 15ms", "15ms");
+    CheckMatch("\\.txt$", "file.txt", ".txt");
+    CheckMatch("\\.txt$", "filetxt", NULL);
+    CheckMatch("^error: .* failed$", "error: open failed", "error: open failed");
+    CheckMatch("^error: .* failed$", "error: open succeeded", NULL);
+    CheckMatch("ERROR", "error", "error", wxRE_ICASE);
+    CheckMatch("a(b", "a(b", "a(b", wxRE_BASIC);
+#ifdef wxHAS_REGEX_ADVANCED
+    CheckMatch("\\d+ms", "took 15ms", "15ms", wxRE_ADVANCED);
+    CheckMatch("(?i)ERROR", "error", "error", wxRE_ADVANCED);
+    CheckMatch("***=a.b", "a.b", "a.b", wxRE_ADVANCED);
+    CheckMatch("***=a.b", "axb", NULL, wxRE_ADVANCED);
+    CheckMatch("a\\x41-", "aA-", "aA-", wxRE_ADVANCED);
+    CheckMatch("a\\u0042c", "aBc", "aBc", wxRE_ADVANCED);
+    CheckMatch("x\\cAy", "x\001y", "x\001y", wxRE_ADVANCED);
+    CheckMatch("x\\012y", "x\ny", "x\ny", wxRE_ADVANCED);
+    CheckMatch("(b)\\1c", "abbc", "bbc", wxRE_ADVANCED);
+#endif // wxHAS_REGEX_ADVANCED
+
+    // check that only the given part of the text is searched
+    wxRegEx re("bar");
+    REQUIRE( re.IsValid() );
+
+    const wxString text("foobar");
+    CHECK( re.Matches(text.wx_str(), 0, 6) );
+    CHECK( !re.Matches(text.wx_str(), 0, 5) );
+    CHECK( re.Matches(text.wx_str() + 3, 0, 3) );
+}
+
+TEST_CASE("wxRegEx::Reuse", "[regex]")
+{
+    static const char* const patterns[] =
+    {
+        "([a-z]+)[^0-9]*([0-9]+)",
+        "^([a-z]+) ([0-9]+)$",
+        "(a|ab)(c|bcd)(d*)",
+        "o+",
+#ifdef wxHAS_REGEX_ADVANCED
+        "(a+)b\\1",
+        "(\\w+?)(\\d*)",
+#endif // wxHAS_REGEX_ADVANCED
+    };
+
+    static const char* const texts[] =
+    {
+        "foo123",
+        "123",
+        "abcd",
+        "foo 42",
+        "aabaa",
+        "bar",
+        "",
+        "foo bar 17 and 18",
+        "aaabaaa",
+        "x9",
+    };
+
+    for ( size_t n = 0; n < WXSIZEOF(patterns); n++ )
+    {
+#ifdef wxHAS_REGEX_ADVANCED
+        const int flags = n < 4 ? wxRE_EXTENDED : wxRE_ADVANCED;
+#else
+        const int flags = wxRE_EXTENDED;
+#endif
+
+        // this object is reused for all texts while a new one is created for
+        // each of them below, the results must be the same
+        wxRegEx re(patterns[n], flags);
+        REQUIRE( re.IsValid() );
+
+        for ( int pass = 0; pass < 2; pass++ )
+        {
+            for ( size_t m = 0; m < WXSIZEOF(texts); m++ )
+            {
+                INFO( "Pattern: /" << patterns[n] << "/, "
+                      "text: \"" << texts[m] << "\"" );
+
+                wxRegEx reNew(patterns[n], flags);
+                REQUIRE( reNew.IsValid() );
+
+                const bool matches = reNew.Matches(texts[m]);
+                REQUIRE( re.Matches(texts[m]) == matches );
+                if ( !matches )
+                    continue;
+
+                REQUIRE( re.GetMatchCount() == reNew.GetMatchCount() );
+                for ( size_t i = 0; i < re.GetMatchCount(); i++ )
+                {
+                    size_t start, len, startNew, lenNew;
+                    CHECK( re.GetMatch(&start, &len, i) );
+                    CHECK( reNew.GetMatch(&startNew, &lenNew, i) );
+                    CHECK( start == startNew );
+                    CHECK( len == lenNew );
+                }
+            }
+        }
+    }
+}
+
+TEST_CASE("wxRegEx::PCRE", "[regex]")
+{
+    // these expressions are valid in both Perl-compatible and advanced syntax
+    // and so the results are the same whether PCRE2 is really used or not
+    CheckMatch("\\d+", "abc123", "123", wxRE_PCRE);
+    CheckMatch("a.*?b", "aXbYb", "aXb", wxRE_PCRE);
+    CheckMatch("(?:foo)+", "foofoo", "foofoo", wxRE_PCRE);
+    CheckMatch("FOO", "foo", "foo", wxRE_PCRE | wxRE_ICASE);
+    CheckMatch("^b", "a\nb", NULL, wxRE_PCRE);
+    CheckMatch("^b", "a\nb", "b", wxRE_PCRE | wxRE_NEWLINE);
+    CheckMatch("a.b", "a\nb", "a\nb", wxRE_PCRE);
+    CheckMatch("a.b", "a\nb", NULL, wxRE_PCRE | wxRE_NEWLINE);
+
+    wxRegEx re("(\\w+)@(\\w+)\\.com", wxRE_PCRE);
+    REQUIRE( re.IsValid() );
+    CHECK( re.GetMatchCount() == 3 );
+
+    const wxString text("mail foo@example.com now");
+    REQUIRE( re.Matches(text) );
+    CHECK( re.GetMatch(text, 1) == "foo" );
+    CHECK( re.GetMatch(text, 2) == "example" );
+
+    wxString replaced(text);
+    CHECK( re.Replace(&replaced, "\\2") == 1 );
+    CHECK( replaced == "mail example now" );
+
+    CHECK( !re.Matches("foo@example.org") );
+
+    {
+        wxLogNull noLog;
+        CHECK( !re.Compile("(foo", wxRE_PCRE) );
+    }
+
+#if wxUSE_LIBPCRE2 && defined(wxHAS_REGEX_ADVANCED)
+    // these expressions are only valid in Perl-compatible syntax
+    CheckMatch("(?<w>\\w+) \\k<w>", "say bye bye", "bye bye", wxRE_PCRE);
+    CheckMatch("\\d++5", "12345", NULL, wxRE_PCRE);
+    CheckMatch("a$", "a\n", NULL, wxRE_PCRE);
+#endif // wxUSE_LIBPCRE2
+}
+
+TEST_CASE("wxRegEx::Unset", "[regex]")
+{
+    // subexpressions which don't participate in the match must be handled in
+    // the same way whether PCRE2 is used or not
+    static const int flags[] = { wxRE_EXTENDED, wxRE_PCRE };
+
+    for ( size_t n = 0; n < WXSIZEOF(flags); n++ )
+    {
+        INFO( "Flags: " << flags[n] );
+
+        wxRegEx re("(a)|(b)", flags[n]);
+        REQUIRE( re.IsValid() );
+        REQUIRE( re.GetMatchCount() == 3 );
+
+        const wxString text("xa");
+        REQUIRE( re.Matches(text) );
+        CHECK( re.GetMatch(text, 1) == "a" );
+        CHECK( re.GetMatch(text, 2) == "" );
+
+        size_t start, len;
+        CHECK( re.GetMatch(&start, &len, 2) );
+        CHECK( len == 0 );
+
+        wxString replaced(text);
+        CHECK( re.Replace(&replaced, "[\\1\\2]") == 1 );
+        CHECK( replaced == "x[a]" );
+    }
+}
+
+TEST_CASE("wxRegEx::MatchLines", "[regex]")
+{
+    wxRegEx re("[0-9]+ms");
+    REQUIRE( re.IsValid() );
+
+    wxArrayString lines;
+    lines.push_back("took 15ms");
+    lines.push_back("no time");
+    lines.push_back("");
+    lines.push_back("7ms and 8ms");
+
+    wxRegExLineMatches matches;
+    REQUIRE( re.MatchLines(lines, &matches) == 2 );
+    REQUIRE( matches.size() == 2 );
+    CHECK( matches[0].line == 0 );
+    CHECK( matches[0].start == 5 );
+    CHECK( matches[0].len == 4 );
+    CHECK( matches[1].line == 3 );
+    CHECK( matches[1].start == 0 );
+    CHECK( matches[1].len == 3 );
+
+    CHECK( re.MatchLines(lines, NULL) == 2 );
+
+    SECTION("Buffer")
+    {
+        const wxString text("took 15ms\nno time\r\n\n7ms and 8ms");
+        const size_t offsets[] = { 0, 10, 19, 20, text.length() };
+
+        REQUIRE( re.MatchLines(text.wc_str(), offsets, 4, &matches) == 2 );
+        CHECK( matches[0].line == 0 );
+        CHECK( matches[0].start == 5 );
+        CHECK( matches[1].line == 3 );
+        CHECK( matches[1].len == 3 );
+
+        // the trailing line end is not part of the line
+        wxRegEx reEnd("e$");
+        REQUIRE( reEnd.IsValid() );
+        REQUIRE( reEnd.MatchLines(text.wc_str(), offsets, 4, &matches) == 1 );
+        CHECK( matches[0].line == 1 );
+    }
+
+#if wxUSE_UNICODE
+    SECTION("UTF-8")
+    {
+        // the offsets and the matches are in bytes, including the invalid
+        // one in the last line
+        const char text[] = "d\xc3\xa9j\xc3\xa0 15ms\n"
+                            "\xe2\x82\xac\n"
+                            "\xff 8ms\n";
+        const size_t offsets[] = { 0, 12, 16, 22 };
+
+        REQUIRE( re.MatchLinesUTF8(text, offsets, 3, &matches) == 2 );
+        CHECK( matches[0].line == 0 );
+        CHECK( matches[0].start == 7 );
+        CHECK( matches[0].len == 4 );
+        CHECK( matches[1].line == 2 );
+        CHECK( matches[1].start == 2 );
+        CHECK( matches[1].len == 3 );
+
+        wxRegEx reEuro(wxString::FromUTF8("\xe2\x82\xac"));
+        REQUIRE( reEuro.IsValid() );
+        REQUIRE( reEuro.MatchLinesUTF8(text, offsets, 3, &matches) == 1 );
+        CHECK( matches[0].line == 1 );
+        CHECK( matches[0].start == 0 );
+        CHECK( matches[0].len == 3 );
+    }
+#endif // wxUSE_UNICODE
+
+    SECTION("NoSub")
+    {
+        wxRegEx reNoSub("[0-9]+ms", wxRE_NOSUB);
+        REQUIRE( reNoSub.IsValid() );
+        REQUIRE( reNoSub.MatchLines(lines, &matches) == 2 );
+        CHECK( matches[1].line == 3 );
+        CHECK( matches[1].start == 0 );
+        CHECK( matches[1].len == 0 );
+    }
+
+    SECTION("Threads")
+    {
+        // use enough lines for them to be really matched by several threads
+        lines.clear();
+        for ( int n = 0; n < 10000; n++ )
+            lines.push_back(wxString::Format("line %d took %dms", n, n % 7));
+
+        wxRegEx reThreads("took [1-3]([0-9]*)ms");
+        REQUIRE( reThreads.IsValid() );
+
+        wxRegExLineMatches matchesSerial;
+        const size_t count = reThreads.MatchLines(lines, &matchesSerial);
+        CHECK( count == 4287 );
+
+        const unsigned numThreads[] = { 0, 3, 16 };
+        for ( size_t n = 0; n < WXSIZEOF(numThreads); n++ )
+        {
+            INFO( "Threads: " << numThreads[n] );
+
+            REQUIRE( reThreads.MatchLines(lines, &matches, 0, numThreads[n])
+                        == count );
+            REQUIRE( matches.size() == count );
+            for ( size_t i = 0; i < count; i++ )
+            {
+                CHECK( matches[i].line == matchesSerial[i].line );
+                CHECK( matches[i].start == matchesSerial[i].start );
+                CHECK( matches[i].len == matchesSerial[i].len );
+            }
+        }
+    }
+}
+
 #endif // wxUSE_REGEX
@@ -279,6 +279,50 @@ protected:
         }
     }
 
+    // Read the stream using PeekBuffer() and check that it returns the same
+    // data as GetC() does for another stream with the same contents.
+    void Input_PeekBuffer()
+    {
+        CleanupHelper cleanup(this);
+        TStreamIn &stream_in = CreateInStream();
+        TStreamIn * const stream_ref = DoCreateInStream();
+
+        size_t size;
+        const unsigned char *data;
+
+        // The data put back into the stream must be returned first.
+        const int first = stream_ref->GetC();
+        CPPUNIT_ASSERT_EQUAL(first, stream_in.GetC());
+        if (stream_in.Ungetch(char(first)))
+        {
+            data = static_cast<const unsigned char *>(stream_in.PeekBuffer(&size));
+            CPPUNIT_ASSERT(data);
+            CPPUNIT_ASSERT_EQUAL(1, size);
+            CPPUNIT_ASSERT_EQUAL(first, int(*data));
+            stream_in.ConsumeBuffer(1);
+        }
+
+        while ((data = static_cast<const unsigned char *>(stream_in.PeekBuffer(&size))) != NULL)
+        {
+            CPPUNIT_ASSERT(size > 0);
+
+            // Consume only a part of the data to check that the rest of it is
+            // returned again by the next call.
+            const size_t consume = size > 3 ? size / 2 : size;
+            for (size_t n = 0; n < consume; n++)
+                CPPUNIT_ASSERT_EQUAL(stream_ref->GetC(), int(data[n]));
+
+            stream_in.ConsumeBuffer(consume);
+            CPPUNIT_ASSERT_EQUAL(consume, stream_in.LastRead());
+        }
+
+        CPPUNIT_ASSERT_EQUAL(0, size);
+        CPPUNIT_ASSERT(stream_in.Eof());
+        CPPUNIT_ASSERT_EQUAL(wxEOF, stream_ref->GetC());
+
+        delete stream_ref;
+    }
+
     /*
      * Output stream tests.
      */
@@ -24,6 +24,7 @@
 
 #include "wx/datstrm.h"
 #include "wx/wfstream.h"
+#include "wx/mstream.h"
 #include "wx/math.h"
 
 #include "testfile.h"
@@ -313,3 +314,101 @@ void DataStreamTestCase::NaNRW()
 }
 
 
+
+// Check that the array functions produce the same data as writing the values
+// one by one and that reading it back gives the original values.
+template <class T>
+static void
+TestArrayRW(const std::vector<T>& values,
+            void (wxDataOutputStream::*pfnWriter)(const T *buffer, size_t size),
+            void (wxDataInputStream::*pfnReader)(T *buffer, size_t size),
+            bool bigEndian,
+            bool basicPrecisions)
+{
+    wxMemoryOutputStream moScalar;
+    {
+        wxDataOutputStream dos(moScalar);
+        dos.BigEndianOrdered(bigEndian);
+        if ( basicPrecisions )
+            dos.UseBasicPrecisions();
+
+        for ( size_t n = 0; n < values.size(); n++ )
+            dos << values[n];
+    }
+
+    wxMemoryOutputStream moArray;
+    {
+        wxDataOutputStream dos(moArray);
+        dos.BigEndianOrdered(bigEndian);
+        if ( basicPrecisions )
+            dos.UseBasicPrecisions();
+
+        (dos.*pfnWriter)(&values[0], values.size());
+    }
+
+    const wxStreamBuffer * const bufScalar = moScalar.GetOutputStreamBuffer();
+    const wxStreamBuffer * const bufArray = moArray.GetOutputStreamBuffer();
+    REQUIRE( bufArray->GetIntPosition() == bufScalar->GetIntPosition() );
+    CHECK( memcmp(bufArray->GetBufferStart(), bufScalar->GetBufferStart(),
+                  bufArray->GetIntPosition()) == 0 );
+
+    wxMemoryInputStream mi(moArray);
+    wxDataInputStream dis(mi);
+    dis.BigEndianOrdered(bigEndian);
+    if ( basicPrecisions )
+        dis.UseBasicPrecisions();
+
+    std::vector<T> valuesIn(values.size());
+    (dis.*pfnReader)(&valuesIn[0], valuesIn.size());
+    CHECK( valuesIn == values );
+}
+
+template <class T>
+static void
+TestArrayRW(const std::vector<T>& values,
+            void (wxDataOutputStream::*pfnWriter)(const T *buffer, size_t size),
+            void (wxDataInputStream::*pfnReader)(T *buffer, size_t size))
+{
+    for ( int bigEndian = 0; bigEndian < 2; bigEndian++ )
+    {
+        for ( int basic = 0; basic < 2; basic++ )
+        {
+            INFO( "Big endian: " << bigEndian << ", basic: " << basic );
+            TestArrayRW(values, pfnWriter, pfnReader, bigEndian != 0, basic != 0);
+        }
+    }
+}
+
+TEST_CASE("wxDataStream::Arrays", "[stream][datastream]")
+{
+    // Use enough values to need more than one chunk internally.
+    const size_t count = 10000;
+
+    std::vector<wxUint16> values16;
+    std::vector<wxUint32> values32;
+    std::vector<float> valuesFloat;
+    std::vector<double> valuesDouble;
+    for ( size_t n = 0; n < count; n++ )
+    {
+        values16.push_back(static_cast<wxUint16>(n * 13));
+        values32.push_back(static_cast<wxUint32>(n * 0x01020304));
+        valuesFloat.push_back(n / 3.0f);
+        valuesDouble.push_back(n * 1234.5678 - 1e6);
+    }
+
+    SECTION("16") { TestArrayRW(values16, &wxDataOutputStream::Write16, &wxDataInputStream::Read16); }
+    SECTION("32") { TestArrayRW(values32, &wxDataOutputStream::Write32, &wxDataInputStream::Read32); }
+    SECTION("float") { TestArrayRW(valuesFloat, &wxDataOutputStream::WriteFloat, &wxDataInputStream::ReadFloat); }
+    SECTION("double") { TestArrayRW(valuesDouble, &wxDataOutputStream::WriteDouble, &wxDataInputStream::ReadDouble); }
+
+#if wxHAS_INT64
+    SECTION("64")
+    {
+        std::vector<wxUint64> values64;
+        for ( size_t n = 0; n < count; n++ )
+            values64.push_back((wxUint64(n) << 40) + n * 0x01020304);
+
+        TestArrayRW(values64, &wxDataOutputStream::Write64, &wxDataInputStream::Read64);
+    }
+#endif // wxHAS_INT64
+}
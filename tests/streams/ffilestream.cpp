@@ -50,6 +50,7 @@ public:
         CPPUNIT_TEST(Input_TellI);
         CPPUNIT_TEST(Input_Peek);
         CPPUNIT_TEST(Input_Ungetch);
+        CPPUNIT_TEST(Input_PeekBuffer);
 
         CPPUNIT_TEST(Output_PutC);
         CPPUNIT_TEST(Output_Write);
@@ -22,6 +22,7 @@
 #include "wx/wfstream.h"
 
 #include "bstream.h"
+#include "testfile.h"
 
 #define DATABUFFER_SIZE     1024
 
@@ -50,6 +51,7 @@ public:
         CPPUNIT_TEST(Input_TellI);
         CPPUNIT_TEST(Input_Peek);
         CPPUNIT_TEST(Input_Ungetch);
+        CPPUNIT_TEST(Input_PeekBuffer);
 
         CPPUNIT_TEST(Output_PutC);
         CPPUNIT_TEST(Output_Write);
@@ -147,3 +149,48 @@ wxString fileStream::GetInFileName() const
 // Register the stream sub suite, by using some stream helper macro.
 // Note: Don't forget to connect it to the base suite (See: bstream.cpp => StreamCase::suite())
 STREAM_TEST_SUBSUITE_NAMED_REGISTRATION(fileStream)
+
+#if wxUSE_THREADS
+
+TEST_CASE("wxBufferedInputStream::ReadAhead::File", "[stream][buffered]")
+{
+    static const size_t SIZE = 200000;
+
+    wxCharBuffer data(SIZE);
+    for ( size_t n = 0; n < SIZE; n++ )
+        data.data()[n] = static_cast<char>(n % 251);
+
+    TempFile tmp("readahead.test");
+    {
+        wxFileOutputStream out(tmp.GetName());
+        REQUIRE( out.Write(data.data(), SIZE).LastWrite() == SIZE );
+    }
+
+    wxFileInputStream stream(tmp.GetName());
+    REQUIRE( stream.IsOk() );
+
+    wxBufferedInputStream buffered(stream, 1000);
+    REQUIRE( buffered.EnableReadAhead() );
+
+    // GetLength() and IsSeekable() use the file while it may be being read
+    // in background, this must not change the position in it
+    char buf[300];
+    size_t total = 0;
+    for ( ;; )
+    {
+        CHECK( buffered.GetLength() == wxFileOffset(SIZE) );
+        CHECK( buffered.IsSeekable() );
+
+        const size_t len = buffered.Read(buf, sizeof(buf)).LastRead();
+        if ( !len )
+            break;
+
+        REQUIRE( total + len <= SIZE );
+        REQUIRE( memcmp(buf, data.data() + total, len) == 0 );
+        total += len;
+    }
+
+    CHECK( total == SIZE );
+}
+
+#endif // wxUSE_THREADS
@@ -17,6 +17,7 @@
 
 #include "wx/mstream.h"
 #include "wx/lzmastream.h"
+#include "wx/scopedptr.h"
 
 #include "bstream.h"
 
@@ -87,4 +88,118 @@ wxLZMAOutputStream *LZMAStream::DoCreateOutStream()
     return new wxLZMAOutputStream(new wxMemoryOutputStream());
 }
 
+namespace
+{
+
+// Return some data which is big enough to be split into several blocks.
+const wxMemoryBuffer& GetMultithreadedTestData()
+{
+    static wxMemoryBuffer s_data;
+    if ( s_data.IsEmpty() )
+    {
+        wxMemoryOutputStream mo;
+        for ( int n = 0; n < 100000; n++ )
+        {
+            const wxString line = wxString::Format("Line %d: %d\n", n, n % 37);
+            mo.Write(line.utf8_str(), line.length());
+        }
+
+        const size_t len = mo.GetLength();
+        mo.CopyTo(s_data.GetWriteBuf(len), len);
+        s_data.UngetWriteBuf(len);
+    }
+
+    return s_data;
+}
+
+// Check that the data compressed by the given stream can be decompressed.
+bool CheckLZMARoundTrip(const wxMemoryOutputStream& compressed,
+                        const wxMemoryBuffer& data)
+{
+    wxMemoryInputStream mi(compressed);
+    wxLZMAInputStream in(mi);
+
+    wxMemoryOutputStream out;
+    out.Write(in);
+    if ( !in.Eof() ||
+            out.GetLength() != static_cast<wxFileOffset>(data.GetDataLen()) )
+        return false;
+
+    wxCharBuffer buf(data.GetDataLen());
+    out.CopyTo(buf.data(), buf.length());
+    return memcmp(buf.data(), data.GetData(), data.GetDataLen()) == 0;
+}
+
+} // anonymous namespace
+
+TEST_CASE("wxLZMAOutputStream::Threads", "[stream][lzma]")
+{
+    const wxMemoryBuffer& data = GetMultithreadedTestData();
+
+    SECTION("Default")
+    {
+        wxMemoryOutputStream mo;
+        wxLZMAOutputStream out(mo, -1, 0);
+        CHECK( out.Write(data.GetData(), data.GetDataLen()).IsOk() );
+        REQUIRE( out.Close() );
+
+        CHECK( CheckLZMARoundTrip(mo, data) );
+    }
+
+    SECTION("Blocks")
+    {
+        // Use small blocks to have many of them.
+        wxMemoryOutputStream mo;
+        wxLZMAOutputStream out(mo, 1, 4, 64*1024);
+        CHECK( out.Write(data.GetData(), data.GetDataLen()).IsOk() );
+        REQUIRE( out.Close() );
+
+        CHECK( CheckLZMARoundTrip(mo, data) );
+    }
+
+    SECTION("Sync")
+    {
+        const size_t half = data.GetDataLen() / 2;
+        const char* const p = static_cast<const char*>(data.GetData());
+
+        wxMemoryOutputStream mo;
+        wxLZMAOutputStream out(mo, -1, 2);
+        CHECK( out.Write(p, half).IsOk() );
+        out.Sync();
+        CHECK( out.IsOk() );
+        CHECK( out.Write(p + half, data.GetDataLen() - half).IsOk() );
+        REQUIRE( out.Close() );
+
+        CHECK( CheckLZMARoundTrip(mo, data) );
+    }
+
+    SECTION("Empty")
+    {
+        wxMemoryOutputStream mo;
+        wxLZMAOutputStream out(mo, -1, 2);
+        REQUIRE( out.Close() );
+
+        CHECK( CheckLZMARoundTrip(mo, wxMemoryBuffer()) );
+    }
+
+    SECTION("Factory")
+    {
+        wxLZMAClassFactory factory;
+        CHECK( factory.GetThreads() == 1 );
+
+        factory.SetThreads(2, 128*1024);
+        CHECK( factory.GetThreads() == 2 );
+        CHECK( factory.GetBlockSize() == 128*1024 );
+
+        wxMemoryOutputStream mo;
+        {
+            wxScopedPtr<wxFilterOutputStream> out(factory.NewStream(mo));
+            CHECK( out->Write(data.GetData(), data.GetDataLen()).IsOk() );
+            REQUIRE( out->Close() );
+        }
+
+        CHECK( CheckLZMARoundTrip(mo, data) );
+    }
+}
+
 #endif // wxUSE_LIBLZMA && wxUSE_STREAMS
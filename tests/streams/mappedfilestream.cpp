@@ -0,0 +1,229 @@
+///////////////////////////////////////////////////////////////////////////////
+// Name:        tests/streams/mappedfilestream.cpp
+// Purpose:     Test wxMappedFileInputStream and wxFileMapping
+// Author:      wxWidgets development team
+// Created:     2026-10-19
+// Copyright:   (c) 2026 wxWidgets development team
+// Licence:     wxWindows licence
+///////////////////////////////////////////////////////////////////////////////
+
+// For compilers that support precompilation, includes "wx/wx.h".
+// and "wx/cppunit.h"
+#include "testprec.h"
+
+#ifdef __BORLANDC__
+    #pragma hdrstop
+#endif
+
+// for all others, include the necessary headers
+#ifndef WX_PRECOMP
+    #include "wx/wx.h"
+#endif
+
+#include "wx/wfstream.h"
+#include "wx/filemapping.h"
+
+#include "bstream.h"
+
+#define DATABUFFER_SIZE     1024
+
+static const wxString FILENAME_MAPPEDINSTREAM = wxT("mappedinstream.test");
+static const wxString FILENAME_MAPPEDOUTSTREAM = wxT("mappedoutstream.test");
+
+///////////////////////////////////////////////////////////////////////////////
+// The test case
+//
+// Test wxMappedFileInputStream, it doesn't have any corresponding output
+// stream, so just use wxFileOutputStream for the output part of the tests.
+
+class mappedFileStream : public BaseStreamTestCase<wxMappedFileInputStream, wxFileOutputStream>
+{
+public:
+    mappedFileStream();
+
+    CPPUNIT_TEST_SUITE(mappedFileStream);
+        // Base class stream tests the mappedFileStream supports.
+        CPPUNIT_TEST(Input_GetSize);
+        CPPUNIT_TEST(Input_GetC);
+        CPPUNIT_TEST(Input_Read);
+        CPPUNIT_TEST(Input_Eof);
+        CPPUNIT_TEST(Input_LastRead);
+        CPPUNIT_TEST(Input_CanRead);
+        CPPUNIT_TEST(Input_SeekI);
+        CPPUNIT_TEST(Input_TellI);
+        CPPUNIT_TEST(Input_Peek);
+        CPPUNIT_TEST(Input_Ungetch);
+        CPPUNIT_TEST(Input_PeekBuffer);
+
+        // Other test specific for mapped file stream test case.
+        CPPUNIT_TEST(GetData);
+        CPPUNIT_TEST(NonExistent);
+        CPPUNIT_TEST(Empty);
+        CPPUNIT_TEST(ReadWriteMapping);
+    CPPUNIT_TEST_SUITE_END();
+
+protected:
+    void GetData();
+    void NonExistent();
+    void Empty();
+    void ReadWriteMapping();
+
+private:
+    // Implement base class functions.
+    virtual wxMappedFileInputStream *DoCreateInStream() wxOVERRIDE;
+    virtual wxFileOutputStream *DoCreateOutStream() wxOVERRIDE;
+    virtual void DoDeleteOutStream() wxOVERRIDE;
+
+private:
+    wxString GetInFileName() const;
+};
+
+mappedFileStream::mappedFileStream()
+{
+    m_bEofAtLastRead = false;
+}
+
+wxMappedFileInputStream *mappedFileStream::DoCreateInStream()
+{
+    wxMappedFileInputStream *pInStream = new wxMappedFileInputStream(GetInFileName());
+    CPPUNIT_ASSERT(pInStream->IsOk());
+    return pInStream;
+}
+wxFileOutputStream *mappedFileStream::DoCreateOutStream()
+{
+    wxFileOutputStream *pFileOutStream = new wxFileOutputStream(FILENAME_MAPPEDOUTSTREAM);
+    CPPUNIT_ASSERT(pFileOutStream->IsOk());
+    return pFileOutStream;
+}
+
+void mappedFileStream::DoDeleteOutStream()
+{
+    ::wxRemoveFile(FILENAME_MAPPEDOUTSTREAM);
+}
+
+wxString mappedFileStream::GetInFileName() const
+{
+    class AutoRemoveFile
+    {
+    public:
+        AutoRemoveFile()
+        {
+            m_created = false;
+        }
+
+        ~AutoRemoveFile()
+        {
+            if ( m_created )
+                wxRemoveFile(FILENAME_MAPPEDINSTREAM);
+        }
+
+        bool ShouldCreate()
+        {
+            if ( m_created )
+                return false;
+
+            m_created = true;
+
+            return true;
+        }
+
+    private:
+        bool m_created;
+    };
+
+    static AutoRemoveFile autoFile;
+    if ( autoFile.ShouldCreate() )
+    {
+        // Make sure we have a input file...
+        char buf[DATABUFFER_SIZE];
+        wxFileOutputStream out(FILENAME_MAPPEDINSTREAM);
+
+        // Init the data buffer.
+        for (size_t i = 0; i < DATABUFFER_SIZE; i++)
+            buf[i] = (i % 0xFF);
+
+        // Save the data
+        out.Write(buf, DATABUFFER_SIZE);
+    }
+
+    return FILENAME_MAPPEDINSTREAM;
+}
+
+void mappedFileStream::GetData()
+{
+    wxMappedFileInputStream stream(GetInFileName());
+    CPPUNIT_ASSERT( stream.IsOk() );
+    CPPUNIT_ASSERT_EQUAL( DATABUFFER_SIZE, stream.GetSize() );
+
+    const unsigned char* const
+        data = static_cast<const unsigned char*>(stream.GetData());
+    CPPUNIT_ASSERT( data );
+    CPPUNIT_ASSERT_EQUAL( 0, data[0] );
+    CPPUNIT_ASSERT_EQUAL( 0xFF % 0xFF, data[0xFF] );
+    CPPUNIT_ASSERT_EQUAL( (DATABUFFER_SIZE - 1) % 0xFF, data[DATABUFFER_SIZE - 1] );
+
+    // Reading from the stream must return the same data.
+    CPPUNIT_ASSERT_EQUAL( 100, stream.SeekI(100) );
+    CPPUNIT_ASSERT_EQUAL( data[100], stream.GetC() );
+}
+
+void mappedFileStream::NonExistent()
+{
+    wxLogNull noLog;
+
+    wxMappedFileInputStream stream("no-such-file.test");
+    CPPUNIT_ASSERT( !stream.IsOk() );
+}
+
+void mappedFileStream::Empty()
+{
+    const wxString filename("mappedempty.test");
+    {
+        wxFileOutputStream out(filename);
+        CPPUNIT_ASSERT( out.IsOk() );
+    }
+
+    {
+        wxMappedFileInputStream stream(filename);
+        CPPUNIT_ASSERT( stream.IsOk() );
+        CPPUNIT_ASSERT_EQUAL( 0, stream.GetLength() );
+        CPPUNIT_ASSERT( !stream.GetData() );
+
+        CPPUNIT_ASSERT_EQUAL( wxEOF, stream.GetC() );
+        CPPUNIT_ASSERT( stream.Eof() );
+    }
+
+    wxRemoveFile(filename);
+}
+
+void mappedFileStream::ReadWriteMapping()
+{
+    const wxString filename("mappedrw.test");
+    {
+        wxFileOutputStream out(filename);
+        CPPUNIT_ASSERT( out.Write("Hello, world", 12).IsOk() );
+    }
+
+    {
+        wxFileMapping mapping(filename, wxFileMapping::ReadWrite);
+        CPPUNIT_ASSERT( mapping.IsOk() );
+        CPPUNIT_ASSERT_EQUAL( 12, mapping.GetSize() );
+
+        char* const p = static_cast<char*>(mapping.GetWritableData());
+        CPPUNIT_ASSERT( p );
+        p[0] = 'J';
+        CPPUNIT_ASSERT( mapping.Flush() );
+    }
+
+    wxFileMapping mapping(filename);
+    CPPUNIT_ASSERT( mapping.IsOk() );
+    CPPUNIT_ASSERT_EQUAL( 0, memcmp(mapping.GetData(), "Jello, world", 12) );
+
+    mapping.Close();
+    CPPUNIT_ASSERT( !mapping.IsOk() );
+
+    wxRemoveFile(filename);
+}
+
+// Register the stream sub suite, by using some stream helper macro.
+STREAM_TEST_SUBSUITE_NAMED_REGISTRATION(mappedFileStream)
@@ -48,6 +48,7 @@ public:
         CPPUNIT_TEST(Input_TellI);
         CPPUNIT_TEST(Input_Peek);
         CPPUNIT_TEST(Input_Ungetch);
+        CPPUNIT_TEST(Input_PeekBuffer);
 
         CPPUNIT_TEST(Output_PutC);
         CPPUNIT_TEST(Output_Write);
@@ -58,12 +59,16 @@ public:
         // Other test specific for Memory stream test case.
         CPPUNIT_TEST(Ctor_InFromIn);
         CPPUNIT_TEST(Ctor_InFromOut);
+        CPPUNIT_TEST(PeekBufferZeroCopy);
+        CPPUNIT_TEST(BufferedPeekBuffer);
     CPPUNIT_TEST_SUITE_END();
 
 protected:
     // Add own test here.
     void Ctor_InFromIn();
     void Ctor_InFromOut();
+    void PeekBufferZeroCopy();
+    void BufferedPeekBuffer();
 
 private:
     const char *GetDataBuffer();
@@ -156,6 +161,148 @@ void memStream::Ctor_InFromOut()
     delete pMemOutStream;
 }
 
+void memStream::PeekBufferZeroCopy()
+{
+    wxMemoryInputStream stream(GetDataBuffer(), DATABUFFER_SIZE);
+
+    // The data must be returned directly, without copying it.
+    size_t size;
+    CPPUNIT_ASSERT( stream.PeekBuffer(&size) == GetDataBuffer() );
+    CPPUNIT_ASSERT_EQUAL( DATABUFFER_SIZE, size );
+
+    stream.ConsumeBuffer(10);
+    CPPUNIT_ASSERT_EQUAL( 10, stream.TellI() );
+    CPPUNIT_ASSERT( stream.PeekBuffer(&size) == GetDataBuffer() + 10 );
+    CPPUNIT_ASSERT_EQUAL( DATABUFFER_SIZE - 10, size );
+
+    // And the data can still be read in the usual way after it.
+    CPPUNIT_ASSERT_EQUAL( GetDataBuffer()[10], (char)stream.GetC() );
+}
+
+void memStream::BufferedPeekBuffer()
+{
+    wxMemoryInputStream stream(GetDataBuffer(), DATABUFFER_SIZE);
+    wxBufferedInputStream buffered(stream, 100);
+
+    // The data is returned directly from the stream buffer, so no more than
+    // its size can be returned at once.
+    size_t size;
+    const char* data = static_cast<const char*>(buffered.PeekBuffer(&size));
+    CPPUNIT_ASSERT( data );
+    CPPUNIT_ASSERT_EQUAL( 100, size );
+    CPPUNIT_ASSERT( memcmp(data, GetDataBuffer(), size) == 0 );
+    CPPUNIT_ASSERT( data ==
+                    buffered.GetInputStreamBuffer()->GetBufferStart() );
+
+    buffered.ConsumeBuffer(size);
+    CPPUNIT_ASSERT_EQUAL( 100, buffered.TellI() );
+
+    // Mixing Read() and PeekBuffer() must work too.
+    char buf[50];
+    CPPUNIT_ASSERT_EQUAL( 50, buffered.Read(buf, sizeof(buf)).LastRead() );
+    CPPUNIT_ASSERT( memcmp(buf, GetDataBuffer() + 100, sizeof(buf)) == 0 );
+
+    data = static_cast<const char*>(buffered.PeekBuffer(&size));
+    CPPUNIT_ASSERT( data );
+    CPPUNIT_ASSERT_EQUAL( 50, size );
+    CPPUNIT_ASSERT( memcmp(data, GetDataBuffer() + 150, size) == 0 );
+    buffered.ConsumeBuffer(size);
+
+    // Read the rest of the stream by copying it to an output stream.
+    wxMemoryOutputStream out;
+    buffered >> out;
+    CPPUNIT_ASSERT_EQUAL( DATABUFFER_SIZE - 200, buffered.LastRead() );
+    CPPUNIT_ASSERT( buffered.Eof() );
+    CPPUNIT_ASSERT( !buffered.PeekBuffer(&size) );
+    CPPUNIT_ASSERT_EQUAL( 0, size );
+}
+
 // Register the stream sub suite, by using some stream helper macro.
 // Note: Don't forget to connect it to the base suite (See: bstream.cpp => StreamCase::suite())
 STREAM_TEST_SUBSUITE_NAMED_REGISTRATION(memStream)
+
+TEST_CASE("wxBufferedInputStream::ReadAhead", "[stream][buffered]")
+{
+    wxCharBuffer data(100000);
+    for ( size_t n = 0; n < data.length(); n++ )
+        data.data()[n] = static_cast<char>(n % 251);
+
+    wxMemoryInputStream stream(data.data(), data.length());
+
+    SECTION("Read")
+    {
+        wxBufferedInputStream buffered(stream, 1000);
+        REQUIRE( buffered.EnableReadAhead() );
+        CHECK( buffered.IsReadAheadEnabled() );
+
+        wxMemoryOutputStream out;
+        buffered >> out;
+        CHECK( buffered.Eof() );
+        REQUIRE( out.GetLength() == wxFileOffset(data.length()) );
+
+        wxCharBuffer buf(data.length());
+        out.CopyTo(buf.data(), buf.length());
+        CHECK( memcmp(buf.data(), data.data(), data.length()) == 0 );
+    }
+
+    SECTION("PeekBuffer")
+    {
+        wxBufferedInputStream buffered(stream, 1000);
+        REQUIRE( buffered.EnableReadAhead() );
+
+        size_t total = 0,
+               size;
+        while ( const void* p = buffered.PeekBuffer(&size) )
+        {
+            REQUIRE( memcmp(p, data.data() + total, size) == 0 );
+            total += size;
+            buffered.ConsumeBuffer(size);
+        }
+
+        CHECK( total == data.length() );
+    }
+
+    SECTION("Seek")
+    {
+        wxBufferedInputStream buffered(stream, 1000);
+        REQUIRE( buffered.EnableReadAhead() );
+
+        char buf[300];
+        REQUIRE( buffered.Read(buf, sizeof(buf)).LastRead() == sizeof(buf) );
+        CHECK( buffered.TellI() == 300 );
+
+        CHECK( buffered.SeekI(5000) == 5000 );
+        CHECK( buffered.TellI() == 5000 );
+        REQUIRE( buffered.Read(buf, sizeof(buf)).LastRead() == sizeof(buf) );
+        CHECK( memcmp(buf, data.data() + 5000, sizeof(buf)) == 0 );
+
+        CHECK( buffered.SeekI(2000, wxFromCurrent) == 7300 );
+        REQUIRE( buffered.Read(buf, sizeof(buf)).LastRead() == sizeof(buf) );
+        CHECK( memcmp(buf, data.data() + 7300, sizeof(buf)) == 0 );
+        CHECK( buffered.TellI() == 7600 );
+    }
+
+    SECTION("Disable")
+    {
+        char buf[1500];
+        {
+            wxBufferedInputStream buffered(stream, 1000);
+            REQUIRE( buffered.EnableReadAhead() );
+            REQUIRE( buffered.Read(buf, sizeof(buf)).LastRead() == sizeof(buf) );
+
+            CHECK( buffered.EnableReadAhead(false) );
+            CHECK( !buffered.IsReadAheadEnabled() );
+            REQUIRE( buffered.Read(buf, sizeof(buf)).LastRead() == sizeof(buf) );
+            CHECK( memcmp(buf, data.data() + 1500, sizeof(buf)) == 0 );
+
+            REQUIRE( buffered.EnableReadAhead() );
+            REQUIRE( buffered.Read(buf, 100).LastRead() == 100 );
+        }
+
+        // The data read in background but not consumed must be given back to
+        // the underlying stream when the buffered one is destroyed.
+        CHECK( stream.TellI() == 3100 );
+        REQUIRE( stream.Read(buf, sizeof(buf)).LastRead() == sizeof(buf) );
+        CHECK( memcmp(buf, data.data() + 3100, sizeof(buf)) == 0 );
+    }
+}
@@ -326,4 +326,77 @@ TEST_CASE("wxTextInputStream::GetChar", "[text][input][stream][char]")
     }
 }
 
+
+TEST_CASE("wxTextInputStream::ReadLine", "[text][input][stream][line]")
+{
+    SECTION("separators")
+    {
+        const char buf[] = "foo\nbar\r\nbaz\rqux\n\nlast";
+        wxMemoryInputStream mis(buf, sizeof(buf) - 1);
+        wxTextInputStream tis(mis);
+
+        CHECK( tis.ReadLine() == "foo" );
+        CHECK( tis.ReadLine() == "bar" );
+        CHECK( tis.ReadLine() == "baz" );
+        CHECK( tis.ReadLine() == "qux" );
+        CHECK( tis.ReadLine() == "" );
+        CHECK( tis.ReadLine() == "last" );
+        CHECK( mis.Eof() );
+        CHECK( tis.ReadLine() == "" );
+    }
+
+    SECTION("mixed-with-GetChar")
+    {
+        const char buf[] = "first\nsecond\nthird\n";
+        wxMemoryInputStream mis(buf, sizeof(buf) - 1);
+        wxTextInputStream tis(mis);
+
+        CHECK( tis.ReadLine() == "first" );
+        CHECK( tis.GetChar() == 's' );
+        CHECK( tis.ReadLine() == "econd" );
+        CHECK( tis.ReadLine() == "third" );
+    }
+
+    SECTION("embedded-NUL")
+    {
+        const char buf[] = "one\ntw\0o\n";
+        wxMemoryInputStream mis(buf, sizeof(buf) - 1);
+        wxTextInputStream tis(mis);
+
+        CHECK( tis.ReadLine() == "one" );
+        CHECK( tis.ReadLine() == "tw" );
+        CHECK( mis.GetLastError() == wxSTREAM_READ_ERROR );
+    }
+
+    // Use a file stream here as it returns the data in fixed size chunks, so
+    // the long lines written here span several of them and the multibyte
+    // characters and "\r\n" are split between them.
+    SECTION("long-lines")
+    {
+        const wxString
+            longLine = wxString('x', 4089) + wxString::FromUTF8("\xc3\xa9") +
+                       wxString('y', 4094);
+
+        TempFile f("readline.txt");
+        {
+            wxFileOutputStream fos(f.GetName());
+            const wxScopedCharBuffer utf8 = longLine.utf8_str();
+            fos.Write("first\n", 6);
+            fos.Write(utf8.data(), utf8.length());
+            fos.Write("\r\n", 2);
+            fos.Write("\r", 1);
+            fos.Write(utf8.data(), utf8.length());
+        }
+
+        wxFileInputStream fis(f.GetName());
+        wxTextInputStream tis(fis, wxS(" \t"), wxConvUTF8);
+
+        CHECK( tis.ReadLine() == "first" );
+        CHECK( tis.ReadLine() == longLine );
+        CHECK( tis.ReadLine() == "" );
+        CHECK( tis.ReadLine() == longLine );
+        CHECK( fis.Eof() );
+    }
+}
+
 #endif // wxUSE_UNICODE
@@ -551,3 +551,108 @@ void zlibStream::genExtTestData(wxTextOutputStream &out, const char *buf, int fl
 // Note: Don't forget to connect it to the base suite (See: bstream.cpp => StreamCase::suite())
 STREAM_TEST_SUBSUITE_NAMED_REGISTRATION(zlibStream)
 
+
+// Parallel compression only makes a difference for inputs bigger than the
+// block size used internally, so test it separately with bigger data.
+static wxMemoryBuffer GetParallelTestData()
+{
+    wxMemoryBuffer buf;
+
+    // Generate compressible, but not trivially so, data.
+    wxUint32 seed = 1;
+    for ( size_t n = 0; n < 1000000; n++ )
+    {
+        seed = seed * 1103515245 + 12345;
+        buf.AppendByte(static_cast<char>('a' + (seed >> 16) % 16));
+    }
+
+    return buf;
+}
+
+static bool
+DoTestParallel(const wxMemoryBuffer& data, int flags, int level,
+               const wxMemoryBuffer *dict = NULL, bool sync = false)
+{
+    wxMemoryOutputStream mo;
+    {
+        wxZlibOutputStream zout(mo, level, flags | wxZLIB_PARALLEL);
+        REQUIRE( zout.IsOk() );
+
+        if ( dict )
+            CHECK( zout.SetDictionary(*dict) );
+
+        const char* const p = static_cast<const char*>(data.GetData());
+        const size_t half = data.GetDataLen() / 2;
+        CHECK( zout.Write(p, half).LastWrite() == half );
+
+        if ( sync )
+            zout.Sync();
+
+        const size_t rest = data.GetDataLen() - half;
+        CHECK( zout.Write(p + half, rest).LastWrite() == rest );
+
+        CHECK( zout.Close() );
+    }
+
+    wxMemoryInputStream mi(mo);
+    wxZlibInputStream zin(mi, flags == wxZLIB_NO_HEADER ? wxZLIB_NO_HEADER
+                                                        : wxZLIB_AUTO);
+    if ( dict )
+        zin.SetDictionary(*dict);
+
+    wxMemoryOutputStream out;
+    out.Write(zin);
+    CHECK( zin.Eof() );
+
+    const size_t len = out.GetLength();
+    if ( len != data.GetDataLen() )
+        return false;
+
+    wxCharBuffer result(len);
+    out.CopyTo(result.data(), len);
+
+    return memcmp(result.data(), data.GetData(), len) == 0;
+}
+
+TEST_CASE("wxZlibOutputStream::Parallel", "[stream][zlib]")
+{
+    const wxMemoryBuffer data = GetParallelTestData();
+
+    SECTION("ZLib")
+    {
+        CHECK( DoTestParallel(data, wxZLIB_ZLIB, wxZ_DEFAULT_COMPRESSION) );
+        CHECK( DoTestParallel(data, wxZLIB_ZLIB, wxZ_NO_COMPRESSION) );
+        CHECK( DoTestParallel(data, wxZLIB_ZLIB, wxZ_BEST_COMPRESSION) );
+    }
+
+    SECTION("GZip")
+    {
+        CHECK( DoTestParallel(data, wxZLIB_GZIP, wxZ_DEFAULT_COMPRESSION) );
+        CHECK( DoTestParallel(data, wxZLIB_GZIP, wxZ_BEST_SPEED) );
+    }
+
+    SECTION("NoHeader")
+    {
+        CHECK( DoTestParallel(data, wxZLIB_NO_HEADER, wxZ_DEFAULT_COMPRESSION) );
+    }
+
+    SECTION("Sync")
+    {
+        CHECK( DoTestParallel(data, wxZLIB_ZLIB, wxZ_DEFAULT_COMPRESSION, NULL, true) );
+        CHECK( DoTestParallel(data, wxZLIB_GZIP, wxZ_DEFAULT_COMPRESSION, NULL, true) );
+    }
+
+    SECTION("Dictionary")
+    {
+        wxMemoryBuffer dict;
+        dict.AppendData(data.GetData(), 1000);
+        CHECK( DoTestParallel(data, wxZLIB_NO_HEADER, wxZ_DEFAULT_COMPRESSION, &dict) );
+    }
+
+    SECTION("Empty")
+    {
+        const wxMemoryBuffer empty;
+        CHECK( DoTestParallel(empty, wxZLIB_ZLIB, wxZ_DEFAULT_COMPRESSION) );
+        CHECK( DoTestParallel(empty, wxZLIB_GZIP, wxZ_DEFAULT_COMPRESSION) );
+    }
+}
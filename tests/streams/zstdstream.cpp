@@ -0,0 +1,267 @@
+///////////////////////////////////////////////////////////////////////////////
+// Name:        tests/streams/zstdstream.cpp
+// Purpose:     Unit tests for Zstandard stream classes
+// Author:      wxWidgets development team
+// Created:     2026-10-19
+// Copyright:   (c) 2026 wxWidgets development team
+// Licence:     wxWindows licence
+///////////////////////////////////////////////////////////////////////////////
+
+#include "testprec.h"
+
+#ifdef __BORLANDC__
+    #pragma hdrstop
+#endif
+
+#if wxUSE_LIBZSTD && wxUSE_STREAMS
+
+#include "wx/mstream.h"
+#include "wx/zstdstream.h"
+#include "wx/scopedptr.h"
+#include "wx/log.h"
+
+#include "bstream.h"
+
+class ZstdStream : public BaseStreamTestCase<wxZstdInputStream, wxZstdOutputStream>
+{
+public:
+    ZstdStream();
+
+    CPPUNIT_TEST_SUITE(ZstdStream);
+        // Base class stream tests.
+        CPPUNIT_TEST(Input_GetSizeFail);
+        CPPUNIT_TEST(Input_GetC);
+        CPPUNIT_TEST(Input_Read);
+        CPPUNIT_TEST(Input_Eof);
+        CPPUNIT_TEST(Input_LastRead);
+        CPPUNIT_TEST(Input_CanRead);
+        CPPUNIT_TEST(Input_SeekIFail);
+        CPPUNIT_TEST(Input_TellI);
+        CPPUNIT_TEST(Input_Peek);
+        CPPUNIT_TEST(Input_Ungetch);
+
+        CPPUNIT_TEST(Output_PutC);
+        CPPUNIT_TEST(Output_Write);
+        CPPUNIT_TEST(Output_LastWrite);
+        CPPUNIT_TEST(Output_SeekOFail);
+        CPPUNIT_TEST(Output_TellO);
+    CPPUNIT_TEST_SUITE_END();
+
+protected:
+    wxZstdInputStream *DoCreateInStream() wxOVERRIDE;
+    wxZstdOutputStream *DoCreateOutStream() wxOVERRIDE;
+
+private:
+    wxDECLARE_NO_COPY_CLASS(ZstdStream);
+};
+
+STREAM_TEST_SUBSUITE_NAMED_REGISTRATION(ZstdStream)
+
+ZstdStream::ZstdStream()
+{
+    // Disable TellI() and TellO() tests in the base class which don't work
+    // with the compressed streams.
+    m_bSimpleTellITest =
+    m_bSimpleTellOTest = true;
+}
+
+wxZstdInputStream *ZstdStream::DoCreateInStream()
+{
+    // Compress some data.
+    const char data[] = "This is just some test data for Zstandard streams unit test";
+    const size_t len = sizeof(data);
+
+    wxMemoryOutputStream outmem;
+    wxZstdOutputStream outz(outmem);
+    outz.Write(data, len);
+    REQUIRE( outz.LastWrite() == len );
+    REQUIRE( outz.Close() );
+
+    wxMemoryInputStream* const inmem = new wxMemoryInputStream(outmem);
+    REQUIRE( inmem->IsOk() );
+
+    // Give ownership of the memory input stream to the Zstandard stream.
+    return new wxZstdInputStream(inmem);
+}
+
+wxZstdOutputStream *ZstdStream::DoCreateOutStream()
+{
+    return new wxZstdOutputStream(new wxMemoryOutputStream());
+}
+
+namespace
+{
+
+// Return some data which is big enough to require several buffers.
+const wxMemoryBuffer& GetZstdTestData()
+{
+    static wxMemoryBuffer s_data;
+    if ( s_data.IsEmpty() )
+    {
+        wxMemoryOutputStream mo;
+        for ( int n = 0; n < 100000; n++ )
+        {
+            const wxString line = wxString::Format("Line %d: %d\n", n, n % 37);
+            mo.Write(line.utf8_str(), line.length());
+        }
+
+        const size_t len = mo.GetLength();
+        mo.CopyTo(s_data.GetWriteBuf(len), len);
+        s_data.UngetWriteBuf(len);
+    }
+
+    return s_data;
+}
+
+// Check that the compressed data can be decompressed.
+bool CheckZstdRoundTrip(const wxMemoryOutputStream& compressed,
+                        const wxMemoryBuffer& data)
+{
+    wxMemoryInputStream mi(compressed);
+    wxZstdInputStream in(mi);
+
+    wxMemoryOutputStream out;
+    out.Write(in);
+    if ( !in.Eof() ||
+            out.GetLength() != static_cast<wxFileOffset>(data.GetDataLen()) )
+        return false;
+
+    wxCharBuffer buf(data.GetDataLen());
+    out.CopyTo(buf.data(), buf.length());
+    return memcmp(buf.data(), data.GetData(), data.GetDataLen()) == 0;
+}
+
+// Compress the test data using the given parameters and check the result.
+bool DoTestZstd(int level, int threads, bool sync = false)
+{
+    const wxMemoryBuffer& data = GetZstdTestData();
+    const char* const p = static_cast<const char*>(data.GetData());
+    const size_t half = data.GetDataLen() / 2;
+
+    wxMemoryOutputStream mo;
+    wxZstdOutputStream out(mo, level, threads);
+    if ( !out.Write(p, half).IsOk() )
+        return false;
+
+    if ( sync )
+    {
+        out.Sync();
+        if ( !out.IsOk() )
+            return false;
+    }
+
+    if ( !out.Write(p + half, data.GetDataLen() - half).IsOk() )
+        return false;
+
+    if ( !out.Close() || out.GetLength() != wxFileOffset(data.GetDataLen()) )
+        return false;
+
+    return CheckZstdRoundTrip(mo, data);
+}
+
+} // anonymous namespace
+
+TEST_CASE("wxZstdStream::RoundTrip", "[stream][zstd]")
+{
+    SECTION("Default")  { CHECK( DoTestZstd(-1, 1) ); }
+    SECTION("Fastest")  { CHECK( DoTestZstd(1, 1) ); }
+    SECTION("Best")     { CHECK( DoTestZstd(wxZstdOutputStream::GetMaxLevel(), 1) ); }
+    SECTION("Threads")  { CHECK( DoTestZstd(-1, 2) ); }
+    SECTION("AllCPUs")  { CHECK( DoTestZstd(-1, 0) ); }
+    SECTION("Sync")     { CHECK( DoTestZstd(-1, 1, true) ); }
+    SECTION("SyncMT")   { CHECK( DoTestZstd(-1, 2, true) ); }
+
+    SECTION("Empty")
+    {
+        wxMemoryOutputStream mo;
+        wxZstdOutputStream out(mo);
+        REQUIRE( out.Close() );
+        CHECK( mo.GetLength() > 0 );
+
+        CHECK( CheckZstdRoundTrip(mo, wxMemoryBuffer()) );
+    }
+
+    SECTION("Concatenated")
+    {
+        const char* const data = "First frame. Second frame.";
+
+        wxMemoryOutputStream mo;
+        {
+            wxZstdOutputStream out(mo);
+            out.Write(data, 13);
+            REQUIRE( out.Close() );
+
+            // Writing after closing starts a new frame.
+            out.Write(data + 13, strlen(data) - 13);
+            REQUIRE( out.Close() );
+        }
+
+        wxMemoryBuffer buf;
+        buf.AppendData(data, strlen(data));
+        CHECK( CheckZstdRoundTrip(mo, buf) );
+    }
+
+    SECTION("Truncated")
+    {
+        const wxMemoryBuffer& data = GetZstdTestData();
+
+        wxMemoryOutputStream mo;
+        {
+            wxZstdOutputStream out(mo);
+            out.Write(data.GetData(), data.GetDataLen());
+            REQUIRE( out.Close() );
+        }
+
+        wxCharBuffer buf(mo.GetLength() / 2);
+        mo.CopyTo(buf.data(), buf.length());
+
+        wxMemoryInputStream mi(buf.data(), buf.length());
+        wxZstdInputStream in(mi);
+
+        wxLogNull noLog;
+        wxMemoryOutputStream out;
+        out.Write(in);
+        CHECK( in.GetLastError() == wxSTREAM_READ_ERROR );
+    }
+
+    SECTION("Invalid")
+    {
+        static const char data[] = "This is not compressed";
+        wxMemoryInputStream mi(data, sizeof(data));
+        wxZstdInputStream in(mi);
+
+        wxLogNull noLog;
+        char buf[64];
+        CHECK( in.Read(buf, sizeof(buf)).LastRead() == 0 );
+        CHECK( in.GetLastError() == wxSTREAM_READ_ERROR );
+    }
+}
+
+TEST_CASE("wxZstdClassFactory", "[stream][zstd]")
+{
+    const wxFilterClassFactory* const
+        found = wxFilterClassFactory::Find(".zst", wxSTREAM_FILEEXT);
+    REQUIRE( found );
+    CHECK( wxDynamicCast(found, wxZstdClassFactory) );
+    CHECK( wxFilterClassFactory::Find("zstd") == found );
+
+    wxZstdClassFactory factory;
+    CHECK( factory.GetLevel() == -1 );
+    CHECK( factory.GetThreads() == 1 );
+
+    factory.SetLevel(5);
+    factory.SetThreads(2);
+
+    const wxMemoryBuffer& data = GetZstdTestData();
+
+    wxMemoryOutputStream mo;
+    {
+        wxScopedPtr<wxFilterOutputStream> out(factory.NewStream(mo));
+        CHECK( out->Write(data.GetData(), data.GetDataLen()).IsOk() );
+        REQUIRE( out->Close() );
+    }
+
+    CHECK( CheckZstdRoundTrip(mo, data) );
+}
+
+#endif // wxUSE_LIBZSTD && wxUSE_STREAMS
@@ -21,6 +21,7 @@
 #endif // WX_PRECOMP
 
 #include "wx/xml/xml.h"
+#include "wx/mstream.h"
 #include "wx/scopedptr.h"
 #include "wx/sstream.h"
 
@@ -613,3 +614,508 @@ void XmlTestCase::Doctype()
     dt = wxXmlDoctype( "root", "O'Reilly (\"editor\")", "Public-ID" );
     CPPUNIT_ASSERT( !dt.IsValid() );
 }
+
+TEST_CASE("wxXmlReader::Read", "[xml][reader]")
+{
+    const char *xmlText =
+"<?xml version='1.0' encoding='utf-8'?>\n"
+"<root a=\"1\" b='two'>\n"
+"  <!-- comment -->\n"
+"  <child>Some <![CDATA[<data>]]> text</child>\n"
+"  <?pi data?>\n"
+"  <empty/>\n"
+"</root>\n"
+;
+
+    wxStringInputStream sis(xmlText);
+    wxXmlReader reader(sis);
+    REQUIRE( reader.IsOpened() );
+    CHECK( reader.GetNodeType() == wxXML_READER_NONE );
+
+    REQUIRE( reader.Read() );
+    CHECK( reader.GetNodeType() == wxXML_READER_START_ELEMENT );
+    CHECK( reader.GetName() == "root" );
+    CHECK( reader.GetDepth() == 0 );
+    CHECK( reader.GetLineNumber() == 2 );
+    REQUIRE( reader.GetAttributeCount() == 2 );
+    CHECK( reader.GetAttributeName(0) == "a" );
+    CHECK( reader.GetAttributeValue(0) == "1" );
+    CHECK( reader.GetAttribute("b") == "two" );
+    CHECK( reader.GetAttribute("c", "default") == "default" );
+    CHECK( !reader.HasAttribute("c") );
+
+    REQUIRE( reader.Read() );
+    CHECK( reader.GetNodeType() == wxXML_READER_COMMENT );
+    CHECK( reader.GetContent() == " comment " );
+
+    REQUIRE( reader.Read() );
+    CHECK( reader.GetNodeType() == wxXML_READER_START_ELEMENT );
+    CHECK( reader.GetName() == "child" );
+    CHECK( reader.GetDepth() == 1 );
+    CHECK( reader.GetAttributeCount() == 0 );
+
+    REQUIRE( reader.Read() );
+    CHECK( reader.GetNodeType() == wxXML_READER_TEXT );
+    CHECK( reader.GetContent() == "Some " );
+    CHECK( reader.GetDepth() == 2 );
+
+    REQUIRE( reader.Read() );
+    CHECK( reader.GetNodeType() == wxXML_READER_CDATA );
+    CHECK( reader.GetContent() == "<data>" );
+
+    REQUIRE( reader.Read() );
+    CHECK( reader.GetNodeType() == wxXML_READER_TEXT );
+    CHECK( reader.GetContent() == " text" );
+
+    REQUIRE( reader.Read() );
+    CHECK( reader.GetNodeType() == wxXML_READER_END_ELEMENT );
+    CHECK( reader.GetName() == "child" );
+    CHECK( reader.GetDepth() == 1 );
+
+    REQUIRE( reader.Read() );
+    CHECK( reader.GetNodeType() == wxXML_READER_PI );
+    CHECK( reader.GetName() == "pi" );
+    CHECK( reader.GetContent() == "data" );
+
+    REQUIRE( reader.Read() );
+    CHECK( reader.GetNodeType() == wxXML_READER_START_ELEMENT );
+    CHECK( reader.GetName() == "empty" );
+
+    REQUIRE( reader.Read() );
+    CHECK( reader.GetNodeType() == wxXML_READER_END_ELEMENT );
+    CHECK( reader.GetName() == "empty" );
+
+    REQUIRE( reader.Read() );
+    CHECK( reader.GetNodeType() == wxXML_READER_END_ELEMENT );
+    CHECK( reader.GetName() == "root" );
+    CHECK( reader.GetDepth() == 0 );
+
+    CHECK( !reader.Read() );
+    CHECK( !reader.HasError() );
+    CHECK( reader.GetNodeType() == wxXML_READER_NONE );
+}
+
+TEST_CASE("wxXmlReader::ReadNode", "[xml][reader]")
+{
+    const char *xmlText =
+"<root>\n"
+"  <item id='1'><name>first</name><value>10</value></item>\n"
+"  <skipped><a><b/></a></skipped>\n"
+"  <item id='2'><name>second</name><!-- c --></item>\n"
+"</root>\n"
+;
+
+    wxStringInputStream sis(xmlText);
+    wxXmlReader reader(sis);
+
+    wxString names;
+    while ( reader.Read() )
+    {
+        if ( reader.GetNodeType() != wxXML_READER_START_ELEMENT )
+            continue;
+
+        if ( reader.GetName() == "skipped" )
+        {
+            REQUIRE( reader.Skip() );
+            CHECK( reader.GetNodeType() == wxXML_READER_END_ELEMENT );
+            CHECK( reader.GetName() == "skipped" );
+        }
+        else if ( reader.GetName() == "item" )
+        {
+            wxScopedPtr<wxXmlNode> node(reader.ReadNode());
+            REQUIRE( node );
+            CHECK( reader.GetNodeType() == wxXML_READER_END_ELEMENT );
+            CHECK( reader.GetName() == "item" );
+
+            CHECK( node->GetName() == "item" );
+            CHECK( node->GetParent() == NULL );
+            CHECK( node->GetLineNumber() == (names.empty() ? 2 : 4) );
+
+            wxXmlNode* const name = node->GetChildren();
+            REQUIRE( name );
+            CHECK( name->GetName() == "name" );
+            CHECK( name->GetParent() == node.get() );
+            CHECK( name->GetNext() );
+
+            names += node->GetAttribute("id");
+            names += name->GetNodeContent();
+        }
+    }
+
+    CHECK( !reader.HasError() );
+    CHECK( names == "1first2second" );
+}
+
+namespace
+{
+
+// Count the elements and their attributes and concatenate all text.
+class TestXmlReaderHandler : public wxXmlReaderHandler
+{
+public:
+    TestXmlReaderHandler() : m_elements(0), m_attributes(0) {}
+
+    virtual bool OnStartElement(wxXmlReader& reader) wxOVERRIDE
+    {
+        m_elements++;
+        m_attributes += reader.GetAttributeCount();
+
+        return reader.GetName() != "stop";
+    }
+
+    virtual bool OnText(wxXmlReader& reader) wxOVERRIDE
+    {
+        m_text += reader.GetContent();
+        return true;
+    }
+
+    int m_elements;
+    size_t m_attributes;
+    wxString m_text;
+};
+
+} // anonymous namespace
+
+TEST_CASE("wxXmlReader::Parse", "[xml][reader]")
+{
+    SECTION("Large")
+    {
+        // Use enough data to require several chunks.
+        wxString xmlText("<root>");
+        for ( int n = 0; n < 10000; n++ )
+            xmlText += wxString::Format("<e n='%d' m=\"x\">%d</e>\n", n, n % 10);
+        xmlText += "</root>";
+
+        wxStringInputStream sis(xmlText);
+        wxXmlReader reader(sis, wxXMLDOC_KEEP_WHITESPACE_NODES);
+
+        TestXmlReaderHandler handler;
+        CHECK( reader.Parse(handler) );
+        CHECK( handler.m_elements == 10001 );
+        CHECK( handler.m_attributes == 20000 );
+        CHECK( handler.m_text.length() == 20000 );
+    }
+
+    SECTION("Stop")
+    {
+        wxStringInputStream sis("<root><a/><stop/><b/></root>");
+        wxXmlReader reader(sis);
+
+        TestXmlReaderHandler handler;
+        CHECK( reader.Parse(handler) );
+        CHECK( handler.m_elements == 3 );
+    }
+
+    SECTION("Error")
+    {
+        wxStringInputStream sis("<root><a></b></root>");
+        wxXmlReader reader(sis);
+
+        wxLogNull noLog;
+        TestXmlReaderHandler handler;
+        CHECK( !reader.Parse(handler) );
+        CHECK( reader.HasError() );
+    }
+}
+
+TEST_CASE("wxXmlDocument::LoadArena", "[xml][arena]")
+{
+    const char *xmlText =
+"<?xml version=\"1.0\" encoding=\"UTF-8\"?>\n"
+"<resource version=\"2.3.0.1\">\n"
+"  <!-- comment -->\n"
+"  <object class=\"wxDialog\" name=\"dlg\">\n"
+"    <title>Some <![CDATA[<data>]]> text</title>\n"
+"    <object class=\"wxButton\" name=\"ok\">\n"
+"      <label>OK</label>\n"
+"    </object>\n"
+"    <object class=\"wxButton\" name=\"cancel\">\n"
+"      <label>Cancel</label>\n"
+"    </object>\n"
+"  </object>\n"
+"  <?pi data?>\n"
+"</resource>\n"
+;
+
+    wxStringInputStream sis(xmlText);
+    wxScopedPtr<wxXmlDocument> doc(new wxXmlDocument);
+    REQUIRE( doc->Load(sis, "UTF-8", wxXMLDOC_USE_ARENA) );
+
+    // The document must be the same as when loaded without the arena.
+    wxStringInputStream sis2(xmlText);
+    wxXmlDocument doc2;
+    REQUIRE( doc2.Load(sis2) );
+
+    wxStringOutputStream sos, sos2;
+    REQUIRE( doc->Save(sos) );
+    REQUIRE( doc2.Save(sos2) );
+    CHECK( sos.GetString() == sos2.GetString() );
+
+    wxXmlNode* const root = doc->GetRoot();
+    REQUIRE( root );
+    CHECK( root->GetName() == "resource" );
+    CHECK( root->GetLineNumber() == 2 );
+
+    wxXmlNode* const dlg = root->GetChildren()->GetNext();
+    REQUIRE( dlg );
+    CHECK( dlg->GetName() == "object" );
+    CHECK( dlg->GetAttribute("name") == "dlg" );
+
+    wxXmlNode* const ok = dlg->GetChildren()->GetNext();
+    wxXmlNode* const cancel = ok->GetNext();
+    REQUIRE( cancel );
+
+    // Element names are shared by all nodes using them.
+    CHECK( &ok->GetName() == &dlg->GetName() );
+
+    SECTION("Modify")
+    {
+        ok->SetName("button");
+        ok->GetAttributes()->SetName("kind");
+        CHECK( ok->GetName() == "button" );
+        CHECK( cancel->GetName() == "object" );
+        CHECK( ok->GetAttribute("kind") == "wxButton" );
+        CHECK( cancel->GetAttribute("class") == "wxButton" );
+
+        // Mixing heap-allocated nodes with the arena-allocated ones is fine.
+        ok->AddChild(new wxXmlNode(wxXML_ELEMENT_NODE, "default"));
+        ok->AddAttribute("id", "wxID_OK");
+        CHECK( cancel->DeleteAttribute("class") );
+        CHECK( !cancel->HasAttribute("class") );
+    }
+
+    SECTION("Copy")
+    {
+        wxXmlAttribute attr(*ok->GetAttributes());
+        wxXmlNode copy(*dlg);
+        wxXmlDocument docCopy(*doc);
+        doc.reset();
+
+        CHECK( attr.GetName() == "class" );
+        CHECK( copy.GetName() == "object" );
+        CHECK( copy.GetChildren()->GetNext()->GetAttribute("name") == "ok" );
+        CHECK( docCopy.GetRoot()->GetName() == "resource" );
+    }
+
+    SECTION("Detach")
+    {
+        // Detached nodes remain valid after the document is destroyed.
+        REQUIRE( dlg->RemoveChild(ok) );
+        doc.reset();
+
+        CHECK( ok->GetName() == "object" );
+        CHECK( ok->GetAttribute("name") == "ok" );
+        CHECK( ok->GetChildren()->GetNodeContent() == "OK" );
+        delete ok;
+    }
+}
+
+TEST_CASE("wxXmlBinaryDocument", "[xml][binary]")
+{
+    const char *xmlText =
+"<?xml version=\"1.0\" encoding=\"UTF-8\"?>\n"
+"<resource version=\"2.3.0.1\">\n"
+"  <object class=\"wxDialog\" name=\"dlg\">\n"
+"    <title>Some <![CDATA[<data>]]> text</title>\n"
+"    <!-- comment -->\n"
+"    <object class=\"wxButton\" name=\"ok\">\n"
+"      <label>\xc3\x89t\xc3\xa9</label>\n"
+"    </object>\n"
+"  </object>\n"
+"  <?pi data?>\n"
+"  <object class=\"wxMenu\" name=\"dlg\"/>\n"
+"  <ids-range name=\"range\" size=\"3\"/>\n"
+"</resource>\n"
+;
+
+    wxMemoryInputStream sis(xmlText, strlen(xmlText));
+    wxXmlDocument doc;
+    REQUIRE( doc.Load(sis) );
+
+    wxMemoryOutputStream mos;
+    REQUIRE( wxXmlBinaryDocument::Save(doc, mos) );
+
+    wxMemoryInputStream mis(mos);
+    REQUIRE( wxXmlBinaryDocument::CanRead(mis) );
+
+    wxXmlBinaryDocument bin;
+    REQUIRE( bin.Load(mis) );
+    CHECK( bin.IsOk() );
+
+    REQUIRE( bin.GetCount() == 4 );
+    CHECK( bin.GetNodeName(0) == "object" );
+    CHECK( bin.GetKey(0) == "dlg" );
+    CHECK( bin.GetNodeName(1) == "pi" );
+    CHECK( bin.GetKey(1) == "" );
+    CHECK( bin.GetNodeName(3) == "ids-range" );
+    CHECK( bin.GetKey(3) == "range" );
+
+    CHECK( bin.Find("dlg") == 0 );
+    CHECK( bin.FindNext(0) == 2 );
+    CHECK( bin.FindNext(2) == wxNOT_FOUND );
+    CHECK( bin.Find("range") == 3 );
+    CHECK( bin.Find("ok") == wxNOT_FOUND );
+
+    wxXmlNode* const menu = bin.CreateNode(2);
+    REQUIRE( menu );
+    CHECK( menu->GetAttribute("class") == "wxMenu" );
+    CHECK( menu->GetLineNumber() == 11 );
+    CHECK( !menu->GetChildren() );
+    delete menu;
+
+    // Recreating the entire document from binary data results in the same
+    // document.
+    wxXmlNode* const root = bin.CreateRoot();
+    REQUIRE( root );
+    CHECK( root->GetName() == "resource" );
+    CHECK( root->GetAttribute("version") == "2.3.0.1" );
+    CHECK( !root->GetChildren() );
+
+    for ( size_t n = 0; n < bin.GetCount(); n++ )
+        root->AddChild(bin.CreateNode(n));
+
+    wxXmlDocument doc2;
+    doc2.SetRoot(root);
+
+    wxStringOutputStream sos, sos2;
+    REQUIRE( doc.Save(sos) );
+    REQUIRE( doc2.Save(sos2) );
+    CHECK( sos.GetString() == sos2.GetString() );
+
+    SECTION("NotBinary")
+    {
+        wxMemoryInputStream sis2(xmlText, strlen(xmlText));
+        CHECK( !wxXmlBinaryDocument::CanRead(sis2) );
+
+        // The stream must not have been consumed.
+        wxXmlDocument doc3;
+        CHECK( doc3.Load(sis2) );
+    }
+
+    SECTION("Truncated")
+    {
+        const size_t len = mos.GetLength();
+        wxCharBuffer buf(len);
+        mos.CopyTo(buf.data(), len);
+
+        wxLogNull noLog;
+
+        wxMemoryInputStream mis2(buf.data(), len / 2);
+        wxXmlBinaryDocument bin2;
+        CHECK( !bin2.Load(mis2) );
+        CHECK( !bin2.IsOk() );
+        CHECK( bin2.GetCount() == 0 );
+    }
+}
+
+namespace
+{
+
+void AppendU32(wxMemoryBuffer& buf, wxUint32 value)
+{
+    value = wxUINT32_SWAP_ON_BE(value);
+    buf.AppendData(&value, sizeof(value));
+}
+
+// Create the binary XML data with the single child of the root element
+// containing "depth" nested elements.
+wxMemoryBuffer CreateNestedBinaryXml(unsigned depth)
+{
+    static const wxUint32 NO_STRING = 0xffffffff;
+
+    // The only string used, for all element names.
+    wxMemoryBuffer strings;
+    AppendU32(strings, 1);
+    strings.AppendData("e", 2);
+
+    wxMemoryBuffer root;
+    AppendU32(root, wxXML_ELEMENT_NODE);
+    AppendU32(root, 0);             // name
+    AppendU32(root, NO_STRING);     // content
+    AppendU32(root, 1);             // line number
+    AppendU32(root, 0);             // attributes count
+    AppendU32(root, 0);             // children count
+
+    wxMemoryBuffer index;
+    AppendU32(index, 0);            // name
+    AppendU32(index, NO_STRING);    // key
+    AppendU32(index, 0);            // offset
+
+    wxMemoryBuffer nodes;
+    for ( unsigned n = 1; n <= depth; n++ )
+    {
+        AppendU32(nodes, wxXML_ELEMENT_NODE);
+        AppendU32(nodes, 0);
+        AppendU32(nodes, NO_STRING);
+        AppendU32(nodes, n + 1);
+        AppendU32(nodes, 0);
+        AppendU32(nodes, n == depth ? 0 : 1);
+    }
+
+    const wxUint32 rootOffset = 8 + 6*4 + strings.GetDataLen();
+    const wxUint32 indexOffset = rootOffset + root.GetDataLen();
+    const wxUint32 nodesOffset = indexOffset + index.GetDataLen();
+
+    wxMemoryBuffer data;
+    data.AppendData("wxXMLbin", 8);
+    AppendU32(data, 1);             // version
+    AppendU32(data, 1);             // strings count
+    AppendU32(data, 1);             // index entries count
+    AppendU32(data, rootOffset);
+    AppendU32(data, indexOffset);
+    AppendU32(data, nodesOffset);
+    data.AppendData(strings.GetData(), strings.GetDataLen());
+    data.AppendData(root.GetData(), root.GetDataLen());
+    data.AppendData(index.GetData(), index.GetDataLen());
+    data.AppendData(nodes.GetData(), nodes.GetDataLen());
+
+    return data;
+}
+
+} // anonymous namespace
+
+TEST_CASE("wxXmlBinaryDocument::Depth", "[xml][binary]")
+{
+    wxMemoryBuffer data = CreateNestedBinaryXml(100);
+    wxMemoryInputStream mis(data.GetData(), data.GetDataLen());
+    wxXmlBinaryDocument bin;
+    REQUIRE( bin.Load(mis) );
+
+    wxScopedPtr<wxXmlNode> node(bin.CreateNode(0));
+    REQUIRE( node );
+
+    unsigned depth = 1;
+    const wxXmlNode* deepest = node.get();
+    for ( ; deepest->GetChildren(); depth++ )
+        deepest = deepest->GetChildren();
+    CHECK( depth == 100 );
+    CHECK( deepest->GetLineNumber() == 101 );
+
+    // Too deeply nested data must be rejected instead of overflowing the
+    // stack when reading it.
+    data = CreateNestedBinaryXml(1000000);
+    wxMemoryInputStream mis2(data.GetData(), data.GetDataLen());
+    wxXmlBinaryDocument bin2;
+    REQUIRE( bin2.Load(mis2) );
+
+    {
+        wxLogNull noLog;
+        CHECK( !bin2.CreateNode(0) );
+    }
+
+    // And such documents can't be saved in this format.
+    wxXmlNode* const root = new wxXmlNode(wxXML_ELEMENT_NODE, "root");
+    wxXmlNode* parent = root;
+    for ( int n = 0; n < 2000; n++ )
+    {
+        wxXmlNode* const child = new wxXmlNode(wxXML_ELEMENT_NODE, "e");
+        parent->AddChild(child);
+        parent = child;
+    }
+
+    wxXmlDocument doc;
+    doc.SetRoot(root);
+
+    wxMemoryOutputStream mos;
+    CHECK( !wxXmlBinaryDocument::Save(doc, mos) );
+}
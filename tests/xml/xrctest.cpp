@@ -146,10 +146,12 @@ private:
     CPPUNIT_TEST_SUITE( XrcTestCase );
         CPPUNIT_TEST( ObjectReferences );
         CPPUNIT_TEST( IDRanges );
+        CPPUNIT_TEST( AsyncLoading );
     CPPUNIT_TEST_SUITE_END();
 
     void ObjectReferences();
     void IDRanges();
+    void AsyncLoading();
 
     wxDECLARE_NO_COPY_CLASS(XrcTestCase);
 };
@@ -229,4 +231,23 @@ void XrcTestCase::IDRanges()
     }
 }
 
+void XrcTestCase::AsyncLoading()
+{
+    wxXmlResource res(wxXRC_LOAD_ASYNC);
+    res.InitAllHandlers();
+
+    CPPUNIT_ASSERT( res.Load(TEST_XRC_FILE) );
+
+    // The resources must be available as soon as they're requested, even if
+    // the file is still being loaded.
+    wxDialog dlg;
+    CPPUNIT_ASSERT( res.LoadDialog(&dlg, NULL, "dialog") );
+    CPPUNIT_ASSERT( XRCCTRL(dlg, "panel1", wxPanel) );
+    CPPUNIT_ASSERT( res.Unload(TEST_XRC_FILE) );
+
+    // Unloading the file before it was used shouldn't be a problem neither.
+    CPPUNIT_ASSERT( res.Load(TEST_XRC_FILE) );
+    CPPUNIT_ASSERT( res.Unload(TEST_XRC_FILE) );
+}
+
 #endif // wxUSE_XRC
@@ -237,6 +237,8 @@ private:
     void MakePackageZIP(const wxArrayString& flist);
     void MakePackageCPP(const wxArrayString& flist);
     void MakePackagePython(const wxArrayString& flist);
+    void MakePackageBinary();
+    void RelocateFilesInXML(wxXmlNode *node, const wxString& inputPath);
 
     void OutputGettext();
     ExtractedStrings FindStrings();
@@ -244,7 +246,7 @@ private:
 
     bool Validate();
 
-    bool flagVerbose, flagCPP, flagPython, flagGettext, flagValidate, flagValidateOnly;
+    bool flagVerbose, flagCPP, flagPython, flagBinary, flagGettext, flagValidate, flagValidateOnly;
     wxString parOutput, parFuncname, parOutputPath, parSchemaFile;
     wxArrayString parFiles;
     int retCode;
@@ -265,9 +267,10 @@ int XmlResApp::OnRun()
         { wxCMD_LINE_SWITCH, "e", "extra-cpp-code",  "output C++ header file with XRC derived classes" },
         { wxCMD_LINE_SWITCH, "c", "cpp-code",  "output C++ source rather than .rsc file" },
         { wxCMD_LINE_SWITCH, "p", "python-code",  "output wxPython source rather than .rsc file" },
+        { wxCMD_LINE_SWITCH, "b", "binary",  "output compiled XRC file which can be loaded faster rather than .rsc file" },
         { wxCMD_LINE_SWITCH, "g", "gettext",  "output list of translatable strings (to stdout or file if -o used)" },
         { wxCMD_LINE_OPTION, "n", "function",  "C++/Python function name (with -c or -p) [InitXmlResource]" },
-        { wxCMD_LINE_OPTION, "o", "output",  "output file [resource.xrs/cpp]" },
+        { wxCMD_LINE_OPTION, "o", "output",  "output file [resource.xrs/cpp/py/xrb]" },
         { wxCMD_LINE_SWITCH, "",  "validate", "check XRC correctness (in addition to other processing)" },
         { wxCMD_LINE_SWITCH, "",  "validate-only", "check XRC correctness and do nothing else" },
         { wxCMD_LINE_OPTION, "",  "xrc-schema", "RELAX NG schema file to validate against (optional)" },
@@ -318,6 +321,7 @@ void XmlResApp::ParseParams(const wxCmdLineParser& cmdline)
     flagVerbose = cmdline.Found("v");
     flagCPP = cmdline.Found("c");
     flagPython = cmdline.Found("p");
+    flagBinary = cmdline.Found("b");
     flagH = flagCPP && cmdline.Found("e");
     flagValidateOnly = cmdline.Found("validate-only");
     flagValidate = flagValidateOnly || cmdline.Found("validate");
@@ -334,6 +338,8 @@ void XmlResApp::ParseParams(const wxCmdLineParser& cmdline)
                 parOutput = wxT("resource.cpp");
             else if (flagPython)
                 parOutput = wxT("resource.py");
+            else if (flagBinary)
+                parOutput = wxT("resource.xrb");
             else
                 parOutput = wxT("resource.xrs");
         }
@@ -370,6 +376,17 @@ void XmlResApp::ParseParams(const wxCmdLineParser& cmdline)
 
 void XmlResApp::CompileRes()
 {
+    if (flagBinary)
+    {
+        // no temporary files are needed as the compiled file just refers to
+        // the external files, so don't bother with creating them
+        if ( wxFileExists(parOutput) )
+            wxRemoveFile(parOutput);
+
+        MakePackageBinary();
+        return;
+    }
+
     wxArrayString files = PrepareTempFiles();
 
     if ( wxFileExists(parOutput) )
@@ -557,6 +574,40 @@ void XmlResApp::FindFilesInXML(wxXmlNode *node, wxArrayString& flist, const wxSt
 
 
 
+// make all relative file names in the structure relative to the output
+// directory instead of the directory of the input file
+void XmlResApp::RelocateFilesInXML(wxXmlNode *node, const wxString& inputPath)
+{
+    if (node == NULL) return;
+    if (node->GetType() != wxXML_ELEMENT_NODE) return;
+
+    bool containsFilename = NodeContainsFilename(node);
+
+    wxXmlNode *n = node->GetChildren();
+    while (n)
+    {
+        if (containsFilename &&
+            (n->GetType() == wxXML_TEXT_NODE ||
+             n->GetType() == wxXML_CDATA_SECTION_NODE) &&
+            !wxIsAbsolutePath(n->GetContent()) && !inputPath.empty())
+        {
+            wxFileName fn(inputPath + wxFILE_SEP_PATH + n->GetContent());
+            fn.MakeRelativeTo(parOutputPath);
+
+            // XRC always uses forward slashes as path separators
+            n->SetContent(fn.GetFullPath(wxPATH_UNIX));
+        }
+
+        // subnodes:
+        if (n->GetType() == wxXML_ELEMENT_NODE)
+            RelocateFilesInXML(n, inputPath);
+
+        n = n->GetNext();
+    }
+}
+
+
+
 void XmlResApp::DeleteTempFiles(const wxArrayString& flist)
 {
     for (size_t i = 0; i < flist.GetCount(); i++)
@@ -638,6 +689,56 @@ static wxString FileToCppArray(wxString filename, int num)
 }
 
 
+void XmlResApp::MakePackageBinary()
+{
+    // all top-level resources of all input files are put in a single document
+    wxXmlDocument doc;
+
+    for (size_t i = 0; i < parFiles.GetCount(); i++)
+    {
+        if (flagVerbose)
+            wxPrintf(wxT("processing ") + parFiles[i] +  wxT("...\n"));
+
+        wxXmlDocument input;
+        if (!input.Load(parFiles[i]))
+        {
+            wxLogError(wxT("Error parsing file ") + parFiles[i]);
+            retCode = 1;
+            continue;
+        }
+
+        RelocateFilesInXML(input.GetRoot(), wxPathOnly(parFiles[i]));
+
+        if (!doc.GetRoot())
+        {
+            doc.SetRoot(input.DetachRoot());
+            continue;
+        }
+
+        wxXmlNode * const root = input.GetRoot();
+        while (wxXmlNode * const node = root->GetChildren())
+        {
+            root->RemoveChild(node);
+            doc.GetRoot()->AddChild(node);
+        }
+    }
+
+    if (retCode)
+        return;
+
+    if (flagVerbose)
+        wxPrintf(wxT("creating compiled XRC file ") + parOutput +  wxT("...\n"));
+
+    wxFileOutputStream out(parOutput);
+    if (!out.IsOk() || !wxXmlBinaryDocument::Save(doc, out) || !out.Close())
+    {
+        wxLogError(wxT("Error writing file ") + parOutput);
+        retCode = 1;
+    }
+}
+
+
+
 void XmlResApp::MakePackageCPP(const wxArrayString& flist)
 {
     wxFFile file(parOutput, wxT("wt"));